@@ -22,6 +22,7 @@ def parseargs(argv)
   options.nodeclarations = false
   options.additionaluint32bucket = false
   options.fatherwithlb = false
+  options.partitioned = false
   opts = OptionParser.new
   opts.on("-k","--key STRING","use given key as suffix for all symbols") do |x|
     options.key = x
@@ -59,6 +60,10 @@ def parseargs(argv)
   opts.on("--sa_reader_sain","use suffixarray_reader with sain-alg") do |x|
     options.sa_reader_standard = false
   end
+  opts.on("--partitioned","generate traversal of parts of a mapped suffix " +
+                          "array and merge of the parts") do |x|
+    options.partitioned = true
+  end
   rest = opts.parse(argv)
   if not rest.empty?
     usage(opts,"superfluous arguments")
@@ -66,6 +71,10 @@ def parseargs(argv)
   if options.key.nil?
     usage(opts,"option --key is mandatory")
   end
+  if options.partitioned and not (options.usefile and options.absolute)
+    usage(opts,"option --partitioned requires options --reader and " +
+               "--absolute")
+  end
   return options
 end
 
@@ -170,6 +179,15 @@ def processlcpinterval_decl(key,options)
   end
 end
 
+def processpartson_decl(key,options)
+  if options.partitioned
+    return "\nstatic void processpartson_#{key}(GtBUinfo_#{key} *,
+                                  GtBUstate_#{key} *);\n"
+  else
+    return ""
+  end
+end
+
 def processlcpinterval_call1(key,options)
   if options.with_process_lcpinterval
     return "if (processlcpinterval_#{key}(lastinterval->lcp,
@@ -206,8 +224,8 @@ def showidxexpr(options)
   end
 end
 
-def process_suf_lcp(key,options)
-print <<END_OF_FILE
+def process_leafedge(key,options,indent = 0)
+print <<END_OF_FILE.gsub(/^(?=.)/," " * indent)
     gt_assert(stack->nextfreeGtBUItvinfo > 0);
     if (lcpvalue <= TOP_ESA_BOTTOMUP_#{key}.lcp)
     {
@@ -230,6 +248,51 @@ print <<END_OF_FILE
       }
     }
     gt_assert(lastinterval == NULL);
+END_OF_FILE
+end
+
+# In a part, the interval at the bottom of the stack represents all
+# lcp-intervals with an lcp value not larger than the threshold. An edge from
+# it to a closed lcp-interval is not processed, instead the interval is
+# moved to the intervals left to the merge.
+def processbranching_call1_part(key,options)
+  if options.partitioned
+    return "if (stack->nextfreeGtBUItvinfo == 1UL)
+        {
+          GtBUinfo_#{key} tmpinfo;
+          GtBUItvinfo_#{key} *partitv;
+
+          if (partitvs->nextfreeGtBUItvinfo >=
+              partitvs->allocatedGtBUItvinfo)
+          {
+            partitvs->spaceGtBUItvinfo
+              = allocateBUstack_#{key}(partitvs->spaceGtBUItvinfo,
+                                partitvs->allocatedGtBUItvinfo,
+                                partitvs->allocatedGtBUItvinfo +
+                                incrementstacksize,
+                                bustate);
+            partitvs->allocatedGtBUItvinfo += incrementstacksize;
+          }
+          partitv = partitvs->spaceGtBUItvinfo +
+                    partitvs->nextfreeGtBUItvinfo++;
+          partitv->lcp = lastinterval->lcp;
+          partitv->lb = lastinterval->lb;
+          partitv->rb = lastinterval->rb;
+          tmpinfo = partitv->info;
+          partitv->info = lastinterval->info;
+          lastinterval->info = tmpinfo;
+          processpartson_#{key}(&partitv->info,bustate);
+        } else
+        {
+          #{processbranching_call1(key,options).gsub("\n","\n  ")}
+        }"
+  else
+    return processbranching_call1(key,options)
+  end
+end
+
+def process_pop_push(key,options,part)
+print <<END_OF_FILE
     while (!haserr && lcpvalue < TOP_ESA_BOTTOMUP_#{key}.lcp)
     {
       lastinterval = POP_ESA_BOTTOMUP_#{key};
@@ -237,7 +300,8 @@ print <<END_OF_FILE
       #{processlcpinterval_call1(key,options)}
       if (lcpvalue <= TOP_ESA_BOTTOMUP_#{key}.lcp)
       {
-        #{processbranching_call1(key,options)}
+        #{part ? processbranching_call1_part(key,options)
+               : processbranching_call1(key,options)}
         lastinterval = NULL;
       }
     }
@@ -265,6 +329,11 @@ print <<END_OF_FILE
 END_OF_FILE
 end
 
+def process_suf_lcp(key,options,part = false)
+  process_leafedge(key,options)
+  process_pop_push(key,options,part)
+end
+
 def lastsuftabvalue_fromarray(options)
   if not options.usefile
     return "GtUword lastsuftabvalue = bucketofsuffixes[numberofsuffixes-1];"
@@ -474,7 +543,7 @@ static int processleafedge_#{key}(bool,
 #{processbranchingedge_decl(key,options)}
 
 #{processlcpinterval_decl(key,options)}
-
+#{processpartson_decl(key,options)}
 #define TOP_ESA_BOTTOMUP_#{key}\\
         stack->spaceGtBUItvinfo[stack->nextfreeGtBUItvinfo-1]
 
@@ -650,3 +719,126 @@ elsif options.process_lastvalue
 end
 puts "  return haserr ? -1 : 0;"
 puts "}"
+
+if options.partitioned
+print <<END_OF_FILE
+
+/* Traverses the suffixes <firstsuffix>..<nextsuffix>-1 of the mapped
+   <suffixarray>, where the lcp values at <firstsuffix> and <nextsuffix> are
+   not larger than <lcpthreshold>. The lcp-intervals with a larger lcp value
+   lie inside the part and are processed, except for the edges from fathers
+   with an lcp value not larger than <lcpthreshold>. Such sons are appended
+   to <partitvs> in the order of their right bounds, the edges to them are
+   processed by the merge. */
+static int gt_esa_bottomup_part_#{key}(const Suffixarray *suffixarray,
+                        GtUword firstsuffix,
+                        GtUword nextsuffix,
+                        GtUword lcpthreshold,
+                        GtArrayGtBUItvinfo_#{key} *partitvs,
+                        GtBUstate_#{key} *bustate,
+                        GtError *err)
+{
+  const GtUword incrementstacksize = 32UL;
+  GtUword lcpvalue,
+                previoussuffix,
+                idx;
+  GtBUItvinfo_#{key} *lastinterval = NULL;
+  bool haserr = false, firstedge, firstedgefromroot = false;
+  GtArrayGtBUItvinfo_#{key} *stack;
+
+  stack = gt_GtArrayGtBUItvinfo_new_#{key}();
+  /* represents all lcp-intervals with lcp value at most lcpthreshold */
+  PUSH_ESA_BOTTOMUP_#{key}(lcpthreshold,firstsuffix);
+  for (idx = firstsuffix; !haserr && idx < nextsuffix; idx++)
+  {
+    lcpvalue = lcptable_get(suffixarray,idx+1);
+    if (lcpvalue <= lcpthreshold)
+    {
+      if (stack->nextfreeGtBUItvinfo == 1UL)
+      {
+        continue; /* the edge to the leaf is processed by the merge */
+      }
+      lcpvalue = lcpthreshold;
+    }
+    previoussuffix = gt_suffixarray_suftab_get(suffixarray,idx);
+END_OF_FILE
+process_suf_lcp(key,options,true)
+print <<END_OF_FILE
+  }
+  gt_assert(haserr || stack->nextfreeGtBUItvinfo == 1UL);
+  gt_GtArrayGtBUItvinfo_delete_#{key}(stack,bustate);
+  return haserr ? -1 : 0;
+}
+
+/* Completes the traversal of the parts processed by
+   gt_esa_bottomup_part_#{key}: traverses the lcp-intervals with an lcp value
+   not larger than <lcpthreshold>, which may cross the borders of the parts,
+   and processes the edges from them to the leaves and to the sons collected
+   in <partitvs[0]>, ..., <partitvs[numofparts-1]>. */
+static int gt_esa_bottomup_merge_#{key}(const Suffixarray *suffixarray,
+                        GtUword numberofsuffixes,
+                        GtUword lcpthreshold,
+                        GtArrayGtBUItvinfo_#{key} **partitvs,
+                        unsigned int numofparts,
+                        GtBUstate_#{key} *bustate,
+                        GtError *err)
+{
+  const GtUword incrementstacksize = 32UL;
+  GtUword lcpvalue,
+                previoussuffix = 0,
+                idx,
+                nextpartitv = 0;
+  unsigned int part = 0;
+  GtBUItvinfo_#{key} *lastinterval = NULL;
+  bool haserr = false, firstedge, firstedgefromroot = true;
+  GtArrayGtBUItvinfo_#{key} *stack;
+
+  stack = gt_GtArrayGtBUItvinfo_new_#{key}();
+  PUSH_ESA_BOTTOMUP_#{key}(0,0);
+  for (idx = 0; !haserr && idx < numberofsuffixes; idx++)
+  {
+    lcpvalue = lcptable_get(suffixarray,idx+1);
+    if (lcpvalue > lcpthreshold)
+    {
+      continue;
+    }
+    while (part < numofparts &&
+           nextpartitv == partitvs[part]->nextfreeGtBUItvinfo)
+    {
+      part++;
+      nextpartitv = 0;
+    }
+    if (part < numofparts &&
+        partitvs[part]->spaceGtBUItvinfo[nextpartitv].rb == idx)
+    {
+      /* continue as if the son closed in its part had just been popped */
+      GtBUItvinfo_#{key} *partitv = partitvs[part]->spaceGtBUItvinfo +
+                                    nextpartitv++;
+      GtBUinfo_#{key} tmpinfo;
+
+      PUSH_ESA_BOTTOMUP_#{key}(partitv->lcp,partitv->lb);
+      lastinterval = POP_ESA_BOTTOMUP_#{key};
+      lastinterval->rb = partitv->rb;
+      tmpinfo = lastinterval->info;
+      lastinterval->info = partitv->info;
+      partitv->info = tmpinfo;
+      if (lcpvalue <= TOP_ESA_BOTTOMUP_#{key}.lcp)
+      {
+        #{processbranching_call1(key,options)}
+        lastinterval = NULL;
+      }
+    } else
+    {
+      previoussuffix = gt_suffixarray_suftab_get(suffixarray,idx);
+END_OF_FILE
+process_leafedge(key,options,2)
+puts "    }"
+process_pop_push(key,options,false)
+print <<END_OF_FILE
+  }
+  gt_assert(haserr || stack->nextfreeGtBUItvinfo == 1UL);
+  gt_GtArrayGtBUItvinfo_delete_#{key}(stack,bustate);
+  return haserr ? -1 : 0;
+}
+END_OF_FILE
+end
@@ -7,7 +7,8 @@ ${SC} --key maxpairs --reader \
                      --absolute \
                      --sa_reader_sain \
                      --fatherwithlb \
-                     --no_process_lcpinterval > ${TEMPLATE}-maxpairs.inc
+                     --no_process_lcpinterval \
+                     --partitioned > ${TEMPLATE}-maxpairs.inc
 
 ${SC} --key spmsk --no_process_branchingedge > ${TEMPLATE}-spmsk.inc
 
@@ -100,6 +100,18 @@ def init_esr(key)
   end
 end
 
+def init_esr_part(key)
+  if key == "ENCSEQ"
+    return "esr = gt_encseq_create_reader_with_readmode(
+                            encseq,
+                            gt_readmode_inverse_direction(
+                                                    part->sainseq->readmode),
+                            part->sainseq->totallength - part->endpos);"
+  else
+    return ""
+  end
+end
+
 def delete_esr(key)
   if key == "ENCSEQ"
     return "gt_encseq_reader_delete(esr);"
@@ -583,6 +595,46 @@ static GtUword gt_sain_#{key}_insertSstarsuffixes(GtSainseq *sainseq,
   return countSstartype;
 }
 
+#ifdef GT_THREADS_ENABLED
+static void gt_sain_#{key}_partSstarsuffixes(#{getc_param(key)},
+                                             GtSainSeqpart *part)
+{
+  GtUword nextcc = part->nextcc;
+  GtUsainindextype position, *bucketcount = part->bucketcount;
+#{declare_tmpvars(key,true)}
+  bool nextisStype = part->nextisStype;
+
+  gt_assert(part->startpos < part->endpos);
+#{init_esr_part(key)}
+  part->countSstartype = 0;
+  for (position = (GtUsainindextype) (part->endpos-1); /* Nothing */;
+       position--)
+  {
+    GtUword currentcc = #{getc_call(key,"position",true)};
+    bool currentisStype = (currentcc < nextcc ||
+                           (currentcc == nextcc && nextisStype)) ? true : false;
+    if (!currentisStype && nextisStype)
+    {
+      if (part->suftab != NULL)
+      {
+        part->suftab[--bucketcount[nextcc]] = position;
+      } else
+      {
+        bucketcount[nextcc]++;
+        part->countSstartype++;
+      }
+    }
+    nextisStype = currentisStype;
+    nextcc = currentcc;
+    if (position == (GtUsainindextype) part->startpos)
+    {
+      break;
+    }
+  }
+#{delete_esr(key)}
+}
+#endif
+
 static void gt_sain_#{key}_assignSstarlength(GtSainseq *sainseq,
                                              #{getc_param(key)},
                                              GtUsainindextype *lentab)
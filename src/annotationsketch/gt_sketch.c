@@ -299,6 +299,7 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
     {
       in_stream = gt_gff3_in_stream_new_unsorted(argc - parsed_args,
                                                  argv + parsed_args);
+      gt_gff3_in_stream_enable_node_arena(in_stream);
       if (arguments->verbose)
         gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) in_stream);
     } else if (strcmp(gt_str_get(arguments->input), "bed") == 0)
@@ -313,6 +314,7 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
         in_stream = gt_gtf_in_stream_new(NULL);
       else
         in_stream = gt_gtf_in_stream_new(argv[parsed_args]);
+      gt_gtf_in_stream_enable_node_arena(in_stream);
     }
     last_stream = in_stream;
 
@@ -35,6 +35,7 @@
 #include "core/ma_api.h"
 #include "core/md5_tab_api.h"
 #include "core/parseutils.h"
+#include "core/seqid_tab.h"
 #include "core/sig.h"
 #include "core/str_array.h"
 #include "core/undef_api.h"
@@ -49,6 +50,7 @@ struct GtBioseq {
   char **descriptions;
   GtEncseq *encseq;
   GtMD5Tab *md5_tab;
+  GtSeqidTab *seqid_tab;
 };
 
 /* this global variable is necessary for the signal handler below */
@@ -279,6 +281,7 @@ void gt_bioseq_delete(GtBioseq *bs)
   if (!bs) return;
   gt_str_delete(bs->sequence_file);
   gt_md5_tab_delete(bs->md5_tab);
+  gt_seqid_tab_delete(bs->seqid_tab);
   if (bs->descriptions) {
     for (i = 0; i < gt_encseq_num_of_sequences(bs->encseq); i++) {
       gt_free(bs->descriptions[i]);
@@ -472,6 +475,20 @@ GtUword gt_bioseq_md5_to_index(GtBioseq *bs, const char *md5)
   return gt_md5_tab_map(bs->md5_tab, md5);
 }
 
+GtUword gt_bioseq_seqid_to_index(GtBioseq *bs, const char *seqid,
+                                 bool *ambiguous)
+{
+  gt_assert(bs && seqid && ambiguous);
+  if (!bs->seqid_tab) {
+    bs->seqid_tab = gt_seqid_tab_new(bs->encseq,
+                                     bs->use_stdin
+                                       ? NULL
+                                       : gt_str_get(bs->sequence_file));
+  }
+  return gt_seqid_tab_map(bs->seqid_tab, bs->encseq, seqid, strlen(seqid),
+                          ambiguous);
+}
+
 void gt_bioseq_show_as_fasta(GtBioseq *bs, GtUword width, GtFile *outfp)
 {
   GtUword i;
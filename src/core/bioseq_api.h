@@ -96,6 +96,12 @@ GtUword     gt_bioseq_number_of_sequences(GtBioseq *bioseq);
 /* Return the index of the (first) sequence with given <MD5> contained in
    <bioseq>, if it exists. Otherwise <GT_UNDEF_UWORD> is returned. */
 GtUword     gt_bioseq_md5_to_index(GtBioseq *bioseq, const char *MD5);
+/* Return the index of the sequence in <bioseq> whose description starts with
+   <seqid>, followed by whitespace or the end of the description. If no such
+   sequence exists, <GT_UNDEF_UWORD> is returned. <ambiguous> is set to true
+   if more than one sequence matches. */
+GtUword     gt_bioseq_seqid_to_index(GtBioseq *bioseq, const char *seqid,
+                                     bool *ambiguous);
 /* Shows a <bioseq> on <outfp> (in fasta format).
    If <width> is != 0 the sequences are formatted accordingly. */
 void        gt_bioseq_show_as_fasta(GtBioseq *bioseq, GtUword width,
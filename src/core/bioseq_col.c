@@ -19,7 +19,6 @@
 #include "core/class_alloc_lock.h"
 #include "core/cstr_api.h"
 #include "core/grep.h"
-#include "core/hashmap_api.h"
 #include "core/ma_api.h"
 #include "core/md5_seqid_api.h"
 #include "core/seq_col_rep.h"
@@ -32,7 +31,6 @@ struct GtBioseqCol {
   GtBioseq **bioseqs;
   GtUword num_of_seqfiles;
   GtSeqInfoCache *grep_cache;
-  GtHashmap *duplicates;
   bool matchdescstart;
 };
 
@@ -47,7 +45,6 @@ static void gt_bioseq_col_delete(GtSeqCol *sc)
   bsc = gt_bioseq_col_cast(sc);
   if (!bsc) return;
   gt_seq_info_cache_delete(bsc->grep_cache);
-  gt_hashmap_delete(bsc->duplicates);
   for (i = 0; i < bsc->num_of_seqfiles; i++)
     gt_bioseq_delete(bsc->bioseqs[i]);
   gt_free(bsc->bioseqs);
@@ -64,17 +61,35 @@ static int grep_desc(GtBioseqCol *bsc, GtUword *filenum,
   int had_err = 0;
   gt_error_check(err);
   gt_assert(bsc && filenum && seqnum && seqid);
+  /* with -matchdescstart, the sequence ID tables answer all queries */
+  if (bsc->matchdescstart) {
+    bool ambiguous = false;
+    for (i = 0; i < bsc->num_of_seqfiles; i++) {
+      j = gt_bioseq_seqid_to_index(bsc->bioseqs[i], gt_str_get(seqid),
+                                   &ambiguous);
+      if (j != GT_UNDEF_UWORD) {
+        if (num_matches++ > 0 || ambiguous) {
+          gt_error_set(err, "query seqid '%s' could match more than one "
+                            "sequence description", gt_str_get(seqid));
+          return -1;
+        }
+        *filenum = i;
+        *seqnum = j;
+      }
+    }
+    if (num_matches == 0) {
+      gt_error_set(err, "no description matched sequence ID '%s'",
+                   gt_str_get(seqid));
+      return -1;
+    }
+    return 0;
+  }
   /* create cache */
   if (!bsc->grep_cache)
     bsc->grep_cache = gt_seq_info_cache_new();
   /* try to read from cache */
   seq_info_ptr = gt_seq_info_cache_get(bsc->grep_cache, gt_str_get(seqid));
   if (seq_info_ptr) {
-    if (bsc->duplicates && gt_hashmap_get(bsc->duplicates, gt_str_get(seqid))) {
-      gt_error_set(err, "query seqid '%s' could match more than one "
-                        "sequence description", gt_str_get(seqid));
-      return -1;
-    }
     *filenum = seq_info_ptr->filenum;
     *seqnum = seq_info_ptr->seqnum;
     return 0;
@@ -82,11 +97,7 @@ static int grep_desc(GtBioseqCol *bsc, GtUword *filenum,
   pattern = gt_str_new();
   escaped = gt_str_new();
   gt_grep_escape_extended(escaped, gt_str_get(seqid), gt_str_length(seqid));
-  if (bsc->matchdescstart)
-    gt_str_append_cstr(pattern, "^");
   gt_str_append_str(pattern, escaped);
-  if (bsc->matchdescstart)
-    gt_str_append_cstr(pattern, "([[:space:]]|$)");
   for (i = 0; !had_err && i < bsc->num_of_seqfiles; i++) {
     GtBioseq *bioseq = bsc->bioseqs[i];
     for (j = 0; !had_err && j < gt_bioseq_number_of_sequences(bioseq); j++) {
@@ -124,32 +135,9 @@ static int grep_desc(GtBioseqCol *bsc, GtUword *filenum,
 static void gt_bioseq_col_enable_match_desc_start(GtSeqCol *sc)
 {
   GtBioseqCol *bsc;
-  GtSeqInfo seq_info;
-  GtUword i,j;
-  char buf[BUFSIZ], fmt[32];
   gt_assert(sc);
   bsc = gt_bioseq_col_cast(sc);
   bsc->matchdescstart = true;
-  (void) sprintf(fmt, "%%%ds", BUFSIZ-1);
-  /* pre-cache seqids for faster search */
-  if (!bsc->grep_cache)
-    bsc->grep_cache = gt_seq_info_cache_new();
-  for (i = 0; i < bsc->num_of_seqfiles; i++) {
-    GtBioseq *bioseq = bsc->bioseqs[i];
-    for (j = 0; j < gt_bioseq_number_of_sequences(bioseq); j++) {
-      const char *desc = gt_bioseq_get_description(bioseq, j);
-      (void) sscanf(desc, fmt, buf);
-      seq_info.filenum = i;
-      seq_info.seqnum = j;
-      if (!gt_seq_info_cache_get(bsc->grep_cache, buf))
-        gt_seq_info_cache_add(bsc->grep_cache, buf, &seq_info);
-      else {
-        if (!bsc->duplicates)
-          bsc->duplicates = gt_hashmap_new(GT_HASH_STRING, NULL, NULL);
-        gt_hashmap_add(bsc->duplicates, buf, (void*) 1);
-      }
-    }
-  }
 }
 
 static int gt_bioseq_col_grep_desc(GtSeqCol *sc, char **seq,
@@ -422,7 +410,6 @@ GtSeqCol* gt_bioseq_col_new(GtStrArray *sequence_files, GtError *err)
   gt_assert(gt_str_array_size(sequence_files));
   sc = gt_seq_col_create(gt_bioseq_col_class());
   bsc = gt_bioseq_col_cast(sc);
-  bsc->duplicates = NULL;
   bsc->num_of_seqfiles = gt_str_array_size(sequence_files);
   bsc->bioseqs = gt_calloc(bsc->num_of_seqfiles, sizeof (GtBioseq*));
   for (i = 0; !had_err && i < bsc->num_of_seqfiles; i++) {
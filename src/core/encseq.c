@@ -21,8 +21,12 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <limits.h>
+#include <string.h>
 #include <errno.h>
 #include <ctype.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 #include "core/alphabet.h"
 #include "core/array.h"
 #include "core/arraydef_api.h"
@@ -716,6 +720,167 @@ static void showGtRange(const GtRange *range)
 }
 #endif
 
+/* The following table maps a byte of the two bit encoding to the four
+   characters it represents, from left to right. */
+
+#define GT_TWOBITBYTE(B)\
+        {(GtUchar) (((B) >> 6) & 3), (GtUchar) (((B) >> 4) & 3),\
+         (GtUchar) (((B) >> 2) & 3), (GtUchar) ((B) & 3)}
+#define GT_TWOBITBYTE4(B)\
+        GT_TWOBITBYTE(B), GT_TWOBITBYTE((B) + 1),\
+        GT_TWOBITBYTE((B) + 2), GT_TWOBITBYTE((B) + 3)
+#define GT_TWOBITBYTE16(B)\
+        GT_TWOBITBYTE4(B), GT_TWOBITBYTE4((B) + 4),\
+        GT_TWOBITBYTE4((B) + 8), GT_TWOBITBYTE4((B) + 12)
+#define GT_TWOBITBYTE64(B)\
+        GT_TWOBITBYTE16(B), GT_TWOBITBYTE16((B) + 16),\
+        GT_TWOBITBYTE16((B) + 32), GT_TWOBITBYTE16((B) + 48)
+
+static const GtUchar twobitbyte2codes[256][4] = {
+  GT_TWOBITBYTE64(0), GT_TWOBITBYTE64(64),
+  GT_TWOBITBYTE64(128), GT_TWOBITBYTE64(192)
+};
+
+#ifdef __SSE2__
+/* number of characters in the 16 bytes of a vector */
+#define GT_TWOBITVECTORCHARS 64
+/* reverses the 16 bit words of each unit of the two bit encoding */
+#if GT_LOGWORDSIZE == 6
+#define GT_TWOBITWORDORDER _MM_SHUFFLE(0, 1, 2, 3)
+#else
+#define GT_TWOBITWORDORDER _MM_SHUFFLE(2, 3, 0, 1)
+#endif
+
+/* Unpack the 64 characters of the 16 bytes of two bit encoding at <src>
+   into <dest>. The bytes of each unit are brought into the order of the
+   characters first. As SSE2 cannot shift single bytes, the four characters
+   of each byte are extracted by 16 bit shifts and masks and interleaved. */
+static void gt_encseq_twobitencoding_unpack_sse2(GtUchar *dest,
+                                                 const GtTwobitencoding *src)
+{
+  const __m128i mask = _mm_set1_epi8(3);
+  __m128i bytes, c6, c4, c2, c0, first, second;
+
+  bytes = _mm_loadu_si128((const __m128i *) src);
+  bytes = _mm_or_si128(_mm_slli_epi16(bytes, 8), _mm_srli_epi16(bytes, 8));
+  bytes = _mm_shufflelo_epi16(bytes, GT_TWOBITWORDORDER);
+  bytes = _mm_shufflehi_epi16(bytes, GT_TWOBITWORDORDER);
+  c6 = _mm_and_si128(_mm_srli_epi16(bytes, 6), mask);
+  c4 = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+  c2 = _mm_and_si128(_mm_srli_epi16(bytes, 2), mask);
+  c0 = _mm_and_si128(bytes, mask);
+  first = _mm_unpacklo_epi8(c6, c4);
+  second = _mm_unpacklo_epi8(c2, c0);
+  _mm_storeu_si128((__m128i *) dest, _mm_unpacklo_epi16(first, second));
+  _mm_storeu_si128((__m128i *) (dest + 16),
+                   _mm_unpackhi_epi16(first, second));
+  first = _mm_unpackhi_epi8(c6, c4);
+  second = _mm_unpackhi_epi8(c2, c0);
+  _mm_storeu_si128((__m128i *) (dest + 32),
+                   _mm_unpacklo_epi16(first, second));
+  _mm_storeu_si128((__m128i *) (dest + 48),
+                   _mm_unpackhi_epi16(first, second));
+}
+#endif
+
+/* Unpack the <len> characters of <twobitencoding> beginning at <startpos>
+   into <dest>. All positions except for those in the first and the last
+   unit are unpacked 64 at a time with SSE2 if available, and bytewise via
+   <twobitbyte2codes> otherwise. */
+static void gt_encseq_twobitencoding_unpack(GtUchar *dest,
+                                        const GtTwobitencoding *twobitencoding,
+                                        GtUword startpos,
+                                        GtUword len)
+{
+  const GtTwobitencoding *tbeptr;
+  GtUword pos = startpos, endpos = startpos + len;
+
+  while (pos < endpos && GT_MODBYUNITSIN2BITENC(pos) > 0) {
+    *dest++ = (GtUchar) EXTRACTENCODEDCHAR(twobitencoding, pos);
+    pos++;
+  }
+  tbeptr = twobitencoding + GT_DIVBYUNITSIN2BITENC(pos);
+#ifdef __SSE2__
+  for (/* Nothing */; pos + GT_TWOBITVECTORCHARS <= endpos;
+       tbeptr += GT_TWOBITVECTORCHARS/GT_UNITSIN2BITENC,
+       pos += GT_TWOBITVECTORCHARS, dest += GT_TWOBITVECTORCHARS) {
+    gt_encseq_twobitencoding_unpack_sse2(dest, tbeptr);
+  }
+#endif
+  for (/* Nothing */; pos + GT_UNITSIN2BITENC <= endpos;
+       tbeptr++, pos += GT_UNITSIN2BITENC) {
+    GtTwobitencoding unit = *tbeptr;
+    int shift;
+
+    for (shift = GT_INTWORDSIZE - CHAR_BIT; shift >= 0; shift -= CHAR_BIT) {
+      memcpy(dest, twobitbyte2codes[(unit >> shift) & 0xFF], (size_t) 4);
+      dest += 4;
+    }
+  }
+  while (pos < endpos) {
+    *dest++ = (GtUchar) EXTRACTENCODEDCHAR(twobitencoding, pos);
+    pos++;
+  }
+}
+
+/* Fast path of the forward extraction functions: if the range from
+   <frompos> to <topos> can be copied directly from the plain sequence or
+   contains no special character, the encoded characters are stored in
+   <buffer> without going through the reader character by character and true
+   is returned. Otherwise false is returned and the caller has to use <esr>. */
+static bool gt_encseq_extract_encoded_bulk(GtEncseqReader *esr,
+                                           const GtEncseq *encseq,
+                                           GtUchar *buffer,
+                                           GtUword frompos,
+                                           GtUword topos)
+{
+  const GtUword len = topos - frompos + 1;
+
+  if (topos >= encseq->totallength)
+    return false;
+  if (encseq->sat == GT_ACCESS_TYPE_DIRECTACCESS) {
+    memcpy(buffer, encseq->plainseq + frompos, sizeof (*buffer) * len);
+    return true;
+  }
+  if (encseq->twobitencoding == NULL ||
+      (encseq->has_specialranges &&
+       encseq->delivercontainsspecial(encseq, GT_READMODE_FORWARD, esr,
+                                      frompos, len)))
+    return false;
+  gt_encseq_twobitencoding_unpack(buffer, encseq->twobitencoding, frompos,
+                                  len);
+  return true;
+}
+
+/* Like gt_encseq_extract_encoded_bulk(), but additionally maps the encoded
+   characters to their original characters. This is only possible if these
+   do not depend on exceptions. */
+static bool gt_encseq_extract_decoded_bulk(GtEncseqReader *esr,
+                                           const GtEncseq *encseq,
+                                           char *buffer,
+                                           GtUword frompos,
+                                           GtUword topos)
+{
+  char decodetab[4];
+  GtUword idx;
+  unsigned int cc;
+
+  if (encseq->twobitencoding == NULL ||
+      (encseq->has_exceptiontable &&
+       encseq->specialcharinfo.realexceptionranges > 0) ||
+      !gt_encseq_extract_encoded_bulk(esr, encseq, (GtUchar *) buffer,
+                                      frompos, topos))
+    return false;
+  for (cc = 0; cc < 4U; cc++) {
+    decodetab[cc] = encseq->has_exceptiontable
+                      ? encseq->maxchars[cc]
+                      : gt_alphabet_decode(encseq->alpha, (GtUchar) cc);
+  }
+  for (idx = 0; idx <= topos - frompos; idx++)
+    buffer[idx] = decodetab[(GtUchar) buffer[idx]];
+  return true;
+}
+
 void gt_encseq_extract_encoded_with_reader(GtEncseqReader *esr,
                                const GtEncseq *encseq,
                                GtUchar *buffer,
@@ -726,6 +891,8 @@ void gt_encseq_extract_encoded_with_reader(GtEncseqReader *esr,
 
   gt_assert(frompos <= topos && encseq != NULL &&
             topos < encseq->logicaltotallength && buffer != NULL);
+  if (gt_encseq_extract_encoded_bulk(esr, encseq, buffer, frompos, topos))
+    return;
   gt_encseq_reader_reinit_with_readmode(esr, encseq, GT_READMODE_FORWARD,
                                         frompos);
   for (pos=frompos, idx = 0; pos <= topos; pos++, idx++) {
@@ -739,16 +906,13 @@ void gt_encseq_extract_encoded(const GtEncseq *encseq,
                                GtUword topos)
 {
   GtEncseqReader *esr;
-  GtUword idx, pos;
 
   gt_assert(frompos <= topos && encseq != NULL &&
             topos < encseq->logicaltotallength && buffer != NULL);
   esr = gt_encseq_create_reader_with_readmode(encseq,
                                               GT_READMODE_FORWARD,
                                               frompos);
-  for (pos=frompos, idx = 0; pos <= topos; pos++, idx++) {
-    buffer[idx] = gt_encseq_reader_next_encoded_char(esr);
-  }
+  gt_encseq_extract_encoded_with_reader(esr, encseq, buffer, frompos, topos);
   gt_encseq_reader_delete(esr);
 }
 
@@ -762,6 +926,8 @@ void gt_encseq_extract_decoded_with_reader(GtEncseqReader *esr,
 
   gt_assert(frompos <= topos && encseq != NULL &&
             topos < encseq->logicaltotallength && buffer != NULL);
+  if (gt_encseq_extract_decoded_bulk(esr, encseq, buffer, frompos, topos))
+    return;
   gt_encseq_reader_reinit_with_readmode(esr, encseq, GT_READMODE_FORWARD,
                                         frompos);
   for (pos=frompos, idx = 0; pos <= topos; pos++, idx++) {
@@ -775,16 +941,13 @@ void gt_encseq_extract_decoded(const GtEncseq *encseq,
                                GtUword topos)
 {
   GtEncseqReader *esr;
-  GtUword idx, pos;
 
   gt_assert(frompos <= topos && encseq != NULL &&
             topos < encseq->logicaltotallength && buffer != NULL);
   esr = gt_encseq_create_reader_with_readmode(encseq,
                                               GT_READMODE_FORWARD,
                                               frompos);
-  for (pos=frompos, idx = 0; pos <= topos; pos++, idx++) {
-    buffer[idx] = gt_encseq_reader_next_decoded_char(esr);
-  }
+  gt_encseq_extract_decoded_with_reader(esr, encseq, buffer, frompos, topos);
   gt_encseq_reader_delete(esr);
 }
 
@@ -4628,6 +4791,7 @@ static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
                            true);
     }
     gt_sequence_buffer_set_symbolmap(fb, gt_alphabet_symbolmap(alphabet));
+    gt_sequence_buffer_enable_prefetch(fb);
     if (encodedseqfunctab[(int) sat].fillposition.function(encseq,
                                                            ssptaboutinfo,
                                                            fb, err) != 0)
@@ -5383,6 +5547,7 @@ static int countnumberofexceptionranges(const GtAlphabet *alpha,
     GtUchar charcode;
 
     gt_sequence_buffer_set_symbolmap(fb, gt_alphabet_symbolmap(alpha));
+    gt_sequence_buffer_enable_prefetch(fb);
     for (currentpos = 0; /* Nothing */; currentpos++) {
       retval = gt_sequence_buffer_next_with_original(fb, &charcode, &cc, err);
       if (retval > 0) {
@@ -5516,6 +5681,7 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
     if (descqueue != NULL)
       gt_sequence_buffer_set_desc_buffer(fb, descqueue);
     gt_sequence_buffer_set_chardisttab(fb, characterdistribution);
+    gt_sequence_buffer_enable_prefetch(fb);
     distspecialrangelength = gt_disc_distri_new();
     distwildcardrangelength = gt_disc_distri_new();
     originaldistribution = gt_calloc((size_t) UCHAR_MAX,
@@ -7820,6 +7986,64 @@ static void testscanatpos(const GtEncseq *encseq,
   gt_encseq_reader_delete(esr);
 }
 
+/* compare the extraction functions, which use a bulk decoding for ranges
+   without special characters, to reading character by character */
+static void runextracttrial(const GtEncseq *encseq,
+                            GtEncseqReader *esr,
+                            GtUchar *encbuf,
+                            char *decbuf,
+                            GtUword frompos,
+                            GtUword topos)
+{
+  GtUword pos;
+
+  gt_encseq_extract_encoded_with_reader(esr, encseq, encbuf, frompos, topos);
+  if (encseq->alpha != NULL)
+    gt_encseq_extract_decoded_with_reader(esr, encseq, decbuf, frompos, topos);
+  gt_encseq_reader_reinit_with_readmode(esr, encseq, GT_READMODE_FORWARD,
+                                        frompos);
+  for (pos = frompos; pos <= topos; pos++) {
+    if (gt_encseq_reader_next_encoded_char(esr) != encbuf[pos - frompos]) {
+      fprintf(stderr, "extract " GT_WU "-" GT_WU ": encoded character at "
+                      "position " GT_WU " differs\n", frompos, topos, pos);
+      exit(GT_EXIT_PROGRAMMING_ERROR);
+    }
+  }
+  if (encseq->alpha != NULL) {
+    gt_encseq_reader_reinit_with_readmode(esr, encseq, GT_READMODE_FORWARD,
+                                          frompos);
+    for (pos = frompos; pos <= topos; pos++) {
+      if (gt_encseq_reader_next_decoded_char(esr) != decbuf[pos - frompos]) {
+        fprintf(stderr, "extract " GT_WU "-" GT_WU ": decoded character at "
+                        "position " GT_WU " differs\n", frompos, topos, pos);
+        exit(GT_EXIT_PROGRAMMING_ERROR);
+      }
+    }
+  }
+}
+
+#define GT_EXTRACTTRIAL_MAXLEN 1000UL
+
+static void testextract(const GtEncseq *encseq, GtUword trials)
+{
+  GtEncseqReader *esr;
+  GtUchar encbuf[GT_EXTRACTTRIAL_MAXLEN];
+  char decbuf[GT_EXTRACTTRIAL_MAXLEN];
+  GtUword frompos, len, trial, totallength = encseq->logicaltotallength;
+
+  esr = gt_encseq_create_reader_with_readmode(encseq, GT_READMODE_FORWARD, 0);
+  runextracttrial(encseq, esr, encbuf, decbuf, 0,
+                  GT_MIN(totallength, GT_EXTRACTTRIAL_MAXLEN) - 1);
+  for (trial = 0; trial < trials; trial++) {
+    frompos = (GtUword) (random() % totallength);
+    len = 1UL + (GtUword) (random() %
+                           GT_MIN(totallength - frompos,
+                                  GT_EXTRACTTRIAL_MAXLEN));
+    runextracttrial(encseq, esr, encbuf, decbuf, frompos, frompos + len - 1);
+  }
+  gt_encseq_reader_delete(esr);
+}
+
 static void testmulticharactercompare(const GtEncseq *encseq,
                                       GtReadmode readmode,
                                       GtUword multicharcmptrials)
@@ -7981,6 +8205,10 @@ int gt_encseq_check_consistency(const GtEncseq *encseq,
     gt_logger_log(logger, "run testscanatpos for "GT_WU" trials", scantrials);
     testscanatpos(encseq, readmode, scantrials);
   }
+  if (scantrials > 0 && readmode == GT_READMODE_FORWARD) {
+    gt_logger_log(logger, "run testextract for "GT_WU" trials", scantrials);
+    testextract(encseq, scantrials);
+  }
   if (withseqnumcheck && readmode == GT_READMODE_FORWARD) {
     gt_logger_log(logger, "run testseqnumextraction");
     testseqnumextraction(encseq);
@@ -15,16 +15,17 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/class_alloc_lock.h"
 #include "core/cstr_api.h"
 #include "core/encseq.h"
 #include "core/encseq_col.h"
 #include "core/grep.h"
-#include "core/hashmap_api.h"
 #include "core/ma_api.h"
 #include "core/md5_seqid_api.h"
 #include "core/seq_col_rep.h"
 #include "core/seq_info_cache.h"
+#include "core/seqid_tab.h"
 #include "core/str_api.h"
 #include "core/undef_api.h"
 
@@ -33,7 +34,7 @@ struct GtEncseqCol {
   GtEncseq *encseq;
   GtMD5Tab *md5_tab;
   GtSeqInfoCache *grep_cache;
-  GtHashmap *duplicates;
+  GtSeqidTab *seqid_tab;
   bool matchstart;
 };
 
@@ -47,7 +48,7 @@ static void gt_encseq_col_delete(GtSeqCol *sc)
   esc = gt_encseq_col_cast(sc);
   if (!esc) return;
   gt_seq_info_cache_delete(esc->grep_cache);
-  gt_hashmap_delete(esc->duplicates);
+  gt_seqid_tab_delete(esc->seqid_tab);
   gt_md5_tab_delete(esc->md5_tab);
   gt_encseq_delete(esc->encseq);
 }
@@ -67,17 +68,32 @@ static int gt_encseq_col_do_grep_desc(GtEncseqCol *esc, GtUword *filenum,
   gt_assert(esc && filenum && seqnum && seqid);
   gt_assert(esc->encseq && gt_encseq_has_description_support(esc->encseq));
 
+  /* with -matchdescstart, the sequence ID table answers all queries */
+  if (esc->matchstart) {
+    bool ambiguous;
+    j = gt_seqid_tab_map(esc->seqid_tab, esc->encseq, gt_str_get(seqid),
+                         gt_str_length(seqid), &ambiguous);
+    if (j == GT_UNDEF_UWORD) {
+      gt_error_set(err, "no description matched sequence ID '%s'",
+                   gt_str_get(seqid));
+      return -1;
+    }
+    if (ambiguous) {
+      gt_error_set(err, "query seqid '%s' could match more than one "
+                        "sequence description", gt_str_get(seqid));
+      return -1;
+    }
+    *filenum = gt_encseq_filenum(esc->encseq,
+                                 gt_encseq_seqstartpos(esc->encseq, j));
+    *seqnum = j - gt_encseq_filenum_first_seqnum(esc->encseq, *filenum);
+    return 0;
+  }
   /* create cache */
   if (!esc->grep_cache)
     esc->grep_cache = gt_seq_info_cache_new();
   /* try to read from cache */
   seq_info_ptr = gt_seq_info_cache_get(esc->grep_cache, gt_str_get(seqid));
   if (seq_info_ptr) {
-    if (esc->duplicates && gt_hashmap_get(esc->duplicates, gt_str_get(seqid))) {
-      gt_error_set(err, "query seqid '%s' could match more than one "
-                        "sequence description", gt_str_get(seqid));
-      return -1;
-    }
     *filenum = seq_info_ptr->filenum;
     *seqnum = seq_info_ptr->seqnum;
     return 0;
@@ -85,11 +101,7 @@ static int gt_encseq_col_do_grep_desc(GtEncseqCol *esc, GtUword *filenum,
   pattern = gt_str_new();
   escaped = gt_str_new();
   gt_grep_escape_extended(escaped, gt_str_get(seqid), gt_str_length(seqid));
-  if (esc->matchstart)
-    gt_str_append_cstr(pattern, "^");
   gt_str_append_str(pattern, escaped);
-  if (esc->matchstart)
-    gt_str_append_cstr(pattern, "([[:space:]]|$)");
   for (j = 0; !had_err && j < gt_encseq_num_of_sequences(esc->encseq); j++) {
     const char *desc;
     GtUword desc_len;
@@ -125,34 +137,16 @@ static int gt_encseq_col_do_grep_desc(GtEncseqCol *esc, GtUword *filenum,
 static void gt_encseq_col_enable_match_desc_start(GtSeqCol *sc)
 {
   GtEncseqCol *esc;
-  GtUword j;
-  GtSeqInfo seq_info;
-  GtStr *descbuf = gt_str_new();
+  const char *indexname;
   esc = gt_encseq_col_cast(sc);
   esc->matchstart = true;
-  /* pre-cache seqids for faster search */
-  if (!esc->grep_cache)
-    esc->grep_cache = gt_seq_info_cache_new();
-  for (j = 0; j < gt_encseq_num_of_sequences(esc->encseq); j++) {
-    const char *desc;
-    GtUword desc_len;
-    desc = gt_encseq_description(esc->encseq, &desc_len, j);
-    gt_assert(desc);
-    gt_str_reset(descbuf);
-    gt_str_append_cstr_nt(descbuf, desc, desc_len);
-    seq_info.filenum = gt_encseq_filenum(esc->encseq,
-                                         gt_encseq_seqstartpos(esc->encseq, j));
-    seq_info.seqnum = j - gt_encseq_filenum_first_seqnum(esc->encseq,
-                                                         seq_info.filenum);
-    if (!gt_seq_info_cache_get(esc->grep_cache, gt_str_get(descbuf)))
-      gt_seq_info_cache_add(esc->grep_cache, gt_str_get(descbuf), &seq_info);
-    else {
-      if (!esc->duplicates)
-        esc->duplicates = gt_hashmap_new(GT_HASH_STRING, NULL, NULL);
-      gt_hashmap_add(esc->duplicates, gt_str_get(descbuf), (void*) 1);
-    }
+  /* the table is stored with the index, unless the encseq is in memory */
+  indexname = gt_encseq_indexname(esc->encseq);
+  if (!esc->seqid_tab) {
+    esc->seqid_tab = gt_seqid_tab_new(esc->encseq,
+                                      strcmp(indexname, "generated") != 0
+                                        ? indexname : NULL);
   }
-  gt_str_delete(descbuf);
 }
 
 static GtUword gt_encseq_col_get_sequence_length(const GtSeqCol *sc,
@@ -465,7 +459,7 @@ GtSeqCol* gt_encseq_col_new(GtEncseq *encseq, GtError *err)
   }
   sc = gt_seq_col_create(gt_encseq_col_class());
   esc = gt_encseq_col_cast(sc);
-  esc->duplicates = NULL;
+  esc->seqid_tab = NULL;
   esc->md5_tab = gt_encseq_get_md5_tab(encseq, err);
   gt_assert(esc->md5_tab);
   esc->encseq = gt_encseq_ref(encseq);
@@ -815,6 +815,12 @@ GtUword gt_fa_get_space_current(void)
   return fa->current_size;
 }
 
+void gt_fa_reset_space_peak(void)
+{
+  gt_assert(fa != NULL);
+  fa->max_size = fa->current_size;
+}
+
 void gt_fa_show_space_peak(FILE *fp)
 {
   gt_assert(fa);
@@ -219,6 +219,9 @@ void    gt_fa_enable_global_spacepeak(void);
 GtUword gt_fa_get_space_peak(void);
 /* Return current space usage, in bytes. */
 GtUword gt_fa_get_space_current(void);
+/* Set the space peak to the current space usage, e.g. to measure the space
+   peak of a single step of a program. */
+void    gt_fa_reset_space_peak(void);
 /* Print statistics about current space peak to <fp>. */
 void    gt_fa_show_space_peak(FILE *fp);
 /* Finalize and free static data held by file allocator. */
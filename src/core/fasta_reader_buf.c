@@ -0,0 +1,268 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/fasta_reader_buf.h"
+#include "core/fasta_reader_rep.h"
+#include "core/fasta_separator.h"
+#include "core/file_api.h"
+#include "core/ma_api.h"
+
+/* size of the blocks read from the sequence file */
+#define GT_FASTA_READER_BUF_BLOCKSIZE ((size_t) (1 << 20))
+
+struct GtFastaReaderBuf {
+  const GtFastaReader parent_instance;
+  GtStr *sequence_filename;
+  GtFile *sequence_file;
+  char *block; /* one additional byte for the terminating '\0' */
+};
+
+typedef enum {
+  EXPECTING_SEPARATOR,
+  READING_DESCRIPTION,
+  READING_SEQUENCE_AFTER_NEWLINE,
+  READING_SEQUENCE
+} GtFastaReaderBufState;
+
+#define gt_fasta_reader_buf_cast(FR)\
+        gt_fasta_reader_cast(gt_fasta_reader_buf_class(), FR)
+
+static inline bool fasta_reader_buf_is_blank(char cc)
+{
+  return cc == ' ' || cc == '\r';
+}
+
+/* Append the characters in <line> of length <length> except for carriage
+   returns to <description>. */
+static void fasta_reader_buf_append_description(GtStr *description,
+                                                const char *line,
+                                                GtUword length)
+{
+  const char *cr, *end = line + length;
+  while (line < end && (cr = memchr(line, '\r', end - line)) != NULL) {
+    gt_str_append_cstr_nt(description, line, cr - line);
+    line = cr + 1;
+  }
+  if (line < end)
+    gt_str_append_cstr_nt(description, line, end - line);
+}
+
+/* Process the sequence characters in <line> of length <length>, which is
+   followed by a writable byte in the block buffer. Every run of characters
+   other than blanks is passed to <proc_sequence_part> without copying. Like
+   the fsm reader, all characters of the line including blanks are added to
+   <sequence_length>. */
+static int fasta_reader_buf_sequence_line(char *line, GtUword length,
+                                          GtFastaReaderProcSequencePart
+                                          proc_sequence_part,
+                                          GtUword *sequence_length,
+                                          void *data, GtError *err)
+{
+  char *end = line + length, *runstart, *ptr, saved;
+  int had_err = 0;
+
+  *sequence_length += length;
+  if (!proc_sequence_part)
+    return 0;
+  for (runstart = line; !had_err && runstart < end; runstart = ptr + 1) {
+    for (ptr = runstart; ptr < end && !fasta_reader_buf_is_blank(*ptr); ptr++)
+      /* Nothing */ ;
+    if (ptr > runstart) {
+      saved = *ptr;
+      *ptr = '\0';
+      had_err = proc_sequence_part(runstart, (GtUword) (ptr - runstart), data,
+                                   err);
+      *ptr = saved;
+    }
+  }
+  return had_err;
+}
+
+static int gt_fasta_reader_buf_run(GtFastaReader *fasta_reader,
+                                   GtFastaReaderProcDescription
+                                   proc_description,
+                                   GtFastaReaderProcSequencePart
+                                   proc_sequence_part,
+                                   GtFastaReaderProcSequenceLength
+                                   proc_sequence_length,
+                                   void *data, GtError *err)
+{
+  GtFastaReaderBuf *fr = gt_fasta_reader_buf_cast(fasta_reader);
+  GtFastaReaderBufState state = EXPECTING_SEPARATOR;
+  GtUword sequence_length = 0, line_counter = 1;
+  GtStr *description;
+  char *ptr, *end, *newline;
+  int nbytes, had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(fr);
+
+  /* at least one function has to be defined */
+  gt_assert(proc_description || proc_sequence_part || proc_sequence_length);
+
+  /* init */
+  description = gt_str_new();
+
+  /* rewind sequence file (to allow multiple calls) */
+  if (fr->sequence_file)
+    gt_file_xrewind(fr->sequence_file);
+
+  /* reading */
+  while (!had_err &&
+         (nbytes = gt_file_xread(fr->sequence_file, fr->block,
+                                 GT_FASTA_READER_BUF_BLOCKSIZE)) > 0) {
+    ptr = fr->block;
+    end = fr->block + nbytes;
+    *end = '\0';
+    while (!had_err && ptr < end) {
+      switch (state) {
+        case EXPECTING_SEPARATOR:
+          if (*ptr != GT_FASTA_SEPARATOR) {
+            gt_error_set(err,
+                      "the first character of fasta file \"%s\" has to be '%c'",
+                      gt_str_get(fr->sequence_filename), GT_FASTA_SEPARATOR);
+            had_err = -1;
+          }
+          else {
+            ptr++;
+            state = READING_DESCRIPTION;
+          }
+          break;
+        case READING_DESCRIPTION:
+          newline = memchr(ptr, '\n', end - ptr);
+          if (proc_description) {
+            fasta_reader_buf_append_description(description, ptr,
+                                                (newline ? newline : end)
+                                                - ptr);
+          }
+          if (newline == NULL) {
+            ptr = end;
+            break;
+          }
+          ptr = newline + 1;
+          if (proc_description) {
+            had_err = proc_description(gt_str_get(description),
+                                       gt_str_length(description), data, err);
+            gt_str_reset(description);
+          }
+          sequence_length = 0;
+          line_counter++;
+          state = READING_SEQUENCE_AFTER_NEWLINE;
+          break;
+        case READING_SEQUENCE_AFTER_NEWLINE:
+          if (*ptr == GT_FASTA_SEPARATOR) {
+            if (!sequence_length) {
+              gt_assert(line_counter);
+              gt_error_set(err, "empty sequence after description given in "
+                                "line "GT_WU"", line_counter - 1);
+              had_err = -1;
+              break;
+            }
+            if (proc_sequence_length)
+              had_err = proc_sequence_length(sequence_length, data, err);
+            ptr++;
+            state = READING_DESCRIPTION;
+            break;
+          }
+          /*@fallthrough@*/
+        case READING_SEQUENCE:
+          newline = memchr(ptr, '\n', end - ptr);
+          had_err = fasta_reader_buf_sequence_line(ptr,
+                                                   (newline ? newline : end)
+                                                   - ptr,
+                                                   proc_sequence_part,
+                                                   &sequence_length, data,
+                                                   err);
+          if (newline == NULL) {
+            ptr = end;
+            state = READING_SEQUENCE;
+          }
+          else {
+            ptr = newline + 1;
+            line_counter++;
+            state = READING_SEQUENCE_AFTER_NEWLINE;
+          }
+          break;
+      }
+    }
+  }
+
+  if (!had_err) {
+    /* checks after reading */
+    switch (state) {
+      case EXPECTING_SEPARATOR:
+        gt_error_set(err, "sequence file \"%s\" is empty",
+                     gt_str_get(fr->sequence_filename));
+        had_err = -1;
+        break;
+      case READING_DESCRIPTION:
+        gt_error_set(err, "unfinished fasta entry in line " GT_WU
+                     " of sequence file \"%s\"",
+                     line_counter, gt_str_get(fr->sequence_filename));
+        had_err = -1;
+        break;
+      case READING_SEQUENCE_AFTER_NEWLINE:
+      case READING_SEQUENCE:
+        if (!sequence_length) {
+          gt_assert(line_counter);
+          gt_error_set(err, "empty sequence after description given in line "
+                            ""GT_WU"", line_counter - 1);
+          had_err = -1;
+        }
+        else if (proc_sequence_length)
+          had_err = proc_sequence_length(sequence_length, data, err);
+    }
+  }
+
+  /* free */
+  gt_str_delete(description);
+
+  return had_err;
+}
+
+static void gt_fasta_reader_buf_free(GtFastaReader *fr)
+{
+  GtFastaReaderBuf *gt_fasta_reader_buf = gt_fasta_reader_buf_cast(fr);
+  gt_str_delete(gt_fasta_reader_buf->sequence_filename);
+  gt_file_delete(gt_fasta_reader_buf->sequence_file);
+  gt_free(gt_fasta_reader_buf->block);
+}
+
+const GtFastaReaderClass* gt_fasta_reader_buf_class(void)
+{
+  static const GtFastaReaderClass frc = { sizeof (GtFastaReaderBuf),
+                                          gt_fasta_reader_buf_run,
+                                          gt_fasta_reader_buf_free };
+  return &frc;
+}
+
+GtFastaReader* gt_fasta_reader_buf_new(const GtStr *sequence_filename)
+{
+  GtFastaReader *fr = gt_fasta_reader_create(gt_fasta_reader_buf_class());
+  GtFastaReaderBuf *gt_fasta_reader_buf = gt_fasta_reader_buf_cast(fr);
+  if (sequence_filename) {
+    gt_fasta_reader_buf->sequence_filename =
+      gt_str_clone(sequence_filename);
+    gt_fasta_reader_buf->sequence_file =
+      gt_file_xopen(gt_str_get(sequence_filename), "r");
+  }
+  else
+    gt_fasta_reader_buf->sequence_filename = gt_str_new_cstr("stdin");
+  gt_fasta_reader_buf->block =
+    gt_malloc(sizeof (char) * (GT_FASTA_READER_BUF_BLOCKSIZE + 1));
+  return fr;
+}
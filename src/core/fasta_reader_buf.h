@@ -0,0 +1,34 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef FASTA_READER_BUF_H
+#define FASTA_READER_BUF_H
+
+#include "core/fasta_reader_api.h"
+#include "core/str_api.h"
+
+/* implements the ``fasta reader'' interface by reading the input in large
+   blocks and scanning them with memchr(3). The sequence part handler is called
+   for each maximal run of sequence characters, pointing directly into the
+   block buffer. The parts are '\0'-terminated, but only valid during the
+   call of the handler. */
+typedef struct GtFastaReaderBuf GtFastaReaderBuf;
+
+const GtFastaReaderClass* gt_fasta_reader_buf_class(void);
+GtFastaReader*            gt_fasta_reader_buf_new(const GtStr
+                                                    *sequence_filename);
+
+#endif
@@ -20,10 +20,14 @@
 #include "core/cstr_api.h"
 #include "core/fa_api.h"
 #include "core/ma_api.h"
+#include "core/minmax_api.h"
 #include "core/xansi_api.h"
 #include "core/xbzlib.h"
 #include "core/xzlib.h"
 
+/* initial size of the read buffer used for files opened for reading */
+#define GT_FILE_READBUFSIZE ((size_t) (1 << 18))
+
 struct GtFile {
   GtFileMode mode;
   GtUword reference_count;
@@ -34,9 +38,16 @@ struct GtFile {
   } fileptr;
   char *orig_path,
        *orig_mode,
-       unget_char;
+       unget_char,
+       *readbuf;  /* the bytes in [readbuf_pos, readbuf_fill) have been read
+                     from the underlying handle but not yet consumed */
+  size_t readbuf_size,
+         readbuf_pos,
+         readbuf_fill;
   bool is_stdin,
-       unget_used;
+       unget_used,
+       buffered,  /* true if reading is done blockwise via <readbuf> */
+       in_memory; /* true if <readbuf> holds the whole content */
 };
 
 GtFileMode gt_file_mode_determine(const char *path)
@@ -84,6 +95,15 @@ size_t gt_file_basename_length(const char *path)
   return path_length;
 }
 
+/* Only files which are exclusively read via the <GtFile> object are read
+   blockwise. Files created from a file pointer might be accessed directly by
+   the caller and are therefore never buffered. */
+static bool file_mode_is_read_only(const char *mode)
+{
+  gt_assert(mode);
+  return mode[0] == 'r' && strchr(mode, '+') == NULL;
+}
+
 GtFile* gt_file_new(const char *path, const char *mode, GtError *err)
 {
   gt_error_check(err);
@@ -140,6 +160,7 @@ GtFile* gt_file_open(GtFileMode file_mode, const char *path, const char *mode,
     file->fileptr.file = stdin;
     file->is_stdin = true;
   }
+  file->buffered = file_mode_is_read_only(mode);
   return file;
 }
 
@@ -172,6 +193,7 @@ GtFile* gt_file_xopen_file_mode(GtFileMode file_mode, const char *path,
     file->fileptr.file = stdin;
     file->is_stdin = true;
   }
+  file->buffered = file_mode_is_read_only(mode);
   return file;
 }
 
@@ -192,12 +214,122 @@ GtFile* gt_file_new_from_fileptr(FILE *fp)
   return file;
 }
 
+GtFile* gt_file_new_from_buffer(char *buffer, size_t length)
+{
+  GtFile *file;
+  gt_assert(buffer);
+  file = gt_calloc(1, sizeof (GtFile));
+  file->reference_count = 0;
+  file->mode = GT_FILE_MODE_UNCOMPRESSED;
+  file->readbuf = buffer;
+  file->readbuf_size = length + 1;
+  file->readbuf_fill = length;
+  file->buffered = true;
+  file->in_memory = true;
+  return file;
+}
+
 GtFileMode gt_file_mode(const GtFile *file)
 {
   gt_assert(file);
   return file->mode;
 }
 
+static size_t file_read_unbuffered(GtFile *file, void *buf, size_t nbytes)
+{
+  size_t rval = 0;
+  gt_assert(file);
+  if (file->in_memory)
+    return 0; /* the whole content is in the read buffer */
+  switch (file->mode) {
+    case GT_FILE_MODE_UNCOMPRESSED:
+      rval = gt_xfread(buf, 1, nbytes, file->fileptr.file);
+      break;
+    case GT_FILE_MODE_GZIP:
+      rval = (size_t) gt_xgzread(file->fileptr.gzfile, buf, nbytes);
+      break;
+    case GT_FILE_MODE_BZIP2:
+      rval = (size_t) gt_xbzread(file->fileptr.bzfile, buf, nbytes);
+      break;
+    default: gt_assert(0);
+  }
+  return rval;
+}
+
+static int file_getc_unbuffered(GtFile *file)
+{
+  int c = -1;
+  gt_assert(file);
+  switch (file->mode) {
+    case GT_FILE_MODE_UNCOMPRESSED:
+      c = gt_xfgetc(file->fileptr.file);
+      break;
+    case GT_FILE_MODE_GZIP:
+      c = gt_xgzfgetc(file->fileptr.gzfile);
+      break;
+    case GT_FILE_MODE_BZIP2:
+      c = gt_xbzfgetc(file->fileptr.bzfile);
+      break;
+    default: gt_assert(0);
+  }
+  return c;
+}
+
+static void file_readbuf_ensure(GtFile *file, size_t minsize)
+{
+  gt_assert(file);
+  if (file->readbuf_size < minsize) {
+    size_t newsize = file->readbuf_size ? file->readbuf_size
+                                        : GT_FILE_READBUFSIZE;
+    while (newsize < minsize)
+      newsize *= 2;
+    file->readbuf = gt_realloc(file->readbuf, newsize);
+    file->readbuf_size = newsize;
+  }
+}
+
+/* Moves the unconsumed part of the read buffer to its start and appends as
+   many bytes from the underlying handle as fit into the buffer. One byte is
+   always kept free, such that a '\0' can be appended to the buffer content.
+   Returns the number of bytes appended, 0 means end-of-file. */
+static size_t file_readbuf_fill(GtFile *file)
+{
+  size_t nbytes;
+  gt_assert(file && file->buffered);
+  file_readbuf_ensure(file, GT_FILE_READBUFSIZE);
+  if (file->readbuf_pos > 0) {
+    gt_assert(file->readbuf_pos <= file->readbuf_fill);
+    memmove(file->readbuf, file->readbuf + file->readbuf_pos,
+            file->readbuf_fill - file->readbuf_pos);
+    file->readbuf_fill -= file->readbuf_pos;
+    file->readbuf_pos = 0;
+  }
+  if (file->readbuf_fill + 1 >= file->readbuf_size)
+    file_readbuf_ensure(file, 2 * file->readbuf_size);
+  nbytes = file_read_unbuffered(file, file->readbuf + file->readbuf_fill,
+                                file->readbuf_size - file->readbuf_fill - 1);
+  file->readbuf_fill += nbytes;
+  return nbytes;
+}
+
+/* Moves a character stored by gt_file_unget_char() into the read buffer, such
+   that it is seen by the blockwise read functions. */
+static void file_readbuf_insert_unget_char(GtFile *file)
+{
+  gt_assert(file && file->buffered);
+  if (file->unget_used) {
+    if (file->readbuf_pos == 0) {
+      file_readbuf_ensure(file, GT_MAX(GT_FILE_READBUFSIZE,
+                                       file->readbuf_fill + 2));
+      memmove(file->readbuf + 1, file->readbuf, file->readbuf_fill);
+      file->readbuf_fill++;
+      file->readbuf_pos++;
+    }
+    file->readbuf[--file->readbuf_pos] = file->unget_char;
+    file->unget_used = false;
+  }
+}
+
 int gt_file_xfgetc(GtFile *file)
 {
   int c = -1;
@@ -206,20 +338,15 @@ int gt_file_xfgetc(GtFile *file)
       c = file->unget_char;
       file->unget_used = false;
     }
-    else {
-      switch (file->mode) {
-        case GT_FILE_MODE_UNCOMPRESSED:
-          c = gt_xfgetc(file->fileptr.file);
-          break;
-        case GT_FILE_MODE_GZIP:
-          c = gt_xgzfgetc(file->fileptr.gzfile);
-          break;
-        case GT_FILE_MODE_BZIP2:
-          c = gt_xbzfgetc(file->fileptr.bzfile);
-          break;
-        default: gt_assert(0);
+    else if (file->buffered) {
+      if (file->readbuf_pos == file->readbuf_fill &&
+          file_readbuf_fill(file) == 0) {
+        return EOF;
       }
+      c = (int) (unsigned char) file->readbuf[file->readbuf_pos++];
     }
+    else
+      c = file_getc_unbuffered(file);
   }
   else
     c = gt_xfgetc(stdin);
@@ -229,6 +356,13 @@ int gt_file_xfgetc(GtFile *file)
 void gt_file_unget_char(GtFile *file, char c)
 {
   if (file) {
+    /* the common case of ungetting the character just read from the read
+       buffer is handled by stepping back */
+    if (file->buffered && !file->unget_used && c != (char) EOF &&
+        file->readbuf_pos > 0 && file->readbuf[file->readbuf_pos-1] == c) {
+      file->readbuf_pos--;
+      return;
+    }
     gt_assert(!file->unget_used); /* only one char can be unget at a time */
     file->unget_char = c;
     file->unget_used = true;
@@ -237,6 +371,59 @@ void gt_file_unget_char(GtFile *file, char c)
     gt_xungetc(c, stdin);
 }
 
+int gt_file_xread_line(GtFile *file, char **line, GtUword *length)
+{
+  size_t start, searched;
+  int rval = 0;
+  gt_assert(file && line && length);
+  if (!file->buffered) {
+    /* collect the line character by character in the otherwise unused read
+       buffer */
+    int cc;
+    file->readbuf_fill = 0;
+    file_readbuf_ensure(file, GT_FILE_READBUFSIZE);
+    while ((cc = gt_file_xfgetc(file)) != '\n') {
+      if (cc == EOF) {
+        rval = EOF;
+        break;
+      }
+      file_readbuf_ensure(file, file->readbuf_fill + 2);
+      file->readbuf[file->readbuf_fill++] = cc;
+    }
+    start = 0;
+    *length = file->readbuf_fill;
+  }
+  else {
+    char *newline;
+    file_readbuf_insert_unget_char(file);
+    start = searched = file->readbuf_pos;
+    for (;;) {
+      newline = memchr(file->readbuf + searched, '\n',
+                       file->readbuf_fill - searched);
+      if (newline != NULL) {
+        *length = (GtUword) (newline - (file->readbuf + start));
+        file->readbuf_pos = start + *length + 1;
+        break;
+      }
+      /* line continues beyond the buffered data */
+      searched = file->readbuf_fill - start;
+      start = 0;
+      if (file_readbuf_fill(file) == 0) {
+        *length = file->readbuf_fill;
+        file->readbuf_pos = file->readbuf_fill;
+        rval = EOF;
+        break;
+      }
+    }
+  }
+  /* a Windows newline "\r\n" is not part of the line */
+  if (rval == 0 && *length > 0 && file->readbuf[start + *length - 1] == '\r')
+    (*length)--;
+  file->readbuf[start + *length] = '\0';
+  *line = file->readbuf + start;
+  return rval;
+}
+
 static int vgzprintf(gzFile file, const char *format, va_list va, int buflen)
 {
   int len;
@@ -365,18 +552,29 @@ int gt_file_xread(GtFile *file, void *buf, size_t nbytes)
 {
   int rval = -1;
   if (file) {
-    switch (file->mode) {
-      case GT_FILE_MODE_UNCOMPRESSED:
-        rval = gt_xfread(buf, 1, nbytes, file->fileptr.file);
-        break;
-      case GT_FILE_MODE_GZIP:
-        rval = gt_xgzread(file->fileptr.gzfile, buf, nbytes);
-        break;
-      case GT_FILE_MODE_BZIP2:
-        rval = gt_xbzread(file->fileptr.bzfile, buf, nbytes);
-        break;
-      default: gt_assert(0);
+    if (file->buffered) {
+      size_t copied;
+      file_readbuf_insert_unget_char(file);
+      copied = file->readbuf_fill - file->readbuf_pos;
+      if (copied >= nbytes)
+        copied = nbytes;
+      else if (nbytes - copied >= GT_FILE_READBUFSIZE / 2) {
+        /* large reads bypass the buffer after draining it */
+        memcpy(buf, file->readbuf + file->readbuf_pos, copied);
+        file->readbuf_pos = file->readbuf_fill = 0;
+        return (int) (copied + file_read_unbuffered(file, (char*) buf + copied,
+                                                    nbytes - copied));
+      }
+      else {
+        if (file_readbuf_fill(file) == 0 && file->readbuf_fill == 0)
+          return 0;
+        copied = GT_MIN(file->readbuf_fill, nbytes);
+      }
+      memcpy(buf, file->readbuf + file->readbuf_pos, copied);
+      file->readbuf_pos += copied;
+      return (int) copied;
     }
+    rval = (int) file_read_unbuffered(file, buf, nbytes);
   }
   else
     rval = gt_xfread(buf, 1, nbytes, stdin);
@@ -405,7 +603,9 @@ void gt_file_xwrite(GtFile *file, void *buf, size_t nbytes)
 
 void gt_file_xrewind(GtFile *file)
 {
-  gt_assert(file);
+  gt_assert(file && !file->in_memory);
+  file->readbuf_pos = file->readbuf_fill = 0;
+  file->unget_used = false;
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
       rewind(file->fileptr.file);
@@ -425,6 +625,7 @@ void gt_file_delete_without_handle(GtFile *file)
   if (!file) return;
   gt_free(file->orig_path);
   gt_free(file->orig_mode);
+  gt_free(file->readbuf);
   gt_free(file);
 }
 
@@ -437,7 +638,7 @@ void gt_file_delete(GtFile *file)
   }
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
-        if (!file->is_stdin)
+        if (!file->is_stdin && !file->in_memory)
           gt_fa_fclose(file->fileptr.file);
       break;
     case GT_FILE_MODE_GZIP:
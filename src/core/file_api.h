@@ -20,6 +20,7 @@
 
 #include <stdio.h>
 #include "core/error_api.h"
+#include "core/types_api.h"
 
 typedef enum {
   GT_FILE_MODE_UNCOMPRESSED,
@@ -45,6 +46,12 @@ GtFile*     gt_file_ref(GtFile *file);
 /* Create a new <GtFile> object from a normal file pointer <fp>. */
 GtFile*     gt_file_new_from_fileptr(FILE *fp);
 
+/* Create a new <GtFile> object for reading the <length> bytes stored in
+   <buffer>. The <buffer> must have been allocated with <gt_malloc()> and must
+   have space for at least one additional byte. The <GtFile> object takes
+   ownership of <buffer>. */
+GtFile*     gt_file_new_from_buffer(char *buffer, size_t length);
+
 /* <printf(3)> for generic <file>. */
 void        gt_file_xprintf(GtFile *file, const char *format, ...)
   __attribute__ ((format (printf, 2, 3)));
@@ -60,6 +67,16 @@ void        gt_file_xfputc(int c, GtFile *file);
 /* Return next character from <file> or <EOF>, if end-of-file is reached. */
 int         gt_file_xfgetc(GtFile *file);
 
+/* Read the next line from <file> (which cannot be <NULL>) and store a pointer
+   to its first character in <line> and its length in <length>. The line
+   terminator ('\n' or "\r\n") is not part of the line and is replaced by a
+   '\0' character. The line resides in the internal read buffer of <file>, it
+   can be modified but is only valid until the next read operation on <file>.
+   Returns 0 if a terminated line was read and <EOF> if the end of <file> has
+   been reached. In the latter case <line> contains the (possibly empty)
+   unterminated rest of <file>. */
+int         gt_file_xread_line(GtFile *file, char **line, GtUword *length);
+
 /* Read up to <nbytes> from generic <file> and store result in <buf>, returns
    bytes read. */
 int         gt_file_xread(GtFile *file, void *buf, size_t nbytes);
@@ -0,0 +1,329 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdlib.h>
+#include "core/dynalloc.h"
+#include "core/ensure_api.h"
+#include "core/interval_index.h"
+#include "core/ma_api.h"
+#include "core/mathsupport_api.h"
+#include "core/minmax_api.h"
+#include "core/unused_api.h"
+
+/* The index is an implicit binary search tree over the array of intervals
+   sorted by start position, as in the cgranges library by Heng Li: the
+   elements with an index of the form (2m+1)*2^k-1 are the nodes of level <k>,
+   their children are the elements at distance 2^(k-1). Each element stores the
+   maximum end position of its subtree. */
+
+typedef struct {
+  GtUword low,
+          high,
+          max_high;
+  void *data;
+} GtIntervalIndexElem;
+
+struct GtIntervalIndex {
+  GtIntervalIndexElem *elems;
+  GtUword num_of_elems;
+  size_t allocated;
+  int max_level;
+  bool frozen;
+  GtFree free_func;
+};
+
+/* subtrees up to this level are scanned linearly */
+#define GT_INTERVAL_INDEX_SCAN_LEVEL  3
+
+GtIntervalIndex* gt_interval_index_new(GtFree free_func)
+{
+  GtIntervalIndex *ii = gt_calloc(1, sizeof *ii);
+  ii->free_func = free_func;
+  ii->max_level = -1;
+  ii->frozen = true;
+  return ii;
+}
+
+void gt_interval_index_add(GtIntervalIndex *ii, void *data, GtUword low,
+                           GtUword high)
+{
+  GtIntervalIndexElem *elem;
+  gt_assert(ii && low <= high);
+  ii->elems = gt_dynalloc(ii->elems, &ii->allocated,
+                          (ii->num_of_elems + 1) * sizeof *ii->elems);
+  elem = ii->elems + ii->num_of_elems++;
+  elem->low = low;
+  elem->high = elem->max_high = high;
+  elem->data = data;
+  ii->frozen = false;
+}
+
+static int interval_index_elem_cmp(const void *a, const void *b)
+{
+  const GtIntervalIndexElem *ea = a, *eb = b;
+  if (ea->low != eb->low)
+    return ea->low < eb->low ? -1 : 1;
+  if (ea->high != eb->high)
+    return ea->high < eb->high ? -1 : 1;
+  return 0;
+}
+
+void gt_interval_index_freeze(GtIntervalIndex *ii)
+{
+  GtIntervalIndexElem *a;
+  GtUword i, last_i = 0, last = 0, n;
+  int k;
+  gt_assert(ii);
+  if (ii->frozen)
+    return;
+  a = ii->elems;
+  n = ii->num_of_elems;
+  qsort(a, n, sizeof *a, interval_index_elem_cmp);
+  if (n == 0) {
+    ii->max_level = -1;
+    ii->frozen = true;
+    return;
+  }
+  /* leaves */
+  for (i = 0; i < n; i += 2) {
+    last_i = i;
+    last = a[i].max_high = a[i].high;
+  }
+  /* inner nodes, level by level; <last> is the maximum end position of the
+     rightmost node of the previous level, which stands in for missing right
+     children */
+  for (k = 1; ((GtUword) 1 << k) <= n; k++) {
+    GtUword x = (GtUword) 1 << (k - 1),
+            i0 = (x << 1) - 1,
+            step = x << 2;
+    for (i = i0; i < n; i += step) {
+      GtUword el = a[i - x].max_high,
+              er = i + x < n ? a[i + x].max_high : last,
+              e = a[i].high;
+      e = GT_MAX(e, el);
+      a[i].max_high = GT_MAX(e, er);
+    }
+    last_i = (last_i >> k & 1) ? last_i - x : last_i + x;
+    if (last_i < n && a[last_i].max_high > last)
+      last = a[last_i].max_high;
+  }
+  ii->max_level = k - 1;
+  ii->frozen = true;
+}
+
+bool gt_interval_index_is_frozen(const GtIntervalIndex *ii)
+{
+  gt_assert(ii);
+  return ii->frozen;
+}
+
+GtUword gt_interval_index_size(const GtIntervalIndex *ii)
+{
+  gt_assert(ii);
+  return ii->num_of_elems;
+}
+
+typedef struct {
+  GtUword x;
+  int k;
+  bool left_done;
+} GtIntervalIndexStackElem;
+
+int gt_interval_index_iterate_overlapping(const GtIntervalIndex *ii,
+                                          GtUword start, GtUword end,
+                                          GtIntervalIndexIteratorFunc func,
+                                          void *userdata)
+{
+  GtIntervalIndexStackElem stack[128];
+  const GtIntervalIndexElem *a;
+  GtUword n;
+  int t = 0, rval = 0;
+  gt_assert(ii && ii->frozen && func && start <= end);
+
+  if (ii->max_level < 0)
+    return 0;
+  a = ii->elems;
+  n = ii->num_of_elems;
+  stack[t].k = ii->max_level;
+  stack[t].x = ((GtUword) 1 << ii->max_level) - 1;
+  stack[t++].left_done = false;
+  while (!rval && t > 0) {
+    GtIntervalIndexStackElem z = stack[--t];
+    if (z.k <= GT_INTERVAL_INDEX_SCAN_LEVEL) {
+      /* small subtree, scan it */
+      GtUword i, i0 = z.x >> z.k << z.k,
+              i1 = GT_MIN(i0 + ((GtUword) 1 << (z.k + 1)) - 1, n);
+      for (i = i0; !rval && i < i1 && a[i].low <= end; i++) {
+        if (start <= a[i].high)
+          rval = func(a[i].data, a[i].low, a[i].high, userdata);
+      }
+    }
+    else if (!z.left_done) {
+      /* revisit this node after its left subtree */
+      GtUword y = z.x - ((GtUword) 1 << (z.k - 1));
+      z.left_done = true;
+      stack[t++] = z;
+      if (y >= n || a[y].max_high >= start) {
+        stack[t].k = z.k - 1;
+        stack[t].x = y;
+        stack[t++].left_done = false;
+      }
+    }
+    else if (z.x < n && a[z.x].low <= end) {
+      /* this node and its right subtree may overlap */
+      if (start <= a[z.x].high)
+        rval = func(a[z.x].data, a[z.x].low, a[z.x].high, userdata);
+      stack[t].k = z.k - 1;
+      stack[t].x = z.x + ((GtUword) 1 << (z.k - 1));
+      stack[t++].left_done = false;
+    }
+  }
+  return rval;
+}
+
+static int interval_index_collect(void *data, GT_UNUSED GtUword low,
+                                  GT_UNUSED GtUword high, void *userdata)
+{
+  gt_array_add((GtArray*) userdata, data);
+  return 0;
+}
+
+void gt_interval_index_find_all_overlapping(const GtIntervalIndex *ii,
+                                            GtUword start, GtUword end,
+                                            GtArray *results)
+{
+  GT_UNUSED int rval;
+  gt_assert(ii && results);
+  rval = gt_interval_index_iterate_overlapping(ii, start, end,
+                                               interval_index_collect,
+                                               results);
+  gt_assert(!rval); /* interval_index_collect() is sane */
+}
+
+void gt_interval_index_find_all_overlapping_batch(const GtIntervalIndex *ii,
+                                                  const GtRange *queries,
+                                                  GtUword num_of_queries,
+                                                  GtArray *results,
+                                                  GtUword *boundaries)
+{
+  GtUword i;
+  gt_assert(ii && (queries || !num_of_queries) && results && boundaries);
+  for (i = 0; i < num_of_queries; i++) {
+    boundaries[i] = gt_array_size(results);
+    gt_interval_index_find_all_overlapping(ii, queries[i].start,
+                                           queries[i].end, results);
+  }
+  boundaries[num_of_queries] = gt_array_size(results);
+}
+
+void gt_interval_index_delete(GtIntervalIndex *ii)
+{
+  GtUword i;
+  if (!ii) return;
+  if (ii->free_func) {
+    for (i = 0; i < ii->num_of_elems; i++)
+      ii->free_func(ii->elems[i].data);
+  }
+  gt_free(ii->elems);
+  gt_free(ii);
+}
+
+static int interval_index_stop_at_first(GT_UNUSED void *data,
+                                        GT_UNUSED GtUword low,
+                                        GT_UNUSED GtUword high,
+                                        void *userdata)
+{
+  (*(GtUword*) userdata)++;
+  return 1;
+}
+
+int gt_interval_index_unit_test(GT_UNUSED GtError *err)
+{
+  GtIntervalIndex *ii;
+  GtArray *ranges, *results, *expected;
+  GtRange *queries;
+  GtUword i, j, *boundaries, calls,
+          num_of_ranges[] = { 0, 1, 2, 7, 8, 9, 100, 3000 };
+  int had_err = 0, r,
+      num_of_queries = 1000,
+      max_basepos = 90000,
+      width = 700;
+  gt_error_check(err);
+
+  ranges = gt_array_new(sizeof (GtRange*));
+  results = gt_array_new(sizeof (GtRange*));
+  expected = gt_array_new(sizeof (GtRange*));
+  queries = gt_malloc(num_of_queries * sizeof *queries);
+  boundaries = gt_malloc((num_of_queries + 1) * sizeof *boundaries);
+
+  for (r = 0; !had_err && r < (int) (sizeof num_of_ranges /
+                                     sizeof num_of_ranges[0]); r++) {
+    ii = gt_interval_index_new(gt_free_func);
+    gt_array_reset(ranges);
+    for (i = 0; i < num_of_ranges[r]; i++) {
+      GtRange *rng = gt_malloc(sizeof *rng);
+      rng->start = gt_rand_max(max_basepos);
+      /* include some long intervals */
+      rng->end = rng->start + gt_rand_max(i % 50 ? width : max_basepos);
+      gt_array_add(ranges, rng);
+      gt_interval_index_add(ii, rng, rng->start, rng->end);
+    }
+    gt_ensure(!gt_interval_index_is_frozen(ii) || num_of_ranges[r] == 0);
+    gt_interval_index_freeze(ii);
+    gt_ensure(gt_interval_index_is_frozen(ii));
+    gt_ensure(gt_interval_index_size(ii) == num_of_ranges[r]);
+
+    for (i = 0; i < (GtUword) num_of_queries; i++) {
+      queries[i].start = gt_rand_max(max_basepos);
+      queries[i].end = queries[i].start + gt_rand_max(width);
+    }
+    gt_array_reset(results);
+    gt_interval_index_find_all_overlapping_batch(ii, queries, num_of_queries,
+                                                 results, boundaries);
+    for (i = 0; !had_err && i < (GtUword) num_of_queries; i++) {
+      GtUword k;
+      gt_array_reset(expected);
+      for (j = 0; j < gt_array_size(ranges); j++) {
+        GtRange *rng = *(GtRange**) gt_array_get(ranges, j);
+        if (gt_range_overlap(rng, queries + i))
+          gt_array_add(expected, rng);
+      }
+      gt_ensure(boundaries[i + 1] - boundaries[i] == gt_array_size(expected));
+      /* every reported interval overlaps and is reported once */
+      for (j = boundaries[i]; !had_err && j < boundaries[i + 1]; j++) {
+        GtRange *rng = *(GtRange**) gt_array_get(results, j);
+        gt_ensure(gt_range_overlap(rng, queries + i));
+        for (k = j + 1; !had_err && k < boundaries[i + 1]; k++)
+          gt_ensure(rng != *(GtRange**) gt_array_get(results, k));
+      }
+      calls = 0;
+      gt_ensure(gt_interval_index_iterate_overlapping(ii, queries[i].start,
+                                                 queries[i].end,
+                                                 interval_index_stop_at_first,
+                                                 &calls)
+                == (gt_array_size(expected) ? 1 : 0));
+      gt_ensure(calls == (gt_array_size(expected) ? 1UL : 0UL));
+    }
+    gt_interval_index_delete(ii);
+  }
+
+  gt_free(boundaries);
+  gt_free(queries);
+  gt_array_delete(expected);
+  gt_array_delete(results);
+  gt_array_delete(ranges);
+  return had_err;
+}
@@ -0,0 +1,95 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef INTERVAL_INDEX_API_H
+#define INTERVAL_INDEX_API_H
+
+#include "core/array_api.h"
+#include "core/fptr_api.h"
+#include "core/range_api.h"
+
+/* The <GtIntervalIndex> class is a static counterpart of the <GtIntervalTree>
+   for workloads in which a set of intervals is built once and queried many
+   times. The intervals are kept in a single array sorted by start position,
+   which is augmented with the maximum end position of an implicit binary
+   search tree laid over the array. Overlap queries therefore do not chase
+   pointers across the heap. Intervals are closed, as in <GtRange>.
+   After all intervals have been added, the index has to be frozen with
+   <gt_interval_index_freeze()> before it can be queried. A frozen index is
+   not modified by queries, so it can be queried from multiple threads. */
+typedef struct GtIntervalIndex GtIntervalIndex;
+
+/* Callback function for <gt_interval_index_iterate_overlapping()>, called with
+   the <data> pointer and the interval of each overlapping element. A non-zero
+   return value stops the iteration. */
+typedef int (*GtIntervalIndexIteratorFunc)(void *data, GtUword low,
+                                           GtUword high, void *userdata);
+
+/* Creates a new, empty <GtIntervalIndex>. If <free_func> is given, it is
+   applied on the data pointers of all added intervals when the index is
+   deleted. */
+GtIntervalIndex* gt_interval_index_new(GtFree free_func);
+
+/* Adds the interval from <low> to <high> with associated <data> to
+   <interval_index>. Adding an interval unfreezes the index. */
+void             gt_interval_index_add(GtIntervalIndex *interval_index,
+                                       void *data, GtUword low, GtUword high);
+
+/* Sorts and augments <interval_index>, which makes it ready for queries. */
+void             gt_interval_index_freeze(GtIntervalIndex *interval_index);
+
+/* Returns <true> if <interval_index> is frozen. */
+bool             gt_interval_index_is_frozen(const GtIntervalIndex
+                                                               *interval_index);
+
+/* Returns the number of intervals in <interval_index>. */
+GtUword          gt_interval_index_size(const GtIntervalIndex *interval_index);
+
+/* Adds the data pointers of all intervals in the frozen <interval_index>
+   which overlap the query range (from <start> to <end>) to <results>. */
+void             gt_interval_index_find_all_overlapping(
+                                          const GtIntervalIndex *interval_index,
+                                          GtUword start,
+                                          GtUword end,
+                                          GtArray *results);
+
+/* Calls <func> for all intervals in the frozen <interval_index> which overlap
+   the query range (from <start> to <end>). Returns the first non-zero return
+   value of <func>, or 0. */
+int              gt_interval_index_iterate_overlapping(
+                                          const GtIntervalIndex *interval_index,
+                                          GtUword start,
+                                          GtUword end,
+                                          GtIntervalIndexIteratorFunc func,
+                                          void *userdata);
+
+/* Answers the <num_of_queries> range queries given in <queries> on the frozen
+   <interval_index>. The data pointers of the intervals overlapping query <i>
+   are appended to <results> at positions <boundaries[i]> up to (excluding)
+   <boundaries[i+1]>, <boundaries> must have room for <num_of_queries> + 1
+   entries. Queries sorted by start position have the best memory locality. */
+void             gt_interval_index_find_all_overlapping_batch(
+                                          const GtIntervalIndex *interval_index,
+                                          const GtRange *queries,
+                                          GtUword num_of_queries,
+                                          GtArray *results,
+                                          GtUword *boundaries);
+
+/* Deletes <interval_index>, freeing the data pointers if a free function was
+   given in the constructor. */
+void             gt_interval_index_delete(GtIntervalIndex *interval_index);
+
+#endif
@@ -276,6 +276,12 @@ GtUword gt_ma_get_space_current(void)
   return ma->current_size;
 }
 
+void gt_ma_reset_space_peak(void)
+{
+  gt_assert(ma);
+  ma->max_size = ma->current_size;
+}
+
 void gt_ma_show_space_peak(FILE *fp)
 {
   gt_assert(ma);
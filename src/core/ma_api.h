@@ -36,6 +36,9 @@ void    gt_ma_disable_global_spacepeak(void);
 GtUword gt_ma_get_space_peak(void);
 /* Return current space usage, in bytes. */
 GtUword gt_ma_get_space_current(void);
+/* Set the space peak to the current space usage, e.g. to measure the space
+   peak of a single step of a program. */
+void    gt_ma_reset_space_peak(void);
 /* Print statistics about current space peak to <fp>. */
 void    gt_ma_show_space_peak(FILE *fp);
 /* Print statistics about allocations to <fp>. */
@@ -0,0 +1,274 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <ctype.h>
+#include <string.h>
+#include "core/ensure_api.h"
+#include "core/fa_api.h"
+#include "core/fileutils_api.h"
+#include "core/ma_api.h"
+#include "core/minmax_api.h"
+#include "core/qsort_r_api.h"
+#include "core/seqid_tab.h"
+#include "core/str_api.h"
+#include "core/undef_api.h"
+#include "core/xansi_api.h"
+
+struct GtSeqidTab {
+  GtUword *seqnums, /* sequence numbers sorted by sequence ID */
+          numofseqs;
+  bool mapped;
+};
+
+static const char* seqid_tab_get_seqid(const GtEncseq *encseq, GtUword seqnum,
+                                       GtUword *seqid_len)
+{
+  const char *desc, *end, *ptr;
+  GtUword desc_len;
+
+  desc = gt_encseq_description(encseq, &desc_len, seqnum);
+  end = desc + desc_len;
+  for (ptr = desc; ptr < end && !isspace((int) *ptr); ptr++)
+    /* Nothing */ ;
+  *seqid_len = (GtUword) (ptr - desc);
+  return desc;
+}
+
+static int seqid_tab_cmp(const char *seqid1, GtUword len1,
+                         const char *seqid2, GtUword len2)
+{
+  int cmp = memcmp(seqid1, seqid2, (size_t) GT_MIN(len1, len2));
+  if (cmp != 0)
+    return cmp;
+  return len1 < len2 ? -1 : (len1 > len2 ? 1 : 0);
+}
+
+static int seqid_tab_cmp_seqnums(const void *a, const void *b, void *data)
+{
+  const GtEncseq *encseq = data;
+  const char *seqid1, *seqid2;
+  GtUword len1, len2, seqnum1 = *(const GtUword*) a,
+          seqnum2 = *(const GtUword*) b;
+  int cmp;
+
+  seqid1 = seqid_tab_get_seqid(encseq, seqnum1, &len1);
+  seqid2 = seqid_tab_get_seqid(encseq, seqnum2, &len2);
+  if ((cmp = seqid_tab_cmp(seqid1, len1, seqid2, len2)) != 0)
+    return cmp;
+  /* keep sequences with identical IDs in input order */
+  return seqnum1 < seqnum2 ? -1 : (seqnum1 > seqnum2 ? 1 : 0);
+}
+
+/* Return true if the entries of <seqid_tab> are strictly increasing with
+   respect to seqid_tab_cmp_seqnums(), i.e. if it is a valid table for
+   <encseq>. This guards against tables which are stale but could not be
+   recognized as such from the file modification times. */
+static bool seqid_tab_is_valid(const GtSeqidTab *seqid_tab,
+                               const GtEncseq *encseq)
+{
+  GtUword idx;
+
+  for (idx = 0; idx < seqid_tab->numofseqs; idx++) {
+    if (seqid_tab->seqnums[idx] >= seqid_tab->numofseqs)
+      return false;
+    if (idx > 0 && seqid_tab_cmp_seqnums(seqid_tab->seqnums + idx - 1,
+                                         seqid_tab->seqnums + idx,
+                                         (void*) encseq) >= 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void seqid_tab_write(const GtSeqidTab *seqid_tab, const char *indexname)
+{
+  GtError *err = gt_error_new();
+  FILE *fp;
+
+  /* the table is only a cache, so it is fine if it cannot be written */
+  fp = gt_fa_fopen_with_suffix(indexname, GT_SIDTABFILESUFFIX, "wb", err);
+  if (fp != NULL) {
+    gt_xfwrite(seqid_tab->seqnums, sizeof (*seqid_tab->seqnums),
+               (size_t) seqid_tab->numofseqs, fp);
+    gt_fa_xfclose(fp);
+  }
+  gt_error_delete(err);
+}
+
+GtSeqidTab* gt_seqid_tab_new(const GtEncseq *encseq, const char *indexname)
+{
+  GtSeqidTab *seqid_tab;
+  GtStr *desfile = NULL, *sidfile = NULL;
+  GtUword idx;
+
+  gt_assert(encseq && gt_encseq_has_description_support(encseq));
+  seqid_tab = gt_calloc(1, sizeof *seqid_tab);
+  seqid_tab->numofseqs = gt_encseq_num_of_sequences(encseq);
+  if (indexname != NULL) {
+    desfile = gt_str_new_cstr(indexname);
+    gt_str_append_cstr(desfile, GT_DESTABFILESUFFIX);
+    sidfile = gt_str_new_cstr(indexname);
+    gt_str_append_cstr(sidfile, GT_SIDTABFILESUFFIX);
+    if (!gt_file_exists(gt_str_get(desfile))) {
+      /* the descriptions were not read from <indexname> */
+      gt_str_delete(desfile);
+      gt_str_delete(sidfile);
+      desfile = sidfile = NULL;
+    }
+  }
+  if (sidfile != NULL && gt_file_exists(gt_str_get(sidfile)) &&
+      !gt_file_is_newer(gt_str_get(desfile), gt_str_get(sidfile))) {
+    GtError *err = gt_error_new();
+    seqid_tab->seqnums = gt_fa_mmap_check_size_with_suffix(indexname,
+                                                        GT_SIDTABFILESUFFIX,
+                                                        seqid_tab->numofseqs,
+                                                        sizeof (GtUword),
+                                                        err);
+    seqid_tab->mapped = (seqid_tab->seqnums != NULL);
+    if (seqid_tab->mapped && !seqid_tab_is_valid(seqid_tab, encseq)) {
+      gt_fa_xmunmap(seqid_tab->seqnums);
+      seqid_tab->seqnums = NULL;
+      seqid_tab->mapped = false;
+    }
+    gt_error_delete(err);
+  }
+  if (!seqid_tab->mapped) {
+    seqid_tab->seqnums = gt_malloc(sizeof (*seqid_tab->seqnums) *
+                                   seqid_tab->numofseqs);
+    for (idx = 0; idx < seqid_tab->numofseqs; idx++)
+      seqid_tab->seqnums[idx] = idx;
+    gt_qsort_r(seqid_tab->seqnums, (size_t) seqid_tab->numofseqs,
+               sizeof (*seqid_tab->seqnums), (void*) encseq,
+               seqid_tab_cmp_seqnums);
+    if (sidfile != NULL && seqid_tab->numofseqs > 0)
+      seqid_tab_write(seqid_tab, indexname);
+  }
+  gt_str_delete(desfile);
+  gt_str_delete(sidfile);
+  return seqid_tab;
+}
+
+GtUword gt_seqid_tab_map(const GtSeqidTab *seqid_tab, const GtEncseq *encseq,
+                         const char *seqid, GtUword seqid_len,
+                         bool *ambiguous)
+{
+  GtUword left = 0, right, mid, len;
+  const char *midseqid;
+  int cmp;
+
+  gt_assert(seqid_tab && encseq && seqid && ambiguous);
+  gt_assert(seqid_tab->numofseqs == gt_encseq_num_of_sequences(encseq));
+  *ambiguous = false;
+  /* find the leftmost sequence whose ID is not smaller than <seqid> */
+  right = seqid_tab->numofseqs;
+  while (left < right) {
+    mid = left + (right - left) / 2;
+    midseqid = seqid_tab_get_seqid(encseq, seqid_tab->seqnums[mid], &len);
+    if (seqid_tab_cmp(midseqid, len, seqid, seqid_len) < 0)
+      left = mid + 1;
+    else
+      right = mid;
+  }
+  if (left == seqid_tab->numofseqs)
+    return GT_UNDEF_UWORD;
+  midseqid = seqid_tab_get_seqid(encseq, seqid_tab->seqnums[left], &len);
+  cmp = seqid_tab_cmp(midseqid, len, seqid, seqid_len);
+  if (cmp != 0)
+    return GT_UNDEF_UWORD;
+  if (left + 1 < seqid_tab->numofseqs) {
+    midseqid = seqid_tab_get_seqid(encseq, seqid_tab->seqnums[left + 1], &len);
+    if (seqid_tab_cmp(midseqid, len, seqid, seqid_len) == 0)
+      *ambiguous = true;
+  }
+  return seqid_tab->seqnums[left];
+}
+
+void gt_seqid_tab_delete(GtSeqidTab *seqid_tab)
+{
+  if (!seqid_tab) return;
+  if (seqid_tab->mapped)
+    gt_fa_xmunmap(seqid_tab->seqnums);
+  else
+    gt_free(seqid_tab->seqnums);
+  gt_free(seqid_tab);
+}
+
+int gt_seqid_tab_unit_test(GtError *err)
+{
+  static const char *descriptions[] = {"seq10",
+                                       "seq1 first sequence",
+                                       "dup first",
+                                       "seq2\tsecond sequence",
+                                       "dup second",
+                                       "seq"};
+  const GtUword numofseqs = (GtUword) (sizeof descriptions /
+                                       sizeof descriptions[0]);
+  GtAlphabet *alpha;
+  GtEncseqBuilder *eb;
+  GtEncseq *encseq;
+  GtSeqidTab *seqid_tab;
+  GtUword idx, seqnum;
+  bool ambiguous;
+  int had_err = 0;
+  gt_error_check(err);
+
+  alpha = gt_alphabet_new_dna();
+  eb = gt_encseq_builder_new(alpha);
+  gt_encseq_builder_enable_description_support(eb);
+  for (idx = 0; idx < numofseqs; idx++)
+    gt_encseq_builder_add_cstr(eb, "acgt", 4UL, descriptions[idx]);
+  encseq = gt_encseq_builder_build(eb, NULL);
+  gt_ensure(encseq != NULL);
+  seqid_tab = gt_seqid_tab_new(encseq, NULL);
+
+  /* present IDs, also if one is a prefix of another */
+  if (!had_err) {
+    seqnum = gt_seqid_tab_map(seqid_tab, encseq, "seq1", 4UL, &ambiguous);
+    gt_ensure(seqnum == 1UL && !ambiguous);
+    seqnum = gt_seqid_tab_map(seqid_tab, encseq, "seq10", 5UL, &ambiguous);
+    gt_ensure(seqnum == 0 && !ambiguous);
+    seqnum = gt_seqid_tab_map(seqid_tab, encseq, "seq2", 4UL, &ambiguous);
+    gt_ensure(seqnum == 3UL && !ambiguous);
+    seqnum = gt_seqid_tab_map(seqid_tab, encseq, "seq", 3UL, &ambiguous);
+    gt_ensure(seqnum == 5UL && !ambiguous);
+    /* only the first <seqid_len> characters of <seqid> are compared */
+    seqnum = gt_seqid_tab_map(seqid_tab, encseq, "seq10", 4UL, &ambiguous);
+    gt_ensure(seqnum == 1UL && !ambiguous);
+  }
+
+  /* absent IDs, smaller and larger than all others */
+  if (!had_err) {
+    static const char *absent[] = {"a", "se", "seq0", "seq11", "seq1 first",
+                                   "dup2", "zzz"};
+    for (idx = 0; !had_err && idx < sizeof absent / sizeof absent[0]; idx++) {
+      seqnum = gt_seqid_tab_map(seqid_tab, encseq, absent[idx],
+                                (GtUword) strlen(absent[idx]), &ambiguous);
+      gt_ensure(seqnum == GT_UNDEF_UWORD && !ambiguous);
+    }
+  }
+
+  /* duplicate IDs are reported as ambiguous */
+  if (!had_err) {
+    seqnum = gt_seqid_tab_map(seqid_tab, encseq, "dup", 3UL, &ambiguous);
+    gt_ensure((seqnum == 2UL || seqnum == 4UL) && ambiguous);
+  }
+
+  gt_seqid_tab_delete(seqid_tab);
+  gt_encseq_delete(encseq);
+  gt_encseq_builder_delete(eb);
+  gt_alphabet_delete(alpha);
+  return had_err;
+}
@@ -0,0 +1,54 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef SEQID_TAB_H
+#define SEQID_TAB_H
+
+#include <stdbool.h>
+#include "core/encseq_api.h"
+#include "core/error_api.h"
+
+/* The file suffix used for sequence ID tables. */
+#define GT_SIDTABFILESUFFIX ".sid"
+
+/* <GtSeqidTab> maps sequence IDs to sequence numbers of a <GtEncseq>. The
+   sequence ID of a sequence is its description from the beginning up to the
+   first whitespace character. The table
+   stores the sequence numbers sorted by sequence ID, so that a lookup is a
+   binary search on the descriptions. */
+typedef struct GtSeqidTab GtSeqidTab;
+
+/* Returns a new <GtSeqidTab> for <encseq>, which must have description
+   support. If <indexname> is not <NULL> and the description table
+   "<indexname>.des" exists, the table is read from the file
+   "<indexname>.sid" if it exists and is not older than the description
+   table. Otherwise it is computed and written to this file, if possible. */
+GtSeqidTab* gt_seqid_tab_new(const GtEncseq *encseq, const char *indexname);
+
+/* Returns the number of the sequence in <encseq> whose sequence ID equals
+   <seqid> of length <seqid_len>, or <GT_UNDEF_UWORD> if there is no such
+   sequence. If there is more than one, <ambiguous> is set to true and the
+   number of one of them is returned. <encseq> must be the <GtEncseq>
+   <seqid_tab> was created for. */
+GtUword     gt_seqid_tab_map(const GtSeqidTab *seqid_tab,
+                             const GtEncseq *encseq, const char *seqid,
+                             GtUword seqid_len, bool *ambiguous);
+
+void        gt_seqid_tab_delete(GtSeqidTab *seqid_tab);
+
+int         gt_seqid_tab_unit_test(GtError *err);
+
+#endif
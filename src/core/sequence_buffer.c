@@ -26,9 +26,68 @@
 #include "core/sequence_buffer_fastq.h"
 #include "core/sequence_buffer_gb.h"
 #include "core/sequence_buffer_inline.h"
+#include "core/str_api.h"
+#include "core/thread_api.h"
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
 
+/* number of <OUTBUFSIZE> chunks read ahead at once if prefetching is enabled */
+#define GT_SEQUENCE_BUFFER_PREFETCH_CHUNKS 128UL
+#define GT_SEQUENCE_BUFFER_PREFETCH_SIZE \
+        (GT_SEQUENCE_BUFFER_PREFETCH_CHUNKS * OUTBUFSIZE)
+
+/* One block of prefetched characters, consisting of the output of several
+   calls to the advance function. <descs> stores the descriptions belonging to
+   the separators in the block, each terminated by '\0'. */
+typedef struct {
+  unsigned char *outbuf,
+                *outbuforig;
+  GtUword nextfree,
+          numofchunks,
+          chunkend[GT_SEQUENCE_BUFFER_PREFETCH_CHUNKS],
+          chunkfilenum[GT_SEQUENCE_BUFFER_PREFETCH_CHUNKS];
+  GtStr *descs;
+  bool complete;
+  int had_err;
+  GtError *err;
+} GtSequenceBufferBlock;
+
+/* While the caller consumes block <current>, the other block is filled by
+   <thread>. The descriptions read by the advance function go to the private
+   <readdesc> buffer and are copied into the <GtDescBuffer> of the caller when
+   a block becomes current. */
+struct GtSequenceBufferPrefetch {
+  GtSequenceBuffer *sb;
+  GtSequenceBufferBlock blocks[2];
+  GtDescBuffer *descptr,
+               *readdesc;
+  GtThread *thread;
+  unsigned int current;
+  GtUword nextread;
+  bool started,
+       advanced;
+};
+
+static void gt_sequence_buffer_prefetch_delete(GtSequenceBufferPrefetch *pf)
+{
+  unsigned int idx;
+  if (!pf) return;
+#ifdef GT_THREADS_ENABLED
+  if (pf->thread != NULL) {
+    gt_thread_join(pf->thread);
+    gt_thread_delete(pf->thread);
+  }
+#endif
+  for (idx = 0; idx < 2U; idx++) {
+    gt_free(pf->blocks[idx].outbuf);
+    gt_free(pf->blocks[idx].outbuforig);
+    gt_str_delete(pf->blocks[idx].descs);
+    gt_error_delete(pf->blocks[idx].err);
+  }
+  gt_desc_buffer_delete(pf->readdesc);
+  gt_free(pf);
+}
+
 GtSequenceBuffer*
 gt_sequence_buffer_create(const GtSequenceBufferClass *sic)
 {
@@ -48,6 +107,7 @@ void gt_sequence_buffer_delete(GtSequenceBuffer *si)
     return;
   }
   gt_assert(si->c_class && si->c_class->free);
+  gt_sequence_buffer_prefetch_delete(si->pvt->prefetch);
   si->c_class->free(si);
   gt_free(si->pvt);
   gt_free(si);
@@ -105,6 +165,18 @@ GtSequenceBuffer* gt_sequence_buffer_new_guess_type(const GtStrArray *seqs,
 GtUword gt_sequence_buffer_get_file_index(GtSequenceBuffer *si)
 {
   gt_assert(si && si->c_class && si->c_class->get_file_index);
+  if (si->pvt->prefetch != NULL) {
+    const GtSequenceBufferPrefetch *pf = si->pvt->prefetch;
+    const GtSequenceBufferBlock *block = pf->blocks + pf->current;
+    GtUword chunk;
+
+    if (!pf->started || block->numofchunks == 0)
+      return 0;
+    for (chunk = 0; chunk + 1 < block->numofchunks &&
+                    pf->nextread > block->chunkend[chunk]; chunk++)
+      /* Nothing */ ;
+    return block->chunkfilenum[chunk];
+  }
   return si->c_class->get_file_index(si);
 }
 
@@ -154,11 +226,184 @@ int gt_sequence_buffer_advance(GtSequenceBuffer *sb, GtError *err)
   return sb->c_class->advance(sb, err);
 }
 
+void gt_sequence_buffer_enable_prefetch(GtSequenceBuffer *sb)
+{
+  gt_assert(sb && sb->pvt && sb->pvt->nextfree == 0 && !sb->pvt->complete);
+#ifdef GT_THREADS_ENABLED
+  if (gt_jobs > 1U && sb->pvt->prefetch == NULL) {
+    GtSequenceBufferPrefetch *pf = gt_calloc(1, sizeof *pf);
+    unsigned int idx;
+
+    pf->sb = sb;
+    for (idx = 0; idx < 2U; idx++) {
+      GtSequenceBufferBlock *block = pf->blocks + idx;
+      block->outbuf = gt_malloc(sizeof *block->outbuf *
+                                GT_SEQUENCE_BUFFER_PREFETCH_SIZE);
+      block->outbuforig = gt_malloc(sizeof *block->outbuforig *
+                                    GT_SEQUENCE_BUFFER_PREFETCH_SIZE);
+      block->descs = gt_str_new();
+      block->err = gt_error_new();
+    }
+    sb->pvt->prefetch = pf;
+  }
+#endif
+}
+
+/* Fill <block> by repeatedly calling the advance function. This is the only
+   place where the members of the sequence buffer are accessed while
+   prefetching, so it may run in parallel to the consumer of the other
+   block. */
+static void gt_sequence_buffer_prefetch_fill(GtSequenceBufferPrefetch *pf,
+                                             GtSequenceBufferBlock *block)
+{
+  GtSequenceBufferMembers *pvt = pf->sb->pvt;
+
+  block->nextfree = block->numofchunks = 0;
+  block->complete = false;
+  block->had_err = 0;
+  gt_str_reset(block->descs);
+  gt_error_unset(block->err);
+  while (block->numofchunks < GT_SEQUENCE_BUFFER_PREFETCH_CHUNKS) {
+    GtUword idx;
+
+    if (pvt->complete) {
+      block->complete = true;
+      break;
+    }
+    if (pf->readdesc != NULL && pf->advanced)
+      gt_desc_buffer_reset(pf->readdesc);
+    pf->advanced = true;
+    if (gt_sequence_buffer_advance(pf->sb, block->err) != 0) {
+      block->had_err = -1;
+      break;
+    }
+    if (pvt->nextfree == 0) {
+      block->complete = true;
+      break;
+    }
+    memcpy(block->outbuf + block->nextfree, pvt->outbuf,
+           sizeof *pvt->outbuf * pvt->nextfree);
+    memcpy(block->outbuforig + block->nextfree, pvt->outbuforig,
+           sizeof *pvt->outbuforig * pvt->nextfree);
+    if (pf->readdesc != NULL) {
+      for (idx = 0; idx < pvt->nextfree; idx++) {
+        if (pvt->outbuf[idx] == (unsigned char) GT_SEPARATOR) {
+          gt_str_append_cstr(block->descs,
+                             gt_desc_buffer_get_next(pf->readdesc));
+          gt_str_append_char(block->descs, '\0');
+        }
+      }
+    }
+    block->nextfree += pvt->nextfree;
+    block->chunkend[block->numofchunks] = block->nextfree;
+    block->chunkfilenum[block->numofchunks++] =
+      pf->sb->c_class->get_file_index(pf->sb);
+  }
+  /* the description of the last sequence is not followed by a separator */
+  if (block->complete && pf->readdesc != NULL) {
+    gt_str_append_cstr(block->descs, gt_desc_buffer_get_next(pf->readdesc));
+    gt_str_append_char(block->descs, '\0');
+  }
+}
+
+#ifdef GT_THREADS_ENABLED
+static void* gt_sequence_buffer_prefetch_thread(void *data)
+{
+  GtSequenceBufferPrefetch *pf = data;
+  gt_sequence_buffer_prefetch_fill(pf, pf->blocks + (pf->current ^ 1U));
+  return NULL;
+}
+#endif
+
+/* Make the next block current. Returns 1 if it contains characters, 0 if the
+   input is exhausted and -1 on error. */
+static int gt_sequence_buffer_prefetch_switch(GtSequenceBufferPrefetch *pf,
+                                              GtError *err)
+{
+  GtSequenceBufferBlock *block = pf->blocks + pf->current;
+  const char *desc, *descend;
+
+  if (!pf->started) {
+    pf->started = true;
+    if (pf->sb->pvt->descptr != NULL) {
+      pf->descptr = pf->sb->pvt->descptr;
+      pf->readdesc = gt_desc_buffer_new();
+      pf->sb->pvt->descptr = pf->readdesc;
+    }
+    /* read first block synchronously into the other block */
+    gt_sequence_buffer_prefetch_fill(pf, pf->blocks + (pf->current ^ 1U));
+  }
+  else {
+    if (block->had_err) {
+      gt_error_set(err, "%s", gt_error_get(block->err));
+      return -1;
+    }
+    if (block->complete)
+      return 0;
+#ifdef GT_THREADS_ENABLED
+    if (pf->thread != NULL) {
+      gt_thread_join(pf->thread);
+      gt_thread_delete(pf->thread);
+      pf->thread = NULL;
+    }
+    else
+#endif
+      gt_sequence_buffer_prefetch_fill(pf, pf->blocks + (pf->current ^ 1U));
+  }
+  pf->current ^= 1U;
+  pf->nextread = 0;
+  block = pf->blocks + pf->current;
+#ifdef GT_THREADS_ENABLED
+  /* if the thread cannot be created, the next block is read on demand */
+  if (!block->complete && !block->had_err)
+    pf->thread = gt_thread_new(gt_sequence_buffer_prefetch_thread, pf, NULL);
+#endif
+  if (pf->descptr != NULL) {
+    gt_desc_buffer_reset(pf->descptr);
+    desc = gt_str_get(block->descs);
+    descend = desc + gt_str_length(block->descs);
+    while (desc < descend) {
+      for (/* Nothing */; *desc != '\0'; desc++)
+        gt_desc_buffer_append_char(pf->descptr, *desc);
+      gt_desc_buffer_finish(pf->descptr);
+      desc++;
+    }
+  }
+  if (block->nextfree == 0) {
+    if (block->had_err) {
+      gt_error_set(err, "%s", gt_error_get(block->err));
+      return -1;
+    }
+    return 0;
+  }
+  return 1;
+}
+
+static int gt_sequence_buffer_prefetch_next(GtSequenceBufferPrefetch *pf,
+                                            GtUchar *val, char *orig,
+                                            GtError *err)
+{
+  GtSequenceBufferBlock *block = pf->blocks + pf->current;
+  if (!pf->started || pf->nextread >= block->nextfree) {
+    int retval = gt_sequence_buffer_prefetch_switch(pf, err);
+    if (retval != 1)
+      return retval;
+    block = pf->blocks + pf->current;
+  }
+  *val = block->outbuf[pf->nextread];
+  if (orig != NULL)
+    *orig = (char) block->outbuforig[pf->nextread];
+  pf->nextread++;
+  return 1;
+}
+
 int gt_sequence_buffer_next(GtSequenceBuffer *sb, GtUchar *val,
                             GtError *err)
 {
   GtSequenceBufferMembers *pvt;
   pvt = sb->pvt;
+  if (pvt->prefetch != NULL)
+    return gt_sequence_buffer_prefetch_next(pvt->prefetch, val, NULL, err);
   if (pvt->nextread >= pvt->nextfree)
   {
     if (pvt->complete)
@@ -187,6 +432,8 @@ int gt_sequence_buffer_next_with_original(GtSequenceBuffer *sb,
 {
   GtSequenceBufferMembers *pvt;
   pvt = sb->pvt;
+  if (pvt->prefetch != NULL)
+    return gt_sequence_buffer_prefetch_next(pvt->prefetch, val, orig, err);
   if (pvt->nextread >= pvt->nextfree)
   {
     if (pvt->complete)
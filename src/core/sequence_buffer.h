@@ -87,6 +87,14 @@ void          gt_sequence_buffer_set_desc_buffer(GtSequenceBuffer *si,
 void          gt_sequence_buffer_set_chardisttab(GtSequenceBuffer*,
                                                  GtUword*);
 
+/* Lets the <GtSequenceBuffer> parse its input files in a separate thread,
+   which reads ahead while the characters delivered so far are processed by
+   the caller. Has no effect unless threads are enabled and <gt_jobs> is larger
+   than one. The delivered characters, descriptions and file indices are the
+   same as without reading ahead. Must be called before the first character is
+   fetched. */
+void          gt_sequence_buffer_enable_prefetch(GtSequenceBuffer*);
+
 /* Returns the length of the last processed continuous stretch of special
    characters (wildcards or separators, see chardef.h). */
 uint64_t      gt_sequence_buffer_get_lastspeciallength(const GtSequenceBuffer*);
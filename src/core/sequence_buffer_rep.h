@@ -37,6 +37,7 @@ struct GtSequenceBufferClass {
 };
 
 typedef struct GtSequenceBufferMembers GtSequenceBufferMembers;
+typedef struct GtSequenceBufferPrefetch GtSequenceBufferPrefetch;
 
 struct GtSequenceBuffer {
   const GtSequenceBufferClass *c_class;
@@ -65,6 +66,7 @@ struct GtSequenceBufferMembers {
                 outbuf[OUTBUFSIZE],
                 outbuforig[OUTBUFSIZE];
   const unsigned char *symbolmap;
+  GtSequenceBufferPrefetch *prefetch;
 };
 
 GtSequenceBuffer* gt_sequence_buffer_create(const GtSequenceBufferClass*);
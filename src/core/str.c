@@ -255,7 +255,8 @@ GtStr* gt_str_ref(GtStr *s)
    following:
    gt_str_read_next_line uses gt_xfgetc while
    gt_str_read_next_line_generic uses gt_file_xfgetc
-   Also gt_str_read_next_line_generic does not assert <fpin> != NULL
+   Also gt_str_read_next_line_generic does not assert <fpin> != NULL and
+   reads whole lines via gt_file_xread_line if <fpin> != NULL
 */
 
 int gt_str_read_next_line(GtStr *s, FILE *fpin)
@@ -322,6 +323,13 @@ int gt_str_read_next_line_generic(GtStr *s, GtFile *fpin)
   int cc;
   char c;
   gt_assert(s);
+  if (fpin != NULL) {
+    char *line;
+    GtUword line_length;
+    cc = gt_file_xread_line(fpin, &line, &line_length);
+    gt_str_append_cstr_nt(s, line, line_length);
+    return cc;
+  }
   for (;;) {
     cc = gt_file_xfgetc(fpin);
     if (cc == EOF)
@@ -0,0 +1,1292 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/class_alloc_lock.h"
+#include "core/cstr_api.h"
+#include "core/ensure_api.h"
+#include "core/fa_api.h"
+#include "core/hashmap_api.h"
+#include "core/ma_api.h"
+#include "core/minmax_api.h"
+#include "core/thread_api.h"
+#include "core/undef_api.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+#include "extended/feature_index_mapped.h"
+#include "extended/feature_index_memory_api.h"
+#include "extended/feature_index_rep.h"
+#include "extended/feature_node.h"
+#include "extended/feature_node_iterator_api.h"
+#include "extended/genome_node.h"
+#include "extended/region_node_api.h"
+
+/* On-disk layout (all integers in native byte order):
+   header | seqid table | interval records | seqid names | feature payload
+   The seqid table is sorted by name, the interval records of each seqid are
+   sorted by start position (in input order for equal start positions) and
+   store the maximum end position of all preceding records of the same seqid.
+   The payload contains one serialized feature tree per interval record. */
+
+#define GT_FEATURE_INDEX_MAPPED_MAGIC    "GTFIMAP"
+#define GT_FEATURE_INDEX_MAPPED_VERSION  1
+
+typedef struct {
+  char magic[8];
+  GtUint64 version,
+           num_of_seqids,
+           num_of_records,
+           first_seqid,
+           strings_length,
+           payload_length;
+} GtFeatureIndexMappedHeader;
+
+typedef struct {
+  GtUint64 name_offset,
+           name_length,
+           has_region,
+           region_start,
+           region_end,
+           first_record,
+           num_of_records;
+} GtFeatureIndexMappedSeqid;
+
+typedef struct {
+  GtUint64 start,
+           end,
+           max_end,
+           payload_offset,
+           payload_length;
+} GtFeatureIndexMappedRecord;
+
+/* flags of a serialized feature node */
+#define FIM_PSEUDO         1ULL
+#define FIM_MULTI          (1ULL << 1)
+#define FIM_SCORE_DEFINED  (1ULL << 2)
+#define FIM_HAS_SOURCE     (1ULL << 3)
+#define FIM_STRAND_OFFSET  8
+#define FIM_PHASE_OFFSET   16
+#define FIM_ENUM_MASK      0xffULL
+
+struct GtFeatureIndexMapped {
+  const GtFeatureIndex parent_instance;
+  char *filename;
+  /* used while building, NULL for mapped indices */
+  GtFeatureIndex *builder;
+  /* maps the added feature nodes to their insertion number, so that features
+     with the same start position are stored in input order */
+  GtHashmap *insertion_order;
+  GtUword num_of_insertions;
+  /* used for mapped indices */
+  void *map;
+  const GtFeatureIndexMappedHeader *header;
+  const GtFeatureIndexMappedSeqid *seqids;
+  const GtFeatureIndexMappedRecord *records;
+  const char *strings,
+             *payload;
+  GtStr **seqid_strs;
+  GtFeatureNode **nodes;
+  GtHashmap *sources;
+  GtMutex *nodes_mutex;
+};
+
+#define gt_feature_index_mapped_cast(FI)\
+        gt_feature_index_cast(gt_feature_index_mapped_class(), FI)
+
+static const char* fim_seqid_name(const GtFeatureIndexMapped *fim, GtUword i)
+{
+  return fim->strings + fim->seqids[i].name_offset;
+}
+
+static GtUword fim_find_seqid(const GtFeatureIndexMapped *fim,
+                              const char *seqid)
+{
+  GtUword lo = 0, hi = fim->header->num_of_seqids;
+  while (lo < hi) {
+    GtUword mid = lo + (hi - lo) / 2;
+    int cmp = strcmp(seqid, fim_seqid_name(fim, mid));
+    if (cmp == 0)
+      return mid;
+    if (cmp < 0)
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  return GT_UNDEF_UWORD;
+}
+
+static int fim_read_only(const GtFeatureIndexMapped *fim, GtError *err)
+{
+  gt_error_set(err, "feature index file \"%s\" is mapped read-only",
+               fim->filename);
+  return -1;
+}
+
+/* serialization of feature trees */
+
+static void fim_append_uint64(GtStr *buf, GtUint64 value)
+{
+  gt_str_append_cstr_nt(buf, (const char*) &value, sizeof (value));
+}
+
+static void fim_append_string(GtStr *buf, const char *cstr)
+{
+  GtUword length = strlen(cstr);
+  fim_append_uint64(buf, length);
+  gt_str_append_cstr_nt(buf, cstr, length);
+  gt_str_append_char(buf, '\0');
+}
+
+typedef struct {
+  GtStr *buf;
+  GtUint64 count;
+} FIMAttributeInfo;
+
+static void fim_append_attribute(const char *attr_name, const char *attr_value,
+                                 void *data)
+{
+  FIMAttributeInfo *info = (FIMAttributeInfo*) data;
+  fim_append_string(info->buf, attr_name);
+  fim_append_string(info->buf, attr_value);
+  info->count++;
+}
+
+static int fim_cmp_position(const void *a, const void *b)
+{
+  GtUword pa = *(const GtUword*) a, pb = *(const GtUword*) b;
+  return pa < pb ? -1 : (pa > pb ? 1 : 0);
+}
+
+/* Appends the feature tree (or DAG) rooted at <root> to <buf>. Nodes are
+   written in topological order, so that every node is stored after all of its
+   parents and children are referenced by their position. */
+static void fim_serialize_tree(GtStr *buf, GtFeatureNode *root)
+{
+  GtArray *found, *order, *children;
+  GtHashmap *index;
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *node, *child;
+  GtUword i, j, *indegree, *position, count_pos;
+  FIMAttributeInfo ai;
+
+  found = gt_array_new(sizeof (GtFeatureNode*));
+  order = gt_array_new(sizeof (GtFeatureNode*));
+  children = gt_array_new(sizeof (GtUword));
+  index = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+
+  /* collect all nodes, index values are positions in <found> plus one */
+  gt_array_add(found, root);
+  gt_hashmap_add(index, root, (void*) 1);
+  for (i = 0; i < gt_array_size(found); i++) {
+    node = *(GtFeatureNode**) gt_array_get(found, i);
+    fni = gt_feature_node_iterator_new_direct(node);
+    while ((child = gt_feature_node_iterator_next(fni))) {
+      if (!gt_hashmap_get(index, child)) {
+        gt_array_add(found, child);
+        gt_hashmap_add(index, child, (void*) gt_array_size(found));
+      }
+    }
+    gt_feature_node_iterator_delete(fni);
+  }
+
+  /* sort topologically */
+  indegree = gt_calloc(gt_array_size(found), sizeof (GtUword));
+  position = gt_calloc(gt_array_size(found), sizeof (GtUword));
+  for (i = 0; i < gt_array_size(found); i++) {
+    node = *(GtFeatureNode**) gt_array_get(found, i);
+    fni = gt_feature_node_iterator_new_direct(node);
+    while ((child = gt_feature_node_iterator_next(fni)))
+      indegree[(GtUword) gt_hashmap_get(index, child) - 1]++;
+    gt_feature_node_iterator_delete(fni);
+  }
+  gt_array_add(order, root);
+  for (i = 0; i < gt_array_size(order); i++) {
+    node = *(GtFeatureNode**) gt_array_get(order, i);
+    position[(GtUword) gt_hashmap_get(index, node) - 1] = i;
+    fni = gt_feature_node_iterator_new_direct(node);
+    while ((child = gt_feature_node_iterator_next(fni))) {
+      if (--indegree[(GtUword) gt_hashmap_get(index, child) - 1] == 0)
+        gt_array_add(order, child);
+    }
+    gt_feature_node_iterator_delete(fni);
+  }
+  gt_assert(gt_array_size(order) == gt_array_size(found));
+
+  /* write nodes */
+  fim_append_uint64(buf, gt_array_size(order));
+  for (i = 0; i < gt_array_size(order); i++) {
+    GtRange range;
+    GtUint64 flags = 0, score_bits = 0, rep = 0;
+    node = *(GtFeatureNode**) gt_array_get(order, i);
+    range = gt_genome_node_get_range((GtGenomeNode*) node);
+    if (gt_feature_node_is_pseudo(node))
+      flags |= FIM_PSEUDO;
+    else if (gt_feature_node_is_multi(node)) {
+      GtFeatureNode *representative;
+      flags |= FIM_MULTI;
+      representative = gt_feature_node_get_multi_representative(node);
+      if (representative != node && gt_hashmap_get(index, representative)) {
+        rep = position[(GtUword) gt_hashmap_get(index, representative) - 1]
+              + 1;
+      }
+    }
+    if (gt_feature_node_has_source(node))
+      flags |= FIM_HAS_SOURCE;
+    if (gt_feature_node_score_is_defined(node)) {
+      float score = gt_feature_node_get_score(node);
+      flags |= FIM_SCORE_DEFINED;
+      memcpy(&score_bits, &score, sizeof (score));
+    }
+    flags |= ((GtUint64) gt_feature_node_get_strand(node)) << FIM_STRAND_OFFSET;
+    flags |= ((GtUint64) gt_feature_node_get_phase(node)) << FIM_PHASE_OFFSET;
+    fim_append_uint64(buf, flags);
+    fim_append_string(buf, gt_feature_node_is_pseudo(node)
+                           ? "" : gt_feature_node_get_type(node));
+    fim_append_string(buf, gt_feature_node_has_source(node)
+                           ? gt_feature_node_get_source(node) : "");
+    fim_append_uint64(buf, range.start);
+    fim_append_uint64(buf, range.end);
+    fim_append_uint64(buf, score_bits);
+    /* attributes, the count is filled in afterwards */
+    count_pos = gt_str_length(buf);
+    fim_append_uint64(buf, 0);
+    ai.buf = buf;
+    ai.count = 0;
+    gt_feature_node_foreach_attribute(node, fim_append_attribute, &ai);
+    memcpy((char*) gt_str_get_mem(buf) + count_pos, &ai.count,
+           sizeof (ai.count));
+    /* children, sorted by position */
+    gt_array_reset(children);
+    fni = gt_feature_node_iterator_new_direct(node);
+    while ((child = gt_feature_node_iterator_next(fni))) {
+      GtUword pos = position[(GtUword) gt_hashmap_get(index, child) - 1];
+      gt_array_add(children, pos);
+    }
+    gt_feature_node_iterator_delete(fni);
+    gt_array_sort(children, fim_cmp_position);
+    fim_append_uint64(buf, gt_array_size(children));
+    for (j = 0; j < gt_array_size(children); j++)
+      fim_append_uint64(buf, *(GtUword*) gt_array_get(children, j));
+    fim_append_uint64(buf, rep);
+  }
+
+  gt_free(position);
+  gt_free(indegree);
+  gt_hashmap_delete(index);
+  gt_array_delete(children);
+  gt_array_delete(order);
+  gt_array_delete(found);
+}
+
+/* deserialization of feature trees */
+
+typedef struct {
+  const char *pos,
+             *end;
+  bool valid;
+} FIMReader;
+
+static GtUint64 fim_read_uint64(FIMReader *r)
+{
+  GtUint64 value = 0;
+  if (!r->valid || (size_t) (r->end - r->pos) < sizeof (value)) {
+    r->valid = false;
+    return 0;
+  }
+  memcpy(&value, r->pos, sizeof (value));
+  r->pos += sizeof (value);
+  return value;
+}
+
+static const char* fim_read_string(FIMReader *r)
+{
+  const char *cstr;
+  GtUint64 length = fim_read_uint64(r);
+  if (!r->valid || (GtUint64) (r->end - r->pos) <= length
+      || r->pos[length] != '\0') {
+    r->valid = false;
+    return "";
+  }
+  cstr = r->pos;
+  r->pos += length + 1;
+  return cstr;
+}
+
+static GtStr* fim_get_source(GtFeatureIndexMapped *fim, const char *source)
+{
+  GtStr *str;
+  if (!(str = gt_hashmap_get(fim->sources, source))) {
+    str = gt_str_new_cstr(source);
+    gt_hashmap_add(fim->sources, gt_str_get(str), str);
+  }
+  return str;
+}
+
+typedef struct {
+  GtUword parent,
+          child;
+} FIMEdge;
+
+static GtFeatureNode* fim_deserialize_tree(GtFeatureIndexMapped *fim,
+                                           GtStr *seqid,
+                                           const GtFeatureIndexMappedRecord
+                                                                        *record,
+                                           GtError *err)
+{
+  FIMReader r;
+  GtFeatureNode **nodes = NULL, *root = NULL;
+  GtUint64 num_of_nodes, *flags = NULL, *reps = NULL;
+  GtUword i, j, *parents = NULL;
+  GtArray *edges;
+  gt_error_check(err);
+
+  r.pos = fim->payload + record->payload_offset;
+  r.end = r.pos + record->payload_length;
+  r.valid = true;
+  edges = gt_array_new(sizeof (FIMEdge));
+  num_of_nodes = fim_read_uint64(&r);
+  if (num_of_nodes == 0 || num_of_nodes > record->payload_length)
+    r.valid = false;
+  if (r.valid) {
+    nodes = gt_calloc(num_of_nodes, sizeof (GtFeatureNode*));
+    flags = gt_calloc(num_of_nodes, sizeof (GtUint64));
+    reps = gt_calloc(num_of_nodes, sizeof (GtUint64));
+    parents = gt_calloc(num_of_nodes, sizeof (GtUword));
+  }
+
+  for (i = 0; r.valid && i < num_of_nodes; i++) {
+    const char *type, *source;
+    GtUint64 start, end, score_bits, num_of_attributes, num_of_children;
+    GtStrand strand;
+    GtPhase phase;
+    flags[i] = fim_read_uint64(&r);
+    type = fim_read_string(&r);
+    source = fim_read_string(&r);
+    start = fim_read_uint64(&r);
+    end = fim_read_uint64(&r);
+    score_bits = fim_read_uint64(&r);
+    strand = (GtStrand) ((flags[i] >> FIM_STRAND_OFFSET) & FIM_ENUM_MASK);
+    phase = (GtPhase) ((flags[i] >> FIM_PHASE_OFFSET) & FIM_ENUM_MASK);
+    if (!r.valid || start == 0 || start > end
+        || strand >= GT_NUM_OF_STRAND_TYPES || phase > GT_PHASE_UNDEFINED
+        || ((flags[i] & FIM_PSEUDO) && (i > 0 || (flags[i] & FIM_MULTI)))
+        || (!(flags[i] & FIM_PSEUDO) && *type == '\0')) {
+      r.valid = false;
+      break;
+    }
+    if (flags[i] & FIM_PSEUDO) {
+      nodes[i] = (GtFeatureNode*) gt_feature_node_new_pseudo(seqid, start, end,
+                                                              strand);
+    }
+    else {
+      nodes[i] = (GtFeatureNode*) gt_feature_node_new(seqid, type, start, end,
+                                                      strand);
+    }
+    if (flags[i] & FIM_HAS_SOURCE)
+      gt_feature_node_set_source(nodes[i], fim_get_source(fim, source));
+    if (flags[i] & FIM_SCORE_DEFINED) {
+      float score;
+      memcpy(&score, &score_bits, sizeof (score));
+      gt_feature_node_set_score(nodes[i], score);
+    }
+    gt_feature_node_set_phase(nodes[i], phase);
+    num_of_attributes = fim_read_uint64(&r);
+    for (j = 0; r.valid && j < num_of_attributes; j++) {
+      const char *attr_name, *attr_value;
+      attr_name = fim_read_string(&r);
+      attr_value = fim_read_string(&r);
+      if (r.valid && (*attr_name == '\0' || *attr_value == '\0'
+                      || gt_feature_node_get_attribute(nodes[i], attr_name))) {
+        r.valid = false;
+      }
+      if (r.valid)
+        gt_feature_node_add_attribute(nodes[i], attr_name, attr_value);
+    }
+    num_of_children = fim_read_uint64(&r);
+    for (j = 0; r.valid && j < num_of_children; j++) {
+      FIMEdge edge;
+      edge.parent = i;
+      edge.child = fim_read_uint64(&r);
+      /* children are stored in increasing order after their parents */
+      if (r.valid && (edge.child <= i || edge.child >= num_of_nodes
+                      || (j > 0 && edge.child <= ((FIMEdge*)
+                                                  gt_array_get_last(edges))
+                                                                   ->child))) {
+        r.valid = false;
+      }
+      if (r.valid) {
+        gt_array_add(edges, edge);
+        parents[edge.child]++;
+      }
+    }
+    reps[i] = fim_read_uint64(&r);
+    if (r.valid && (reps[i] > num_of_nodes || reps[i] == i + 1
+                    || (reps[i] && !(flags[i] & FIM_MULTI)))) {
+      r.valid = false;
+    }
+  }
+
+  if (r.valid && r.pos != r.end)
+    r.valid = false;
+  for (i = 1; r.valid && i < num_of_nodes; i++) {
+    if (parents[i] == 0)
+      r.valid = false;
+    if (reps[i]) {
+      GtUword rep = reps[i] - 1;
+      if (!(flags[rep] & FIM_MULTI) || reps[rep])
+        r.valid = false;
+    }
+  }
+
+  if (r.valid) {
+    /* link nodes, a child with multiple parents is referenced once for each
+       additional parent */
+    memset(parents, 0, num_of_nodes * sizeof (GtUword));
+    for (i = 0; i < gt_array_size(edges); i++) {
+      FIMEdge *edge = gt_array_get(edges, i);
+      if (parents[edge->child]++)
+        gt_genome_node_ref((GtGenomeNode*) nodes[edge->child]);
+      gt_feature_node_add_child(nodes[edge->parent], nodes[edge->child]);
+    }
+    for (i = 0; i < num_of_nodes; i++) {
+      if ((flags[i] & FIM_MULTI) && !reps[i])
+        gt_feature_node_make_multi_representative(nodes[i]);
+    }
+    for (i = 0; i < num_of_nodes; i++) {
+      if (reps[i])
+        gt_feature_node_set_multi_representative(nodes[i], nodes[reps[i] - 1]);
+    }
+    root = nodes[0];
+  }
+  else {
+    gt_error_set(err, "feature index file \"%s\" is corrupt (invalid feature "
+                 "record)", fim->filename);
+    if (nodes) {
+      for (i = 0; i < num_of_nodes; i++)
+        gt_genome_node_delete((GtGenomeNode*) nodes[i]);
+    }
+  }
+
+  gt_free(parents);
+  gt_free(reps);
+  gt_free(flags);
+  gt_free(nodes);
+  gt_array_delete(edges);
+  return root;
+}
+
+/* Returns the feature tree of interval record <i>, which belongs to seqid
+   <seqid_idx>. Trees are reconstructed on first access and owned by the
+   index. Must be called with <nodes_mutex> held. */
+static GtFeatureNode* fim_get_node(GtFeatureIndexMapped *fim,
+                                   GtUword seqid_idx, GtUword i, GtError *err)
+{
+  if (!fim->nodes[i]) {
+    fim->nodes[i] = fim_deserialize_tree(fim, fim->seqid_strs[seqid_idx],
+                                         fim->records + i, err);
+  }
+  return fim->nodes[i];
+}
+
+static int gt_feature_index_mapped_add_region_node(GtFeatureIndex *gfi,
+                                                   GtRegionNode *rn,
+                                                   GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  gt_assert(gfi && rn);
+  fim = gt_feature_index_mapped_cast(gfi);
+  if (!fim->builder)
+    return fim_read_only(fim, err);
+  return gt_feature_index_add_region_node(fim->builder, rn, err);
+}
+
+static int gt_feature_index_mapped_add_feature_node(GtFeatureIndex *gfi,
+                                                    GtFeatureNode *fn,
+                                                    GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  gt_assert(gfi && fn);
+  fim = gt_feature_index_mapped_cast(gfi);
+  if (!fim->builder)
+    return fim_read_only(fim, err);
+  if (gt_feature_index_add_feature_node(fim->builder, fn, err))
+    return -1;
+  if (!gt_hashmap_get(fim->insertion_order, fn)) {
+    gt_hashmap_add(fim->insertion_order, fn,
+                   (void*) ++fim->num_of_insertions);
+  }
+  return 0;
+}
+
+static int gt_feature_index_mapped_remove_node(GtFeatureIndex *gfi,
+                                               GtFeatureNode *fn,
+                                               GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  gt_assert(gfi && fn);
+  fim = gt_feature_index_mapped_cast(gfi);
+  if (!fim->builder)
+    return fim_read_only(fim, err);
+  if (gt_feature_index_remove_node(fim->builder, fn, err))
+    return -1;
+  if (gt_hashmap_get(fim->insertion_order, fn))
+    gt_hashmap_remove(fim->insertion_order, fn);
+  return 0;
+}
+
+/* orders features by start position, features with the same start position
+   by the order in which they were added */
+static int fim_cmp_feature_start_insertion(const void *a, const void *b,
+                                           void *data)
+{
+  GtFeatureIndexMapped *fim = data;
+  GtGenomeNode *gna = *(GtGenomeNode**) a,
+               *gnb = *(GtGenomeNode**) b;
+  GtUword sa = gt_genome_node_get_start(gna),
+          sb = gt_genome_node_get_start(gnb),
+          ia, ib;
+  if (sa != sb)
+    return sa < sb ? -1 : 1;
+  ia = (GtUword) gt_hashmap_get(fim->insertion_order, gna);
+  ib = (GtUword) gt_hashmap_get(fim->insertion_order, gnb);
+  if (ia == ib)
+    return 0;
+  return ia < ib ? -1 : 1;
+}
+
+static GtArray* gt_feature_index_mapped_get_features_for_seqid(
+                                                            GtFeatureIndex *gfi,
+                                                            const char *seqid,
+                                                            GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  GtArray *a;
+  GtUword idx, i;
+  int had_err = 0;
+  gt_assert(gfi && seqid);
+  fim = gt_feature_index_mapped_cast(gfi);
+  if (fim->builder) {
+    if ((a = gt_feature_index_get_features_for_seqid(fim->builder, seqid,
+                                                     err))) {
+      gt_array_sort_stable_with_data(a, fim_cmp_feature_start_insertion, fim);
+    }
+    return a;
+  }
+  a = gt_array_new(sizeof (GtFeatureNode*));
+  if ((idx = fim_find_seqid(fim, seqid)) != GT_UNDEF_UWORD) {
+    const GtFeatureIndexMappedSeqid *s = fim->seqids + idx;
+    gt_mutex_lock(fim->nodes_mutex);
+    for (i = s->first_record;
+         !had_err && i < s->first_record + s->num_of_records; i++) {
+      GtFeatureNode *fn = fim_get_node(fim, idx, i, err);
+      if (fn)
+        gt_array_add(a, fn);
+      else
+        had_err = -1;
+    }
+    gt_mutex_unlock(fim->nodes_mutex);
+  }
+  if (had_err) {
+    gt_array_delete(a);
+    return NULL;
+  }
+  return a;
+}
+
+static int gt_genome_node_cmp_range_start(const void *v1, const void *v2)
+{
+  GtGenomeNode *n1, *n2;
+  n1 = *(GtGenomeNode**) v1;
+  n2 = *(GtGenomeNode**) v2;
+  return gt_genome_node_compare(&n1, &n2);
+}
+
+static int gt_feature_index_mapped_get_features_for_range(GtFeatureIndex *gfi,
+                                                          GtArray *results,
+                                                          const char *seqid,
+                                                          const GtRange
+                                                                     *qry_range,
+                                                          GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  const GtFeatureIndexMappedSeqid *s;
+  GtUword idx, lo, hi, first_result = gt_array_size(results);
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(gfi && results && qry_range);
+  fim = gt_feature_index_mapped_cast(gfi);
+  if (fim->builder) {
+    had_err = gt_feature_index_get_features_for_range(fim->builder, results,
+                                                      seqid, qry_range, err);
+    if (!had_err) {
+      gt_array_sort_stable_with_data(results, fim_cmp_feature_start_insertion,
+                                     fim);
+    }
+    return had_err;
+  }
+  if ((idx = fim_find_seqid(fim, seqid)) == GT_UNDEF_UWORD) {
+    gt_error_set(err, "feature index does not contain the given sequence id");
+    return -1;
+  }
+  s = fim->seqids + idx;
+  /* find the first record starting behind the query range */
+  lo = s->first_record;
+  hi = s->first_record + s->num_of_records;
+  while (lo < hi) {
+    GtUword mid = lo + (hi - lo) / 2;
+    if (fim->records[mid].start <= qry_range->end)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  /* scan backwards until no preceding record can reach the query range */
+  gt_mutex_lock(fim->nodes_mutex);
+  for (; !had_err && lo > s->first_record; lo--) {
+    const GtFeatureIndexMappedRecord *record = fim->records + lo - 1;
+    if (record->max_end < qry_range->start)
+      break;
+    if (record->end >= qry_range->start) {
+      GtFeatureNode *fn = fim_get_node(fim, idx, lo - 1, err);
+      if (fn)
+        gt_array_add(results, fn);
+      else
+        had_err = -1;
+    }
+  }
+  gt_mutex_unlock(fim->nodes_mutex);
+  if (!had_err) {
+    /* the records were visited in descending order */
+    GtFeatureNode **nodes = gt_array_get_space(results);
+    for (lo = first_result, hi = gt_array_size(results); lo + 1 < hi;
+         lo++, hi--) {
+      GtFeatureNode *tmp = nodes[lo];
+      nodes[lo] = nodes[hi - 1];
+      nodes[hi - 1] = tmp;
+    }
+    if (first_result > 0)
+      gt_array_sort_stable(results, gt_genome_node_cmp_range_start);
+  }
+  return had_err;
+}
+
+static char* gt_feature_index_mapped_get_first_seqid(const GtFeatureIndex *gfi,
+                                                     GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  gt_assert(gfi);
+  fim = gt_feature_index_mapped_cast((GtFeatureIndex*) gfi);
+  if (fim->builder)
+    return gt_feature_index_get_first_seqid(fim->builder, err);
+  if (!fim->header->num_of_seqids)
+    return NULL;
+  return gt_cstr_dup(fim_seqid_name(fim, fim->header->first_seqid));
+}
+
+static GtStrArray* gt_feature_index_mapped_get_seqids(const GtFeatureIndex *gfi,
+                                                      GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  GtStrArray *seqids;
+  GtUword i;
+  gt_assert(gfi);
+  fim = gt_feature_index_mapped_cast((GtFeatureIndex*) gfi);
+  if (fim->builder)
+    return gt_feature_index_get_seqids(fim->builder, err);
+  seqids = gt_str_array_new();
+  for (i = 0; i < fim->header->num_of_seqids; i++)
+    gt_str_array_add_cstr(seqids, fim_seqid_name(fim, i));
+  return seqids;
+}
+
+static int gt_feature_index_mapped_get_range_for_seqid(GtFeatureIndex *gfi,
+                                                       GtRange *range,
+                                                       const char *seqid,
+                                                       GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  const GtFeatureIndexMappedSeqid *s;
+  GtUword idx;
+  gt_assert(gfi && range && seqid);
+  fim = gt_feature_index_mapped_cast(gfi);
+  if (fim->builder) {
+    return gt_feature_index_get_range_for_seqid(fim->builder, range, seqid,
+                                                err);
+  }
+  if ((idx = fim_find_seqid(fim, seqid)) == GT_UNDEF_UWORD) {
+    gt_error_set(err, "feature index does not contain the given sequence id");
+    return -1;
+  }
+  s = fim->seqids + idx;
+  if (s->num_of_records) {
+    range->start = fim->records[s->first_record].start;
+    range->end = fim->records[s->first_record + s->num_of_records - 1].max_end;
+  }
+  else if (s->has_region) {
+    range->start = s->region_start;
+    range->end = s->region_end;
+  }
+  return 0;
+}
+
+static int gt_feature_index_mapped_get_orig_range_for_seqid(GtFeatureIndex
+                                                                           *gfi,
+                                                            GtRange *range,
+                                                            const char *seqid,
+                                                            GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  GtUword idx;
+  gt_assert(gfi && range && seqid);
+  fim = gt_feature_index_mapped_cast(gfi);
+  if (fim->builder) {
+    return gt_feature_index_get_orig_range_for_seqid(fim->builder, range,
+                                                     seqid, err);
+  }
+  if ((idx = fim_find_seqid(fim, seqid)) == GT_UNDEF_UWORD) {
+    gt_error_set(err, "feature index does not contain the given sequence id");
+    return -1;
+  }
+  if (fim->seqids[idx].has_region) {
+    range->start = fim->seqids[idx].region_start;
+    range->end = fim->seqids[idx].region_end;
+  }
+  return 0;
+}
+
+static int gt_feature_index_mapped_has_seqid(const GtFeatureIndex *gfi,
+                                             bool *has_seqid,
+                                             const char *seqid,
+                                             GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  gt_assert(gfi && has_seqid && seqid);
+  fim = gt_feature_index_mapped_cast((GtFeatureIndex*) gfi);
+  if (fim->builder) {
+    return gt_feature_index_has_seqid(fim->builder, has_seqid, seqid, err);
+  }
+  *has_seqid = (fim_find_seqid(fim, seqid) != GT_UNDEF_UWORD);
+  return 0;
+}
+
+static int fim_cmp_cstr(const void *a, const void *b)
+{
+  return strcmp(*(const char**) a, *(const char**) b);
+}
+
+static int gt_feature_index_mapped_save(GtFeatureIndex *gfi, GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  GtFeatureIndexMappedHeader header;
+  GtStrArray *seqid_array;
+  GtArray *names, *seqids, *records;
+  GtStr *strings, *payload;
+  char *first_seqid;
+  GtUword i, j;
+  FILE *fp;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(gfi);
+
+  fim = gt_feature_index_mapped_cast(gfi);
+  if (!fim->builder)
+    return fim_read_only(fim, err);
+  if (!(seqid_array = gt_feature_index_get_seqids(fim->builder, err)))
+    return -1;
+  first_seqid = gt_feature_index_get_first_seqid(fim->builder, err);
+
+  names = gt_array_new(sizeof (const char*));
+  for (i = 0; i < gt_str_array_size(seqid_array); i++) {
+    const char *name = gt_str_array_get(seqid_array, i);
+    gt_array_add(names, name);
+  }
+  gt_array_sort(names, fim_cmp_cstr);
+
+  memset(&header, 0, sizeof (header));
+  memcpy(header.magic, GT_FEATURE_INDEX_MAPPED_MAGIC, sizeof (header.magic));
+  header.version = GT_FEATURE_INDEX_MAPPED_VERSION;
+  header.num_of_seqids = gt_array_size(names);
+  seqids = gt_array_new(sizeof (GtFeatureIndexMappedSeqid));
+  records = gt_array_new(sizeof (GtFeatureIndexMappedRecord));
+  strings = gt_str_new();
+  payload = gt_str_new();
+
+  for (i = 0; !had_err && i < gt_array_size(names); i++) {
+    const char *name = *(const char**) gt_array_get(names, i);
+    GtFeatureIndexMappedSeqid s;
+    GtFeatureIndexMappedRecord record;
+    GtArray *features;
+    GtRange range;
+
+    if (first_seqid && strcmp(name, first_seqid) == 0)
+      header.first_seqid = i;
+    s.name_offset = gt_str_length(strings);
+    s.name_length = strlen(name);
+    gt_str_append_cstr_nt(strings, name, strlen(name));
+    gt_str_append_char(strings, '\0');
+    range.start = range.end = GT_UNDEF_UWORD;
+    had_err = gt_feature_index_get_orig_range_for_seqid(fim->builder, &range,
+                                                        name, err);
+    if (!had_err) {
+      s.has_region = (range.start != GT_UNDEF_UWORD);
+      s.region_start = s.has_region ? range.start : 0;
+      s.region_end = s.has_region ? range.end : 0;
+      if (!(features = gt_feature_index_get_features_for_seqid(fim->builder,
+                                                               name, err))) {
+        had_err = -1;
+      }
+    }
+    if (!had_err) {
+      gt_array_sort_stable_with_data(features, fim_cmp_feature_start_insertion,
+                                     fim);
+      s.first_record = gt_array_size(records);
+      s.num_of_records = gt_array_size(features);
+      record.max_end = 0;
+      for (j = 0; j < gt_array_size(features); j++) {
+        GtFeatureNode *fn = *(GtFeatureNode**) gt_array_get(features, j);
+        range = gt_genome_node_get_range((GtGenomeNode*) fn);
+        record.start = range.start;
+        record.end = range.end;
+        record.max_end = GT_MAX(record.max_end, range.end);
+        record.payload_offset = gt_str_length(payload);
+        fim_serialize_tree(payload, fn);
+        record.payload_length = gt_str_length(payload) - record.payload_offset;
+        gt_array_add(records, record);
+      }
+      gt_array_delete(features);
+      gt_array_add(seqids, s);
+    }
+  }
+
+  if (!had_err) {
+    header.num_of_records = gt_array_size(records);
+    header.strings_length = gt_str_length(strings);
+    header.payload_length = gt_str_length(payload);
+    if (!(fp = gt_fa_fopen(fim->filename, "wb", err)))
+      had_err = -1;
+  }
+  if (!had_err) {
+    gt_xfwrite_one(&header, fp);
+    if (gt_array_size(seqids)) {
+      gt_xfwrite(gt_array_get_space(seqids), sizeof (GtFeatureIndexMappedSeqid),
+                 gt_array_size(seqids), fp);
+    }
+    if (gt_array_size(records)) {
+      gt_xfwrite(gt_array_get_space(records),
+                 sizeof (GtFeatureIndexMappedRecord), gt_array_size(records),
+                 fp);
+    }
+    if (gt_str_length(strings))
+      gt_xfwrite(gt_str_get_mem(strings), 1, gt_str_length(strings), fp);
+    if (gt_str_length(payload))
+      gt_xfwrite(gt_str_get_mem(payload), 1, gt_str_length(payload), fp);
+    gt_fa_xfclose(fp);
+  }
+
+  gt_str_delete(payload);
+  gt_str_delete(strings);
+  gt_array_delete(records);
+  gt_array_delete(seqids);
+  gt_array_delete(names);
+  gt_free(first_seqid);
+  gt_str_array_delete(seqid_array);
+  return had_err;
+}
+
+static void gt_feature_index_mapped_delete(GtFeatureIndex *gfi)
+{
+  GtFeatureIndexMapped *fim;
+  GtUword i;
+  if (!gfi) return;
+  fim = gt_feature_index_mapped_cast(gfi);
+  gt_feature_index_delete(fim->builder);
+  gt_hashmap_delete(fim->insertion_order);
+  if (fim->nodes) {
+    for (i = 0; i < fim->header->num_of_records; i++)
+      gt_genome_node_delete((GtGenomeNode*) fim->nodes[i]);
+    gt_free(fim->nodes);
+  }
+  if (fim->seqid_strs) {
+    for (i = 0; i < fim->header->num_of_seqids; i++)
+      gt_str_delete(fim->seqid_strs[i]);
+    gt_free(fim->seqid_strs);
+  }
+  gt_hashmap_delete(fim->sources);
+  gt_mutex_delete(fim->nodes_mutex);
+  gt_fa_xmunmap(fim->map);
+  gt_free(fim->filename);
+}
+
+const GtFeatureIndexClass* gt_feature_index_mapped_class(void)
+{
+  static const GtFeatureIndexClass *fic = NULL;
+  gt_class_alloc_lock_enter();
+  if (!fic) {
+    fic = gt_feature_index_class_new(sizeof (GtFeatureIndexMapped),
+                     gt_feature_index_mapped_add_region_node,
+                     gt_feature_index_mapped_add_feature_node,
+                     gt_feature_index_mapped_remove_node,
+                     gt_feature_index_mapped_get_features_for_seqid,
+                     gt_feature_index_mapped_get_features_for_range,
+                     gt_feature_index_mapped_get_first_seqid,
+                     gt_feature_index_mapped_save,
+                     gt_feature_index_mapped_get_seqids,
+                     gt_feature_index_mapped_get_range_for_seqid,
+                     gt_feature_index_mapped_get_orig_range_for_seqid,
+                     gt_feature_index_mapped_has_seqid,
+                     gt_feature_index_mapped_delete);
+  }
+  gt_class_alloc_lock_leave();
+  return fic;
+}
+
+GtFeatureIndex* gt_feature_index_mapped_new(const char *filename)
+{
+  GtFeatureIndexMapped *fim;
+  GtFeatureIndex *fi;
+  gt_assert(filename);
+  fi = gt_feature_index_create(gt_feature_index_mapped_class());
+  fim = gt_feature_index_mapped_cast(fi);
+  fim->filename = gt_cstr_dup(filename);
+  fim->builder = gt_feature_index_memory_new();
+  fim->insertion_order = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+  return fi;
+}
+
+/* Checks the structure of the mapped file, so that queries only have to
+   validate the serialized feature trees. */
+static int fim_check_map(GtFeatureIndexMapped *fim, size_t length,
+                         GtError *err)
+{
+  const GtFeatureIndexMappedHeader *h;
+  GtUword i, j, offset;
+  int had_err = 0;
+  gt_error_check(err);
+
+  h = fim->header = fim->map;
+  if (length < sizeof (*h)
+      || memcmp(h->magic, GT_FEATURE_INDEX_MAPPED_MAGIC, sizeof (h->magic))) {
+    gt_error_set(err, "file \"%s\" is not a feature index file",
+                 fim->filename);
+    return -1;
+  }
+  if (h->version != GT_FEATURE_INDEX_MAPPED_VERSION) {
+    gt_error_set(err, "feature index file \"%s\" has version " GT_LLU
+                 ", expected %d", fim->filename, h->version,
+                 GT_FEATURE_INDEX_MAPPED_VERSION);
+    return -1;
+  }
+  offset = sizeof (*h);
+  if (h->num_of_seqids > length / sizeof (GtFeatureIndexMappedSeqid)
+      || h->num_of_records > length / sizeof (GtFeatureIndexMappedRecord)
+      || h->strings_length > length || h->payload_length > length
+      || (h->num_of_seqids && h->first_seqid >= h->num_of_seqids)
+      || offset + h->num_of_seqids * sizeof (GtFeatureIndexMappedSeqid)
+         + h->num_of_records * sizeof (GtFeatureIndexMappedRecord)
+         + h->strings_length + h->payload_length != length) {
+    had_err = -1;
+  }
+  if (!had_err) {
+    fim->seqids = (const GtFeatureIndexMappedSeqid*)
+                  ((const char*) fim->map + offset);
+    offset += h->num_of_seqids * sizeof (GtFeatureIndexMappedSeqid);
+    fim->records = (const GtFeatureIndexMappedRecord*)
+                   ((const char*) fim->map + offset);
+    offset += h->num_of_records * sizeof (GtFeatureIndexMappedRecord);
+    fim->strings = (const char*) fim->map + offset;
+    offset += h->strings_length;
+    fim->payload = (const char*) fim->map + offset;
+  }
+  for (i = 0; !had_err && i < h->num_of_seqids; i++) {
+    const GtFeatureIndexMappedSeqid *s = fim->seqids + i;
+    if (s->name_offset >= h->strings_length
+        || s->name_length >= h->strings_length - s->name_offset
+        || fim->strings[s->name_offset + s->name_length] != '\0'
+        || strlen(fim_seqid_name(fim, i)) != s->name_length
+        || (i > 0 && strcmp(fim_seqid_name(fim, i - 1),
+                            fim_seqid_name(fim, i)) >= 0)
+        || s->first_record > h->num_of_records
+        || s->num_of_records > h->num_of_records - s->first_record
+        || (s->has_region && s->region_start > s->region_end)) {
+      had_err = -1;
+      break;
+    }
+    for (j = s->first_record; j < s->first_record + s->num_of_records; j++) {
+      const GtFeatureIndexMappedRecord *r = fim->records + j;
+      GtUint64 max_end = j > s->first_record ? r[-1].max_end : 0;
+      if (r->start > r->end
+          || (j > s->first_record && r[-1].start > r->start)
+          || r->max_end != GT_MAX(max_end, r->end)
+          || r->payload_offset > h->payload_length
+          || r->payload_length > h->payload_length - r->payload_offset) {
+        had_err = -1;
+        break;
+      }
+    }
+  }
+  if (had_err) {
+    gt_error_set(err, "feature index file \"%s\" is corrupt", fim->filename);
+  }
+  return had_err;
+}
+
+GtFeatureIndex* gt_feature_index_mapped_load(const char *filename,
+                                             GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  GtFeatureIndex *fi;
+  size_t length;
+  GtUword i;
+  gt_error_check(err);
+  gt_assert(filename);
+
+  fi = gt_feature_index_create(gt_feature_index_mapped_class());
+  fim = gt_feature_index_mapped_cast(fi);
+  fim->filename = gt_cstr_dup(filename);
+  if (!(fim->map = gt_fa_mmap_read(filename, &length, err))
+      || fim_check_map(fim, length, err)) {
+    gt_feature_index_delete(fi);
+    return NULL;
+  }
+  fim->seqid_strs = gt_malloc(fim->header->num_of_seqids * sizeof (GtStr*));
+  for (i = 0; i < fim->header->num_of_seqids; i++)
+    fim->seqid_strs[i] = gt_str_new_cstr(fim_seqid_name(fim, i));
+  fim->nodes = gt_calloc(fim->header->num_of_records + 1,
+                         sizeof (GtFeatureNode*));
+  fim->sources = gt_hashmap_new(GT_HASH_STRING, NULL, (GtFree) gt_str_delete);
+  fim->nodes_mutex = gt_mutex_new();
+  return fi;
+}
+
+typedef struct {
+  GtFeatureNode *other;
+  bool equal;
+} FIMTestAttributeInfo;
+
+static void fim_test_compare_attribute(const char *attr_name,
+                                       const char *attr_value, void *data)
+{
+  FIMTestAttributeInfo *info = (FIMTestAttributeInfo*) data;
+  const char *other_value = gt_feature_node_get_attribute(info->other,
+                                                          attr_name);
+  if (!other_value || strcmp(attr_value, other_value))
+    info->equal = false;
+}
+
+static bool fim_test_nodes_equal(GtFeatureNode *a, GtFeatureNode *b)
+{
+  GtFeatureNodeIterator *fni_a, *fni_b;
+  GtFeatureNode *na, *nb;
+  bool equal = true;
+  fni_a = gt_feature_node_iterator_new(a);
+  fni_b = gt_feature_node_iterator_new(b);
+  while (equal) {
+    GtRange ra, rb;
+    FIMTestAttributeInfo info;
+    na = gt_feature_node_iterator_next(fni_a);
+    nb = gt_feature_node_iterator_next(fni_b);
+    if (!na || !nb) {
+      equal = (na == nb);
+      break;
+    }
+    ra = gt_genome_node_get_range((GtGenomeNode*) na);
+    rb = gt_genome_node_get_range((GtGenomeNode*) nb);
+    if (gt_range_compare(&ra, &rb)
+        || gt_feature_node_is_pseudo(na) != gt_feature_node_is_pseudo(nb)
+        || gt_feature_node_is_multi(na) != gt_feature_node_is_multi(nb)
+        || gt_feature_node_get_strand(na) != gt_feature_node_get_strand(nb)
+        || gt_feature_node_get_phase(na) != gt_feature_node_get_phase(nb)
+        || strcmp(gt_feature_node_get_source(na),
+                  gt_feature_node_get_source(nb))
+        || gt_feature_node_score_is_defined(na)
+           != gt_feature_node_score_is_defined(nb)
+        || gt_feature_node_number_of_children(na)
+           != gt_feature_node_number_of_children(nb)) {
+      equal = false;
+      break;
+    }
+    if (!gt_feature_node_is_pseudo(na)
+        && strcmp(gt_feature_node_get_type(na), gt_feature_node_get_type(nb))) {
+      equal = false;
+    }
+    if (gt_feature_node_score_is_defined(na)
+        && gt_feature_node_get_score(na) != gt_feature_node_get_score(nb)) {
+      equal = false;
+    }
+    info.other = nb;
+    info.equal = equal;
+    gt_feature_node_foreach_attribute(na, fim_test_compare_attribute, &info);
+    info.other = na;
+    gt_feature_node_foreach_attribute(nb, fim_test_compare_attribute, &info);
+    equal = info.equal;
+  }
+  gt_feature_node_iterator_delete(fni_b);
+  gt_feature_node_iterator_delete(fni_a);
+  return equal;
+}
+
+static int fim_test_compare(GtFeatureIndex *expected, GtFeatureIndex *mapped,
+                            const char *seqid, const GtRange *range,
+                            GtError *err)
+{
+  GtArray *a, *b;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+
+  a = gt_array_new(sizeof (GtFeatureNode*));
+  b = gt_array_new(sizeof (GtFeatureNode*));
+  gt_ensure(!gt_feature_index_get_features_for_range(expected, a, seqid,
+                                                     range, err));
+  gt_ensure(!gt_feature_index_get_features_for_range(mapped, b, seqid,
+                                                     range, err));
+  gt_ensure(gt_array_size(a) == gt_array_size(b));
+  for (i = 0; !had_err && i < gt_array_size(a); i++) {
+    gt_ensure(fim_test_nodes_equal(*(GtFeatureNode**) gt_array_get(a, i),
+                                   *(GtFeatureNode**) gt_array_get(b, i)));
+  }
+  gt_array_delete(b);
+  gt_array_delete(a);
+  return had_err;
+}
+
+#define FIM_TEST_NOF_FEATURES  200
+#define FIM_TEST_SEQLEN        100000
+
+int gt_feature_index_mapped_unit_test(GtError *err)
+{
+  int had_err = 0;
+  GtFeatureIndex *fi, *mapped = NULL;
+  GtGenomeNode *gn, *child, *pseudo, *rep;
+  GtStr *tmpfilename, *seqid, *source;
+  GtStrArray *seqids;
+  GtRange range;
+  GtError *testerr;
+  char *first_seqid;
+  bool has_seqid;
+  FILE *tmpfp;
+  GtUword i;
+  gt_error_check(err);
+
+  tmpfilename = gt_str_new();
+  tmpfp = gt_xtmpfp(tmpfilename);
+  gt_fa_xfclose(tmpfp);
+  testerr = gt_error_new();
+
+  /* run generic feature index tests */
+  fi = gt_feature_index_mapped_new(gt_str_get(tmpfilename));
+  had_err = gt_feature_index_unit_test(fi, err);
+  gt_feature_index_delete(fi);
+
+  /* build an index with some more complicated features */
+  fi = gt_feature_index_mapped_new(gt_str_get(tmpfilename));
+  gn = gt_feature_node_new_standard_gene();
+  gt_ensure(!gt_feature_index_add_feature_node(fi, (GtFeatureNode*) gn, err));
+  gt_genome_node_delete(gn);
+  seqid = gt_str_new_cstr("seq2");
+  source = gt_str_new_cstr("test");
+  gn = gt_region_node_new(seqid, 1, FIM_TEST_SEQLEN);
+  gt_ensure(!gt_feature_index_add_region_node(fi, (GtRegionNode*) gn, err));
+  gt_genome_node_delete(gn);
+  for (i = 0; !had_err && i < FIM_TEST_NOF_FEATURES; i++) {
+    GtUword start = random() % (FIM_TEST_SEQLEN / 2) + 1,
+            end = start + random() % (i % 10 ? 1000 : FIM_TEST_SEQLEN / 2);
+    gn = gt_feature_node_new(seqid, "gene", start, end, GT_STRAND_FORWARD);
+    gt_feature_node_set_source((GtFeatureNode*) gn, source);
+    gt_feature_node_set_score((GtFeatureNode*) gn, (float) i / 3);
+    gt_feature_node_add_attribute((GtFeatureNode*) gn, "Name", "foo");
+    child = gt_feature_node_new(seqid, "exon", start, end, GT_STRAND_FORWARD);
+    gt_feature_node_set_phase((GtFeatureNode*) child, GT_PHASE_ONE);
+    gt_feature_node_add_child((GtFeatureNode*) gn, (GtFeatureNode*) child);
+    gt_ensure(!gt_feature_index_add_feature_node(fi, (GtFeatureNode*) gn,
+                                                 err));
+    gt_genome_node_delete(gn);
+  }
+  /* a multi-feature below a pseudo-feature, sharing a child */
+  pseudo = gt_feature_node_new_pseudo(seqid, 100, 400, GT_STRAND_REVERSE);
+  rep = gt_feature_node_new(seqid, "CDS", 100, 200, GT_STRAND_REVERSE);
+  gt_feature_node_make_multi_representative((GtFeatureNode*) rep);
+  gt_feature_node_add_child((GtFeatureNode*) pseudo, (GtFeatureNode*) rep);
+  child = gt_feature_node_new(seqid, "CDS", 300, 400, GT_STRAND_REVERSE);
+  gt_feature_node_set_multi_representative((GtFeatureNode*) child,
+                                           (GtFeatureNode*) rep);
+  gt_feature_node_add_child((GtFeatureNode*) pseudo, (GtFeatureNode*) child);
+  gn = gt_feature_node_new(seqid, "region", 100, 400, GT_STRAND_REVERSE);
+  gt_feature_node_add_child((GtFeatureNode*) rep, (GtFeatureNode*) gn);
+  gt_feature_node_add_child((GtFeatureNode*) child,
+                            (GtFeatureNode*) gt_genome_node_ref(gn));
+  gt_ensure(!gt_feature_index_add_feature_node(fi, (GtFeatureNode*) pseudo,
+                                               err));
+  gt_genome_node_delete(pseudo);
+  gt_str_delete(source);
+  gt_str_delete(seqid);
+  gt_ensure(!gt_feature_index_save(fi, err));
+
+  /* compare the mapped index with the original one */
+  if (!had_err) {
+    mapped = gt_feature_index_mapped_load(gt_str_get(tmpfilename), err);
+    gt_ensure(mapped);
+  }
+  if (!had_err) {
+    seqids = gt_feature_index_get_seqids(mapped, err);
+    gt_ensure(seqids && gt_str_array_size(seqids) == 2);
+    gt_str_array_delete(seqids);
+    first_seqid = gt_feature_index_get_first_seqid(mapped, err);
+    gt_ensure(first_seqid && strcmp(first_seqid, "ctg123") == 0);
+    gt_free(first_seqid);
+    gt_ensure(!gt_feature_index_has_seqid(mapped, &has_seqid, "seq2", err));
+    gt_ensure(has_seqid);
+    gt_ensure(!gt_feature_index_has_seqid(mapped, &has_seqid, "seq3", err));
+    gt_ensure(!has_seqid);
+    gt_ensure(!gt_feature_index_get_orig_range_for_seqid(mapped, &range,
+                                                         "seq2", err));
+    gt_ensure(range.start == 1 && range.end == FIM_TEST_SEQLEN);
+  }
+  for (i = 0; !had_err && i < FIM_TEST_NOF_FEATURES; i++) {
+    range.start = random() % FIM_TEST_SEQLEN + 1;
+    range.end = range.start + random() % 2000;
+    had_err = fim_test_compare(fi, mapped, i % 2 ? "seq2" : "ctg123", &range,
+                               err);
+  }
+  if (!had_err) {
+    range.start = 1;
+    range.end = FIM_TEST_SEQLEN;
+    had_err = fim_test_compare(fi, mapped, "seq2", &range, err);
+  }
+  if (!had_err) {
+    GtFeatureNode *fn = gt_feature_node_cast(
+                                       gt_feature_node_new_standard_gene());
+    gt_ensure(gt_feature_index_add_feature_node(mapped, fn, testerr));
+    gt_ensure(gt_error_is_set(testerr));
+    gt_genome_node_delete((GtGenomeNode*) fn);
+  }
+  gt_feature_index_delete(mapped);
+  gt_feature_index_delete(fi);
+
+  /* corrupt files are rejected */
+  if (!had_err) {
+    tmpfp = gt_fa_xfopen(gt_str_get(tmpfilename), "wb");
+    gt_xfputs("GTFIMAP", tmpfp);
+    gt_fa_xfclose(tmpfp);
+    gt_error_unset(testerr);
+    mapped = gt_feature_index_mapped_load(gt_str_get(tmpfilename), testerr);
+    gt_ensure(!mapped && gt_error_is_set(testerr));
+  }
+
+  gt_xremove(gt_str_get(tmpfilename));
+  gt_str_delete(tmpfilename);
+  gt_error_delete(testerr);
+  return had_err;
+}
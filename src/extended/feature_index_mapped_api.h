@@ -0,0 +1,42 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef FEATURE_INDEX_MAPPED_API_H
+#define FEATURE_INDEX_MAPPED_API_H
+
+#include "extended/feature_index_api.h"
+
+/* The <GtFeatureIndexMapped> class implements a <GtFeatureIndex> which can be
+   stored in a binary file and later be mapped into memory again, avoiding
+   the need to reparse the annotation. The file contains a sorted sequence ID
+   table and, per sequence ID, the feature intervals sorted by start position
+   together with the running maximum of their end positions, which allows for
+   range queries by binary search. Feature trees are stored in a compact binary
+   form and are only reconstructed when they are returned by a query. */
+typedef struct GtFeatureIndexMapped GtFeatureIndexMapped;
+
+/* Creates a new, empty <GtFeatureIndexMapped> object. Features can be added as
+   for a <GtFeatureIndexMemory>, <gt_feature_index_save()> writes the index to
+   the file <filename>. */
+GtFeatureIndex* gt_feature_index_mapped_new(const char *filename);
+
+/* Maps the feature index stored in <filename> into memory and returns it as a
+   read-only <GtFeatureIndexMapped> object. Returns NULL and sets <err> if the
+   file could not be mapped or is not a valid feature index file. */
+GtFeatureIndex* gt_feature_index_mapped_load(const char *filename,
+                                             GtError *err);
+
+#endif
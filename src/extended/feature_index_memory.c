@@ -24,10 +24,12 @@
 #include "core/cstr_api.h"
 #include "core/ensure_api.h"
 #include "core/hashmap_api.h"
+#include "core/interval_index.h"
 #include "core/interval_tree.h"
 #include "core/ma_api.h"
 #include "core/minmax_api.h"
 #include "core/range_api.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "extended/feature_index_memory.h"
@@ -42,6 +44,7 @@ struct GtFeatureIndexMemory {
   GtHashmap *nodes_in_index;
   GtArray *ids;
   char *firstseqid;
+  GtMutex *freeze_mutex;
   GtUword nof_region_nodes,
                 reference_count,
                 nof_nodes;
@@ -50,15 +53,28 @@ struct GtFeatureIndexMemory {
 #define gt_feature_index_memory_cast(FI)\
         gt_feature_index_cast(gt_feature_index_memory_class(), FI)
 
+/* Range queries are answered from a static <GtIntervalIndex> snapshot of the
+   interval tree once a region has been queried repeatedly without being
+   modified in between. Adding or removing features drops the snapshot. */
 typedef struct {
   GtIntervalTree *features;
+  GtIntervalIndex *frozen_features;
+  GtUword unmodified_queries;
   GtRegionNode *region;
   GtRange dyn_range;
 } RegionInfo;
 
+static void region_info_unfreeze(RegionInfo *info)
+{
+  gt_interval_index_delete(info->frozen_features);
+  info->frozen_features = NULL;
+  info->unmodified_queries = 0;
+}
+
 static void region_info_delete(RegionInfo *info)
 {
   gt_interval_tree_delete(info->features);
+  gt_interval_index_delete(info->frozen_features);
   if (info->region)
     gt_genome_node_delete((GtGenomeNode*)info->region);
   gt_free(info);
@@ -128,6 +144,7 @@ int gt_feature_index_memory_add_feature_node(GtFeatureIndex *gfi,
   /* add node to the appropriate array in the hashtable */
   new_node = gt_interval_tree_node_new(gn, node_range.start, node_range.end);
   gt_interval_tree_insert(info->features, new_node);
+  region_info_unfreeze(info);
   /* update dynamic range */
   info->dyn_range.start = GT_MIN(info->dyn_range.start, node_range.start);
   info->dyn_range.end = GT_MAX(info->dyn_range.end, node_range.end);
@@ -178,8 +195,10 @@ int gt_feature_index_memory_remove_node(GtFeatureIndex *gfi,
                                    node_range.end,
                                    &info);
 
-  if (info.node)
+  if (info.node) {
     gt_interval_tree_remove(rinfo->features, info.node);
+    region_info_unfreeze(rinfo);
+  }
   return 0;
 }
 
@@ -220,6 +239,37 @@ static int gt_genome_node_cmp_range_start(const void *v1, const void *v2)
   return gt_genome_node_compare(&n1, &n2);
 }
 
+static int add_feature_to_interval_index(GtIntervalTreeNode *node, void *data)
+{
+  GtIntervalIndex *ii = (GtIntervalIndex*) data;
+  GtGenomeNode *gn = (GtGenomeNode*) gt_interval_tree_node_get_data(node);
+  GtRange range = gt_genome_node_get_range(gn);
+  gt_interval_index_add(ii, gn, range.start, range.end);
+  return 0;
+}
+
+/* Returns the static snapshot of the features in <ri>, creating it if <ri> has
+   been queried before without modification. Returns NULL if the interval tree
+   should be used instead. */
+static GtIntervalIndex* region_info_get_frozen(GtFeatureIndexMemory *fi,
+                                               RegionInfo *ri)
+{
+  GtIntervalIndex *ii;
+  gt_mutex_lock(fi->freeze_mutex);
+  if (!ri->frozen_features && ri->unmodified_queries++ > 0) {
+    GT_UNUSED int had_err;
+    ii = gt_interval_index_new(NULL);
+    had_err = gt_interval_tree_traverse(ri->features,
+                                        add_feature_to_interval_index, ii);
+    gt_assert(!had_err); /* add_feature_to_interval_index() is sane */
+    gt_interval_index_freeze(ii);
+    ri->frozen_features = ii;
+  }
+  ii = ri->frozen_features;
+  gt_mutex_unlock(fi->freeze_mutex);
+  return ii;
+}
+
 int gt_feature_index_memory_get_features_for_range(GtFeatureIndex *gfi,
                                                    GtArray *results,
                                                    const char *seqid,
@@ -228,6 +278,7 @@ int gt_feature_index_memory_get_features_for_range(GtFeatureIndex *gfi,
 {
   RegionInfo *ri;
   GtFeatureIndexMemory *fi;
+  GtIntervalIndex *frozen;
   gt_error_check(err);
   gt_assert(gfi && results);
 
@@ -237,8 +288,14 @@ int gt_feature_index_memory_get_features_for_range(GtFeatureIndex *gfi,
     gt_error_set(err, "feature index does not contain the given sequence id");
     return -1;
   }
-  gt_interval_tree_find_all_overlapping(ri->features, qry_range->start,
-                                        qry_range->end, results);
+  if ((frozen = region_info_get_frozen(fi, ri))) {
+    gt_interval_index_find_all_overlapping(frozen, qry_range->start,
+                                           qry_range->end, results);
+  }
+  else {
+    gt_interval_tree_find_all_overlapping(ri->features, qry_range->start,
+                                          qry_range->end, results);
+  }
   gt_array_sort(results, gt_genome_node_cmp_range_start);
   return 0;
 }
@@ -358,6 +415,7 @@ void gt_feature_index_memory_delete(GtFeatureIndex *gfi)
   fi = gt_feature_index_memory_cast(gfi);
   gt_hashmap_delete(fi->regions);
   gt_hashmap_delete(fi->nodes_in_index);
+  gt_mutex_delete(fi->freeze_mutex);
 }
 
 const GtFeatureIndexClass* gt_feature_index_memory_class(void)
@@ -393,6 +451,7 @@ GtFeatureIndex* gt_feature_index_memory_new(void)
   fim->regions = gt_hashmap_new(GT_HASH_STRING, NULL,
                                 (GtFree) region_info_delete);
   fim->nodes_in_index = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+  fim->freeze_mutex = gt_mutex_new();
   return fi;
 }
 
@@ -430,6 +489,44 @@ int gt_feature_index_memory_unit_test(GtError *err)
                                                 testerr);
   gt_ensure(tmp == NULL);
   gt_ensure(gt_error_is_set(testerr));
+
+  /* repeated queries are answered from a frozen snapshot, which has to be
+     dropped when the index is modified */
+  if (!had_err) {
+    GtArray *results = gt_array_new(sizeof (GtFeatureNode*));
+    GtRange rng = gt_genome_node_get_range((GtGenomeNode*) fn);
+    GtStr *seqid = gt_genome_node_get_seqid((GtGenomeNode*) fn);
+    GtUword i, nof_results = 0;
+    gt_error_unset(testerr);
+    for (i = 0; !had_err && i < 3; i++) {
+      gt_array_reset(results);
+      gt_ensure(!gt_feature_index_get_features_for_range(fi, results,
+                                                         gt_str_get(seqid),
+                                                         &rng, testerr));
+      gt_ensure(i == 0 || gt_array_size(results) == nof_results);
+      nof_results = gt_array_size(results);
+    }
+    gt_ensure(nof_results > 0);
+    tmp = gt_feature_node_cast(gt_feature_node_new(seqid, "gene", rng.start,
+                                                   rng.start,
+                                                   GT_STRAND_FORWARD));
+    gt_ensure(!gt_feature_index_add_feature_node(fi, tmp, testerr));
+    gt_genome_node_delete((GtGenomeNode*) tmp);
+    for (i = 0; !had_err && i < 2; i++) {
+      gt_array_reset(results);
+      gt_ensure(!gt_feature_index_get_features_for_range(fi, results,
+                                                         gt_str_get(seqid),
+                                                         &rng, testerr));
+      gt_ensure(gt_array_size(results) == nof_results + 1);
+    }
+    gt_ensure(!gt_feature_index_remove_node(fi, tmp, testerr));
+    gt_array_reset(results);
+    gt_ensure(!gt_feature_index_get_features_for_range(fi, results,
+                                                       gt_str_get(seqid),
+                                                       &rng, testerr));
+    gt_ensure(gt_array_size(results) == nof_results);
+    gt_array_delete(results);
+  }
   gt_genome_node_delete((GtGenomeNode*) fn);
   gt_feature_index_delete(fi);
 
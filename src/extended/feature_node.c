@@ -231,15 +231,18 @@ static void set_tree_status(unsigned int *bit_field, TreeStatus tree_status)
   *bit_field |= tree_status << TREE_STATUS_OFFSET;
 }
 
-GtGenomeNode* gt_feature_node_new(GtStr *seqid, const char *type,
-                                  GtUword start, GtUword end,
-                                  GtStrand strand)
+static GtGenomeNode* feature_node_new(GtGenomeNodeArena *arena, GtStr *seqid,
+                                      const char *type, GtUword start,
+                                      GtUword end, GtStrand strand)
 {
   GtGenomeNode *gn;
   GtFeatureNode *fn;
   gt_assert(seqid && type);
   gt_assert(start <= end);
-  gn = gt_genome_node_create(gt_feature_node_class());
+  if (arena)
+    gn = gt_genome_node_create_in_arena(gt_feature_node_class(), arena);
+  else
+    gn = gt_genome_node_create(gt_feature_node_class());
   fn = gt_feature_node_cast(gn);
   fn->seqid       = gt_str_ref(seqid);
   fn->source      = NULL;
@@ -261,6 +264,21 @@ GtGenomeNode* gt_feature_node_new(GtStr *seqid, const char *type,
   return gn;
 }
 
+GtGenomeNode* gt_feature_node_new(GtStr *seqid, const char *type,
+                                  GtUword start, GtUword end,
+                                  GtStrand strand)
+{
+  return feature_node_new(NULL, seqid, type, start, end, strand);
+}
+
+GtGenomeNode* gt_feature_node_new_in_arena(GtGenomeNodeArena *arena,
+                                           GtStr *seqid, const char *type,
+                                           GtUword start, GtUword end,
+                                           GtStrand strand)
+{
+  return feature_node_new(arena, seqid, type, start, end, strand);
+}
+
 GtGenomeNode* gt_feature_node_new_pseudo(GtStr *seqid, GtUword start,
                                          GtUword end, GtStrand strand)
 {
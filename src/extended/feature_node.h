@@ -26,12 +26,20 @@
 #include "extended/feature_node_observer.h"
 #include "extended/feature_type_api.h"
 #include "extended/genome_node.h"
+#include "extended/genome_node_arena.h"
 #include "extended/transcript_feature_type.h"
 
 typedef int (*GtFeatureNodeTraverseFunc)(GtFeatureNode*, void*, GtError*);
 
 const GtGenomeNodeClass* gt_feature_node_class(void);
 
+/* Like <gt_feature_node_new()>, but the node is allocated from <arena>, if it
+   is not <NULL>. */
+GtGenomeNode*  gt_feature_node_new_in_arena(GtGenomeNodeArena *arena,
+                                            GtStr *seqid, const char *type,
+                                            GtUword start, GtUword end,
+                                            GtStrand strand);
+
 GtFeatureNode* gt_feature_node_clone(const GtFeatureNode*);
 void           gt_feature_node_get_exons(GtFeatureNode*,
                                          GtArray *exon_features);
@@ -212,20 +212,37 @@ static int compare_genome_nodes_with_delta(GtGenomeNode *gn_a,
   return gt_range_compare_with_delta(&range_a, &range_b, delta);
 }
 
-GtGenomeNode* gt_genome_node_create(const GtGenomeNodeClass *gnc)
+static void genome_node_init(GtGenomeNode *gn, const GtGenomeNodeClass *gnc,
+                             bool in_arena)
 {
-  GtGenomeNode *gn;
-  gt_assert(gnc && gnc->size);
-  gn                     = gt_malloc(gnc->size);
   gn->c_class            = gnc;
   gn->filename           = NULL; /* means the node is generated */
   gn->line_number        = 0;
   gn->reference_count    = 0;
   gn->userdata           = NULL;
   gn->userdata_nof_items = 0;
+  gn->in_arena           = in_arena;
 #ifdef GT_THREADS_ENABLED
   gn->lock              = gt_rwlock_new();
 #endif
+}
+
+GtGenomeNode* gt_genome_node_create(const GtGenomeNodeClass *gnc)
+{
+  GtGenomeNode *gn;
+  gt_assert(gnc && gnc->size);
+  gn = gt_malloc(gnc->size);
+  genome_node_init(gn, gnc, false);
+  return gn;
+}
+
+GtGenomeNode* gt_genome_node_create_in_arena(const GtGenomeNodeClass *gnc,
+                                             GtGenomeNodeArena *arena)
+{
+  GtGenomeNode *gn;
+  gt_assert(gnc && gnc->size && arena);
+  gn = gt_genome_node_arena_alloc(arena, gnc->size);
+  genome_node_init(gn, gnc, true);
   return gn;
 }
 
@@ -539,5 +556,8 @@ void gt_genome_node_delete(GtGenomeNode *gn)
 #ifdef GT_THREADS_ENABLED
   gt_rwlock_delete(gn->lock);
 #endif
-  gt_free(gn);
+  if (gn->in_arena)
+    gt_genome_node_arena_free(gn);
+  else
+    gt_free(gn);
 }
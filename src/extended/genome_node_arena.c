@@ -0,0 +1,160 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/array_api.h"
+#include "core/assert_api.h"
+#include "core/ensure_api.h"
+#include "core/ma_api.h"
+#include "core/thread_api.h"
+#include "core/types_api.h"
+#include "extended/genome_node_arena.h"
+
+#define GT_GENOME_NODE_ARENA_BLOCKSIZE  (64 * 1024)
+
+typedef struct {
+  GtMutex *mutex; /* protects the members below */
+  GtUword num_of_allocations; /* not freed yet */
+  bool in_use; /* the arena still allocates from this block */
+} GtGenomeNodeArenaBlock;
+
+/* every allocation is preceded by a pointer to its block, the union ensures
+   the proper alignment of the allocated memory */
+typedef union {
+  GtGenomeNodeArenaBlock *block;
+  GtUint64 uint64;
+  double dbl;
+  void *ptr;
+} GtGenomeNodeArenaUnit;
+
+#define GT_GENOME_NODE_ARENA_UNITS(SIZE)\
+        (((SIZE) + sizeof (GtGenomeNodeArenaUnit) - 1) /\
+         sizeof (GtGenomeNodeArenaUnit))
+
+#define GT_GENOME_NODE_ARENA_HEADER_UNITS\
+        GT_GENOME_NODE_ARENA_UNITS(sizeof (GtGenomeNodeArenaBlock))
+
+#define GT_GENOME_NODE_ARENA_BLOCK_UNITS\
+        (GT_GENOME_NODE_ARENA_BLOCKSIZE / sizeof (GtGenomeNodeArenaUnit))
+
+struct GtGenomeNodeArena {
+  GtGenomeNodeArenaBlock *block;
+  GtUword next_unit;
+};
+
+GtGenomeNodeArena* gt_genome_node_arena_new(void)
+{
+  return gt_calloc(1, sizeof (GtGenomeNodeArena));
+}
+
+static void genome_node_arena_block_release(GtGenomeNodeArenaBlock *block,
+                                            bool free_allocation)
+{
+  bool delete_block;
+  gt_assert(block);
+  gt_mutex_lock(block->mutex);
+  if (free_allocation) {
+    gt_assert(block->num_of_allocations);
+    block->num_of_allocations--;
+  }
+  else
+    block->in_use = false;
+  delete_block = !block->in_use && !block->num_of_allocations;
+  gt_mutex_unlock(block->mutex);
+  if (delete_block) {
+    gt_mutex_delete(block->mutex);
+    gt_free(block);
+  }
+}
+
+void* gt_genome_node_arena_alloc(GtGenomeNodeArena *arena, size_t size)
+{
+  GtGenomeNodeArenaUnit *units;
+  GtUword num_of_units;
+  gt_assert(arena && size);
+  num_of_units = 1 + GT_GENOME_NODE_ARENA_UNITS(size);
+  gt_assert(GT_GENOME_NODE_ARENA_HEADER_UNITS + num_of_units <=
+            GT_GENOME_NODE_ARENA_BLOCK_UNITS);
+  if (!arena->block ||
+      arena->next_unit + num_of_units > GT_GENOME_NODE_ARENA_BLOCK_UNITS) {
+    if (arena->block)
+      genome_node_arena_block_release(arena->block, false);
+    arena->block = gt_malloc(GT_GENOME_NODE_ARENA_BLOCKSIZE);
+    arena->block->mutex = gt_mutex_new();
+    arena->block->num_of_allocations = 0;
+    arena->block->in_use = true;
+    arena->next_unit = GT_GENOME_NODE_ARENA_HEADER_UNITS;
+  }
+  units = (GtGenomeNodeArenaUnit*) arena->block + arena->next_unit;
+  arena->next_unit += num_of_units;
+  units[0].block = arena->block;
+  gt_mutex_lock(arena->block->mutex);
+  arena->block->num_of_allocations++;
+  gt_mutex_unlock(arena->block->mutex);
+  return units + 1;
+}
+
+void gt_genome_node_arena_free(void *ptr)
+{
+  GtGenomeNodeArenaUnit *units;
+  if (!ptr) return;
+  units = (GtGenomeNodeArenaUnit*) ptr - 1;
+  genome_node_arena_block_release(units[0].block, true);
+}
+
+void gt_genome_node_arena_delete(GtGenomeNodeArena *arena)
+{
+  if (!arena) return;
+  if (arena->block)
+    genome_node_arena_block_release(arena->block, false);
+  gt_free(arena);
+}
+
+int gt_genome_node_arena_unit_test(GtError *err)
+{
+  GtGenomeNodeArena *arena;
+  GtArray *allocations;
+  GtUword i;
+  char *ptr;
+  int had_err = 0;
+  gt_error_check(err);
+
+  arena = gt_genome_node_arena_new();
+  allocations = gt_array_new(sizeof (char*));
+  /* spans several blocks */
+  for (i = 0; i < 10000; i++) {
+    ptr = gt_genome_node_arena_alloc(arena, 1 + i % 100);
+    gt_ensure((size_t) ptr % sizeof (GtGenomeNodeArenaUnit) == 0);
+    memset(ptr, (int) (i % 128), 1 + i % 100);
+    gt_array_add(allocations, ptr);
+  }
+  /* free every other allocation while the arena exists */
+  for (i = 0; !had_err && i < gt_array_size(allocations); i += 2) {
+    ptr = *(char**) gt_array_get(allocations, i);
+    gt_ensure(ptr[i % 100] == (char) (i % 128));
+    gt_genome_node_arena_free(ptr);
+  }
+  /* the remaining allocations outlive the arena */
+  gt_genome_node_arena_delete(arena);
+  for (i = 1; !had_err && i < gt_array_size(allocations); i += 2) {
+    ptr = *(char**) gt_array_get(allocations, i);
+    gt_ensure(ptr[i % 100] == (char) (i % 128));
+    gt_genome_node_arena_free(ptr);
+  }
+  gt_array_delete(allocations);
+
+  return had_err;
+}
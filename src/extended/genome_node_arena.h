@@ -0,0 +1,43 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef GENOME_NODE_ARENA_H
+#define GENOME_NODE_ARENA_H
+
+#include <stdlib.h>
+#include "core/error_api.h"
+
+/* A <GtGenomeNodeArena> hands out the memory of many genome nodes from a few
+   large blocks, which saves many small allocations when annotations are
+   parsed. Every block keeps track of the number of its allocations which have
+   not been freed yet. A block is released as soon as this number drops to zero
+   and the arena does not allocate from it anymore. Therefore, the nodes may
+   outlive the arena they have been allocated from. */
+typedef struct GtGenomeNodeArena GtGenomeNodeArena;
+
+GtGenomeNodeArena* gt_genome_node_arena_new(void);
+/* Return <size> bytes of memory from <arena>. */
+void*              gt_genome_node_arena_alloc(GtGenomeNodeArena *arena,
+                                              size_t size);
+/* Free the memory <ptr> returned by <gt_genome_node_arena_alloc()>. Can be
+   called from any thread and after the arena has been deleted. */
+void               gt_genome_node_arena_free(void *ptr);
+/* Stop allocating from <arena>. Blocks which still hold allocations are
+   released when the last of them is freed. */
+void               gt_genome_node_arena_delete(GtGenomeNodeArena *arena);
+int                gt_genome_node_arena_unit_test(GtError *err);
+
+#endif
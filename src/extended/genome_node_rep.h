@@ -23,6 +23,7 @@
 #include "core/hashmap_api.h"
 #include "core/thread_api.h"
 #include "extended/genome_node.h"
+#include "extended/genome_node_arena.h"
 
 typedef void    (*GtGenomeNodeFreeFunc)(GtGenomeNode*);
 typedef GtStr*  (*GtGenomeNodeSetSeqidFunc)(GtGenomeNode*);
@@ -60,6 +61,7 @@ struct GtGenomeNode
   unsigned int line_number,
                reference_count,
                userdata_nof_items;
+  bool in_arena; /* the node has been allocated from a <GtGenomeNodeArena> */
 };
 
 const GtGenomeNodeClass* gt_genome_node_class_new(size_t size,
@@ -71,5 +73,7 @@ const GtGenomeNodeClass* gt_genome_node_class_new(size_t size,
                                        GtGenomeNodeChangeSeqidFunc change_seqid,
                                        GtGenomeNodeAcceptFunc accept);
 GtGenomeNode* gt_genome_node_create(const GtGenomeNodeClass*);
+GtGenomeNode* gt_genome_node_create_in_arena(const GtGenomeNodeClass*,
+                                             GtGenomeNodeArena*);
 
 #endif
@@ -116,6 +116,13 @@ void gt_gff3_in_stream_set_offset(GtNodeStream *ns, GtWord offset)
   gt_gff3_in_stream_plain_set_offset(is->gff3_in_stream_plain, offset);
 }
 
+void gt_gff3_in_stream_enable_node_arena(GtNodeStream *ns)
+{
+  GtGFF3InStream *is = gff3_in_stream_cast(ns);
+  gt_assert(is);
+  gt_gff3_in_stream_plain_enable_node_arena(is->gff3_in_stream_plain);
+}
+
 int gt_gff3_in_stream_set_offsetfile(GtNodeStream *ns, GtStr *offsetfile,
                                      GtError *err)
 {
@@ -31,6 +31,9 @@ void                     gt_gff3_in_stream_set_offset(GtNodeStream*, GtWord);
 int                      gt_gff3_in_stream_set_offsetfile(GtNodeStream*, GtStr*,
                                                           GtError*);
 void                     gt_gff3_in_stream_disable_add_ids(GtNodeStream*);
+/* Allocate the parsed feature nodes from a <GtGenomeNodeArena>, which saves
+   many small allocations for large annotations. */
+void                     gt_gff3_in_stream_enable_node_arena(GtNodeStream*);
 void                     gt_gff3_in_stream_fix_region_boundaries(
                                                                GtGFF3InStream*);
 
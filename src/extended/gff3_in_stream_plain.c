@@ -18,12 +18,20 @@
 #include <string.h>
 #include "core/assert_api.h"
 #include "core/class_alloc_lock.h"
+#include "core/cstr_api.h"
 #include "core/cstr_table.h"
 #include "core/fileutils_api.h"
+#include "core/hashmap_api.h"
+#include "core/ma_api.h"
+#include "core/multithread_api.h"
 #include "core/queue.h"
 #include "core/progressbar.h"
 #include "core/str_array.h"
+#include "core/thread_api.h"
+#include "core/unused_api.h"
+#include "core/warning_api.h"
 #include "extended/genome_node.h"
+#include "extended/gff3_defines.h"
 #include "extended/gff3_in_stream_plain.h"
 #include "extended/gff3_parser.h"
 #include "extended/node_stream_api.h"
@@ -37,9 +45,22 @@ struct GtGFF3InStreamPlain {
        stdin_argument,
        stdin_processed,
        file_is_open,
-       progress_bar;
-  GtFile *fpin;
-  GtUint64 line_number;
+       progress_bar,
+       chunked,          /* the current file is parsed in chunks in parallel */
+       input_exhausted,  /* the current file has been read completely */
+       batch_last,       /* <batch_file> ends the current file */
+       has_next_line,    /* <next_line> has been read but not been chunked */
+       terminated,       /* the last chunked line is a terminator */
+       region_has_ids;   /* <region_ids> is not empty */
+  GtFile *fpin,
+         *batch_file;    /* a batch of chunks which is parsed sequentially */
+  GtStr *next_line,
+        *last_seqid;     /* of the last chunked feature line */
+  GtHashmap *region_ids; /* maps the ID and Parent values since the last
+                            terminator to the first line they occur on */
+  GtUint64 line_number,
+           batch_line_number,
+           last_terminator;
   GtQueue *genome_node_buffer;
   GtGFF3Parser *gff3_parser;
   GtCstrTable *used_types;
@@ -71,6 +92,469 @@ static int buffer_is_sorted(void **elem, void *info, GtError *err)
   return 0;
 }
 
+/* Chunks are cut after a terminator line or before a change of the sequence
+   id following this many bytes. */
+#define GT_GFF3_IN_STREAM_CHUNK_SIZE      (256 * 1024)
+/* Chunks are cut before any line following this many bytes. */
+#define GT_GFF3_IN_STREAM_MAX_CHUNK_SIZE  (4 * GT_GFF3_IN_STREAM_CHUNK_SIZE)
+
+typedef struct {
+  GtStr *text,
+        *filenamestr;
+  GtUint64 line_number,     /* number of lines in the file before the chunk */
+           last_terminator; /* line number of the last terminator before it */
+  bool barrier, /* subsequent chunks depend on the parser state after it */
+       last;    /* the chunk ends the file */
+  GtGFF3Parser *parser;
+  GtQueue *parse_buffer,
+          *genome_nodes;
+  GtCstrTable *used_types;
+  GtError *err;
+  int had_err;
+} GFF3Chunk;
+
+typedef struct {
+  GFF3Chunk *chunks;
+  GtUword num_of_chunks,
+          allocated_chunks,
+          next_chunk,
+          num_of_warnings;
+  GtMutex *mutex;
+} GFF3Batch;
+
+static GFF3Chunk* gff3_in_stream_plain_add_chunk(GtGFF3InStreamPlain *is,
+                                                 GFF3Batch *batch)
+{
+  GFF3Chunk *chunk;
+  gt_assert(is && batch);
+  if (batch->num_of_chunks == batch->allocated_chunks) {
+    batch->allocated_chunks += gt_jobs;
+    batch->chunks = gt_realloc(batch->chunks, sizeof *batch->chunks *
+                                              batch->allocated_chunks);
+  }
+  chunk = batch->chunks + batch->num_of_chunks++;
+  memset(chunk, 0, sizeof *chunk);
+  chunk->text = gt_str_new();
+  chunk->line_number = is->line_number;
+  chunk->last_terminator = is->last_terminator;
+  /* the first lines of a file determine the mode of the parser */
+  chunk->barrier = is->line_number == 0;
+  return chunk;
+}
+
+/* Append the chunks following the one which contains line <line_number> to
+   it and return it. */
+static GFF3Chunk* gff3_in_stream_plain_join_chunks(GFF3Batch *batch,
+                                                   GtUint64 line_number)
+{
+  GFF3Chunk *chunk;
+  GtUword i = batch->num_of_chunks - 1, j;
+  while (batch->chunks[i].line_number >= line_number) {
+    gt_assert(i > 0);
+    i--;
+  }
+  chunk = batch->chunks + i;
+  for (j = i + 1; j < batch->num_of_chunks; j++) {
+    gt_str_append_str(chunk->text, batch->chunks[j].text);
+    chunk->barrier = chunk->barrier || batch->chunks[j].barrier;
+    gt_str_delete(batch->chunks[j].text);
+  }
+  batch->num_of_chunks = i + 1;
+  return chunk;
+}
+
+/* Add the ID or Parent <value> of the current line to <is->region_ids>. If it
+   occurs in a previous chunk of the batch already, the chunks in between are
+   joined, because the parser has to relate the lines. Returns the current
+   chunk. */
+static GFF3Chunk* gff3_in_stream_plain_add_id(GtGFF3InStreamPlain *is,
+                                              GFF3Batch *batch,
+                                              GFF3Chunk *chunk,
+                                              const char *value,
+                                              GtUword length, GtStr *buf)
+{
+  GtUword first_line;
+  gt_str_reset(buf);
+  gt_str_append_cstr_nt(buf, value, length);
+  first_line = (GtUword) gt_hashmap_get(is->region_ids, gt_str_get(buf));
+  if (!first_line) {
+    gt_hashmap_add(is->region_ids, gt_cstr_dup(gt_str_get(buf)),
+                   (void*) (GtUword) is->line_number);
+    is->region_has_ids = true;
+  }
+  else if (first_line <= chunk->line_number)
+    chunk = gff3_in_stream_plain_join_chunks(batch, first_line);
+  return chunk;
+}
+
+/* Add the ID and Parent values of the feature <line> to <is->region_ids>. The
+   values are taken as they are, like by the parser. */
+static GFF3Chunk* gff3_in_stream_plain_add_ids(GtGFF3InStreamPlain *is,
+                                               GFF3Batch *batch,
+                                               GFF3Chunk *chunk,
+                                               const char *line, GtStr *buf)
+{
+  const char *attr;
+  unsigned int column;
+  /* skip to the attribute column */
+  for (column = 0; column < 8U && line; column++) {
+    if ((line = strchr(line, '\t')))
+      line++;
+  }
+  if (!line)
+    return chunk;
+  attr = line;
+  while (*attr != '\0' && *attr != '\t') {
+    GtUword length = strcspn(attr, ";\t");
+    const char *next = attr + length;
+    while (*attr == ' ')
+      attr++;
+    if (!strncmp(attr, GT_GFF_ID "=", strlen(GT_GFF_ID) + 1)) {
+      attr += strlen(GT_GFF_ID) + 1;
+      chunk = gff3_in_stream_plain_add_id(is, batch, chunk, attr, next - attr,
+                                          buf);
+    }
+    else if (!strncmp(attr, GT_GFF_PARENT "=", strlen(GT_GFF_PARENT) + 1)) {
+      attr += strlen(GT_GFF_PARENT) + 1;
+      while (attr < next) {
+        length = strcspn(attr, ",;\t");
+        chunk = gff3_in_stream_plain_add_id(is, batch, chunk, attr, length,
+                                            buf);
+        attr += length + (attr + length < next ? 1 : 0);
+      }
+    }
+    attr = *next == ';' ? next + 1 : next;
+  }
+  return chunk;
+}
+
+/* Return true if the current <chunk> should be cut before the next line. */
+static bool gff3_in_stream_plain_cut_chunk(const GtGFF3InStreamPlain *is,
+                                           const GFF3Chunk *chunk,
+                                           bool feature_line, bool new_seqid)
+{
+  GtUword length = gt_str_length(chunk->text);
+  /* a chunk which changes the parser state ends its batch, therefore it can
+     only be cut where no later line can refer to its features */
+  if (chunk->barrier)
+    return length > 0 && feature_line && !is->region_has_ids;
+  return length >= GT_GFF3_IN_STREAM_MAX_CHUNK_SIZE ||
+         (length >= GT_GFF3_IN_STREAM_CHUNK_SIZE &&
+          (is->terminated || new_seqid));
+}
+
+/* Read the next batch of chunks of <is->fpin> into <batch>. It contains at
+   least <gt_jobs> chunks, unless a chunk changes the parser state or the file
+   ends. As the lines of a batch are parsed without the state of the previous
+   batches, a batch only ends where no later line can refer to a feature of
+   it. Chunks are only kept apart if none of their lines refer to each other
+   via ID and Parent attributes. */
+static void gff3_in_stream_plain_read_batch(GtGFF3InStreamPlain *is,
+                                            GFF3Batch *batch)
+{
+  GFF3Chunk *chunk;
+  GtStr *buf = gt_str_new();
+  GtUword line_length;
+  char *line;
+  gt_assert(is && is->fpin && batch);
+  chunk = gff3_in_stream_plain_add_chunk(is, batch);
+  for (;;) {
+    GtUword seqid_length = 0;
+    bool feature_line, new_seqid;
+    if (is->has_next_line) {
+      line = gt_str_get(is->next_line);
+      line_length = gt_str_length(is->next_line);
+      is->has_next_line = false;
+    }
+    else if (gt_file_xread_line(is->fpin, &line, &line_length) == EOF) {
+      /* an unterminated last line is ignored by the parser, too */
+      chunk->last = true;
+      is->input_exhausted = true;
+      break;
+    }
+    if (line[0] == '>' || !strncmp(line, GT_GFF_FASTA_DIRECTIVE,
+                                   strlen(GT_GFF_FASTA_DIRECTIVE))) {
+      /* the rest of the file is a FASTA section, keep it as is */
+      char fastabuf[BUFSIZ];
+      int len;
+      is->line_number++;
+      gt_str_append_cstr_nt(chunk->text, line, line_length);
+      gt_str_append_char(chunk->text, '\n');
+      while ((len = gt_file_xread(is->fpin, fastabuf, sizeof fastabuf)) > 0)
+        gt_str_append_cstr_nt(chunk->text, fastabuf, len);
+      chunk->last = true;
+      is->input_exhausted = true;
+      break;
+    }
+    feature_line = line_length > 0 && line[0] != '#';
+    if (feature_line)
+      seqid_length = strcspn(line, "\t");
+    new_seqid = feature_line &&
+                (seqid_length != gt_str_length(is->last_seqid) ||
+                 strncmp(line, gt_str_get(is->last_seqid), seqid_length));
+    if (gff3_in_stream_plain_cut_chunk(is, chunk, feature_line, new_seqid)) {
+      if (!is->region_has_ids &&
+          (chunk->barrier || batch->num_of_chunks >= gt_jobs)) {
+        /* the line starts the next batch */
+        if (line != gt_str_get(is->next_line)) {
+          gt_str_reset(is->next_line);
+          gt_str_append_cstr_nt(is->next_line, line, line_length);
+        }
+        is->has_next_line = true;
+        break;
+      }
+      chunk = gff3_in_stream_plain_add_chunk(is, batch);
+    }
+    is->line_number++;
+    gt_str_append_cstr_nt(chunk->text, line, line_length);
+    gt_str_append_char(chunk->text, '\n');
+    if (!strncmp(line, GT_GFF_SEQUENCE_REGION, strlen(GT_GFF_SEQUENCE_REGION))
+        || !strncmp(line, GT_GVF_VERSION_PREFIX, strlen(GT_GVF_VERSION_PREFIX))
+        || strstr(line, GT_GFF_IS_CIRCULAR)) {
+      chunk->barrier = true;
+    }
+    is->terminated = !strncmp(line, GT_GFF_TERMINATOR,
+                              strlen(GT_GFF_TERMINATOR));
+    if (is->terminated) {
+      /* the parser forgets all IDs at a terminator */
+      gt_hashmap_reset(is->region_ids);
+      is->region_has_ids = false;
+      is->last_terminator = is->line_number;
+    }
+    else if (feature_line) {
+      if (new_seqid) {
+        gt_str_reset(is->last_seqid);
+        gt_str_append_cstr_nt(is->last_seqid, line, seqid_length);
+      }
+      chunk = gff3_in_stream_plain_add_ids(is, batch, chunk, line, buf);
+    }
+  }
+  gt_str_delete(buf);
+}
+
+static void gff3_in_stream_plain_count_warning(void *data,
+                                               GT_UNUSED const char *format,
+                                               GT_UNUSED va_list ap)
+{
+  GFF3Batch *batch = data;
+  gt_mutex_lock(batch->mutex);
+  batch->num_of_warnings++;
+  gt_mutex_unlock(batch->mutex);
+}
+
+/* Parse chunks of <data> until none is left, the nodes are released in the
+   same way as by gff3_in_stream_plain_next(). */
+static void* gff3_in_stream_plain_parse_chunks(void *data)
+{
+  GFF3Batch *batch = data;
+  GFF3Chunk *chunk;
+  GtFile *file;
+  GtUint64 line_number;
+  char *buf;
+  int status_code;
+
+  for (;;) {
+    gt_mutex_lock(batch->mutex);
+    if (batch->next_chunk == batch->num_of_chunks) {
+      gt_mutex_unlock(batch->mutex);
+      return NULL;
+    }
+    chunk = batch->chunks + batch->next_chunk++;
+    gt_mutex_unlock(batch->mutex);
+
+    /* the parser modifies the lines in place, keep the text intact */
+    buf = gt_malloc(gt_str_length(chunk->text) + 1);
+    memcpy(buf, gt_str_get(chunk->text), gt_str_length(chunk->text));
+    file = gt_file_new_from_buffer(buf, gt_str_length(chunk->text));
+    line_number = chunk->line_number;
+    for (;;) {
+      while (gt_queue_size(chunk->parse_buffer) > 1)
+        gt_queue_add(chunk->genome_nodes, gt_queue_get(chunk->parse_buffer));
+      chunk->had_err = gt_gff3_parser_parse_genome_nodes(chunk->parser,
+                                                         &status_code,
+                                                         chunk->parse_buffer,
+                                                         chunk->used_types,
+                                                         chunk->filenamestr,
+                                                         &line_number, file,
+                                                         chunk->err);
+      if (!chunk->had_err && status_code != EOF) {
+        chunk->had_err =
+          gt_gff3_parser_parse_genome_nodes(chunk->parser, &status_code,
+                                            chunk->parse_buffer,
+                                            chunk->used_types,
+                                            chunk->filenamestr, &line_number,
+                                            file, chunk->err);
+      }
+      if (chunk->had_err || status_code == EOF)
+        break;
+      gt_queue_add(chunk->genome_nodes, gt_queue_get(chunk->parse_buffer));
+    }
+    gt_file_delete(file);
+  }
+  return NULL;
+}
+
+static void gff3_in_stream_plain_add_used_types(GtCstrTable *used_types,
+                                                const GtCstrTable *chunk_types)
+{
+  GtStrArray *types = gt_cstr_table_get_all(chunk_types);
+  GtUword i;
+  for (i = 0; i < gt_str_array_size(types); i++) {
+    if (!gt_cstr_table_get(used_types, gt_str_array_get(types, i)))
+      gt_cstr_table_add(used_types, gt_str_array_get(types, i));
+  }
+  gt_str_array_delete(types);
+}
+
+/* Read up to <gt_jobs> chunks from <is->fpin> and parse them in parallel. If
+   this causes any warning or error, the chunks are parsed again sequentially
+   from <is->batch_file>, to report them exactly as without chunks. */
+static int gff3_in_stream_plain_parse_batch(GtGFF3InStreamPlain *is,
+                                            GtStr *filenamestr, GtError *err)
+{
+  GtWarningHandler warning_handler;
+  void *warning_data;
+  GFF3Batch batch;
+  GFF3Chunk *chunk;
+  GtUword i;
+  bool failed = false;
+  int had_err;
+
+  gt_error_check(err);
+  gt_assert(is && is->chunked && !is->batch_file && !is->input_exhausted);
+
+  /* split */
+  batch.chunks = NULL;
+  batch.num_of_chunks = batch.allocated_chunks = 0;
+  gff3_in_stream_plain_read_batch(is, &batch);
+  for (i = 0; i < batch.num_of_chunks; i++) {
+    chunk = batch.chunks + i;
+    chunk->filenamestr = gt_str_clone(filenamestr);
+    chunk->parser = gt_gff3_parser_new_chunk_parser(is->gff3_parser,
+                                                    chunk->last_terminator,
+                                                    chunk->last);
+    chunk->parse_buffer = gt_queue_new();
+    chunk->genome_nodes = gt_queue_new();
+    chunk->used_types = gt_cstr_table_new();
+    chunk->err = gt_error_new();
+  }
+
+  /* parse */
+  batch.next_chunk = 0;
+  batch.num_of_warnings = 0;
+  batch.mutex = gt_mutex_new();
+  warning_handler = gt_warning_get_handler();
+  warning_data = gt_warning_get_data();
+  gt_warning_set_handler(gff3_in_stream_plain_count_warning, &batch);
+  had_err = gt_multithread(gff3_in_stream_plain_parse_chunks, &batch, err);
+  gt_warning_set_handler(warning_handler, warning_data);
+  gt_mutex_delete(batch.mutex);
+
+  if (!had_err) {
+    failed = batch.num_of_warnings > 0;
+    for (i = 0; !failed && i < batch.num_of_chunks; i++)
+      failed = batch.chunks[i].had_err ? true : false;
+  }
+  if (!had_err && !failed) {
+    for (i = 0; i < batch.num_of_chunks; i++) {
+      chunk = batch.chunks + i;
+      gt_assert(!gt_queue_size(chunk->parse_buffer));
+      while (gt_queue_size(chunk->genome_nodes)) {
+        gt_queue_add(is->genome_node_buffer,
+                     gt_queue_get(chunk->genome_nodes));
+      }
+      gff3_in_stream_plain_add_used_types(is->used_types, chunk->used_types);
+    }
+    chunk = batch.chunks + batch.num_of_chunks - 1;
+    if (chunk->barrier) {
+      gt_gff3_parser_delete(is->gff3_parser);
+      is->gff3_parser = chunk->parser;
+      chunk->parser = NULL;
+    }
+  }
+  else if (!had_err) {
+    GtStr *text = batch.chunks[0].text;
+    GtGFF3Parser *parser;
+    char *buf;
+    for (i = 1; i < batch.num_of_chunks; i++)
+      gt_str_append_str(text, batch.chunks[i].text);
+    buf = gt_malloc(gt_str_length(text) + 1);
+    memcpy(buf, gt_str_get(text), gt_str_length(text));
+    is->batch_file = gt_file_new_from_buffer(buf, gt_str_length(text));
+    is->batch_line_number = batch.chunks[0].line_number;
+    is->batch_last = batch.chunks[batch.num_of_chunks-1].last;
+    parser = gt_gff3_parser_new_chunk_parser(is->gff3_parser,
+                                             batch.chunks[0].last_terminator,
+                                             is->batch_last);
+    gt_gff3_parser_delete(is->gff3_parser);
+    is->gff3_parser = parser;
+  }
+
+  for (i = 0; i < batch.num_of_chunks; i++) {
+    chunk = batch.chunks + i;
+    while (gt_queue_size(chunk->genome_nodes))
+      gt_genome_node_delete(gt_queue_get(chunk->genome_nodes));
+    while (gt_queue_size(chunk->parse_buffer))
+      gt_genome_node_delete(gt_queue_get(chunk->parse_buffer));
+    gt_queue_delete(chunk->genome_nodes);
+    gt_queue_delete(chunk->parse_buffer);
+    gt_cstr_table_delete(chunk->used_types);
+    gt_gff3_parser_delete(chunk->parser);
+    gt_error_delete(chunk->err);
+    gt_str_delete(chunk->filenamestr);
+    gt_str_delete(chunk->text);
+  }
+  gt_free(batch.chunks);
+  return had_err;
+}
+
+/* Like two calls of gt_gff3_parser_parse_genome_nodes() on the current file,
+   but the file is parsed batchwise by gff3_in_stream_plain_parse_batch(). */
+static int gff3_in_stream_plain_parse_chunked(GtGFF3InStreamPlain *is,
+                                              int *status_code,
+                                              GtStr *filenamestr, GtError *err)
+{
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(is && is->chunked && status_code);
+  for (;;) {
+    if (is->batch_file) {
+      had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser, status_code,
+                                                  is->genome_node_buffer,
+                                                  is->used_types, filenamestr,
+                                                  &is->batch_line_number,
+                                                  is->batch_file, err);
+      if (!had_err && *status_code != EOF) {
+        had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser,
+                                                    status_code,
+                                                    is->genome_node_buffer,
+                                                    is->used_types,
+                                                    filenamestr,
+                                                    &is->batch_line_number,
+                                                    is->batch_file, err);
+      }
+      if (had_err || *status_code != EOF)
+        return had_err;
+      gt_file_delete(is->batch_file);
+      is->batch_file = NULL;
+      if (is->batch_last)
+        return had_err;
+    }
+    else if (gt_queue_size(is->genome_node_buffer)) {
+      *status_code = 0;
+      return had_err;
+    }
+    else if (is->input_exhausted) {
+      *status_code = EOF;
+      return had_err;
+    }
+    else if ((had_err = gff3_in_stream_plain_parse_batch(is, filenamestr,
+                                                         err))) {
+      return had_err;
+    }
+  }
+}
+
 static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
                                      GtError *err)
 {
@@ -121,6 +605,17 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
         is->file_is_open = true;
       }
       is->line_number = 0;
+      is->input_exhausted = false;
+      is->has_next_line = false;
+      is->terminated = false;
+      is->region_has_ids = false;
+      is->last_terminator = 0;
+      gt_str_reset(is->last_seqid);
+      gt_hashmap_reset(is->region_ids);
+#ifdef GT_THREADS_ENABLED
+      is->chunked = is->fpin && gt_jobs > 1 && !is->ensure_sorting &&
+                    gt_gff3_parser_chunks_possible(is->gff3_parser);
+#endif
 
       if (!had_err && is->progress_bar) {
         printf("processing file \"%s\"\n", gt_str_array_size(is->files)
@@ -139,21 +634,32 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
                   ? gt_str_array_get_str(is->files, is->next_file-1)
                   : is->stdinstr;
     /* read two nodes */
-    had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser, &status_code,
-                                                is->genome_node_buffer,
-                                                is->used_types, filenamestr,
-                                                &is->line_number, is->fpin,
-                                                err);
-    if (had_err)
-      break;
-    if (status_code != EOF) {
-      had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser, &status_code,
+    if (is->chunked) {
+      had_err = gff3_in_stream_plain_parse_chunked(is, &status_code,
+                                                   filenamestr, err);
+      if (had_err)
+        break;
+    }
+    else {
+      had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser,
+                                                  &status_code,
                                                   is->genome_node_buffer,
                                                   is->used_types, filenamestr,
                                                   &is->line_number, is->fpin,
                                                   err);
       if (had_err)
         break;
+      if (status_code != EOF) {
+        had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser,
+                                                    &status_code,
+                                                    is->genome_node_buffer,
+                                                    is->used_types,
+                                                    filenamestr,
+                                                    &is->line_number,
+                                                    is->fpin, err);
+        if (had_err)
+          break;
+      }
     }
 
     if (status_code == EOF) {
@@ -204,6 +710,10 @@ static void gff3_in_stream_plain_free(GtNodeStream *ns)
   gt_gff3_parser_delete(gff3_in_stream_plain->gff3_parser);
   gt_cstr_table_delete(gff3_in_stream_plain->used_types);
   gt_file_delete(gff3_in_stream_plain->fpin);
+  gt_file_delete(gff3_in_stream_plain->batch_file);
+  gt_str_delete(gff3_in_stream_plain->next_line);
+  gt_str_delete(gff3_in_stream_plain->last_seqid);
+  gt_hashmap_delete(gff3_in_stream_plain->region_ids);
 }
 
 const GtNodeStreamClass* gt_gff3_in_stream_plain_class(void)
@@ -232,6 +742,11 @@ static GtNodeStream* gff3_in_stream_plain_new(GtStrArray *files,
   gff3_in_stream_plain->genome_node_buffer  = gt_queue_new();
   gff3_in_stream_plain->gff3_parser         = gt_gff3_parser_new(NULL);
   gff3_in_stream_plain->used_types          = gt_cstr_table_new();
+  gff3_in_stream_plain->next_line           = gt_str_new();
+  gff3_in_stream_plain->last_seqid          = gt_str_new();
+  gff3_in_stream_plain->region_ids          = gt_hashmap_new(GT_HASH_STRING,
+                                                             gt_free_func,
+                                                             NULL);
   return ns;
 }
 
@@ -305,6 +820,13 @@ void gt_gff3_in_stream_plain_enable_strict_mode(GtNodeStream *ns)
   gt_gff3_parser_enable_strict_mode(is->gff3_parser);
 }
 
+void gt_gff3_in_stream_plain_enable_node_arena(GtNodeStream *ns)
+{
+  GtGFF3InStreamPlain *is = gff3_in_stream_plain_cast(ns);
+  gt_assert(is);
+  gt_gff3_parser_enable_node_arena(is->gff3_parser);
+}
+
 void gt_gff3_in_stream_plain_enable_tidy_mode(GtNodeStream *ns)
 {
   GtGFF3InStreamPlain *is = gff3_in_stream_plain_cast(ns);
@@ -66,6 +66,8 @@ struct GtGFF3Parser {
   GtOrphanage *orphanage;
   GtTypeChecker *type_checker;
   GtXRFChecker *xrf_checker;
+  GtFile *stdin_file; /* buffered stdin, used if no file pointer is given */
+  GtGenomeNodeArena *node_arena; /* created on demand */
   unsigned int last_terminator; /* line number of the last terminator */
 };
 
@@ -113,6 +115,56 @@ GtGFF3Parser* gt_gff3_parser_new(GtTypeChecker *type_checker)
   return parser;
 }
 
+static int copy_simple_sequence_region(void *key, void *value, void *data,
+                                       GT_UNUSED GtError *err)
+{
+  SimpleSequenceRegion *ssr = value, *copy;
+  GtHashmap *seqid_to_ssr_mapping = data;
+  gt_error_check(err);
+  gt_assert(key && ssr && seqid_to_ssr_mapping);
+  copy = simple_sequence_region_new(key, ssr->range, ssr->line_number);
+  copy->pseudo = ssr->pseudo;
+  copy->is_circular = ssr->is_circular;
+  gt_hashmap_add(seqid_to_ssr_mapping, gt_str_get(copy->seqid_str), copy);
+  return 0;
+}
+
+GtGFF3Parser* gt_gff3_parser_new_chunk_parser(GtGFF3Parser *parser,
+                                              unsigned int last_terminator,
+                                              bool last_chunk)
+{
+  GtGFF3Parser *chunk_parser;
+  GT_UNUSED int had_err;
+  gt_assert(parser && gt_gff3_parser_chunks_possible(parser));
+  chunk_parser = gt_gff3_parser_new(parser->type_checker);
+  if (parser->xrf_checker)
+    gt_gff3_parser_set_xrf_checker(chunk_parser, parser->xrf_checker);
+  chunk_parser->checkids = parser->checkids;
+  chunk_parser->checkregions = parser->checkregions;
+  chunk_parser->strict = parser->strict;
+  chunk_parser->tidy = parser->tidy;
+  chunk_parser->gvf_mode = parser->gvf_mode;
+  chunk_parser->offset = parser->offset;
+  if (parser->node_arena)
+    gt_gff3_parser_enable_node_arena(chunk_parser);
+  /* the sequence regions are copied (instead of shared) to keep the reference
+     counts of the sequence id strings local to the chunk */
+  had_err = gt_hashmap_foreach(parser->seqid_to_ssr_mapping,
+                               copy_simple_sequence_region,
+                               chunk_parser->seqid_to_ssr_mapping, NULL);
+  gt_assert(!had_err); /* copy_simple_sequence_region() is sane */
+  chunk_parser->last_terminator = last_terminator;
+  /* only the last chunk of a file ends with an EOF node */
+  chunk_parser->eof_emitted = !last_chunk;
+  return chunk_parser;
+}
+
+bool gt_gff3_parser_chunks_possible(const GtGFF3Parser *parser)
+{
+  gt_assert(parser);
+  return !parser->checkids && !parser->offset_mapping;
+}
+
 void gt_gff3_parser_set_xrf_checker(GtGFF3Parser *parser,
                                     GtXRFChecker *xrf_checker)
 {
@@ -179,6 +231,13 @@ void gt_gff3_parser_enable_tidy_mode(GtGFF3Parser *parser)
   parser->tidy = true;
 }
 
+void gt_gff3_parser_enable_node_arena(GtGFF3Parser *parser)
+{
+  gt_assert(parser);
+  if (!parser->node_arena)
+    parser->node_arena = gt_genome_node_arena_new();
+}
+
 static int offset_possible(const GtRange *range, GtWord offset,
                            const char *filename, unsigned int line_number,
                            GtError *err)
@@ -1614,8 +1673,9 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
 
   /* create the feature */
   if (!had_err) {
-    feature_node = gt_feature_node_new(seqid_str, type, range.start, range.end,
-                                       gt_strand_value);
+    feature_node = gt_feature_node_new_in_arena(parser->node_arena, seqid_str,
+                                                type, range.start, range.end,
+                                                gt_strand_value);
     gt_genome_node_set_origin(feature_node, filenamestr, line_number);
   }
 
@@ -1744,6 +1804,8 @@ static int gff3_parser_parse_fasta_entry(GtQueue *genome_nodes,
   if (!had_err) {
     GtGenomeNode *sequence_node;
     GtStr *sequence = gt_str_new();
+    /* <line> points into the read buffer of <fpin>, save it before reading on */
+    char *description = gt_cstr_dup(line+1);
     int cc;
     while ((cc = gt_file_xfgetc(fpin)) != EOF) {
       if (cc == '>') {
@@ -1753,10 +1815,11 @@ static int gff3_parser_parse_fasta_entry(GtQueue *genome_nodes,
       if (cc != '\n' && cc != '\r' && cc != ' ')
         gt_str_append_char(sequence, cc);
     }
-    sequence_node = gt_sequence_node_new(line+1, sequence);
+    sequence_node = gt_sequence_node_new(description, sequence);
     gt_genome_node_set_origin(sequence_node, filename, line_number);
     gt_queue_add(genome_nodes, sequence_node);
     gt_str_delete(sequence);
+    gt_free(description);
   }
   return had_err;
 }
@@ -2109,8 +2172,7 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
                                       GtUint64 *line_number,
                                       GtFile *fpin, GtError *err)
 {
-  size_t line_length;
-  GtStr *line_buffer;
+  GtUword line_length;
   char *line;
   const char *filename;
   int rval, had_err = 0;
@@ -2119,13 +2181,15 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
   gt_assert(status_code && genome_nodes && used_types);
 
   filename = gt_str_get(filenamestr);
+  if (!fpin) {
+    /* the read buffer has to persist between calls */
+    if (!parser->stdin_file)
+      parser->stdin_file = gt_file_xopen(NULL, "r");
+    fpin = parser->stdin_file;
+  }
 
-  /* init */
-  line_buffer = gt_str_new();
-
-  while ((rval = gt_str_read_next_line_generic(line_buffer, fpin)) != EOF) {
-    line = gt_str_get(line_buffer);
-    line_length = gt_str_length(line_buffer);
+  /* the lines are parsed in place in the read buffer of <fpin> */
+  while ((rval = gt_file_xread_line(fpin, &line, &line_length)) != EOF) {
     (*line_number)++;
 
     if (*line_number == 1) {
@@ -2135,7 +2199,6 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
       if (had_err == -1) /* error */
         break;
       if (had_err == 1) { /* line processed */
-        gt_str_reset(line_buffer);
         had_err = 0;
         continue;
       }
@@ -2166,7 +2229,6 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
       if (had_err || (!parser->incomplete_node && gt_queue_size(genome_nodes)))
         break;
     }
-    gt_str_reset(line_buffer);
   }
 
   if (!had_err && rval == EOF && *line_number == 0) {
@@ -2195,7 +2257,6 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
     parser->eof_emitted = true;
   }
 
-  gt_str_delete(line_buffer);
   if (gt_queue_size(genome_nodes))
     *status_code = 0; /* at least one node was created */
   else
@@ -2225,5 +2286,7 @@ void gt_gff3_parser_delete(GtGFF3Parser *parser)
   gt_orphanage_delete(parser->orphanage);
   gt_type_checker_delete(parser->type_checker);
   gt_xrf_checker_delete(parser->xrf_checker);
+  gt_file_delete(parser->stdin_file);
+  gt_genome_node_arena_delete(parser->node_arena);
   gt_free(parser);
 }
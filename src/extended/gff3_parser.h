@@ -21,6 +21,23 @@
 #include "extended/gff3_parser_api.h"
 
 void gt_gff3_parser_enable_strict_mode(GtGFF3Parser*);
+/* Allocate the feature nodes created by <parser> from a
+   <GtGenomeNodeArena>. */
+void gt_gff3_parser_enable_node_arena(GtGFF3Parser *parser);
+/* Return <true> if the input of <parser> can be split into chunks directly
+   after terminator lines, which are then parsed independently of each other
+   (i.e., ID attributes are not checked across terminators and no offset file
+   is used). */
+bool gt_gff3_parser_chunks_possible(const GtGFF3Parser *parser);
+/* Return a new parser for a chunk of input which directly follows the input
+   parsed by <parser> so far. The chunk must start at the beginning of a file
+   (<last_terminator> is 0) or directly after the terminator line
+   <last_terminator>. The settings, checkers, and sequence regions of <parser>
+   are taken over. Only if <last_chunk> is <true> an EOF node is created at the
+   end of the chunk. */
+GtGFF3Parser* gt_gff3_parser_new_chunk_parser(GtGFF3Parser *parser,
+                                              unsigned int last_terminator,
+                                              bool last_chunk);
 int  gt_gff3_parser_set_offsetfile(GtGFF3Parser*, GtStr*, GtError*);
 int  gt_gff3_parser_parse_target_attributes(const char *values,
                                             GtUword *num_of_targets,
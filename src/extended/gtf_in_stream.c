@@ -32,7 +32,8 @@ struct GtGTFInStream {
   GtTypeChecker *type_checker;
   char *filename;
   bool file_processed,
-       tidy;
+       tidy,
+       node_arena;
 };
 
 #define gtf_in_stream_cast(NS)\
@@ -49,6 +50,8 @@ static int gtf_in_stream_process_file(GtGTFInStream *gtf_in_stream,
   gt_assert(gtf_in_stream);
 
   gtf_parser = gt_gtf_parser_new(gtf_in_stream->type_checker);
+  if (gtf_in_stream->node_arena)
+    gt_gtf_parser_enable_node_arena(gtf_parser);
 
   /* open input file */
   if (gtf_in_stream->filename) {
@@ -139,3 +142,9 @@ void gt_gtf_in_stream_enable_tidy_mode(GtNodeStream *ns)
   GtGTFInStream *is = gtf_in_stream_cast(ns);
   is->tidy = true;
 }
+
+void gt_gtf_in_stream_enable_node_arena(GtNodeStream *ns)
+{
+  GtGTFInStream *is = gtf_in_stream_cast(ns);
+  is->node_arena = true;
+}
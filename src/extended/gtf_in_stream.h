@@ -22,5 +22,7 @@
 
 const GtNodeStreamClass* gt_gtf_in_stream_class(void);
 void                     gt_gtf_in_stream_enable_tidy_mode(GtNodeStream*);
+/* Allocate the parsed feature nodes from a <GtGenomeNodeArena>. */
+void                     gt_gtf_in_stream_enable_node_arena(GtNodeStream*);
 
 #endif
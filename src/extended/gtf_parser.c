@@ -49,6 +49,7 @@ struct GtGTFParser {
             *transcript_id_to_name_mapping;
   GtRegionNodeBuilder *region_node_builder;
   GtTypeChecker *type_checker;
+  GtGenomeNodeArena *node_arena; /* created on demand */
 };
 
 typedef struct {
@@ -56,6 +57,7 @@ typedef struct {
   GtArray *mRNAs;
   GtHashmap *gene_id_to_name_mapping,
             *transcript_id_to_name_mapping;
+  GtGenomeNodeArena *node_arena;
   bool tidy;
 } ConstructionInfo;
 
@@ -109,9 +111,17 @@ GtGTFParser* gt_gtf_parser_new(GtTypeChecker *type_checker)
                                                          gt_free_func);
   parser->region_node_builder = gt_region_node_builder_new();
   parser->type_checker = type_checker;
+  parser->node_arena = NULL;
   return parser;
 }
 
+void gt_gtf_parser_enable_node_arena(GtGTFParser *parser)
+{
+  gt_assert(parser);
+  if (!parser->node_arena)
+    parser->node_arena = gt_genome_node_arena_new();
+}
+
 static int construct_mRNAs(GT_UNUSED void *key, void *value, void *data,
                            GtError *err)
 {
@@ -240,8 +250,9 @@ static int construct_mRNAs(GT_UNUSED void *key, void *value, void *data,
   }
 
   if (!had_err) {
-    mRNA_node = gt_feature_node_new(mRNA_seqid, gt_ft_mRNA, mRNA_range.start,
-                                    mRNA_range.end, mRNA_strand);
+    mRNA_node = gt_feature_node_new_in_arena(cinfo->node_arena, mRNA_seqid,
+                                             gt_ft_mRNA, mRNA_range.start,
+                                             mRNA_range.end, mRNA_strand);
     gt_feature_node_add_attribute(((GtFeatureNode*) mRNA_node), "ID", key);
     gt_feature_node_add_attribute(((GtFeatureNode*) mRNA_node), "transcript_id",
                                   key);
@@ -333,8 +344,9 @@ static int construct_genes(GT_UNUSED void *key, void *value, void *data,
   }
 
   if (!had_err) {
-    gene_node = gt_feature_node_new(gene_seqid, gt_ft_gene, gene_range.start,
-                                    gene_range.end, gene_strand);
+    gene_node = gt_feature_node_new_in_arena(cinfo->node_arena, gene_seqid,
+                                             gt_ft_gene, gene_range.start,
+                                             gene_range.end, gene_strand);
     gt_feature_node_add_attribute((GtFeatureNode*) gene_node, "ID", key);
     gt_feature_node_add_attribute((GtFeatureNode*) gene_node, "gene_id", key);
 
@@ -382,10 +394,10 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
                         GtStr *filenamestr, GtFile *fpin, bool be_tolerant,
                         GtError *err)
 {
-  GtStr *seqid_str, *source_str, *line_buffer;
+  GtStr *seqid_str, *source_str;
+  GtFile *stdin_file = NULL;
   char *line;
-  size_t line_length;
-  GtUword i, line_number = 0;
+  GtUword i, line_length, line_number = 0;
   GtGenomeNode *gn;
   GtRange range;
   GtPhase phase_value;
@@ -424,7 +436,8 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
   filename = gt_str_get(filenamestr);
 
   /* alloc */
-  line_buffer = gt_str_new();
+  if (!fpin)
+    fpin = stdin_file = gt_file_xopen(NULL, "r");
   splitter = gt_splitter_new(),
   attribute_splitter = gt_splitter_new();
 
@@ -433,7 +446,6 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
           if (be_tolerant) {                                           \
             fprintf(stderr, "skipping line: %s\n", gt_error_get(err)); \
             gt_error_unset(err);                                       \
-            gt_str_reset(line_buffer);                                 \
             had_err = 0;                                               \
             continue;                                                  \
           }                                                            \
@@ -443,9 +455,8 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
           }                                                            \
         }
 
-  while (gt_str_read_next_line_generic(line_buffer, fpin) != EOF) {
-    line = gt_str_get(line_buffer);
-    line_length = gt_str_length(line_buffer);
+  /* the lines are parsed in place in the read buffer of <fpin> */
+  while (gt_file_xread_line(fpin, &line, &line_length) != EOF) {
     line_number++;
     gene_name = gene_id = transcript_id = transcript_name = NULL;
     had_err = 0;
@@ -495,7 +506,6 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
         /* we skip unknown features */
         fprintf(stderr, "skipping line " GT_WU " in file \"%s\": unknown "
                 "feature: \"%s\"\n", line_number, filename, feature);
-        gt_str_reset(line_buffer);
         continue;
       }
 
@@ -515,7 +525,6 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
           break;
         case GTF_start_codon:
           /* we can skip the start codons, they are part of the CDS anyway */
-          gt_str_reset(line_buffer);
           continue;
       }
       gt_assert(gff_type_is_valid);
@@ -704,8 +713,9 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
       gt_assert(seqid_str);
 
       /* construct the new feature */
-      gn = gt_feature_node_new(seqid_str, type, range.start, range.end,
-                                 gt_strand_value);
+      gn = gt_feature_node_new_in_arena(parser->node_arena, seqid_str, type,
+                                        range.start, range.end,
+                                        gt_strand_value);
       gt_genome_node_set_origin(gn, filenamestr, line_number);
       if (stop_codon) {
         gt_feature_node_add_attribute((GtFeatureNode*) gn,
@@ -751,8 +761,6 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
         gt_feature_node_set_phase((GtFeatureNode*) gn, phase_value);
       gt_array_add(gt_genome_node_array, gn);
     }
-
-    gt_str_reset(line_buffer);
   }
 
   /* process all region nodes */
@@ -764,6 +772,7 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
   cinfo.tidy = be_tolerant;
   cinfo.gene_id_to_name_mapping = parser->gene_id_to_name_mapping;
   cinfo.transcript_id_to_name_mapping = parser->transcript_id_to_name_mapping;
+  cinfo.node_arena = parser->node_arena;
   if (!had_err) {
     had_err = gt_hashmap_foreach(parser->gene_id_hash, construct_genes,
                                  &cinfo, err);
@@ -773,7 +782,7 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
   /* free */
   gt_splitter_delete(splitter);
   gt_splitter_delete(attribute_splitter);
-  gt_str_delete(line_buffer);
+  gt_file_delete(stdin_file);
 
   return had_err;
 }
@@ -787,5 +796,6 @@ void gt_gtf_parser_delete(GtGTFParser *parser)
   gt_hashmap_delete(parser->source_to_str_mapping);
   gt_hashmap_delete(parser->transcript_id_to_name_mapping);
   gt_hashmap_delete(parser->gene_id_to_name_mapping);
+  gt_genome_node_arena_delete(parser->node_arena);
   gt_free(parser);
 }
@@ -37,6 +37,9 @@
 typedef struct GtGTFParser GtGTFParser;
 
 GtGTFParser* gt_gtf_parser_new(GtTypeChecker*);
+/* Allocate the feature nodes created by <parser> from a
+   <GtGenomeNodeArena>. */
+void         gt_gtf_parser_enable_node_arena(GtGTFParser *parser);
 int          gt_gtf_parser_parse(GtGTFParser*, GtQueue *genome_nodes,
                                  GtStr *filenamestr, GtFile*,
                                  bool be_tolerant, GtError*);
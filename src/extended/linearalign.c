@@ -36,6 +36,7 @@
 #include "extended/maxcoordvalue.h"
 #include "extended/reconstructalignment.h"
 #include "extended/squarealign.h"
+#include "extended/stripedalign.h"
 
 #include "extended/linearalign.h"
 #define LINEAR_EDIST_GAP          ((GtUchar) UCHAR_MAX)
@@ -645,7 +646,7 @@ GtWord gt_linearalign_compute_local_generic(GtLinspaceManagement *spacemanager,
   GtWord *Ltabcolumn,
          score = GT_WORD_MAX;
   GtUwordPair *Starttabcolumn;
-  GtUword ulen_part, ustart_part, vlen_part, vstart_part;
+  GtUword ulen_part, ustart_part, vlen_part, vstart_part, uend, vend;
   GtMaxcoordvalue *max;
 
   gt_assert(spacemanager && scorehandler && align);
@@ -678,6 +679,19 @@ GtWord gt_linearalign_compute_local_generic(GtLinspaceManagement *spacemanager,
                                                   scorehandler);
   }
 
+  if (gt_stripedalign_local_end(&score, &uend, &vend, scorehandler, false,
+                                useq, ustart, ulen, vseq, vstart, vlen))
+  {
+    if (score == 0)
+    {
+      /* empty alignment */
+      return 0;
+    }
+    /* the scores up to the first end of an optimal alignment, and hence
+       its start, do not depend on the rows and columns behind this end */
+    ulen = uend;
+    vlen = vend;
+  }
   gt_linspace_management_check_local(spacemanager,
                                      ulen, vlen,
                                      sizeof (*Ltabcolumn),
@@ -739,6 +753,99 @@ GtWord gt_linearalign_compute_local(GtLinspaceManagement *spacemanager,
   return score;
 }
 
+/*-------------------------------score only---------------------------------*/
+
+static GtUword gt_linearalign_global_distance_64(
+                                            const GtScoreHandler *scorehandler,
+                                            const GtUchar *useq,
+                                            GtUword ustart,
+                                            GtUword ulen,
+                                            const GtUchar *vseq,
+                                            GtUword vstart,
+                                            GtUword vlen)
+{
+  GtUword *EDtabcolumn, *Rtabcolumn, distance;
+
+  EDtabcolumn = gt_malloc(sizeof *EDtabcolumn * (ulen + 1));
+  Rtabcolumn = gt_malloc(sizeof *Rtabcolumn * (ulen + 1));
+  /* with the last column as midcolumn, no crosspoints are stored */
+  distance = evaluateallEDtabRtabcolumns(EDtabcolumn, Rtabcolumn, scorehandler,
+                                         vlen, useq, ustart, ulen,
+                                         vseq, vstart, vlen);
+  gt_free(EDtabcolumn);
+  gt_free(Rtabcolumn);
+  return distance;
+}
+
+GtUword gt_linearalign_global_distance_only(const GtScoreHandler *scorehandler,
+                                            const GtUchar *useq,
+                                            GtUword ustart,
+                                            GtUword ulen,
+                                            const GtUchar *vseq,
+                                            GtUword vstart,
+                                            GtUword vlen)
+{
+  GtWord distance;
+
+  gt_assert(scorehandler != NULL);
+  if (gt_stripedalign_score(&distance, scorehandler, true, false,
+                            useq, ustart, ulen, vseq, vstart, vlen))
+  {
+    return (GtUword) distance;
+  }
+  return gt_linearalign_global_distance_64(scorehandler, useq, ustart, ulen,
+                                           vseq, vstart, vlen);
+}
+
+static GtWord gt_linearalign_local_score_64(const GtScoreHandler *scorehandler,
+                                            const GtUchar *useq,
+                                            GtUword ustart,
+                                            GtUword ulen,
+                                            const GtUchar *vseq,
+                                            GtUword vstart,
+                                            GtUword vlen)
+{
+  GtWord *Ltabcolumn, score;
+  GtUwordPair *Starttabcolumn;
+  GtUword colindex;
+  GtMaxcoordvalue *max;
+
+  Ltabcolumn = gt_malloc(sizeof *Ltabcolumn * (ulen + 1));
+  Starttabcolumn = gt_malloc(sizeof *Starttabcolumn * (ulen + 1));
+  max = gt_maxcoordvalue_new();
+  firstLStabcolumn(Ltabcolumn, Starttabcolumn, ulen);
+  for (colindex = 1UL; colindex <= vlen; colindex++)
+  {
+    nextLStabcolumn(Ltabcolumn, Starttabcolumn, scorehandler,
+                    useq, ustart, ulen, vseq[vstart+colindex-1], colindex, max);
+  }
+  score = gt_maxcoordvalue_get_value(max);
+  gt_maxcoordvalue_delete(max);
+  gt_free(Ltabcolumn);
+  gt_free(Starttabcolumn);
+  return score;
+}
+
+GtWord gt_linearalign_local_score_only(const GtScoreHandler *scorehandler,
+                                       const GtUchar *useq,
+                                       GtUword ustart,
+                                       GtUword ulen,
+                                       const GtUchar *vseq,
+                                       GtUword vstart,
+                                       GtUword vlen)
+{
+  GtWord score;
+
+  gt_assert(scorehandler != NULL);
+  if (gt_stripedalign_score(&score, scorehandler, false, false,
+                            useq, ustart, ulen, vseq, vstart, vlen))
+  {
+    return score;
+  }
+  return gt_linearalign_local_score_64(scorehandler, useq, ustart, ulen,
+                                       vseq, vstart, vlen);
+}
+
 /*-----------------------------checkfunctions--------------------------------*/
 
 void gt_linearalign_check(GT_UNUSED bool forward,
@@ -748,7 +855,7 @@ void gt_linearalign_check(GT_UNUSED bool forward,
                           GtUword vlen)
 {
   GtAlignment *align;
-  GtUword edist1, edist2, edist3, edist4,
+  GtUword edist1, edist2, edist3, edist4, edist5, edist6,
           matchcost = 0, mismatchcost = 1, gapcost = 1;
   GtLinspaceManagement *spacemanager;
   GtScoreHandler *scorehandler;
@@ -800,6 +907,23 @@ void gt_linearalign_check(GT_UNUSED bool forward,
             " = gt_calc_linearedist\n", edist3, edist4);
     exit(GT_EXIT_PROGRAMMING_ERROR);
   }
+
+  edist5 = gt_linearalign_global_distance_64(scorehandler, useq, 0, ulen,
+                                             vseq, 0, vlen);
+  if (edist1 != edist5)
+  {
+    fprintf(stderr,"gt_calc_linearalign = "GT_WU" != "GT_WU
+            " = gt_linearalign_global_distance_64\n", edist1, edist5);
+    exit(GT_EXIT_PROGRAMMING_ERROR);
+  }
+  edist6 = gt_linearalign_global_distance_only(scorehandler, useq, 0, ulen,
+                                               vseq, 0, vlen);
+  if (edist1 != edist6)
+  {
+    fprintf(stderr,"gt_calc_linearalign = "GT_WU" != "GT_WU
+            " = gt_linearalign_global_distance_only\n", edist1, edist6);
+    exit(GT_EXIT_PROGRAMMING_ERROR);
+  }
   gt_linspace_management_delete(spacemanager);
   gt_scorehandler_delete(scorehandler);
   gt_alignment_delete(align);
@@ -810,7 +934,7 @@ void gt_linearalign_check_local(GT_UNUSED bool forward,
                                 const GtUchar *vseq, GtUword vlen)
 {
   GtAlignment *align;
-  GtWord score1, score2, score3, score4,
+  GtWord score1, score2, score3, score4, score5, score6,
          matchscore = 2, mismatchscore = -2, gapscore = -1;
   GtLinspaceManagement *spacemanager;
   GtScoreHandler *scorehandler;
@@ -835,6 +959,10 @@ void gt_linearalign_check_local(GT_UNUSED bool forward,
 
   score2 = gt_alignment_eval_with_score(align, true, matchscore,
                                         mismatchscore, gapscore);
+  score5 = gt_linearalign_local_score_64(scorehandler, useq, 0, ulen,
+                                         vseq, 0, vlen);
+  score6 = gt_linearalign_local_score_only(scorehandler, useq, 0, ulen,
+                                           vseq, 0, vlen);
   gt_linspace_management_delete(spacemanager);
   gt_scorehandler_delete(scorehandler);
   if (score1 != score2)
@@ -843,6 +971,18 @@ void gt_linearalign_check_local(GT_UNUSED bool forward,
             " = gt_alignment_eval_generic_with_score\n", score1, score2);
     exit(GT_EXIT_PROGRAMMING_ERROR);
   }
+  if (score1 != score5)
+  {
+    fprintf(stderr,"gt_linearalign_compute_local_generic = "GT_WD" != "GT_WD
+            " = gt_linearalign_local_score_64\n", score1, score5);
+    exit(GT_EXIT_PROGRAMMING_ERROR);
+  }
+  if (score1 != score6)
+  {
+    fprintf(stderr,"gt_linearalign_compute_local_generic = "GT_WD" != "GT_WD
+            " = gt_linearalign_local_score_only\n", score1, score6);
+    exit(GT_EXIT_PROGRAMMING_ERROR);
+  }
 
   gt_alignment_reset(align);
   score3 = gt_squarealign_calculate_local(NULL, align, useq, 0, ulen,
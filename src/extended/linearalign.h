@@ -95,6 +95,34 @@ GtWord  gt_linearalign_compute_local(GtLinspaceManagement *spacemanager,
                                      GtWord mismatchscore,
                                      GtWord gapscore);
 
+/* Computes the distance of an optimal global alignment with linear gapcosts
+   of the regions of <useq> and <vseq> given by their start positions
+   <ustart> and <vstart> and lengths <ulen> and <vlen>, without the alignment
+   itself. The cost values are specified by an initialised <scorehandler>.
+   The distance is computed with 16 bit SIMD instructions if available and
+   if the values fit, otherwise in linear space with 64 bit values. */
+GtUword gt_linearalign_global_distance_only(const GtScoreHandler *scorehandler,
+                                            const GtUchar *useq,
+                                            GtUword ustart,
+                                            GtUword ulen,
+                                            const GtUchar *vseq,
+                                            GtUword vstart,
+                                            GtUword vlen);
+
+/* Computes the score of an optimal local alignment with linear gapcosts
+   of the regions of <useq> and <vseq> given by their start positions
+   <ustart> and <vstart> and lengths <ulen> and <vlen>, without the alignment
+   itself. The score values are specified by an initialised <scorehandler>.
+   The score is computed with 8 or 16 bit SIMD instructions if available and
+   if the values fit, otherwise in linear space with 64 bit values. */
+GtWord  gt_linearalign_local_score_only(const GtScoreHandler *scorehandler,
+                                        const GtUchar *useq,
+                                        GtUword ustart,
+                                        GtUword ulen,
+                                        const GtUchar *vseq,
+                                        GtUword vstart,
+                                        GtUword vlen);
+
 void    gt_linearalign_check(GT_UNUSED bool forward,
                              const GtUchar *useq,
                              GtUword ulen,
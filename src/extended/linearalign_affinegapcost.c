@@ -29,6 +29,7 @@
 #include "extended/affinealign.h"
 #include "extended/maxcoordvalue.h"
 #include "extended/reconstructalignment.h"
+#include "extended/stripedalign.h"
 
 #include "extended/linearalign_affinegapcost.h"
 #define LINEAR_EDIST_GAP          ((GtUchar) UCHAR_MAX)
@@ -983,7 +984,7 @@ GtWord gt_linearalign_affinegapcost_compute_local_generic(
                                             GtUword vstart,
                                             GtUword vlen)
 {
-  GtUword ulen_part, ustart_part, vlen_part, vstart_part;
+  GtUword ulen_part, ustart_part, vlen_part, vstart_part, uend, vend;
   GtWord score;
   GtAffinealignDPentry *Atabcolumn;
   Starttabentry *Starttabcolumn;
@@ -1016,6 +1017,19 @@ GtWord gt_linearalign_affinegapcost_compute_local_generic(
                                                   vseq, vstart, vlen);
   }
 
+  if (gt_stripedalign_local_end(&score, &uend, &vend, scorehandler, true,
+                                useq, ustart, ulen, vseq, vstart, vlen))
+  {
+    if (score == 0)
+    {
+      /* empty alignment */
+      return 0;
+    }
+    /* the scores up to the first end of an optimal alignment, and hence
+       its start, do not depend on the rows and columns behind this end */
+    ulen = uend;
+    vlen = vend;
+  }
   gt_linspace_management_check_local(spacemanager, ulen, vlen,
                                      sizeof (*Atabcolumn),
                                      sizeof (*Starttabcolumn));
@@ -1084,6 +1098,107 @@ GtWord gt_linearalign_affinegapcost_compute_local(
   return score;
 }
 
+/*-------------------------------score only---------------------------------*/
+
+static GtUword gt_linearalign_affinegapcost_global_distance_64(
+                                            const GtScoreHandler *scorehandler,
+                                            const GtUchar *useq,
+                                            GtUword ustart,
+                                            GtUword ulen,
+                                            const GtUchar *vseq,
+                                            GtUword vstart,
+                                            GtUword vlen)
+{
+  GtAffinealignDPentry *Atabcolumn;
+  GtAffineAlignRtabentry *Rtabcolumn;
+  GtUword distance;
+
+  Atabcolumn = gt_malloc(sizeof *Atabcolumn * (ulen + 1));
+  Rtabcolumn = gt_malloc(sizeof *Rtabcolumn * (ulen + 1));
+  /* with the last column as midcolumn, no crosspoints are stored */
+  distance = evaluateallAtabRtabcolumns(Atabcolumn, Rtabcolumn, scorehandler,
+                                        useq, ustart, ulen,
+                                        vseq, vstart, vlen, vlen, Affine_X);
+  gt_free(Atabcolumn);
+  gt_free(Rtabcolumn);
+  return distance;
+}
+
+GtUword gt_linearalign_affinegapcost_global_distance_only(
+                                            const GtScoreHandler *scorehandler,
+                                            const GtUchar *useq,
+                                            GtUword ustart,
+                                            GtUword ulen,
+                                            const GtUchar *vseq,
+                                            GtUword vstart,
+                                            GtUword vlen)
+{
+  GtWord distance;
+
+  gt_assert(scorehandler != NULL);
+  if (gt_stripedalign_score(&distance, scorehandler, true, true,
+                            useq, ustart, ulen, vseq, vstart, vlen))
+  {
+    return (GtUword) distance;
+  }
+  return gt_linearalign_affinegapcost_global_distance_64(scorehandler,
+                                                         useq, ustart, ulen,
+                                                         vseq, vstart, vlen);
+}
+
+static GtWord gt_linearalign_affinegapcost_local_score_64(
+                                            const GtScoreHandler *scorehandler,
+                                            const GtUchar *useq,
+                                            GtUword ustart,
+                                            GtUword ulen,
+                                            const GtUchar *vseq,
+                                            GtUword vstart,
+                                            GtUword vlen)
+{
+  GtAffinealignDPentry *Atabcolumn;
+  Starttabentry *Starttabcolumn;
+  GtUword colindex;
+  GtMaxcoordvalue *max;
+  GtWord score;
+
+  Atabcolumn = gt_malloc(sizeof *Atabcolumn * (ulen + 1));
+  Starttabcolumn = gt_malloc(sizeof *Starttabcolumn * (ulen + 1));
+  max = gt_maxcoordvalue_new();
+  firstAStabcolumn(Atabcolumn, Starttabcolumn, scorehandler, ulen);
+  for (colindex = 1UL; colindex <= vlen; colindex++)
+  {
+    nextAStabcolumn(Atabcolumn, Starttabcolumn, scorehandler, useq, ustart,
+                    ulen, vseq[vstart+colindex-1], colindex, max);
+  }
+  score = gt_maxcoordvalue_get_value(max);
+  gt_maxcoordvalue_delete(max);
+  gt_free(Atabcolumn);
+  gt_free(Starttabcolumn);
+  return score;
+}
+
+GtWord gt_linearalign_affinegapcost_local_score_only(
+                                            const GtScoreHandler *scorehandler,
+                                            const GtUchar *useq,
+                                            GtUword ustart,
+                                            GtUword ulen,
+                                            const GtUchar *vseq,
+                                            GtUword vstart,
+                                            GtUword vlen)
+{
+  GtWord score;
+
+  gt_assert(scorehandler != NULL);
+  if (gt_stripedalign_score(&score, scorehandler, false, true,
+                            useq, ustart, ulen, vseq, vstart, vlen))
+  {
+    return score;
+  }
+  return gt_linearalign_affinegapcost_local_score_64(scorehandler,
+                                                     useq, ustart, ulen,
+                                                     vseq, vstart, vlen);
+}
+
 /*----------------------------checkfunctions--------------------------*/
 void gt_linearalign_affinegapcost_check(GT_UNUSED bool forward,
                                         const GtUchar *useq,
@@ -1092,8 +1207,8 @@ void gt_linearalign_affinegapcost_check(GT_UNUSED bool forward,
                                         GtUword vlen)
 {
   GtAlignment *align;
-  GtUword affine_score1, affine_score2, affine_score3,
-          matchcost = 0, mismatchcost = 4, gap_opening = 4, gap_extension = 1;
+  GtUword affine_score1, affine_score2, affine_score3, affine_score4,
+          affine_score5, matchcost = 0, mismatchcost = 4, gap_opening = 4, gap_extension = 1;
   GtLinspaceManagement *spacemanager;
   GtScoreHandler *scorehandler;
 
@@ -1123,6 +1238,15 @@ void gt_linearalign_affinegapcost_check(GT_UNUSED bool forward,
   affine_score2 = gt_alignment_eval_with_affine_score(align,  true,matchcost,
                                                       mismatchcost, gap_opening,
                                                       gap_extension);
+  affine_score4 = gt_linearalign_affinegapcost_global_distance_64(scorehandler,
+                                                                  useq, 0, ulen,
+                                                                  vseq, 0,
+                                                                  vlen);
+  affine_score5 = gt_linearalign_affinegapcost_global_distance_only(
+                                                                  scorehandler,
+                                                                  useq, 0, ulen,
+                                                                  vseq, 0,
+                                                                  vlen);
   gt_alignment_delete(align);
   gt_scorehandler_delete(scorehandler);
   if (affine_score1 != affine_score2)
@@ -1132,6 +1256,20 @@ void gt_linearalign_affinegapcost_check(GT_UNUSED bool forward,
                                                         affine_score2);
     exit(GT_EXIT_PROGRAMMING_ERROR);
   }
+  if (affine_score2 != affine_score4)
+  {
+    fprintf(stderr,"gt_alignment_eval_with_affine_score = "GT_WU" != "GT_WU
+            " = gt_linearalign_affinegapcost_global_distance_64\n",
+            affine_score2, affine_score4);
+    exit(GT_EXIT_PROGRAMMING_ERROR);
+  }
+  if (affine_score2 != affine_score5)
+  {
+    fprintf(stderr,"gt_alignment_eval_with_affine_score = "GT_WU" != "GT_WU
+            " = gt_linearalign_affinegapcost_global_distance_only\n",
+            affine_score2, affine_score5);
+    exit(GT_EXIT_PROGRAMMING_ERROR);
+  }
 
   align = gt_affinealign(useq, ulen, vseq, vlen, matchcost,
                          mismatchcost, gap_opening, gap_extension);
@@ -1157,7 +1295,7 @@ void gt_linearalign_affinegapcost_check_local(GT_UNUSED bool forward,
 {
   GtAlignment *align;
   GtWord affine_score1, affine_score2, affine_score3, affine_score4,
-         matchscore = 6, mismatchscore = -3,
+         affine_score5, affine_score6, matchscore = 6, mismatchscore = -3,
          gap_opening = -2, gap_extension = -1;
   GtScoreHandler *scorehandler;
   GtLinspaceManagement *spacemanager;
@@ -1184,7 +1322,29 @@ void gt_linearalign_affinegapcost_check_local(GT_UNUSED bool forward,
                                                             useq, 0, ulen,
                                                             vseq,  0, vlen);
   gt_linspace_management_delete(spacemanager);
+  affine_score5 = gt_linearalign_affinegapcost_local_score_64(scorehandler,
+                                                              useq, 0, ulen,
+                                                              vseq, 0, vlen);
+  affine_score6 = gt_linearalign_affinegapcost_local_score_only(scorehandler,
+                                                                useq, 0, ulen,
+                                                                vseq, 0, vlen);
   gt_scorehandler_delete(scorehandler);
+  if (affine_score1 != affine_score5)
+  {
+    fprintf(stderr,"gt_linearalign_affinegapcost_compute_local_generic ="
+            " "GT_WD"!= "GT_WD
+            " = gt_linearalign_affinegapcost_local_score_64\n", affine_score1,
+                                                                affine_score5);
+    exit(GT_EXIT_PROGRAMMING_ERROR);
+  }
+  if (affine_score1 != affine_score6)
+  {
+    fprintf(stderr,"gt_linearalign_affinegapcost_compute_local_generic ="
+            " "GT_WD"!= "GT_WD
+            " = gt_linearalign_affinegapcost_local_score_only\n",
+            affine_score1, affine_score6);
+    exit(GT_EXIT_PROGRAMMING_ERROR);
+  }
 
   affine_score2 = gt_alignment_eval_with_affine_score(align, true, matchscore,
                                     mismatchscore, gap_opening, gap_extension);
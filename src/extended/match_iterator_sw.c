@@ -80,7 +80,7 @@ static GtMatchIteratorStatus gt_match_iterator_sw_next(GtMatchIterator *mi,
     gt_encseq_extract_decoded(mis->pvt->es1, a, seqpos, seqpos + seqlen_a - 1);
     b = gt_malloc(seqlen_b * sizeof (char));
     seqpos = gt_encseq_seqstartpos(mis->pvt->es2, mis->pvt->seqno_es2);
-    gt_encseq_extract_decoded(mis->pvt->es1, b, seqpos, seqpos + seqlen_b - 1);
+    gt_encseq_extract_decoded(mis->pvt->es2, b, seqpos, seqpos + seqlen_b - 1);
     seq_a = gt_seq_new(a, seqlen_a, gt_encseq_alphabet(mis->pvt->es1));
     seq_b = gt_seq_new(b, seqlen_b, gt_encseq_alphabet(mis->pvt->es2));
     ali = gt_swalign(seq_a, seq_b, mis->pvt->sf);
@@ -18,22 +18,203 @@
 #include "core/array.h"
 #include "core/assert_api.h"
 #include "core/class_alloc_lock.h"
+#include "core/fa_api.h"
+#include "core/file_api.h"
+#include "core/ma_api.h"
+#include "core/xposix_api.h"
 #include "extended/eof_node_api.h"
+#include "extended/feature_node_api.h"
+#include "extended/feature_node_iterator_api.h"
 #include "extended/genome_node.h"
+#include "extended/gff3_in_stream.h"
+#include "extended/gff3_visitor.h"
+#include "extended/meta_node_api.h"
 #include "extended/node_stream_api.h"
+#include "extended/priority_queue.h"
+#include "extended/sequence_node_api.h"
 #include "extended/sort_stream.h"
 
+/* estimated memory footprint of a single feature node (including attributes)
+   and of other genome nodes, used to check the memory limit */
+#define GT_SORT_STREAM_FEATURE_SIZE 512
+#define GT_SORT_STREAM_NODE_SIZE    128
+
+typedef struct {
+  GtGenomeNode *gn;
+  GtUword run;
+} GtSortStreamRunItem;
+
 struct GtSortStream {
   const GtNodeStream parent_instance;
   GtNodeStream *in_stream;
-  GtUword idx;
-  GtArray *nodes;
+  GtUword idx,
+          memory_limit,
+          memory_used;
+  GtArray *nodes,
+          *runfiles,   /* names of the temporary files holding sorted runs */
+          *runstreams; /* node streams reading the sorted runs */
+  GtSortStreamRunItem *runitems;
+  GtPriorityQueue *pq;
+  GtGenomeNode *buffered;
   bool sorted;
 };
 
 #define gt_sort_stream_cast(GS)\
         gt_node_stream_cast(gt_sort_stream_class(), GS);
 
+static GtUword sort_stream_estimate_size(GtGenomeNode *gn)
+{
+  GtFeatureNode *fn;
+  GtSequenceNode *sn;
+  GtUword size = 0;
+  if ((fn = gt_feature_node_try_cast(gn))) {
+    GtFeatureNodeIterator *fni = gt_feature_node_iterator_new(fn);
+    while (gt_feature_node_iterator_next(fni))
+      size += GT_SORT_STREAM_FEATURE_SIZE;
+    gt_feature_node_iterator_delete(fni);
+  }
+  else if ((sn = gt_sequence_node_try_cast(gn))) {
+    size = GT_SORT_STREAM_NODE_SIZE +
+           gt_sequence_node_get_sequence_length(sn);
+  }
+  else
+    size = GT_SORT_STREAM_NODE_SIZE;
+  return size;
+}
+
+/* Sort the nodes currently held in memory and write them as GFF3 to a new
+   temporary file. The written nodes are deleted afterwards. Meta and region
+   nodes are kept in memory, because they are few and the GFF3 parser would
+   not accept repeated or (in rare cases) the written region definitions. */
+static int sort_stream_write_run(GtSortStream *sort_stream, GtError *err)
+{
+  GtNodeVisitor *gff3_visitor;
+  GtStr *runfile;
+  GtFile *outfp;
+  GtUword i, numofkept = 0;
+  int had_err = 0;
+  gt_error_check(err);
+
+  gt_genome_nodes_sort_stable(sort_stream->nodes);
+  runfile = gt_str_new();
+  outfp = gt_file_new_from_fileptr(gt_xtmpfp(runfile));
+  gt_array_add(sort_stream->runfiles, runfile);
+  gff3_visitor = gt_gff3_visitor_new(outfp);
+  gt_gff3_visitor_retain_id_attributes((GtGFF3Visitor*) gff3_visitor);
+  gt_gff3_visitor_allow_nonunique_ids((GtGFF3Visitor*) gff3_visitor);
+  for (i = 0; i < gt_array_size(sort_stream->nodes); i++) {
+    GtGenomeNode *gn = *(GtGenomeNode**) gt_array_get(sort_stream->nodes, i);
+    if (gt_meta_node_try_cast(gn) || gt_region_node_try_cast(gn)) {
+      *(GtGenomeNode**) gt_array_get(sort_stream->nodes, numofkept++) = gn;
+      continue;
+    }
+    if (!had_err)
+      had_err = gt_genome_node_accept(gn, gff3_visitor, err);
+    gt_genome_node_delete(gn);
+  }
+  gt_node_visitor_delete(gff3_visitor);
+  gt_file_delete(outfp);
+  gt_array_set_size(sort_stream->nodes, numofkept);
+  sort_stream->memory_used = 0;
+  return had_err;
+}
+
+static int sort_stream_run_item_compare(const void *a, const void *b)
+{
+  const GtSortStreamRunItem *item1 = a, *item2 = b;
+  int rval;
+  gt_assert(item1->gn && item2->gn);
+  if ((rval = gt_genome_node_cmp(item1->gn, item2->gn)))
+    return rval;
+  /* keep the input order of equal nodes, as in the in-memory sort */
+  if (item1->run < item2->run)
+    return -1;
+  return item1->run > item2->run ? 1 : 0;
+}
+
+/* Get the next node from sorted run <run> and add it to the priority queue,
+   unless the run is exhausted. The last run consists of the nodes still held
+   in memory. */
+static int sort_stream_fetch_from_run(GtSortStream *sort_stream, GtUword run,
+                                      GtError *err)
+{
+  GtNodeStream *runstream;
+  GtGenomeNode *gn = NULL;
+  int had_err = 0;
+  gt_error_check(err);
+  if (run < gt_array_size(sort_stream->runstreams)) {
+    runstream = *(GtNodeStream**) gt_array_get(sort_stream->runstreams, run);
+    had_err = gt_node_stream_next(runstream, &gn, err);
+  }
+  else if (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
+    gn = *(GtGenomeNode**) gt_array_get(sort_stream->nodes, sort_stream->idx);
+    sort_stream->idx++;
+  }
+  if (!had_err && gn) {
+    if (gt_eof_node_try_cast(gn))
+      gt_genome_node_delete(gn);
+    else {
+      sort_stream->runitems[run].gn = gn;
+      sort_stream->runitems[run].run = run;
+      gt_priority_queue_add(sort_stream->pq, sort_stream->runitems + run);
+    }
+  }
+  return had_err;
+}
+
+/* Prepare the k-way merge of all sorted runs, including the nodes still held
+   in memory. */
+static int sort_stream_start_merge(GtSortStream *sort_stream, GtError *err)
+{
+  GtUword i, numofruns = gt_array_size(sort_stream->runfiles) + 1;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_genome_nodes_sort_stable(sort_stream->nodes);
+  sort_stream->runstreams = gt_array_new(sizeof (GtNodeStream*));
+  sort_stream->runitems = gt_calloc(numofruns,
+                                    sizeof (*sort_stream->runitems));
+  sort_stream->pq = gt_priority_queue_new(sort_stream_run_item_compare,
+                                          numofruns);
+  for (i = 0; i < numofruns - 1; i++) {
+    GtStr *runfile = *(GtStr**) gt_array_get(sort_stream->runfiles, i);
+    GtNodeStream *runstream = gt_gff3_in_stream_new_sorted(gt_str_get(runfile));
+    gt_gff3_in_stream_disable_add_ids(runstream);
+    gt_array_add(sort_stream->runstreams, runstream);
+  }
+  for (i = 0; !had_err && i < numofruns; i++)
+    had_err = sort_stream_fetch_from_run(sort_stream, i, err);
+  return had_err;
+}
+
+/* Return the next node in sorted order (or NULL) in <gn>, either from the
+   in-memory array or from the merge of the sorted runs. */
+static int sort_stream_next_sorted(GtSortStream *sort_stream,
+                                   GtGenomeNode **gn, GtError *err)
+{
+  GtSortStreamRunItem *min_item;
+  int had_err = 0;
+  gt_error_check(err);
+  *gn = NULL;
+  if (sort_stream->buffered) {
+    *gn = sort_stream->buffered;
+    sort_stream->buffered = NULL;
+  }
+  else if (!sort_stream->pq) {
+    if (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
+      *gn = *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
+                                           sort_stream->idx);
+      sort_stream->idx++;
+    }
+  }
+  else if (!gt_priority_queue_is_empty(sort_stream->pq)) {
+    min_item = gt_priority_queue_extract_min(sort_stream->pq);
+    *gn = min_item->gn;
+    min_item->gn = NULL;
+    had_err = sort_stream_fetch_from_run(sort_stream, min_item->run, err);
+  }
+  return had_err;
+}
+
 static int gt_sort_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
                                GtError *err)
 {
@@ -49,48 +230,55 @@ static int gt_sort_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
                                            err)) && node) {
       if ((eofn = gt_eof_node_try_cast(node)))
         gt_genome_node_delete(node); /* get rid of EOF nodes */
-      else
+      else {
         gt_array_add(sort_stream->nodes, node);
+        if (sort_stream->memory_limit) {
+          sort_stream->memory_used += sort_stream_estimate_size(node);
+          if (sort_stream->memory_used > sort_stream->memory_limit &&
+              (had_err = sort_stream_write_run(sort_stream, err))) {
+            break;
+          }
+        }
+      }
     }
-    if (!had_err) {
+    if (!had_err && gt_array_size(sort_stream->runfiles)) {
+      /* the memory limit has been exceeded, merge the sorted runs */
+      had_err = sort_stream_start_merge(sort_stream, err);
+    }
+    else if (!had_err)
       gt_genome_nodes_sort_stable(sort_stream->nodes);
+    if (!had_err)
       sort_stream->sorted = true;
-    }
   }
 
   if (!had_err) {
     gt_assert(sort_stream->sorted);
-    if (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
-      *gn = *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
-                                           sort_stream->idx);
-      sort_stream->idx++;
-      /* join region nodes with the same sequence ID */
-      if (gt_region_node_try_cast(*gn)) {
-        GtRange range_a, range_b;
-        while (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
-          node = *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
-                                                sort_stream->idx);
-          if (!gt_region_node_try_cast(node) ||
-              gt_str_cmp(gt_genome_node_get_seqid(*gn),
-                         gt_genome_node_get_seqid(node))) {
-            /* the next node is not a region node with the same ID */
-            break;
-          }
-          range_a = gt_genome_node_get_range(*gn);
-          range_b = gt_genome_node_get_range(node);
-          range_a = gt_range_join(&range_a, &range_b);
-          gt_genome_node_set_range(*gn, &range_a);
-          gt_genome_node_delete(node);
-          sort_stream->idx++;
+    had_err = sort_stream_next_sorted(sort_stream, gn, err);
+    /* join region nodes with the same sequence ID */
+    if (!had_err && *gn && gt_region_node_try_cast(*gn)) {
+      GtRange range_a, range_b;
+      while (!(had_err = sort_stream_next_sorted(sort_stream, &node, err)) &&
+             node) {
+        if (!gt_region_node_try_cast(node) ||
+            gt_str_cmp(gt_genome_node_get_seqid(*gn),
+                       gt_genome_node_get_seqid(node))) {
+          /* the next node is not a region node with the same ID */
+          sort_stream->buffered = node;
+          break;
         }
+        range_a = gt_genome_node_get_range(*gn);
+        range_b = gt_genome_node_get_range(node);
+        range_a = gt_range_join(&range_a, &range_b);
+        gt_genome_node_set_range(*gn, &range_a);
+        gt_genome_node_delete(node);
+      }
+      if (had_err) {
+        gt_genome_node_delete(*gn);
+        *gn = NULL;
       }
-      return 0;
     }
-  }
-
-  if (!had_err) {
-    gt_array_reset(sort_stream->nodes);
-    *gn = NULL;
+    if (!had_err && !*gn)
+      gt_array_reset(sort_stream->nodes);
   }
 
   return had_err;
@@ -100,11 +288,29 @@ static void gt_sort_stream_free(GtNodeStream *ns)
 {
   GtUword i;
   GtSortStream *sort_stream = gt_sort_stream_cast(ns);
+  gt_genome_node_delete(sort_stream->buffered);
   for (i = sort_stream->idx; i < gt_array_size(sort_stream->nodes); i++) {
     gt_genome_node_delete(*(GtGenomeNode**)
                           gt_array_get(sort_stream->nodes, i));
   }
   gt_array_delete(sort_stream->nodes);
+  if (sort_stream->runstreams) {
+    for (i = 0; i < gt_array_size(sort_stream->runstreams); i++) {
+      gt_node_stream_delete(*(GtNodeStream**)
+                            gt_array_get(sort_stream->runstreams, i));
+    }
+    for (i = 0; i < gt_array_size(sort_stream->runfiles) + 1; i++)
+      gt_genome_node_delete(sort_stream->runitems[i].gn);
+    gt_array_delete(sort_stream->runstreams);
+  }
+  for (i = 0; i < gt_array_size(sort_stream->runfiles); i++) {
+    GtStr *runfile = *(GtStr**) gt_array_get(sort_stream->runfiles, i);
+    gt_xunlink(gt_str_get(runfile));
+    gt_str_delete(runfile);
+  }
+  gt_array_delete(sort_stream->runfiles);
+  gt_free(sort_stream->runitems);
+  gt_priority_queue_delete(sort_stream->pq);
   gt_node_stream_delete(sort_stream->in_stream);
 }
 
@@ -129,6 +335,20 @@ GtNodeStream* gt_sort_stream_new(GtNodeStream *in_stream)
   sort_stream->in_stream = gt_node_stream_ref(in_stream);
   sort_stream->sorted = false;
   sort_stream->idx = 0;
+  sort_stream->memory_limit = 0;
+  sort_stream->memory_used = 0;
   sort_stream->nodes = gt_array_new(sizeof (GtGenomeNode*));
+  sort_stream->runfiles = gt_array_new(sizeof (GtStr*));
+  sort_stream->runstreams = NULL;
+  sort_stream->runitems = NULL;
+  sort_stream->pq = NULL;
+  sort_stream->buffered = NULL;
   return ns;
 }
+
+void gt_sort_stream_set_memory_limit(GtSortStream *sort_stream,
+                                     GtUword memory_limit)
+{
+  gt_assert(sort_stream && !sort_stream->sorted);
+  sort_stream->memory_limit = memory_limit;
+}
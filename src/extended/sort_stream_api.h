@@ -28,4 +28,12 @@ typedef struct GtSortStream GtSortStream;
    <in_stream> and returns them unmodified, but in sorted order. */
 GtNodeStream* gt_sort_stream_new(GtNodeStream *in_stream);
 
+/* Limit the memory used by <sort_stream> to hold genome nodes to (roughly)
+   <memory_limit> bytes. If the limit is exceeded, the nodes retrieved so far
+   are sorted and written to a temporary file in GFF3 format. After all nodes
+   have been retrieved, these sorted runs are merged. A <memory_limit> of 0
+   means no limit, which is the default. */
+void          gt_sort_stream_set_memory_limit(GtSortStream *sort_stream,
+                                              GtUword memory_limit);
+
 #endif
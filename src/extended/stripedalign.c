@@ -0,0 +1,729 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "core/assert_api.h"
+#include "core/chardef_api.h"
+#include "core/ma_api.h"
+#include "core/minmax_api.h"
+#include "core/unused_api.h"
+#include "extended/stripedalign.h"
+
+#ifdef __SSE2__
+
+/* The DP matrix is computed column by column, with the maximal score as the
+   value of each entry. The rows of a column are distributed over the lanes
+   of <seglen> vectors, such that the k-th vector holds the rows k, k +
+   seglen, k + 2 * seglen, ... (Farrar, Bioinformatics 23(2):156-161, 2007).
+   Gaps spanning several segments are propagated in a second pass over the
+   column, which usually terminates after a few vectors. */
+
+#define GT_STRIPEDALIGN_VECTORBYTES 16
+
+typedef struct
+{
+  const GtUchar *vseq;
+  GtUword ulen,
+          vlen,
+          numofsymbols;
+  int symbolindex[UCHAR_MAX+1];
+  /* <scores>[idx * ulen + row] is the score of the row-th symbol of u
+     against the symbol of v with index idx, for global alignments this is
+     the negated cost */
+  GtWord *scores,
+         minscore,
+         maxscore,
+         /* penalties of the first and of each further symbol of an
+            insertion (a gap in u, values E) and of a deletion (a gap in v,
+            values F) */
+         ins_open,
+         ins_extend,
+         del_open,
+         del_extend;
+} GtStripedalignProblem;
+
+static __m128i *gt_stripedalign_vectors(void **space, GtUword numofvectors)
+{
+  *space = gt_malloc(sizeof (__m128i) * numofvectors +
+                     GT_STRIPEDALIGN_VECTORBYTES - 1);
+  return (__m128i *) (((uintptr_t) *space + GT_STRIPEDALIGN_VECTORBYTES - 1) &
+                      ~((uintptr_t) GT_STRIPEDALIGN_VECTORBYTES - 1));
+}
+
+/* The end of a local alignment is the first entry of maximal score, with
+   the entries ordered by column and by row within a column. It lies in the
+   first column in which the running maximum increases to its final value,
+   this column is saved in <pvBest> whenever the maximum increases. Returns
+   the smallest row of the saved column with the maximal <value>. */
+static GtUword gt_stripedalign_endrow_8(const __m128i *pvBest, GtUword seglen,
+                                        GtUword ulen, uint8_t value)
+{
+  uint8_t values[GT_STRIPEDALIGN_VECTORBYTES];
+  GtUword row;
+
+  for (row = 0; row < ulen; row++)
+  {
+    _mm_storeu_si128((__m128i *) values, pvBest[row % seglen]);
+    if (values[row / seglen] == value)
+    {
+      break;
+    }
+  }
+  gt_assert(row < ulen);
+  return row;
+}
+
+static GtUword gt_stripedalign_endrow_16(const __m128i *pvBest,
+                                         GtUword seglen, GtUword ulen,
+                                         int16_t value)
+{
+  int16_t values[GT_STRIPEDALIGN_VECTORBYTES/sizeof (int16_t)];
+  GtUword row;
+
+  for (row = 0; row < ulen; row++)
+  {
+    _mm_storeu_si128((__m128i *) values, pvBest[row % seglen]);
+    if (values[row / seglen] == value)
+    {
+      break;
+    }
+  }
+  gt_assert(row < ulen);
+  return row;
+}
+
+/* local alignment with unsigned 8 bit values, the scores of the profile are
+   increased by <bias>, which is subtracted after adding the profile. If
+   <uend> is not NULL, the end of the alignment is stored in <uend> and
+   <vend> */
+static bool gt_stripedalign_local_8(GtWord *score,
+                                    GtUword *uend,
+                                    GtUword *vend,
+                                    const GtStripedalignProblem *problem)
+{
+  const GtUword lanes = (GtUword) GT_STRIPEDALIGN_VECTORBYTES,
+                seglen = (problem->ulen + lanes - 1)/lanes;
+  const GtWord bias = problem->minscore < 0 ? -problem->minscore : 0;
+  GtUword idx, k, l, j, bestcol = 0;
+  void *profilespace, *columnspace;
+  __m128i *profile, *pvHStore, *pvHLoad, *pvE, *pvBest, vBias, vInsO, vInsE,
+          vDelO, vDelE, vZero, vMax, vBest, vThreshold;
+  uint8_t values[GT_STRIPEDALIGN_VECTORBYTES], best = 0;
+  bool overflow = false;
+
+  if (problem->maxscore + bias > (GtWord) UINT8_MAX ||
+      problem->ins_open > (GtWord) UINT8_MAX ||
+      problem->ins_extend > (GtWord) UINT8_MAX ||
+      problem->del_open > (GtWord) UINT8_MAX ||
+      problem->del_extend > (GtWord) UINT8_MAX)
+  {
+    return false;
+  }
+  profile = gt_stripedalign_vectors(&profilespace,
+                                    problem->numofsymbols * seglen);
+  for (idx = 0; idx < problem->numofsymbols; idx++)
+  {
+    const GtWord *scores = problem->scores + idx * problem->ulen;
+
+    for (k = 0; k < seglen; k++)
+    {
+      for (l = 0; l < lanes; l++)
+      {
+        const GtUword row = l * seglen + k;
+
+        values[l] = (uint8_t) (row < problem->ulen ? scores[row] + bias : 0);
+      }
+      profile[idx * seglen + k] = _mm_loadu_si128((const __m128i *) values);
+    }
+  }
+  pvHStore = gt_stripedalign_vectors(&columnspace, 4 * seglen);
+  pvHLoad = pvHStore + seglen;
+  pvE = pvHLoad + seglen;
+  pvBest = pvE + seglen;
+  vZero = _mm_setzero_si128();
+  for (k = 0; k < seglen; k++)
+  {
+    pvHStore[k] = pvE[k] = vZero;
+  }
+  vBias = _mm_set1_epi8((char) bias);
+  vInsO = _mm_set1_epi8((char) problem->ins_open);
+  vInsE = _mm_set1_epi8((char) problem->ins_extend);
+  vDelO = _mm_set1_epi8((char) problem->del_open);
+  vDelE = _mm_set1_epi8((char) problem->del_extend);
+  /* as long as no value exceeds <vThreshold>, adding the profile does not
+     saturate */
+  vThreshold = _mm_set1_epi8((char) (UINT8_MAX - problem->maxscore - bias));
+  vMax = vBest = vZero;
+  for (j = 0; !overflow && j < problem->vlen; j++)
+  {
+    const __m128i *vP
+      = profile + problem->symbolindex[problem->vseq[j]] * seglen;
+    __m128i vF = vZero, vH, vE, *swap;
+
+    vH = _mm_slli_si128(pvHStore[seglen - 1], 1);
+    swap = pvHLoad;
+    pvHLoad = pvHStore;
+    pvHStore = swap;
+    for (k = 0; k < seglen; k++)
+    {
+      vH = _mm_subs_epu8(_mm_adds_epu8(vH, vP[k]), vBias);
+      vE = pvE[k];
+      vH = _mm_max_epu8(_mm_max_epu8(vH, vE), vF);
+      vMax = _mm_max_epu8(vMax, vH);
+      pvHStore[k] = vH;
+      pvE[k] = _mm_max_epu8(_mm_subs_epu8(vE, vInsE),
+                            _mm_subs_epu8(vH, vInsO));
+      vF = _mm_max_epu8(_mm_subs_epu8(vF, vDelE), _mm_subs_epu8(vH, vDelO));
+      vH = pvHLoad[k];
+    }
+    for (l = 0; l < lanes; l++)
+    {
+      vF = _mm_slli_si128(vF, 1);
+      for (k = 0; k < seglen; k++)
+      {
+        /* the gap opened in the previous row from the value before the
+           update was already considered, so stop as soon as extending
+           <vF> gives nothing better; comparing with the updated value
+           would stop too early if opening and extending cost the same */
+        __m128i vHprev = _mm_subs_epu8(pvHStore[k], vDelO);
+
+        vH = _mm_max_epu8(pvHStore[k], vF);
+        vMax = _mm_max_epu8(vMax, vH);
+        pvHStore[k] = vH;
+        pvE[k] = _mm_max_epu8(pvE[k], _mm_subs_epu8(vH, vInsO));
+        vF = _mm_subs_epu8(vF, vDelE);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_subs_epu8(vF, vHprev),
+                                             vZero)) == 0xFFFF)
+        {
+          l = lanes;
+          break;
+        }
+      }
+    }
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_subs_epu8(vMax, vThreshold),
+                                         vZero)) != 0xFFFF)
+    {
+      overflow = true;
+    } else
+    {
+      if (uend != NULL &&
+          _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_subs_epu8(vMax, vBest),
+                                           vZero)) != 0xFFFF)
+      {
+        _mm_storeu_si128((__m128i *) values, vMax);
+        for (l = 0; l < lanes; l++)
+        {
+          if (best < values[l])
+          {
+            best = values[l];
+          }
+        }
+        vBest = _mm_set1_epi8((char) best);
+        memcpy(pvBest, pvHStore, sizeof *pvBest * seglen);
+        bestcol = j;
+      }
+    }
+  }
+  if (!overflow)
+  {
+    _mm_storeu_si128((__m128i *) values, vMax);
+    *score = 0;
+    for (l = 0; l < lanes; l++)
+    {
+      if (*score < (GtWord) values[l])
+      {
+        *score = (GtWord) values[l];
+      }
+    }
+    if (uend != NULL && *score > 0)
+    {
+      gt_assert(*score == (GtWord) best);
+      *uend = gt_stripedalign_endrow_8(pvBest, seglen, problem->ulen, best)
+              + 1;
+      *vend = bestcol + 1;
+    }
+  }
+  gt_free(columnspace);
+  gt_free(profilespace);
+  return !overflow;
+}
+
+/* global or local alignment with signed 16 bit values, for local
+   alignments the end is stored in <uend> and <vend> if <uend> is not NULL,
+   see gt_stripedalign_local_8 */
+static bool gt_stripedalign_16(GtWord *score,
+                               GtUword *uend,
+                               GtUword *vend,
+                               bool global,
+                               const GtStripedalignProblem *problem)
+{
+  const GtUword lanes = GT_STRIPEDALIGN_VECTORBYTES/sizeof (int16_t),
+                seglen = (problem->ulen + lanes - 1)/lanes;
+  GtUword idx, k, l, j, bestcol = 0;
+  void *profilespace, *columnspace;
+  __m128i *profile, *pvHStore, *pvHLoad, *pvE, *pvBest, vInsO, vInsE, vDelO,
+          vDelE, vZero, vNegInf, vMax, vBest, vThreshold;
+  int16_t values[GT_STRIPEDALIGN_VECTORBYTES/sizeof (int16_t)],
+          evalues[GT_STRIPEDALIGN_VECTORBYTES/sizeof (int16_t)], best = 0;
+  bool overflow = false;
+
+  gt_assert(!global || uend == NULL);
+  if (global)
+  {
+    /* all values of the DP matrix are bounded by the costs of a path of
+       maximal length, with two gaps at most */
+    const GtWord maxcost = GT_MAX(-problem->minscore, problem->maxscore) +
+                           GT_MAX(problem->ins_open, problem->del_open) +
+                           GT_MAX(problem->ins_extend, problem->del_extend);
+
+    if (maxcost > (GtWord) INT16_MAX ||
+        (GtWord) (problem->ulen + problem->vlen + 2) >
+          (GtWord) INT16_MAX/GT_MAX(maxcost, 1))
+    {
+      return false;
+    }
+  } else
+  {
+    if (problem->maxscore >= (GtWord) INT16_MAX ||
+        problem->minscore <= (GtWord) INT16_MIN ||
+        problem->ins_open > (GtWord) INT16_MAX ||
+        problem->ins_extend > (GtWord) INT16_MAX ||
+        problem->del_open > (GtWord) INT16_MAX ||
+        problem->del_extend > (GtWord) INT16_MAX)
+    {
+      return false;
+    }
+  }
+  profile = gt_stripedalign_vectors(&profilespace,
+                                    problem->numofsymbols * seglen);
+  for (idx = 0; idx < problem->numofsymbols; idx++)
+  {
+    const GtWord *scores = problem->scores + idx * problem->ulen;
+
+    for (k = 0; k < seglen; k++)
+    {
+      for (l = 0; l < lanes; l++)
+      {
+        const GtUword row = l * seglen + k;
+
+        values[l] = (int16_t) (row < problem->ulen ? scores[row]
+                                                   : (global ? 0 : INT16_MIN));
+      }
+      profile[idx * seglen + k] = _mm_loadu_si128((const __m128i *) values);
+    }
+  }
+  pvHStore = gt_stripedalign_vectors(&columnspace, 4 * seglen);
+  pvHLoad = pvHStore + seglen;
+  pvE = pvHLoad + seglen;
+  pvBest = pvE + seglen;
+  for (k = 0; k < seglen; k++)
+  {
+    for (l = 0; l < lanes; l++)
+    {
+      if (global)
+      {
+        /* the first column consists of a deletion of length row + 1 */
+        const GtWord row = (GtWord) (l * seglen + k);
+
+        values[l] = (int16_t) -(problem->del_open + row * problem->del_extend);
+        evalues[l] = (int16_t) (values[l] - problem->ins_open);
+      } else
+      {
+        values[l] = 0;
+        evalues[l] = INT16_MIN;
+      }
+    }
+    pvHStore[k] = _mm_loadu_si128((const __m128i *) values);
+    pvE[k] = _mm_loadu_si128((const __m128i *) evalues);
+  }
+  vInsO = _mm_set1_epi16((short) problem->ins_open);
+  vInsE = _mm_set1_epi16((short) problem->ins_extend);
+  vDelO = _mm_set1_epi16((short) problem->del_open);
+  vDelE = _mm_set1_epi16((short) problem->del_extend);
+  vZero = _mm_setzero_si128();
+  vNegInf = _mm_set1_epi16(INT16_MIN);
+  vThreshold = _mm_set1_epi16((short) (INT16_MAX - 1 -
+                                       GT_MAX(problem->maxscore, 0)));
+  vMax = vBest = vZero;
+  for (j = 0; !overflow && j < problem->vlen; j++)
+  {
+    const __m128i *vP
+      = profile + problem->symbolindex[problem->vseq[j]] * seglen;
+    __m128i vF = vNegInf, vH, vE, *swap;
+
+    vH = _mm_slli_si128(pvHStore[seglen - 1], 2);
+    if (global)
+    {
+      /* the first row consists of an insertion of length j + 1, the entry
+         in the previous column is the diagonal predecessor of the first
+         row */
+      vF = _mm_insert_epi16(vF, (int) -(problem->ins_open + problem->del_open +
+                                        (GtWord) j * problem->ins_extend), 0);
+      vH = _mm_insert_epi16(vH, j == 0 ? 0
+                                       : (int) -(problem->ins_open +
+                                                 (GtWord) (j - 1) *
+                                                 problem->ins_extend), 0);
+    }
+    swap = pvHLoad;
+    pvHLoad = pvHStore;
+    pvHStore = swap;
+    for (k = 0; k < seglen; k++)
+    {
+      vH = _mm_adds_epi16(vH, vP[k]);
+      vE = pvE[k];
+      vH = _mm_max_epi16(_mm_max_epi16(vH, vE), vF);
+      if (!global)
+      {
+        vH = _mm_max_epi16(vH, vZero);
+        vMax = _mm_max_epi16(vMax, vH);
+      }
+      pvHStore[k] = vH;
+      pvE[k] = _mm_max_epi16(_mm_subs_epi16(vE, vInsE),
+                             _mm_subs_epi16(vH, vInsO));
+      vF = _mm_max_epi16(_mm_subs_epi16(vF, vDelE),
+                         _mm_subs_epi16(vH, vDelO));
+      vH = pvHLoad[k];
+    }
+    for (l = 0; l < lanes; l++)
+    {
+      vF = _mm_insert_epi16(_mm_slli_si128(vF, 2), INT16_MIN, 0);
+      for (k = 0; k < seglen; k++)
+      {
+        /* see gt_stripedalign_local_8 */
+        __m128i vHprev = _mm_subs_epi16(pvHStore[k], vDelO);
+
+        vH = _mm_max_epi16(pvHStore[k], vF);
+        if (!global)
+        {
+          vMax = _mm_max_epi16(vMax, vH);
+        }
+        pvHStore[k] = vH;
+        pvE[k] = _mm_max_epi16(pvE[k], _mm_subs_epi16(vH, vInsO));
+        vF = _mm_subs_epi16(vF, vDelE);
+        if (_mm_movemask_epi8(_mm_cmpgt_epi16(vF, vHprev)) == 0)
+        {
+          l = lanes;
+          break;
+        }
+      }
+    }
+    if (!global && _mm_movemask_epi8(_mm_cmpgt_epi16(vMax, vThreshold)) != 0)
+    {
+      overflow = true;
+    } else
+    {
+      if (uend != NULL && _mm_movemask_epi8(_mm_cmpgt_epi16(vMax, vBest)) != 0)
+      {
+        _mm_storeu_si128((__m128i *) values, vMax);
+        for (l = 0; l < lanes; l++)
+        {
+          if (best < values[l])
+          {
+            best = values[l];
+          }
+        }
+        vBest = _mm_set1_epi16(best);
+        memcpy(pvBest, pvHStore, sizeof *pvBest * seglen);
+        bestcol = j;
+      }
+    }
+  }
+  if (!overflow)
+  {
+    if (global)
+    {
+      const GtUword row = problem->ulen - 1;
+
+      _mm_storeu_si128((__m128i *) values, pvHStore[row % seglen]);
+      *score = -(GtWord) values[row / seglen];
+    } else
+    {
+      _mm_storeu_si128((__m128i *) values, vMax);
+      *score = 0;
+      for (l = 0; l < lanes; l++)
+      {
+        if (*score < (GtWord) values[l])
+        {
+          *score = (GtWord) values[l];
+        }
+      }
+      if (uend != NULL && *score > 0)
+      {
+        gt_assert(*score == (GtWord) best);
+        *uend = gt_stripedalign_endrow_16(pvBest, seglen, problem->ulen, best)
+                + 1;
+        *vend = bestcol + 1;
+      }
+    }
+  }
+  gt_free(columnspace);
+  gt_free(profilespace);
+  return !overflow;
+}
+
+/* determines the symbols of <vseq> and allocates the profile scores for
+   them, which are to be filled in by the caller */
+static void gt_stripedalign_problem_init(GtStripedalignProblem *problem,
+                                         const GtUchar *vseq,
+                                         GtUword ulen,
+                                         GtUword vlen)
+{
+  GtUword idx;
+
+  problem->vseq = vseq;
+  problem->ulen = ulen;
+  problem->vlen = vlen;
+  problem->numofsymbols = 0;
+  for (idx = 0; idx <= UCHAR_MAX; idx++)
+  {
+    problem->symbolindex[idx] = -1;
+  }
+  for (idx = 0; idx < vlen; idx++)
+  {
+    if (problem->symbolindex[vseq[idx]] == -1)
+    {
+      problem->symbolindex[vseq[idx]] = (int) problem->numofsymbols++;
+    }
+  }
+  problem->scores = gt_malloc(sizeof *problem->scores *
+                              problem->numofsymbols * ulen);
+}
+
+/* computes the range of the profile scores, tries the kernels and frees
+   the profile scores */
+static bool gt_stripedalign_solve(GtWord *score,
+                                  GtUword *uend,
+                                  GtUword *vend,
+                                  bool global,
+                                  GtStripedalignProblem *problem)
+{
+  GtUword idx;
+  bool success = false;
+
+  problem->minscore = GT_WORD_MAX;
+  problem->maxscore = GT_WORD_MIN;
+  for (idx = 0; idx < problem->numofsymbols * problem->ulen; idx++)
+  {
+    if (problem->scores[idx] < problem->minscore)
+    {
+      problem->minscore = problem->scores[idx];
+    }
+    if (problem->scores[idx] > problem->maxscore)
+    {
+      problem->maxscore = problem->scores[idx];
+    }
+  }
+  if (problem->minscore > (GtWord) INT16_MIN &&
+      problem->maxscore < (GtWord) INT16_MAX)
+  {
+    if (!global)
+    {
+      success = gt_stripedalign_local_8(score, uend, vend, problem);
+    }
+    if (!success)
+    {
+      success = gt_stripedalign_16(score, uend, vend, global, problem);
+    }
+  }
+  gt_free(problem->scores);
+  return success;
+}
+
+static bool gt_stripedalign_scorehandler(GtWord *score,
+                                         GtUword *uend,
+                                         GtUword *vend,
+                                         const GtScoreHandler *scorehandler,
+                                         bool global,
+                                         bool affine,
+                                         const GtUchar *useq,
+                                         GtUword ustart,
+                                         GtUword ulen,
+                                         const GtUchar *vseq,
+                                         GtUword vstart,
+                                         GtUword vlen)
+{
+  GtStripedalignProblem problem;
+  GtWord gap_opening, gap_extension;
+  GtUword idx, row;
+
+  gt_assert(score != NULL && scorehandler != NULL);
+  if (ulen == 0 || vlen == 0)
+  {
+    return false;
+  }
+  gap_opening = affine ? gt_scorehandler_get_gap_opening(scorehandler) : 0;
+  gap_extension = gt_scorehandler_get_gapscore(scorehandler);
+  problem.ins_open = problem.del_open
+    = global ? gap_opening + gap_extension : -(gap_opening + gap_extension);
+  problem.ins_extend = problem.del_extend
+    = global ? gap_extension : -gap_extension;
+  if (problem.ins_open < 0 || problem.ins_extend < 0)
+  {
+    return false;
+  }
+  gt_stripedalign_problem_init(&problem, vseq + vstart, ulen, vlen);
+  for (idx = 0; idx <= UCHAR_MAX; idx++)
+  {
+    if (problem.symbolindex[idx] >= 0)
+    {
+      GtWord *scores = problem.scores + problem.symbolindex[idx] * ulen;
+
+      for (row = 0; row < ulen; row++)
+      {
+        const GtWord replacement
+          = gt_scorehandler_get_replacement(scorehandler, useq[ustart + row],
+                                            (GtUchar) idx);
+
+        scores[row] = global ? -replacement : replacement;
+      }
+    }
+  }
+  return gt_stripedalign_solve(score, uend, vend, global, &problem);
+}
+
+bool gt_stripedalign_score(GtWord *score,
+                           const GtScoreHandler *scorehandler,
+                           bool global,
+                           bool affine,
+                           const GtUchar *useq,
+                           GtUword ustart,
+                           GtUword ulen,
+                           const GtUchar *vseq,
+                           GtUword vstart,
+                           GtUword vlen)
+{
+  return gt_stripedalign_scorehandler(score, NULL, NULL, scorehandler, global,
+                                      affine, useq, ustart, ulen,
+                                      vseq, vstart, vlen);
+}
+
+bool gt_stripedalign_local_end(GtWord *score,
+                               GtUword *uend,
+                               GtUword *vend,
+                               const GtScoreHandler *scorehandler,
+                               bool affine,
+                               const GtUchar *useq,
+                               GtUword ustart,
+                               GtUword ulen,
+                               const GtUchar *vseq,
+                               GtUword vstart,
+                               GtUword vlen)
+{
+  gt_assert(uend != NULL && vend != NULL);
+  return gt_stripedalign_scorehandler(score, uend, vend, scorehandler, false,
+                                      affine, useq, ustart, ulen,
+                                      vseq, vstart, vlen);
+}
+
+bool gt_stripedalign_local_scorematrix(GtWord *score,
+                                       GtUword *uend,
+                                       GtUword *vend,
+                                       const int **scores,
+                                       unsigned int u_alpha_size,
+                                       unsigned int v_alpha_size,
+                                       int deletion_score,
+                                       int insertion_score,
+                                       const GtUchar *u,
+                                       GtUword ulen,
+                                       const GtUchar *v,
+                                       GtUword vlen)
+{
+  GtStripedalignProblem problem;
+  GtUword idx, row;
+
+  gt_assert(score != NULL && uend != NULL && vend != NULL && scores != NULL &&
+            u_alpha_size > 0 && v_alpha_size > 0);
+  if (ulen == 0 || vlen == 0 || deletion_score > 0 || insertion_score > 0)
+  {
+    return false;
+  }
+  problem.ins_open = problem.ins_extend = -(GtWord) insertion_score;
+  problem.del_open = problem.del_extend = -(GtWord) deletion_score;
+  gt_stripedalign_problem_init(&problem, v, ulen, vlen);
+  for (idx = 0; idx <= UCHAR_MAX; idx++)
+  {
+    if (problem.symbolindex[idx] >= 0)
+    {
+      GtWord *profile = problem.scores + problem.symbolindex[idx] * ulen;
+      const unsigned int vval = idx == GT_WILDCARD ? v_alpha_size - 1
+                                                   : (unsigned int) idx;
+
+      for (row = 0; row < ulen; row++)
+      {
+        const unsigned int uval = u[row] == GT_WILDCARD ? u_alpha_size - 1
+                                                        : u[row];
+
+        profile[row] = scores[uval][vval];
+      }
+    }
+  }
+  return gt_stripedalign_solve(score, uend, vend, false, &problem);
+}
+
+#else
+
+bool gt_stripedalign_score(GT_UNUSED GtWord *score,
+                           GT_UNUSED const GtScoreHandler *scorehandler,
+                           GT_UNUSED bool global,
+                           GT_UNUSED bool affine,
+                           GT_UNUSED const GtUchar *useq,
+                           GT_UNUSED GtUword ustart,
+                           GT_UNUSED GtUword ulen,
+                           GT_UNUSED const GtUchar *vseq,
+                           GT_UNUSED GtUword vstart,
+                           GT_UNUSED GtUword vlen)
+{
+  return false;
+}
+
+bool gt_stripedalign_local_end(GT_UNUSED GtWord *score,
+                               GT_UNUSED GtUword *uend,
+                               GT_UNUSED GtUword *vend,
+                               GT_UNUSED const GtScoreHandler *scorehandler,
+                               GT_UNUSED bool affine,
+                               GT_UNUSED const GtUchar *useq,
+                               GT_UNUSED GtUword ustart,
+                               GT_UNUSED GtUword ulen,
+                               GT_UNUSED const GtUchar *vseq,
+                               GT_UNUSED GtUword vstart,
+                               GT_UNUSED GtUword vlen)
+{
+  return false;
+}
+
+bool gt_stripedalign_local_scorematrix(GT_UNUSED GtWord *score,
+                                       GT_UNUSED GtUword *uend,
+                                       GT_UNUSED GtUword *vend,
+                                       GT_UNUSED const int **scores,
+                                       GT_UNUSED unsigned int u_alpha_size,
+                                       GT_UNUSED unsigned int v_alpha_size,
+                                       GT_UNUSED int deletion_score,
+                                       GT_UNUSED int insertion_score,
+                                       GT_UNUSED const GtUchar *u,
+                                       GT_UNUSED GtUword ulen,
+                                       GT_UNUSED const GtUchar *v,
+                                       GT_UNUSED GtUword vlen)
+{
+  return false;
+}
+
+#endif
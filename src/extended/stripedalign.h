@@ -0,0 +1,86 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef STRIPEDALIGN_H
+#define STRIPEDALIGN_H
+
+#include <stdbool.h>
+#include "core/types_api.h"
+#include "extended/scorehandler.h"
+
+/* Computes the score of an optimal alignment of the regions of <useq> and
+   <vseq> given by their start positions <ustart> and <vstart> and lengths
+   <ulen> and <vlen>, without the alignment itself. The values are computed
+   in striped SIMD vectors of 8 bit (local alignments only) or 16 bit
+   saturated integers. If <global>, the distance of a global alignment with
+   the cost values of <scorehandler> is stored in <score>, otherwise the
+   score of a local alignment with the score values of <scorehandler>. If
+   <affine>, a gap of length k is evaluated by gap_opening + k *
+   gap_extension, otherwise by k * gap_extension. Returns false if the
+   values may not fit into 16 bits or if no SIMD instructions are
+   available. Then <score> is undefined and the caller has to compute the
+   score with the 64 bit algorithms. */
+bool gt_stripedalign_score(GtWord *score,
+                           const GtScoreHandler *scorehandler,
+                           bool global,
+                           bool affine,
+                           const GtUchar *useq,
+                           GtUword ustart,
+                           GtUword ulen,
+                           const GtUchar *vseq,
+                           GtUword vstart,
+                           GtUword vlen);
+
+/* Computes the score of an optimal local alignment like
+   gt_stripedalign_score and, if the score stored in <score> is positive,
+   the end of the alignment: it ends with the <uend>-th symbol of the region
+   of <useq> and the <vend>-th symbol of the region of <vseq>. Of several
+   ends with the maximal score, the first one in the order of the columns
+   (positions of <vseq>) and of the rows within a column is chosen. Returns
+   false in the same cases as gt_stripedalign_score. */
+bool gt_stripedalign_local_end(GtWord *score,
+                               GtUword *uend,
+                               GtUword *vend,
+                               const GtScoreHandler *scorehandler,
+                               bool affine,
+                               const GtUchar *useq,
+                               GtUword ustart,
+                               GtUword ulen,
+                               const GtUchar *vseq,
+                               GtUword vstart,
+                               GtUword vlen);
+
+/* Like gt_stripedalign_local_end, for the local alignment of <u> and <v>
+   with linear gap costs, where the symbols a of <u> and b of <v> score
+   <scores>[a][b], a gap symbol in <v> scores <deletion_score> and a gap
+   symbol in <u> scores <insertion_score>. Wildcards are scored like the
+   last symbol of the alphabet of size <u_alpha_size> resp.
+   <v_alpha_size>. */
+bool gt_stripedalign_local_scorematrix(GtWord *score,
+                                       GtUword *uend,
+                                       GtUword *vend,
+                                       const int **scores,
+                                       unsigned int u_alpha_size,
+                                       unsigned int v_alpha_size,
+                                       int deletion_score,
+                                       int insertion_score,
+                                       const GtUchar *u,
+                                       GtUword ulen,
+                                       const GtUchar *v,
+                                       GtUword vlen);
+
+#endif
@@ -19,8 +19,10 @@
 #include "core/array2dim_api.h"
 #include "core/assert_api.h"
 #include "core/chardef_api.h"
+#include "core/ma_api.h"
 #include "core/minmax_api.h"
 #include "core/undef_api.h"
+#include "extended/stripedalign.h"
 #include "extended/swalign.h"
 
 typedef struct {
@@ -70,6 +72,60 @@ static void swalign_fill_table(DPentry **dptable,
   }
 }
 
+/* Computes the same scores as <swalign_fill_table>, column by column in
+   linear space, and determines the coordinate of the maximal score in the
+   same order. The scores of each symbol of <v> against all symbols of <u>
+   are looked up in a profile computed once. Returns the maximal score.
+   Used if the scores do not fit into the striped SIMD vectors of
+   gt_stripedalign_local_scorematrix. */
+static GtWord swalign_maxscore(const GtUchar *u, GtUword ulen,
+                               const GtUchar *v, GtUword vlen,
+                               const int **scores,
+                               int deletion_score, int insertion_score,
+                               Coordinate *max_coordinate,
+                               unsigned int u_alpha_size,
+                               unsigned int v_alpha_size)
+{
+  GtUword i, j;
+  GtWord *column, *profile, overall_maxscore = LONG_MIN;
+  gt_assert(u && ulen && v && vlen && max_coordinate && u_alpha_size
+            && v_alpha_size);
+  profile = gt_malloc(sizeof *profile * v_alpha_size * ulen);
+  for (i = 0; i < ulen; i++) {
+    unsigned int vval;
+    int uval = (int) ((u[i] == GT_WILDCARD) ? u_alpha_size - 1 : u[i]);
+    for (vval = 0; vval < v_alpha_size; vval++)
+      profile[vval * ulen + i] = scores[uval][vval];
+  }
+  column = gt_calloc((size_t) (ulen + 1), sizeof *column);
+  for (j = 1; j <= vlen; j++) {
+    const GtWord *vprofile
+      = profile + ((v[j-1] == GT_WILDCARD) ? v_alpha_size - 1 : v[j-1]) * ulen;
+    GtWord northwest = column[0];
+    for (i = 1; i <= ulen; i++) {
+      GtWord maxscore = northwest + vprofile[i-1],
+             delscore = column[i-1] + deletion_score,
+             insscore = column[i] + insertion_score;
+      northwest = column[i];
+      if (delscore > maxscore)
+        maxscore = delscore;
+      if (insscore > maxscore)
+        maxscore = insscore;
+      if (maxscore < 0)
+        maxscore = 0;
+      column[i] = maxscore;
+      if (maxscore > overall_maxscore) {
+        overall_maxscore = maxscore;
+        max_coordinate->x = i;
+        max_coordinate->y = j;
+      }
+    }
+  }
+  gt_free(column);
+  gt_free(profile);
+  return overall_maxscore;
+}
+
 static Coordinate traceback(GtAlignment *a, DPentry **dptable,
                             GtUword i, GtUword j)
 {
@@ -117,12 +173,33 @@ static GtAlignment* smith_waterman_align(const char *u_orig,
   GtRange urange, vrange;
   DPentry **dptable;
   GtAlignment *a = NULL;
+  GtWord maxscore;
+  if (!gt_stripedalign_local_scorematrix(&maxscore, &alignment_end.x,
+                                         &alignment_end.y, scores,
+                                         gt_alphabet_size(u_alpha),
+                                         gt_alphabet_size(v_alpha),
+                                         deletion_score, insertion_score,
+                                         u_enc, u_len, v_enc, v_len)) {
+    maxscore = swalign_maxscore(u_enc, u_len, v_enc, v_len, scores,
+                                deletion_score, insertion_score,
+                                &alignment_end, gt_alphabet_size(u_alpha),
+                                gt_alphabet_size(v_alpha));
+  }
+  if (maxscore == 0) {
+    /* no (positive) score was computed, so no traceback is required */
+    return NULL;
+  }
+  gt_assert(alignment_end.x != GT_UNDEF_UWORD);
+  gt_assert(alignment_end.y != GT_UNDEF_UWORD);
+  /* the traceback starts at the end of the alignment, hence only the
+     entries of the DP matrix up to this end are required */
+  u_len = alignment_end.x;
+  v_len = alignment_end.y;
   gt_array2dim_calloc(dptable, u_len+1, v_len+1);
   swalign_fill_table(dptable, u_enc, u_len, v_enc, v_len, scores,
                      deletion_score, insertion_score, &alignment_end,
                      gt_alphabet_size(u_alpha), gt_alphabet_size(v_alpha));
-  gt_assert(alignment_end.x != GT_UNDEF_UWORD);
-  gt_assert(alignment_end.y != GT_UNDEF_UWORD);
+  gt_assert(alignment_end.x == u_len && alignment_end.y == v_len);
   if (dptable[alignment_end.x][alignment_end.y].score) {
     /* construct only an alignment if a (positive) score was computed */
     a = gt_alignment_new();
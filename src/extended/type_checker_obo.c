@@ -19,6 +19,7 @@
 #include "core/cstr_api.h"
 #include "core/cstr_table.h"
 #include "core/ma_api.h"
+#include "core/thread_api.h"
 #include "extended/obo_parse_tree.h"
 #include "extended/type_checker_obo.h"
 #include "extended/type_checker_rep.h"
@@ -29,6 +30,7 @@ struct GtTypeCheckerOBO {
   GtStr *description;
   GtCstrTable *feature_node_types;
   GtTypeGraph *type_graph;
+  GtRWLock *type_graph_lock; /* the type graph caches part_of lookups */
 };
 
 #define gt_type_checker_obo_cast(FTF)\
@@ -38,6 +40,7 @@ static void gt_type_checker_obo_free(GtTypeChecker *tc)
 {
   GtTypeCheckerOBO *tco = gt_type_checker_obo_cast(tc);
   gt_type_graph_delete(tco->type_graph);
+  gt_rwlock_delete(tco->type_graph_lock);
   gt_cstr_table_delete(tco->feature_node_types);
   gt_str_delete(tco->description);
 }
@@ -63,9 +66,21 @@ static bool gt_type_checker_obo_is_partof(GtTypeChecker *tc,
                                           const char *child_type)
 {
   GtTypeCheckerOBO *tco;
+  bool rval, cached;
   gt_assert(tc && parent_type && child_type);
   tco = gt_type_checker_obo_cast(tc);
-  return gt_type_graph_is_partof(tco->type_graph, parent_type, child_type);
+  /* answered lookups can be repeated concurrently, only new ones have to
+     update the cache of the type graph exclusively */
+  gt_rwlock_rdlock(tco->type_graph_lock);
+  cached = gt_type_graph_is_partof_cached(tco->type_graph, parent_type,
+                                          child_type, &rval);
+  gt_rwlock_unlock(tco->type_graph_lock);
+  if (!cached) {
+    gt_rwlock_wrlock(tco->type_graph_lock);
+    rval = gt_type_graph_is_partof(tco->type_graph, parent_type, child_type);
+    gt_rwlock_unlock(tco->type_graph_lock);
+  }
+  return rval;
 }
 
 static bool gt_type_checker_obo_is_a(GtTypeChecker *tc,
@@ -73,9 +88,20 @@ static bool gt_type_checker_obo_is_a(GtTypeChecker *tc,
                                           const char *child_type)
 {
   GtTypeCheckerOBO *tco;
+  bool rval, ready;
   gt_assert(tc && parent_type && child_type);
   tco = gt_type_checker_obo_cast(tc);
-  return gt_type_graph_is_a(tco->type_graph, parent_type, child_type);
+  /* only the first query builds the type graph */
+  gt_rwlock_rdlock(tco->type_graph_lock);
+  ready = gt_type_graph_is_a_ready(tco->type_graph, parent_type, child_type,
+                                   &rval);
+  gt_rwlock_unlock(tco->type_graph_lock);
+  if (!ready) {
+    gt_rwlock_wrlock(tco->type_graph_lock);
+    rval = gt_type_graph_is_a(tco->type_graph, parent_type, child_type);
+    gt_rwlock_unlock(tco->type_graph_lock);
+  }
+  return rval;
 }
 
 const GtTypeCheckerClass* gt_type_checker_obo_class(void)
@@ -147,6 +173,7 @@ GtTypeChecker* gt_type_checker_obo_new(const char *obo_file_path, GtError *err)
   gt_str_append_cstr(tco->description, obo_file_path);
   tco->feature_node_types = gt_cstr_table_new();
   tco->type_graph = gt_type_graph_new();
+  tco->type_graph_lock = gt_rwlock_new();
   if (create_feature_nodes(tco, obo_file_path, err)) {
     gt_type_checker_delete(tc);
     return NULL;
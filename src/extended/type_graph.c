@@ -186,6 +186,26 @@ bool gt_type_graph_is_partof(GtTypeGraph *type_graph, const char *parent_type,
                                  type_graph->nodes, type_graph->id2name, 0);
 }
 
+bool gt_type_graph_is_partof_cached(const GtTypeGraph *type_graph,
+                                    const char *parent_type,
+                                    const char *child_type, bool *result)
+{
+  const char *parent_id, *child_id;
+  GtTypeNode *parent_node, *child_node;
+  gt_assert(type_graph && parent_type && child_type && result);
+  if (!type_graph->ready)
+    return false;
+  if (!(parent_id = gt_hashmap_get(type_graph->name2id, parent_type)))
+    parent_id = parent_type;
+  if (!(child_id = gt_hashmap_get(type_graph->name2id, child_type)))
+    child_id = child_type;
+  parent_node = gt_hashmap_get(type_graph->nodemap, parent_id);
+  gt_assert(parent_node);
+  child_node = gt_hashmap_get(type_graph->nodemap, child_id);
+  gt_assert(child_node);
+  return gt_type_node_has_parent_cached(child_node, parent_node, result);
+}
+
 bool gt_type_graph_is_a(GtTypeGraph *type_graph, const char *parent_type,
                         const char *child_type)
 {
@@ -209,3 +229,22 @@ bool gt_type_graph_is_a(GtTypeGraph *type_graph, const char *parent_type,
   /* check for parent */
   return gt_type_node_is_a(child_node, parent_id);
 }
+
+bool gt_type_graph_is_a_ready(const GtTypeGraph *type_graph,
+                              const char *parent_type, const char *child_type,
+                              bool *result)
+{
+  const char *parent_id, *child_id;
+  GtTypeNode *child_node;
+  gt_assert(type_graph && parent_type && child_type && result);
+  if (!type_graph->ready)
+    return false;
+  if (!(parent_id = gt_hashmap_get(type_graph->name2id, parent_type)))
+    parent_id = parent_type;
+  if (!(child_id = gt_hashmap_get(type_graph->name2id, child_type)))
+    child_id = child_type;
+  child_node = gt_hashmap_get(type_graph->nodemap, child_id);
+  gt_assert(child_node);
+  *result = gt_type_node_is_a(child_node, parent_id);
+  return true;
+}
@@ -28,8 +28,23 @@ void         gt_type_graph_add_stanza(GtTypeGraph *type_graph,
 bool         gt_type_graph_is_partof(GtTypeGraph *type_graph,
                                      const char *parent_type,
                                      const char *child_type);
+/* Like gt_type_graph_is_partof(), but only answers from the results of
+   previous calls of gt_type_graph_is_partof() and does not modify
+   <type_graph>. Returns true and stores the answer in <result>, if it is
+   known. Otherwise false is returned. */
+bool         gt_type_graph_is_partof_cached(const GtTypeGraph *type_graph,
+                                            const char *parent_type,
+                                            const char *child_type,
+                                            bool *result);
 bool         gt_type_graph_is_a(GtTypeGraph *type_graph,
                                 const char *parent_type,
                                 const char *child_type);
+/* Like gt_type_graph_is_a(), but does not modify <type_graph>. Returns true
+   and stores the answer in <result>, if <type_graph> has been built by a
+   previous query already. Otherwise false is returned. */
+bool         gt_type_graph_is_a_ready(const GtTypeGraph *type_graph,
+                                      const char *parent_type,
+                                      const char *child_type,
+                                      bool *result);
 
 #endif
@@ -235,6 +235,18 @@ bool gt_type_node_has_parent(GtTypeNode *node, GtTypeNode *pnode,
   return false;
 }
 
+bool gt_type_node_has_parent_cached(const GtTypeNode *node,
+                                    const GtTypeNode *pnode, bool *result)
+{
+  bool *cached;
+  gt_assert(node && pnode && result);
+  if (node->cache && (cached = gt_hashmap_get(node->cache, pnode->id))) {
+    *result = *cached;
+    return true;
+  }
+  return false;
+}
+
 bool gt_type_node_is_a(GtTypeNode *child_node, const char *parent_id)
 {
   GtUword i;
@@ -42,6 +42,13 @@ bool          gt_type_node_has_parent(GtTypeNode *node, GtTypeNode *pnode,
                                       GtBoolMatrix *part_of_in_edges,
                                       GtArray *node_list, GtHashmap *id2name,
                                       unsigned int indentlevel);
+/* Returns true if a previous call of gt_type_node_has_parent() has determined
+   whether the given <node> has the parent <pnode> and stores the answer in
+   <result>. In contrast to gt_type_node_has_parent(), <node> is not modified.
+ */
+bool          gt_type_node_has_parent_cached(const GtTypeNode *node,
+                                             const GtTypeNode *pnode,
+                                             bool *result);
 bool          gt_type_node_is_a(GtTypeNode *child_node,
                                 const char *parent_id);
 
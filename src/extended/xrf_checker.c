@@ -28,7 +28,6 @@
 struct GtXRFChecker {
   GtHashmap *abbrvs;
   GtXRFAbbrParseTree *xpt;
-  GtSplitter *splitter;
   GtUword reference_count;
 };
 
@@ -46,17 +45,18 @@ bool gt_xrf_checker_is_valid(GtXRFChecker *xrc, const char *value, GtError *err)
        *dbid = NULL,
        *localid = NULL;
   GtXRFAbbrEntry *e;
+  GtSplitter *splitter;
   GtUword nof_tokens, i;
   gt_assert(xrc && value);
   gt_error_check(err);
 
-  /* XXX: Thread safety! */
-  gt_splitter_reset(xrc->splitter);
-  gt_splitter_split(xrc->splitter, myvalue, strlen(myvalue), ',');
-  nof_tokens = gt_splitter_size(xrc->splitter);
+  /* a local splitter keeps the checker usable from several threads */
+  splitter = gt_splitter_new();
+  gt_splitter_split(splitter, myvalue, strlen(myvalue), ',');
+  nof_tokens = gt_splitter_size(splitter);
 
   for (i = 0; valid && i < nof_tokens; i++) {
-    dbid = gt_splitter_get_token(xrc->splitter, i);
+    dbid = gt_splitter_get_token(splitter, i);
 
     if (!(localid = strchr(dbid, ':'))) {
       gt_error_set(err, "xref \"%s\": separator colon missing", value);
@@ -98,6 +98,7 @@ bool gt_xrf_checker_is_valid(GtXRFChecker *xrc, const char *value, GtError *err)
     }
   }
 
+  gt_splitter_delete(splitter);
   gt_free(myvalue);
   return valid;
 }
@@ -126,7 +127,6 @@ GtXRFChecker* gt_xrf_checker_new(const char *file_path, GtError *err)
       gt_hashmap_add(xrc->abbrvs, (void*) synonym, (void*) e);
     }
   }
-  xrc->splitter = gt_splitter_new();
   return xrc;
 }
 
@@ -139,6 +139,5 @@ void gt_xrf_checker_delete(GtXRFChecker *xrc)
   }
   gt_xrf_abbr_parse_tree_delete(xrc->xpt);
   gt_hashmap_delete(xrc->abbrvs);
-  gt_splitter_delete(xrc->splitter);
   gt_free(xrc);
 }
@@ -55,6 +55,7 @@ extern "C" {
 #include "core/grep_api.h"
 #include "core/hashmap_api.h"
 #include "core/init_api.h"
+#include "core/interval_index_api.h"
 #include "core/interval_tree_api.h"
 #include "core/log_api.h"
 #include "core/logger_api.h"
@@ -106,6 +107,7 @@ extern "C" {
 #include "extended/eof_node_api.h"
 #include "extended/extract_feature_stream_api.h"
 #include "extended/feature_index_api.h"
+#include "extended/feature_index_mapped_api.h"
 #include "extended/feature_index_memory_api.h"
 #include "extended/feature_in_stream_api.h"
 #include "extended/feature_node_api.h"
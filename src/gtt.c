@@ -42,11 +42,13 @@
 #include "core/grep_api.h"
 #include "core/hashmap_api.h"
 #include "core/hashtable.h"
+#include "core/interval_index.h"
 #include "core/interval_tree.h"
 #include "core/mathsupport_api.h"
 #include "core/md5_seqid_api.h"
 #include "core/quality.h"
 #include "core/queue.h"
+#include "core/seqid_tab.h"
 #include "core/sequence_buffer.h"
 #include "core/splitter.h"
 #include "core/symbol.h"
@@ -62,10 +64,12 @@
 #include "extended/evaluator.h"
 #include "extended/feature_in_stream.h"
 #include "extended/feature_index.h"
+#include "extended/feature_index_mapped.h"
 #include "extended/feature_index_memory.h"
 #include "extended/feature_node.h"
 #include "extended/feature_node_iterator_api.h"
 #include "extended/genome_node.h"
+#include "extended/genome_node_arena.h"
 #include "extended/gff3_escaping_api.h"
 #include "extended/golomb.h"
 #include "extended/hmm.h"
@@ -88,6 +92,7 @@
 #include "ltr/gt_ltrharvest.h"
 #include "ltr/ltrdigest_pbs_visitor.h"
 #include "match/karlin_altschul_stat.h"
+#include "match/ordered_output.h"
 #include "match/rdj-spmlist.h"
 #include "match/rdj-strgraph.h"
 #include "match/shu-encseq-gc.h"
@@ -266,10 +271,8 @@ GtToolbox* gtt_tools(void)
   gt_toolbox_add_tool(tools, "sketch", gt_sketch());
   gt_toolbox_add_tool(tools, "sketch_page", gt_sketch_page());
 #endif
-#if defined (HAVE_MYSQL) || defined (HAVE_SQLITE)
   gt_toolbox_add_tool(tools, "featureindex", gt_featureindex());
   gt_toolbox_add_tool(tools, "mkfeatureindex", gt_mkfeatureindex());
-#endif
 
   return tools;
 }
@@ -327,6 +330,10 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "feature node class", gt_feature_node_unit_test);
   gt_hashmap_add(unit_tests, "feature in stream class",
                                                 gt_feature_in_stream_unit_test);
+  gt_hashmap_add(unit_tests, "mapped feature index class",
+                 gt_feature_index_mapped_unit_test);
+  gt_hashmap_add(unit_tests, "genome node arena",
+                 gt_genome_node_arena_unit_test);
   gt_hashmap_add(unit_tests, "genome node class", gt_genome_node_unit_test);
   gt_hashmap_add(unit_tests, "gff3 escaping module",
                                                     gt_gff3_escaping_unit_test);
@@ -336,6 +343,8 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "hashtable class", gt_hashtable_unit_test);
   gt_hashmap_add(unit_tests, "hmm class", gt_hmm_unit_test);
   gt_hashmap_add(unit_tests, "huffman coding class", gt_huffman_unit_test);
+  gt_hashmap_add(unit_tests, "interval index class",
+                 gt_interval_index_unit_test);
   gt_hashmap_add(unit_tests, "interval tree class", gt_interval_tree_unit_test);
   gt_hashmap_add(unit_tests, "intset classes", gt_intset_unit_test);
   gt_hashmap_add(unit_tests, "karlin altschul class",
@@ -349,6 +358,8 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "MD5 seqid module", gt_md5_seqid_unit_test);
   gt_hashmap_add(unit_tests, "rdj: suffix-prefix matches list module",
                                                           gt_spmlist_unit_test);
+  gt_hashmap_add(unit_tests, "ordered output class",
+                             gt_ordered_output_unit_test);
   gt_hashmap_add(unit_tests, "PBS finder module",
                                             gt_ltrdigest_pbs_visitor_unit_test);
   gt_hashmap_add(unit_tests, "popcount sorted tab", gt_popcount_tab_unit_test);
@@ -363,6 +374,7 @@ GtHashmap* gtt_unit_tests(void)
                              gt_priority_queue_unit_test);
   gt_hashmap_add(unit_tests, "safearith example", gt_safearith_example);
   gt_hashmap_add(unit_tests, "safearith module", gt_safearith_unit_test);
+  gt_hashmap_add(unit_tests, "seqid table class", gt_seqid_tab_unit_test);
   gt_hashmap_add(unit_tests, "sequence buffer class",
                                                   gt_sequence_buffer_unit_test);
   gt_hashmap_add(unit_tests, "splicedseq class", gt_splicedseq_unit_test);
@@ -24,6 +24,7 @@
 #include <float.h>
 #include <math.h>
 #include "core/arraydef_api.h"
+#include "core/bitbuffer.h"
 #include "core/codetype.h"
 #include "core/complement.h"
 #include "core/cstr_api.h"
@@ -53,6 +54,7 @@
 #include "match/diagband-struct.h"
 #include "match/dbs_spaced_seeds.h"
 #include "match/diagbandseed.h"
+#include "match/ordered_output.h"
 
 #ifdef GT_THREADS_ENABLED
 #include "core/thread_api.h"
@@ -61,6 +63,12 @@
 /* We need to use 6 digits for the micro seconds */
 #define GT_DIAGBANDSEED_FMT          "in " GT_WD ".%06ld seconds.\n"
 
+/* The number of bytes of output buffered for units of parallel processing
+   waiting for previous units, before the threads wait for these, and the
+   number of sections per thread a list of seed pairs is split into. */
+#define GT_DIAGBANDSEED_MAXBUFFERED         ((size_t) 1 << 26)
+#define GT_DIAGBANDSEED_SECTIONS_PER_THREAD 4U
+
 typedef uint32_t GtDiagbandseedSeqnum;
 
 typedef struct { /* 8 + 4 + 4 bytes */
@@ -812,62 +820,21 @@ static GtUword gt_diagbandseed_longest_code_run(const GtKmerPosList
   return longest_code_run;
 }
 
-/* Return a sorted list of k-mers of given seedlength from specified encseq.
- * Only sequences in seqrange will be taken into account.
- * The caller is responsible for freeing the result. */
-static GtKmerPosList *gt_diagbandseed_get_kmers(
+/* Add the k-mers of the sequences seqrange_start..seqrange_end of encseq
+   to kmerpos_list, in the order of their positions. */
+static void gt_diagbandseed_collect_kmers(GtKmerPosList *kmerpos_list,
                                    const GtEncseq *encseq,
                                    unsigned int spacedseedweight,
                                    unsigned int seedlength,
                                    const GtSpacedSeedSpec *spaced_seed_spec,
                                    GtReadmode readmode,
                                    GtUword seqrange_start,
-                                   GtUword seqrange_end,
-                                   const GtKmerPosListEncodeInfo *encode_info,
-                                   bool debug_kmer,
-                                   bool verbose,
-                                   GtUword known_size,
-                                   FILE *stream)
+                                   GtUword seqrange_end)
 {
-  GtKmerPosList *kmerpos_list;
   GtDiagbandseedProcKmerInfo pkinfo;
   GtRange specialrange;
-  GtTimer *timer = NULL;
-  GtUword kmerpos_list_len, totallength;
-
-  gt_assert(encseq != NULL);
-  totallength = gt_encseq_total_length(encseq);
-  if (known_size > 0)
-  {
-    kmerpos_list_len = known_size;
-  } else
-  {
-    kmerpos_list_len = gt_seed_extend_numofkmers(encseq, seedlength,
-                                                 seqrange_start, seqrange_end);
-    gt_assert(kmerpos_list_len > 0);
-  }
-  kmerpos_list = gt_kmerpos_list_new(kmerpos_list_len,encode_info);
-  if (verbose) {
-    GtBitcount_type bits_kmerpos;
+  const GtUword totallength = gt_encseq_total_length(encseq);
 
-    if (encode_info != NULL)
-    {
-      bits_kmerpos = encode_info->bits_kmerpos;
-    } else
-    {
-      bits_kmerpos = sizeof (GtDiagbandseedKmerPos) * CHAR_BIT;
-    }
-    fprintf(stream, "# start fetching %u-mers (%hu bits/" GT_WU " bytes each, "
-                    "expect " GT_WU ", allocate %.0f MB) ...\n",
-            seedlength,
-            bits_kmerpos,
-            (GtUword) gt_kmerpos_list_elem_size(kmerpos_list),
-            kmerpos_list_len,
-            GT_MEGABYTES(kmerpos_list_len *
-                         gt_kmerpos_list_elem_size(kmerpos_list)));
-    timer = gt_timer_new();
-    gt_timer_start(timer);
-  }
   pkinfo.kmerpos_list_ref = kmerpos_list;
   pkinfo.current_seqnum = seqrange_start;
   pkinfo.current_endpos = 0;
@@ -926,6 +893,341 @@ static GtKmerPosList *gt_diagbandseed_get_kmers(
   if (gt_encseq_has_specialranges(encseq)) {
     gt_specialrangeiterator_delete(pkinfo.sri);
   }
+}
+
+/* Run threadfunc for each of the numofparts elements of size sizeofpart
+   stored in parts. The first part is processed by the calling thread. If
+   a thread cannot be created, its part is processed by the calling thread
+   after the others have been started. */
+static void gt_diagbandseed_parts_run(void *(*threadfunc)(void *),
+                                      void *parts,
+                                      size_t sizeofpart,
+                                      unsigned int numofparts)
+{
+#ifdef GT_THREADS_ENABLED
+  GtThread **threads = gt_malloc(sizeof *threads * numofparts);
+  unsigned int part;
+
+  threads[0] = NULL;
+  for (part = 1U; part < numofparts; part++)
+  {
+    threads[part] = gt_thread_new(threadfunc,
+                                  (char *) parts + part * sizeofpart,NULL);
+  }
+  (void) threadfunc(parts);
+  for (part = 1U; part < numofparts; part++)
+  {
+    if (threads[part] != NULL)
+    {
+      gt_thread_join(threads[part]);
+      gt_thread_delete(threads[part]);
+    } else
+    {
+      (void) threadfunc((char *) parts + part * sizeofpart);
+    }
+  }
+  gt_free(threads);
+#else
+  unsigned int part;
+
+  for (part = 0; part < numofparts; part++)
+  {
+    (void) threadfunc((char *) parts + part * sizeofpart);
+  }
+#endif
+}
+
+typedef struct
+{
+  GtKmerPosList slice;
+  const GtEncseq *encseq;
+  unsigned int spacedseedweight,
+               seedlength;
+  const GtSpacedSeedSpec *spaced_seed_spec;
+  GtReadmode readmode;
+  GtUword seqrange_start,
+          seqrange_end,
+          offset;
+} GtDiagbandseedKmerPart;
+
+static void *gt_diagbandseed_kmer_part_thread(void *data)
+{
+  GtDiagbandseedKmerPart *part = (GtDiagbandseedKmerPart *) data;
+
+  gt_diagbandseed_collect_kmers(&part->slice,
+                                part->encseq,
+                                part->spacedseedweight,
+                                part->seedlength,
+                                part->spaced_seed_spec,
+                                part->readmode,
+                                part->seqrange_start,
+                                part->seqrange_end);
+  return NULL;
+}
+
+/* Split the sequences seqrange_start..seqrange_end into at most numofparts
+   ranges of consecutive sequences of about the same total length. The
+   ranges are stored in parts, their number is returned. */
+static unsigned int gt_diagbandseed_kmer_parts_split(
+                                        GtDiagbandseedKmerPart *parts,
+                                        const GtEncseq *encseq,
+                                        GtUword seqrange_start,
+                                        GtUword seqrange_end,
+                                        unsigned int numofparts)
+{
+  const GtUword firstpos = gt_encseq_seqstartpos(encseq,seqrange_start),
+                width = gt_encseq_seqstartpos(encseq,seqrange_end) +
+                        gt_encseq_seqlength(encseq,seqrange_end) - firstpos;
+  unsigned int part, numofranges = 0;
+
+  for (part = 0; part < numofparts; part++)
+  {
+    GtUword seqnum = seqrange_start;
+
+    if (part > 0)
+    {
+      GtUword pos = firstpos + (GtUword) ((double) width * part / numofparts);
+
+      if (gt_encseq_position_is_separator(encseq,pos,GT_READMODE_FORWARD))
+      {
+        pos++;
+      }
+      seqnum = gt_encseq_seqnum(encseq,pos);
+    }
+    gt_assert(seqnum <= seqrange_end);
+    if (numofranges == 0 || seqnum > parts[numofranges-1].seqrange_start)
+    {
+      if (numofranges > 0)
+      {
+        parts[numofranges-1].seqrange_end = seqnum - 1;
+      }
+      parts[numofranges++].seqrange_start = seqnum;
+    }
+  }
+  parts[numofranges-1].seqrange_end = seqrange_end;
+  return numofranges;
+}
+
+/* Return the number of k-mers of the sequences seqrange_start..seqrange_end,
+   i.e. the number of windows of length seedlength without a special
+   character. This only iterates over the special ranges. */
+static GtUword gt_diagbandseed_numofkmers_exact(const GtEncseq *encseq,
+                                                unsigned int seedlength,
+                                                GtUword seqrange_start,
+                                                GtUword seqrange_end)
+{
+  const GtUword firstpos = gt_encseq_seqstartpos(encseq,seqrange_start),
+                endpos = gt_encseq_seqstartpos(encseq,seqrange_end) +
+                         gt_encseq_seqlength(encseq,seqrange_end);
+  GtUword runstart = firstpos, numofkmers = 0;
+
+  if (gt_encseq_has_specialranges(encseq))
+  {
+    GtSpecialrangeiterator *sri = gt_specialrangeiterator_new(encseq,true);
+    GtRange range;
+
+    while (gt_specialrangeiterator_next(sri,&range) && range.start < endpos)
+    {
+      if (range.end <= runstart)
+      {
+        continue;
+      }
+      if (range.start >= runstart + seedlength)
+      {
+        numofkmers += range.start - runstart - seedlength + 1;
+      }
+      runstart = range.end;
+    }
+    gt_specialrangeiterator_delete(sri);
+  }
+  if (endpos >= runstart + seedlength)
+  {
+    numofkmers += endpos - runstart - seedlength + 1;
+  }
+  return numofkmers;
+}
+
+/* Determine the number of k-mers of each of the numofparts parts and
+   their offsets in a common list, return the total number of k-mers. */
+static GtUword gt_diagbandseed_kmer_parts_size(GtDiagbandseedKmerPart *parts,
+                                               unsigned int numofparts,
+                                               const GtEncseq *encseq,
+                                               unsigned int seedlength)
+{
+  GtUword offset = 0;
+  unsigned int part;
+
+  for (part = 0; part < numofparts; part++)
+  {
+    parts[part].offset = offset;
+    parts[part].slice.allocated
+      = gt_diagbandseed_numofkmers_exact(encseq,seedlength,
+                                         parts[part].seqrange_start,
+                                         parts[part].seqrange_end);
+    offset += parts[part].slice.allocated;
+  }
+  return offset;
+}
+
+/* Collect the k-mers of the numofparts parts in parallel. Each part writes
+   into its own slice of kmerpos_list, whose size is the exact number of
+   k-mers of the part, so no thread needs additional space. The slices are
+   then moved together in the order of the parts, so that the result is the
+   same as for a single thread. */
+static void gt_diagbandseed_collect_kmers_threaded(GtKmerPosList *kmerpos_list,
+                                   GtDiagbandseedKmerPart *parts,
+                                   unsigned int numofparts,
+                                   const GtEncseq *encseq,
+                                   unsigned int spacedseedweight,
+                                   unsigned int seedlength,
+                                   const GtSpacedSeedSpec *spaced_seed_spec,
+                                   GtReadmode readmode)
+{
+  const size_t elem_size = gt_kmerpos_list_elem_size(kmerpos_list);
+  unsigned int part;
+
+  gt_assert(kmerpos_list->nextfree == 0);
+  for (part = 0; part < numofparts; part++)
+  {
+    GtKmerPosList *slice = &parts[part].slice;
+
+    gt_assert(parts[part].offset + slice->allocated <=
+              kmerpos_list->allocated);
+    slice->nextfree = 0;
+    slice->longest_code_run = 0;
+    slice->encode_info = kmerpos_list->encode_info;
+    if (kmerpos_list->encode_info != NULL)
+    {
+      slice->spaceGtUword = kmerpos_list->spaceGtUword + parts[part].offset;
+      slice->spaceGtDiagbandseedKmerPos = NULL;
+    } else
+    {
+      slice->spaceGtUword = NULL;
+      slice->spaceGtDiagbandseedKmerPos
+        = kmerpos_list->spaceGtDiagbandseedKmerPos + parts[part].offset;
+    }
+    parts[part].encseq = encseq;
+    parts[part].spacedseedweight = spacedseedweight;
+    parts[part].seedlength = seedlength;
+    parts[part].spaced_seed_spec = spaced_seed_spec;
+    parts[part].readmode = readmode;
+  }
+  gt_diagbandseed_parts_run(gt_diagbandseed_kmer_part_thread,parts,
+                            sizeof *parts,numofparts);
+  for (part = 0; part < numofparts; part++)
+  {
+    const GtKmerPosList *slice = &parts[part].slice;
+
+    /* the slice was sized exactly, so it has never been reallocated */
+    gt_assert(slice->nextfree == slice->allocated &&
+              kmerpos_list->nextfree <= parts[part].offset);
+    if (kmerpos_list->encode_info != NULL)
+    {
+      memmove(kmerpos_list->spaceGtUword + kmerpos_list->nextfree,
+              slice->spaceGtUword,elem_size * slice->nextfree);
+    } else
+    {
+      memmove(kmerpos_list->spaceGtDiagbandseedKmerPos +
+              kmerpos_list->nextfree,
+              slice->spaceGtDiagbandseedKmerPos,
+              elem_size * slice->nextfree);
+    }
+    kmerpos_list->nextfree += slice->nextfree;
+  }
+}
+
+/* Return a sorted list of k-mers of given seedlength from specified encseq.
+ * Only sequences in seqrange will be taken into account.
+ * If numofthreads > 1, the k-mers are collected in parallel.
+ * The caller is responsible for freeing the result. */
+static GtKmerPosList *gt_diagbandseed_get_kmers(
+                                   const GtEncseq *encseq,
+                                   unsigned int spacedseedweight,
+                                   unsigned int seedlength,
+                                   const GtSpacedSeedSpec *spaced_seed_spec,
+                                   GtReadmode readmode,
+                                   GtUword seqrange_start,
+                                   GtUword seqrange_end,
+                                   const GtKmerPosListEncodeInfo *encode_info,
+                                   bool debug_kmer,
+                                   bool verbose,
+                                   GtUword known_size,
+                                   unsigned int numofthreads,
+                                   FILE *stream)
+{
+  GtKmerPosList *kmerpos_list;
+  GtTimer *timer = NULL;
+  GtUword kmerpos_list_len;
+  GtDiagbandseedKmerPart *parts = NULL;
+  unsigned int numofparts = 0;
+
+  gt_assert(encseq != NULL && numofthreads > 0);
+  if (numofthreads > 1U && seqrange_start < seqrange_end)
+  {
+    /* the threads fill slices of a single list of the exact size */
+    parts = gt_malloc(sizeof *parts * numofthreads);
+    numofparts = gt_diagbandseed_kmer_parts_split(parts,
+                                                  encseq,
+                                                  seqrange_start,
+                                                  seqrange_end,
+                                                  numofthreads);
+    kmerpos_list_len = gt_diagbandseed_kmer_parts_size(parts,numofparts,
+                                                       encseq,seedlength);
+    gt_assert(known_size == 0 || known_size == kmerpos_list_len);
+    kmerpos_list_len = GT_MAX(kmerpos_list_len,1UL);
+  } else if (known_size > 0)
+  {
+    kmerpos_list_len = known_size;
+  } else
+  {
+    kmerpos_list_len = gt_seed_extend_numofkmers(encseq, seedlength,
+                                                 seqrange_start, seqrange_end);
+    gt_assert(kmerpos_list_len > 0);
+  }
+  kmerpos_list = gt_kmerpos_list_new(kmerpos_list_len,encode_info);
+  if (verbose) {
+    GtBitcount_type bits_kmerpos;
+
+    if (encode_info != NULL)
+    {
+      bits_kmerpos = encode_info->bits_kmerpos;
+    } else
+    {
+      bits_kmerpos = sizeof (GtDiagbandseedKmerPos) * CHAR_BIT;
+    }
+    fprintf(stream, "# start fetching %u-mers (%hu bits/" GT_WU " bytes each, "
+                    "expect " GT_WU ", allocate %.0f MB) ...\n",
+            seedlength,
+            bits_kmerpos,
+            (GtUword) gt_kmerpos_list_elem_size(kmerpos_list),
+            kmerpos_list_len,
+            GT_MEGABYTES(kmerpos_list_len *
+                         gt_kmerpos_list_elem_size(kmerpos_list)));
+    timer = gt_timer_new();
+    gt_timer_start(timer);
+  }
+  if (parts != NULL)
+  {
+    gt_diagbandseed_collect_kmers_threaded(kmerpos_list,
+                                           parts,
+                                           numofparts,
+                                           encseq,
+                                           spacedseedweight,
+                                           seedlength,
+                                           spaced_seed_spec,
+                                           readmode);
+    gt_free(parts);
+  } else
+  {
+    gt_diagbandseed_collect_kmers(kmerpos_list,
+                                  encseq,
+                                  spacedseedweight,
+                                  seedlength,
+                                  spaced_seed_spec,
+                                  readmode,
+                                  seqrange_start,
+                                  seqrange_end);
+  }
   /* reduce size of array to number of entries */
   gt_kmerpos_list_reduce_size(kmerpos_list);
   if (debug_kmer)
@@ -2443,7 +2745,7 @@ static bool gt_diagbandseed_has_overlap_with_previous_match(
 
 typedef struct
 {
-  bool b_differs_from_a, a_haswildcards, b_haswildcards;
+  bool b_differs_from_a, a_haswildcards, b_haswildcards, owns_byte_sequences;
   const GtUchar *characters;
   GtUchar wildcardshow;
   GtSeqorEncseq aseqorencseq, bseqorencseq;
@@ -2469,6 +2771,7 @@ static void gt_diagbandseed_plainsequence_init(GtDiagbandSeedPlainSequence *ps,
                                           bool with_b_bytestring)
 {
   ps->previous_aseqnum = GT_UWORD_MAX;
+  ps->owns_byte_sequences = true;
   if (s_desc_display && aencseq != NULL &&
       gt_encseq_has_description_support(aencseq))
   {
@@ -2624,6 +2927,10 @@ static void gt_diagbandseed_plainsequence_next_segment(
 static void gt_diagbandseed_plainsequence_delete(
                          GtDiagbandSeedPlainSequence *ps)
 {
+  if (!ps->owns_byte_sequences)
+  {
+    return;
+  }
   if (ps->b_byte_sequence != NULL && ps->b_differs_from_a)
   {
     gt_free(ps->b_byte_sequence);
@@ -3487,30 +3794,40 @@ static GtDiagbandseedExtendSegmentInfo *gt_diagbandseed_extendSI_new(
                                          GtSegmentRejectFunc
                                            segment_reject_func,
                                          GtSegmentRejectInfo
-                                           *segment_reject_info)
+                                           *segment_reject_info,
+                                         const GtDiagbandSeedPlainSequence
+                                           *shared_plainsequence)
 {
   GtDiagbandseedExtendSegmentInfo *esi = gt_malloc(sizeof *esi);
 
   esi->extend_relative_coords_function = extp->extendgreedy
                                             ? gt_greedy_extend_seed_relative
                                             : gt_xdrop_extend_seed_relative;
-  gt_diagbandseed_plainsequence_init(&esi->plainsequence_info,
-                                     gt_querymatch_subjectid_display(
-                                             extp->out_display_flag),
-                                     gt_querymatch_queryid_display(
-                                             extp->out_display_flag),
-                                     aencseq,
-                                     aseqranges,
-                                     aidx,
-                                     extp->a_extend_char_access ==
-                                         GT_EXTEND_CHAR_ACCESS_DIRECT ? true
-                                                                      : false,
-                                     bencseq,
-                                     bseqranges,
-                                     bidx,
-                                     extp->b_extend_char_access ==
-                                        GT_EXTEND_CHAR_ACCESS_DIRECT ? true
-                                                                     : false);
+  if (shared_plainsequence != NULL)
+  {
+    /* the sequences were extracted once for all threads */
+    esi->plainsequence_info = *shared_plainsequence;
+    esi->plainsequence_info.owns_byte_sequences = false;
+  } else
+  {
+    gt_diagbandseed_plainsequence_init(&esi->plainsequence_info,
+                                       gt_querymatch_subjectid_display(
+                                               extp->out_display_flag),
+                                       gt_querymatch_queryid_display(
+                                               extp->out_display_flag),
+                                       aencseq,
+                                       aseqranges,
+                                       aidx,
+                                       extp->a_extend_char_access ==
+                                           GT_EXTEND_CHAR_ACCESS_DIRECT ? true
+                                                                        : false,
+                                       bencseq,
+                                       bseqranges,
+                                       bidx,
+                                       extp->b_extend_char_access ==
+                                          GT_EXTEND_CHAR_ACCESS_DIRECT ? true
+                                                                       : false);
+  }
   gt_diagbandseed_info_qm_set(&esi->info_querymatch,
                               extp,
                               querymoutopt,
@@ -3600,7 +3917,9 @@ static void gt_diagbandseed_process_seeds(GtSeedpairlist *seedpairlist,
                                           GtSegmentRejectFunc
                                             segment_reject_func,
                                           GtSegmentRejectInfo
-                                            *segment_reject_info)
+                                            *segment_reject_info,
+                                          const GtDiagbandSeedPlainSequence
+                                            *shared_plainsequence)
 {
   const bool forward = query_readmode == GT_READMODE_REVCOMPL ? false : true;
   /* Although the sequences of the parts processed are shorter, we need to
@@ -3662,7 +3981,8 @@ static void gt_diagbandseed_process_seeds(GtSeedpairlist *seedpairlist,
                                          stream,
                                          dbs_state,
                                          segment_reject_func,
-                                         segment_reject_info);
+                                         segment_reject_info,
+                                         shared_plainsequence);
       if (verbose)
       {
         if (esi->plainsequence_info.a_byte_sequence != NULL ||
@@ -3955,49 +4275,523 @@ static void gt_diagbandseed_process_seeds(GtSeedpairlist *seedpairlist,
   }
 }
 
-/* * * * * ALGORITHM STEPS * * * * */
-
-static char *gt_diagbandseed_kmer_filename(const GtEncseq *encseq,
-                                           unsigned int spacedseedweight,
-                                           unsigned int seedlength,
-                                           bool forward,
-                                           unsigned int numparts,
-                                           unsigned int partindex,
-                                           GtDiagbandseedBaseListType kmplt)
+static void *gt_diagbandseed_processinfo_new(
+                                      const GtDiagbandseedExtendParams *extp,
+                                      GtFtTrimstat *trimstat,
+                                      GtFtPolishing_info **pol_info)
 {
-  char *filename;
-  GtStr *str = gt_str_new_cstr(gt_encseq_indexname(encseq));
-  if (spacedseedweight < seedlength)
-  {
-    gt_str_append_char(str, '.');
-    gt_str_append_uint(str, spacedseedweight);
+  *pol_info = NULL;
+  if (extp->extendgreedy) {
+    GtGreedyextendmatchinfo *grextinfo = NULL;
+    const double weak_errorperc = (double)(extp->weakends
+                                           ? GT_MAX(extp->errorpercentage, 20)
+                                           : extp->errorpercentage);
+
+    *pol_info = polishing_info_new_with_bias(weak_errorperc,
+                                             extp->matchscore_bias,
+                                             extp->history_size);
+    grextinfo = gt_greedy_extend_matchinfo_new(extp->maxalignedlendifference,
+                                               extp->history_size,
+                                               extp->perc_mat_history,
+                                               extp->userdefinedleastlength,
+                                               extp->errorpercentage,
+                                               extp->evalue_threshold,
+                                               extp->a_extend_char_access,
+                                               extp->b_extend_char_access,
+                                               extp->cam_generic,
+                                               extp->sensitivity,
+                                               *pol_info);
+    if (trimstat != NULL)
+    {
+      gt_greedy_extend_matchinfo_trimstat_set(grextinfo,trimstat);
+    }
+    return (void *) grextinfo;
   }
-  gt_str_append_char(str, '.');
-  gt_str_append_uint(str, seedlength);
-  gt_str_append_char(str, forward ? 'f' : 'r');
-  gt_str_append_uint(str, numparts);
-  gt_str_append_char(str, '-');
-  gt_str_append_uint(str, partindex + 1);
-  if (kmplt == GT_DIAGBANDSEED_BASE_LIST_ULONG)
-  {
-    gt_str_append_char(str, 'U');
-  } else
-  {
-    gt_assert(kmplt == GT_DIAGBANDSEED_BASE_LIST_STRUCT);
+  if (extp->extendxdrop) {
+    GtXdropmatchinfo *xdropinfo = NULL;
+    gt_assert(extp->extendgreedy == false);
+    xdropinfo = gt_xdrop_matchinfo_new(extp->userdefinedleastlength,
+                                       extp->errorpercentage,
+                                       extp->evalue_threshold,
+                                       extp->xdropbelowscore,
+                                       extp->sensitivity);
+    return (void *) xdropinfo;
   }
-  gt_str_append_cstr(str, ".kmer");
-  filename = gt_cstr_dup(gt_str_get(str));
-  gt_str_delete(str);
-  return filename;
+  return NULL;
 }
 
-static GtUword gt_numof_kmerpos_in_file(const char *filename,
-                                        GtDiagbandseedBaseListType kmplt)
+static void gt_diagbandseed_processinfo_delete(
+                                      const GtDiagbandseedExtendParams *extp,
+                                      void *processinfo,
+                                      GtFtPolishing_info *pol_info)
 {
-  off_t file_size = gt_file_size(filename);
-  size_t base_type_size = kmplt == GT_DIAGBANDSEED_BASE_LIST_STRUCT
-                            ? sizeof (GtDiagbandseedKmerPos)
-                            : sizeof (GtUword);
+  if (extp->extendgreedy)
+  {
+    polishing_info_delete(pol_info);
+    gt_greedy_extend_matchinfo_delete((GtGreedyextendmatchinfo *) processinfo);
+  } else
+  {
+    if (extp->extendxdrop)
+    {
+      gt_xdrop_matchinfo_delete((GtXdropmatchinfo *) processinfo);
+    }
+  }
+}
+
+static GtQuerymatchoutoptions *gt_diagbandseed_querymoutopt_new(
+                                      const GtDiagbandseedExtendParams *extp)
+{
+  GtQuerymatchoutoptions *querymoutopt = NULL;
+
+  if (extp->extendxdrop || extp->verify_alignment ||
+      gt_querymatch_alignment_display(extp->out_display_flag) ||
+      gt_querymatch_trace_display(extp->out_display_flag) ||
+      gt_querymatch_dtrace_display(extp->out_display_flag) ||
+      gt_querymatch_cigar_display(extp->out_display_flag) ||
+      gt_querymatch_cigarX_display(extp->out_display_flag))
+  {
+    querymoutopt = gt_querymatchoutoptions_new(extp->out_display_flag,
+                                               NULL,
+                                               NULL);
+    gt_assert(querymoutopt != NULL);
+    if (extp->extendxdrop || extp->extendgreedy) {
+      const GtUword sensitivity = extp->extendxdrop ? 100UL
+                                                    : extp->sensitivity;
+      gt_querymatchoutoptions_extend(querymoutopt,
+                                     extp->errorpercentage,
+                                     extp->evalue_threshold,
+                                     extp->maxalignedlendifference,
+                                     extp->history_size,
+                                     extp->perc_mat_history,
+                                     extp->a_extend_char_access,
+                                     extp->b_extend_char_access,
+                                     extp->cam_generic,
+                                     extp->weakends,
+                                     sensitivity,
+                                     extp->matchscore_bias,
+                                     extp->always_polished_ends,
+                                     extp->out_display_flag);
+    }
+  }
+  return querymoutopt;
+}
+
+/* A copy of the arguments for a thread, in which the ANI statistics are
+   accumulated separately. After the threads have finished, they are added
+   to the statistics of the original arguments. */
+typedef struct
+{
+  GtDiagbandseedInfo arg;
+  GtDiagbandseedExtendParams extp;
+  GtAniAccumulate ani_accumulate[2];
+} GtDiagbandseedLocalInfo;
+
+static const GtDiagbandseedInfo *gt_diagbandseed_local_info_set(
+                                        GtDiagbandseedLocalInfo *local,
+                                        const GtDiagbandseedInfo *arg)
+{
+  local->arg = *arg;
+  local->extp = *arg->extp;
+  if (arg->extp->ani_accumulate != NULL)
+  {
+    memset(local->ani_accumulate,0,sizeof local->ani_accumulate);
+    local->extp.ani_accumulate = local->ani_accumulate;
+  }
+  local->arg.extp = &local->extp;
+  return &local->arg;
+}
+
+static void gt_diagbandseed_local_info_reduce(
+                                        const GtDiagbandseedInfo *arg,
+                                        const GtDiagbandseedLocalInfo *local)
+{
+  if (arg->extp->ani_accumulate != NULL)
+  {
+    unsigned int idx;
+
+    for (idx = 0; idx < 2U; idx++)
+    {
+      arg->extp->ani_accumulate[idx].sum_of_distance
+        += local->ani_accumulate[idx].sum_of_distance;
+      arg->extp->ani_accumulate[idx].sum_of_aligned_len
+        += local->ani_accumulate[idx].sum_of_aligned_len;
+    }
+  }
+}
+
+/* A section of a seed pair list, i.e. a range of consecutive seed pairs
+   sharing the memory of the list. */
+typedef struct
+{
+  GtSeedpairlist seedpairlist;
+  GtArrayGtDiagbandseedSeedPair mlist_struct;
+  GtArrayGtUword mlist_ulong;
+  GtArrayuint8_t mlist_bytestring;
+} GtSeedpairlistSection;
+
+static void gt_seedpairlist_section_set(GtSeedpairlistSection *section,
+                                        const GtSeedpairlist *seedpairlist,
+                                        GtUword from,
+                                        GtUword to)
+{
+  gt_assert(from < to);
+  section->seedpairlist = *seedpairlist;
+  if (seedpairlist->splt == GT_DIAGBANDSEED_BASE_LIST_STRUCT)
+  {
+    section->mlist_struct.spaceGtDiagbandseedSeedPair
+      = seedpairlist->mlist_struct->spaceGtDiagbandseedSeedPair + from;
+    section->mlist_struct.allocatedGtDiagbandseedSeedPair
+      = section->mlist_struct.nextfreeGtDiagbandseedSeedPair = to - from;
+    section->seedpairlist.mlist_struct = &section->mlist_struct;
+  } else
+  {
+    if (seedpairlist->splt == GT_DIAGBANDSEED_BASE_LIST_ULONG)
+    {
+      section->mlist_ulong.spaceGtUword
+        = seedpairlist->mlist_ulong->spaceGtUword + from;
+      section->mlist_ulong.allocatedGtUword
+        = section->mlist_ulong.nextfreeGtUword = to - from;
+      section->seedpairlist.mlist_ulong = &section->mlist_ulong;
+    } else
+    {
+      section->mlist_bytestring.spaceuint8_t
+        = seedpairlist->mlist_bytestring->spaceuint8_t +
+          from * seedpairlist->bytes_seedpair;
+      section->mlist_bytestring.allocateduint8_t
+        = section->mlist_bytestring.nextfreeuint8_t
+        = (to - from) * seedpairlist->bytes_seedpair;
+      section->seedpairlist.mlist_bytestring = &section->mlist_bytestring;
+    }
+  }
+}
+
+/* Return true iff the seed pairs with index idx and idx + 1 belong to the
+   same segment, i.e. have the same sequence numbers. */
+static bool gt_seedpairlist_same_segment(const GtSeedpairlist *seedpairlist,
+                                         GtUword idx)
+{
+  if (seedpairlist->splt == GT_DIAGBANDSEED_BASE_LIST_STRUCT)
+  {
+    const GtDiagbandseedSeedPair *sp
+      = gt_seedpairlist_mlist_struct(seedpairlist) + idx;
+
+    return sp[0].aseqnum == sp[1].aseqnum && sp[0].bseqnum == sp[1].bseqnum;
+  } else
+  {
+    if (seedpairlist->splt == GT_DIAGBANDSEED_BASE_LIST_ULONG)
+    {
+      const GtUword *sp = gt_seedpairlist_mlist_ulong(seedpairlist) + idx;
+
+      return gt_seedpairlist_a_bseqnum_ulong(seedpairlist,sp[0]) ==
+             gt_seedpairlist_a_bseqnum_ulong(seedpairlist,sp[1]);
+    } else
+    {
+      GtDiagbandseedSeedPair current, next;
+
+      gt_diagbandseed_decode_seedpair(&current,seedpairlist,
+                                      idx * seedpairlist->bytes_seedpair);
+      gt_diagbandseed_decode_seedpair(&next,seedpairlist,
+                                      (idx + 1) * seedpairlist->bytes_seedpair);
+      return current.aseqnum == next.aseqnum &&
+             current.bseqnum == next.bseqnum;
+    }
+  }
+}
+
+/* Split the seed pairs of seedpairlist into at most numofsections ranges
+   of about the same size, such that no segment is split. The i-th range
+   is bounds[i]..bounds[i+1]-1. Return the number of ranges. */
+static unsigned int gt_seedpairlist_sections_split(
+                                        GtUword *bounds,
+                                        const GtSeedpairlist *seedpairlist,
+                                        unsigned int numofsections)
+{
+  const GtUword mlistlen = gt_seedpairlist_length(seedpairlist);
+  unsigned int idx, numofranges = 0;
+
+  bounds[0] = 0;
+  for (idx = 1U; idx <= numofsections && bounds[numofranges] < mlistlen;
+       idx++)
+  {
+    GtUword to = idx == numofsections
+                   ? mlistlen
+                   : (GtUword) ((double) mlistlen * idx / numofsections);
+
+    if (to <= bounds[numofranges])
+    {
+      continue;
+    }
+    while (to < mlistlen && gt_seedpairlist_same_segment(seedpairlist,to - 1))
+    {
+      to++;
+    }
+    bounds[++numofranges] = to;
+  }
+  return numofranges;
+}
+
+typedef struct
+{
+  GtOrderedOutput *ordered_output;
+  unsigned int worker;
+  GtSeedpairlistSection *sections;
+  void *processinfo;
+  GtFtPolishing_info *pol_info;
+  GtQuerymatchoutoptions *querymoutopt;
+  GtFtTrimstat *trimstat;
+  const GtDiagbandseedInfo *arg;
+  GtDiagbandseedLocalInfo local;
+  const GtEncseq *aencseq, *bencseq;
+  const GtSequencePartsInfo *aseqranges, *bseqranges;
+  GtUword aidx, bidx;
+  const GtKarlinAltschulStat *karlin_altschul_stat;
+  GtReadmode query_readmode;
+  const GtDiagbandSeedPlainSequence *plainsequence;
+} GtDiagbandseedExtendPart;
+
+static void *gt_diagbandseed_extend_part_thread(void *data)
+{
+  GtDiagbandseedExtendPart *part = (GtDiagbandseedExtendPart *) data;
+  FILE *stream;
+  GtUword unit;
+
+  while ((stream = gt_ordered_output_next(part->ordered_output,part->worker,
+                                          &unit)) != NULL)
+  {
+    gt_diagbandseed_process_seeds(&part->sections[unit].seedpairlist,
+                                  part->arg->extp,
+                                  part->processinfo,
+                                  part->querymoutopt,
+                                  part->aencseq,part->aseqranges,part->aidx,
+                                  part->bencseq,part->bseqranges,part->bidx,
+                                  part->karlin_altschul_stat,
+                                  NULL,
+                                  NULL,
+                                  part->arg->spacedseedweight,
+                                  part->arg->seedlength,
+                                  part->query_readmode,
+                                  false,
+                                  stream,
+                                  part->arg->diagband_statistics_arg,
+                                  NULL,
+                                  NULL,
+                                  NULL,
+                                  part->plainsequence);
+    gt_ordered_output_done(part->ordered_output,part->worker);
+  }
+  return NULL;
+}
+
+/* Process the seeds like gt_diagbandseed_process_seeds. If numofthreads > 1
+   and the segments can be processed independently of each other, the list
+   is split into sections, which are extended in parallel. The output of the
+   sections is written to stream in the order of the sections, so that it
+   does not depend on the number of threads. The output of a section is
+   buffered in memory until the previous sections are completed. The ANI
+   and trimming statistics are collected for each thread separately and
+   added up at the end. */
+static void gt_diagbandseed_process_seeds_threaded(
+                                          GtSeedpairlist *seedpairlist,
+                                          const GtDiagbandseedInfo *arg,
+                                          void *processinfo,
+                                          GtQuerymatchoutoptions *querymoutopt,
+                                          const GtEncseq *aencseq,
+                                          const GtSequencePartsInfo *aseqranges,
+                                          GtUword aidx,
+                                          const GtEncseq *bencseq,
+                                          const GtSequencePartsInfo *bseqranges,
+                                          GtUword bidx,
+                                          const GtKarlinAltschulStat
+                                            *karlin_altschul_stat,
+                                          GtArrayGtDiagbandseedMaximalmatch
+                                            *memstore,
+                                          const GtChain2Dimmode *chainmode,
+                                          GtReadmode query_readmode,
+                                          FILE *stream,
+                                          GtDiagbandseedState *dbs_state,
+                                          GtFtTrimstat *trimstat,
+                                          GtSegmentRejectFunc
+                                            segment_reject_func,
+                                          GtSegmentRejectInfo
+                                            *segment_reject_info,
+                                          unsigned int numofthreads)
+{
+  const GtDiagbandseedExtendParams *extp = arg->extp;
+  GtDiagbandseedExtendPart *parts;
+  GtSeedpairlistSection *sections;
+  GtOrderedOutput *ordered_output;
+  GtDiagbandSeedPlainSequence plainsequence;
+  GtUword *bounds;
+  unsigned int idx, numofsections, numofparts;
+
+  /* the state, the rejection of segments after the first match and
+     the debug output are shared by all segments */
+  if (numofthreads > 1U && !seedpairlist->maxmat_compute &&
+      dbs_state == NULL && segment_reject_func == NULL &&
+      !extp->only_selected_seqpairs &&
+      (extp->extendgreedy || extp->extendxdrop) &&
+      gt_str_length(arg->diagband_statistics_arg) == 0 && !gt_log_enabled())
+  {
+    /* more sections than threads balance the work load */
+    numofsections = GT_DIAGBANDSEED_SECTIONS_PER_THREAD * numofthreads;
+    bounds = gt_malloc(sizeof *bounds * (numofsections + 1));
+    numofsections = gt_seedpairlist_sections_split(bounds,seedpairlist,
+                                                   numofsections);
+  } else
+  {
+    bounds = NULL;
+    numofsections = 1U;
+  }
+  if (numofsections <= 1U)
+  {
+    gt_free(bounds);
+    gt_diagbandseed_process_seeds(seedpairlist,
+                                  extp,
+                                  processinfo,
+                                  querymoutopt,
+                                  aencseq,aseqranges,aidx,
+                                  bencseq,bseqranges,bidx,
+                                  karlin_altschul_stat,
+                                  memstore,
+                                  chainmode,
+                                  arg->spacedseedweight,
+                                  arg->seedlength,
+                                  query_readmode,
+                                  arg->verbose,
+                                  stream,
+                                  arg->diagband_statistics_arg,
+                                  dbs_state,
+                                  segment_reject_func,
+                                  segment_reject_info,
+                                  NULL);
+    return;
+  }
+  sections = gt_malloc(sizeof *sections * numofsections);
+  for (idx = 0; idx < numofsections; idx++)
+  {
+    gt_seedpairlist_section_set(sections + idx,seedpairlist,bounds[idx],
+                                bounds[idx+1]);
+  }
+  gt_free(bounds);
+  numofparts = GT_MIN(numofthreads,numofsections);
+  parts = gt_malloc(sizeof *parts * numofparts);
+  ordered_output = gt_ordered_output_new(stream,(GtUword) numofsections,
+                                         numofparts,
+                                         GT_DIAGBANDSEED_MAXBUFFERED);
+  gt_diagbandseed_plainsequence_init(&plainsequence,
+                                     gt_querymatch_subjectid_display(
+                                             extp->out_display_flag),
+                                     gt_querymatch_queryid_display(
+                                             extp->out_display_flag),
+                                     aencseq,
+                                     aseqranges,
+                                     aidx,
+                                     extp->a_extend_char_access ==
+                                         GT_EXTEND_CHAR_ACCESS_DIRECT ? true
+                                                                      : false,
+                                     bencseq,
+                                     bseqranges,
+                                     bidx,
+                                     extp->b_extend_char_access ==
+                                        GT_EXTEND_CHAR_ACCESS_DIRECT ? true
+                                                                     : false);
+  for (idx = 0; idx < numofparts; idx++)
+  {
+    GtDiagbandseedExtendPart *part = parts + idx;
+
+    part->ordered_output = ordered_output;
+    part->worker = idx;
+    part->sections = sections;
+    /* the first part uses the objects of the caller */
+    if (idx == 0)
+    {
+      part->arg = arg;
+      part->trimstat = NULL;
+      part->processinfo = processinfo;
+      part->pol_info = NULL;
+      part->querymoutopt = querymoutopt;
+    } else
+    {
+      part->arg = gt_diagbandseed_local_info_set(&part->local,arg);
+      part->trimstat = trimstat != NULL ? gt_ft_trimstat_new() : NULL;
+      part->processinfo = gt_diagbandseed_processinfo_new(part->arg->extp,
+                                                          part->trimstat,
+                                                          &part->pol_info);
+      part->querymoutopt = gt_diagbandseed_querymoutopt_new(part->arg->extp);
+    }
+    part->aencseq = aencseq;
+    part->aseqranges = aseqranges;
+    part->aidx = aidx;
+    part->bencseq = bencseq;
+    part->bseqranges = bseqranges;
+    part->bidx = bidx;
+    part->karlin_altschul_stat = karlin_altschul_stat;
+    part->query_readmode = query_readmode;
+    part->plainsequence = &plainsequence;
+  }
+  gt_diagbandseed_parts_run(gt_diagbandseed_extend_part_thread,parts,
+                            sizeof *parts,numofparts);
+  for (idx = 1U; idx < numofparts; idx++)
+  {
+    gt_diagbandseed_local_info_reduce(arg,&parts[idx].local);
+    if (trimstat != NULL)
+    {
+      gt_ft_trimstat_add_trimstat(trimstat,parts[idx].trimstat);
+      gt_ft_trimstat_delete(parts[idx].trimstat);
+    }
+    gt_diagbandseed_processinfo_delete(extp,parts[idx].processinfo,
+                                       parts[idx].pol_info);
+    gt_querymatchoutoptions_delete(parts[idx].querymoutopt);
+  }
+  gt_ordered_output_delete(ordered_output);
+  gt_diagbandseed_plainsequence_delete(&plainsequence);
+  gt_free(parts);
+  gt_free(sections);
+}
+
+/* * * * * ALGORITHM STEPS * * * * */
+
+static char *gt_diagbandseed_kmer_filename(const GtEncseq *encseq,
+                                           unsigned int spacedseedweight,
+                                           unsigned int seedlength,
+                                           bool forward,
+                                           unsigned int numparts,
+                                           unsigned int partindex,
+                                           GtDiagbandseedBaseListType kmplt)
+{
+  char *filename;
+  GtStr *str = gt_str_new_cstr(gt_encseq_indexname(encseq));
+  if (spacedseedweight < seedlength)
+  {
+    gt_str_append_char(str, '.');
+    gt_str_append_uint(str, spacedseedweight);
+  }
+  gt_str_append_char(str, '.');
+  gt_str_append_uint(str, seedlength);
+  gt_str_append_char(str, forward ? 'f' : 'r');
+  gt_str_append_uint(str, numparts);
+  gt_str_append_char(str, '-');
+  gt_str_append_uint(str, partindex + 1);
+  if (kmplt == GT_DIAGBANDSEED_BASE_LIST_ULONG)
+  {
+    gt_str_append_char(str, 'U');
+  } else
+  {
+    gt_assert(kmplt == GT_DIAGBANDSEED_BASE_LIST_STRUCT);
+  }
+  gt_str_append_cstr(str, ".kmer");
+  filename = gt_cstr_dup(gt_str_get(str));
+  gt_str_delete(str);
+  return filename;
+}
+
+static GtUword gt_numof_kmerpos_in_file(const char *filename,
+                                        GtDiagbandseedBaseListType kmplt)
+{
+  off_t file_size = gt_file_size(filename);
+  size_t base_type_size = kmplt == GT_DIAGBANDSEED_BASE_LIST_STRUCT
+                            ? sizeof (GtDiagbandseedKmerPos)
+                            : sizeof (GtUword);
 
   gt_assert(file_size >= sizeof (GtLongestCodeRunType) &&
             (file_size - sizeof (GtLongestCodeRunType)) % base_type_size == 0);
@@ -4011,7 +4805,9 @@ static GtDiagbandseedBaseListType gt_diagbandseed_kmplt(
                              : GT_DIAGBANDSEED_BASE_LIST_ULONG;
 }
 
-/* Go through the different steps of the seed and extend algorithm. */
+/* Go through the different steps of the seed and extend algorithm.
+   The k-mers of the second sequence range are collected and the seeds
+   are extended with numofthreads threads. */
 static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
                                      const GtKmerPosList *alist,
                                      FILE *stream,
@@ -4026,6 +4822,7 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
                                      GtDiagbandseedState
                                        *dbs_state,
                                      GtFtTrimstat *trimstat,
+                                     unsigned int numofthreads,
                                      GtError *err)
 {
   GtKmerPosList *blist = NULL;
@@ -4176,6 +4973,7 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
                               arg->debug_kmer,
                               arg->verbose,
                               known_size,
+                              numofthreads,
                               stream);
     blen = blist->nextfree;
     biter = gt_diagbandseed_kmer_iter_new_list(blist);
@@ -4270,92 +5068,27 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
   /* Create extension info objects */
   if (!had_err)
   {
-    if (extp->extendgreedy) {
-      GtGreedyextendmatchinfo *grextinfo = NULL;
-      const double weak_errorperc = (double)(extp->weakends
-                                             ? GT_MAX(extp->errorpercentage, 20)
-                                             : extp->errorpercentage);
-
-      pol_info = polishing_info_new_with_bias(weak_errorperc,
-                                              extp->matchscore_bias,
-                                              extp->history_size);
-      grextinfo = gt_greedy_extend_matchinfo_new(extp->maxalignedlendifference,
-                                                 extp->history_size,
-                                                 extp->perc_mat_history,
-                                                 extp->userdefinedleastlength,
-                                                 extp->errorpercentage,
-                                                 extp->evalue_threshold,
-                                                 extp->a_extend_char_access,
-                                                 extp->b_extend_char_access,
-                                                 extp->cam_generic,
-                                                 extp->sensitivity,
-                                                 pol_info);
-      if (trimstat != NULL)
-      {
-        gt_greedy_extend_matchinfo_trimstat_set(grextinfo,trimstat);
-      }
-      processinfo = (void *) grextinfo;
-    } else if (extp->extendxdrop) {
-      GtXdropmatchinfo *xdropinfo = NULL;
-      gt_assert(extp->extendgreedy == false);
-      xdropinfo = gt_xdrop_matchinfo_new(extp->userdefinedleastlength,
-                                         extp->errorpercentage,
-                                         extp->evalue_threshold,
-                                         extp->xdropbelowscore,
-                                         extp->sensitivity);
-      processinfo = (void *) xdropinfo;
-    }
-    if (extp->extendxdrop || extp->verify_alignment ||
-        gt_querymatch_alignment_display(extp->out_display_flag) ||
-        gt_querymatch_trace_display(extp->out_display_flag) ||
-        gt_querymatch_dtrace_display(extp->out_display_flag) ||
-        gt_querymatch_cigar_display(extp->out_display_flag) ||
-        gt_querymatch_cigarX_display(extp->out_display_flag))
-    {
-      querymoutopt = gt_querymatchoutoptions_new(extp->out_display_flag,
-                                                 NULL,
-                                                 NULL);
-      gt_assert(querymoutopt != NULL);
-      if (extp->extendxdrop || extp->extendgreedy) {
-        const GtUword sensitivity = extp->extendxdrop ? 100UL
-                                                      : extp->sensitivity;
-        gt_querymatchoutoptions_extend(querymoutopt,
-                                       extp->errorpercentage,
-                                       extp->evalue_threshold,
-                                       extp->maxalignedlendifference,
-                                       extp->history_size,
-                                       extp->perc_mat_history,
-                                       extp->a_extend_char_access,
-                                       extp->b_extend_char_access,
-                                       extp->cam_generic,
-                                       extp->weakends,
-                                       sensitivity,
-                                       extp->matchscore_bias,
-                                       extp->always_polished_ends,
-                                       extp->out_display_flag);
-      }
-    }
+    processinfo = gt_diagbandseed_processinfo_new(extp,trimstat,&pol_info);
+    querymoutopt = gt_diagbandseed_querymoutopt_new(extp);
     /* process first mlist */
     gt_assert(seedpairlist != NULL);
-    gt_diagbandseed_process_seeds(seedpairlist,
-                                  arg->extp,
-                                  processinfo,
-                                  querymoutopt,
-                                  aencseq,aseqranges,aidx,
-                                  bencseq,bseqranges,bidx,
-                                  karlin_altschul_stat,
-                                  memstore,
-                                  chainmode,
-                                  arg->spacedseedweight,
-                                  arg->seedlength,
-                                  arg->nofwd ? GT_READMODE_REVCOMPL
-                                             : GT_READMODE_FORWARD,
-                                  arg->verbose,
-                                  stream,
-                                  arg->diagband_statistics_arg,
-                                  dbs_state,
-                                  segment_reject_func,
-                                  segment_reject_info);
+    gt_diagbandseed_process_seeds_threaded(seedpairlist,
+                                           arg,
+                                           processinfo,
+                                           querymoutopt,
+                                           aencseq,aseqranges,aidx,
+                                           bencseq,bseqranges,bidx,
+                                           karlin_altschul_stat,
+                                           memstore,
+                                           chainmode,
+                                           arg->nofwd ? GT_READMODE_REVCOMPL
+                                                      : GT_READMODE_FORWARD,
+                                           stream,
+                                           dbs_state,
+                                           trimstat,
+                                           segment_reject_func,
+                                           segment_reject_info,
+                                           numofthreads);
     gt_seedpairlist_reset(seedpairlist);
     gt_querymatchoutoptions_reset(querymoutopt);
 
@@ -4402,6 +5135,7 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
                               arg->debug_kmer,
                               arg->verbose,
                               blen,
+                              numofthreads,
                               stream);
         biter = gt_diagbandseed_kmer_iter_new_list(clist);
         use_blist = true;
@@ -4467,24 +5201,22 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
 
   /* Process second (reverse) mlist */
   if (!had_err && both_strands) {
-    gt_diagbandseed_process_seeds(seedpairlist,
-                                  arg->extp,
-                                  processinfo,
-                                  querymoutopt,
-                                  aencseq,aseqranges,aidx,
-                                  bencseq,bseqranges,bidx,
-                                  karlin_altschul_stat,
-                                  memstore,
-                                  chainmode,
-                                  arg->spacedseedweight,
-                                  arg->seedlength,
-                                  GT_READMODE_REVCOMPL,
-                                  arg->verbose,
-                                  stream,
-                                  arg->diagband_statistics_arg,
-                                  dbs_state,
-                                  segment_reject_func,
-                                  segment_reject_info);
+    gt_diagbandseed_process_seeds_threaded(seedpairlist,
+                                           arg,
+                                           processinfo,
+                                           querymoutopt,
+                                           aencseq,aseqranges,aidx,
+                                           bencseq,bseqranges,bidx,
+                                           karlin_altschul_stat,
+                                           memstore,
+                                           chainmode,
+                                           GT_READMODE_REVCOMPL,
+                                           stream,
+                                           dbs_state,
+                                           trimstat,
+                                           segment_reject_func,
+                                           segment_reject_info,
+                                           numofthreads);
   }
   /* Clean up */
   gt_seedpairlist_delete(seedpairlist);
@@ -4497,17 +5229,7 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
     }
     gt_free(memstore);
   }
-  if (extp->extendgreedy)
-  {
-    polishing_info_delete(pol_info);
-    gt_greedy_extend_matchinfo_delete((GtGreedyextendmatchinfo *) processinfo);
-  } else
-  {
-    if (extp->extendxdrop)
-    {
-      gt_xdrop_matchinfo_delete((GtXdropmatchinfo *) processinfo);
-    }
-  }
+  gt_diagbandseed_processinfo_delete(extp,processinfo,pol_info);
   gt_querymatchoutoptions_delete(querymoutopt);
   if (segment_reject_info != NULL)
   {
@@ -4526,72 +5248,172 @@ typedef struct
 {
   const GtDiagbandseedInfo *arg;
   const GtKmerPosList *alist;
-  FILE *stream;
+  GtOrderedOutput *ordered_output;
+  unsigned int worker;
   const GtEncseq *aencseq, *bencseq;
   const GtSequencePartsInfo *aseqranges,
                             *bseqranges;
   GtSegmentRejectFunc segment_reject_func;
-  GtArray *combinations;
+  const GtArray *combinations;
   int had_err;
   GtError *err;
   const GtKarlinAltschulStat *karlin_altschul_stat;
+  GtDiagbandseedState *dbs_state;
+  GtFtTrimstat *trimstat;
+  unsigned int numofthreads;
+  GtDiagbandseedLocalInfo local;
 } GtDiagbandseedThreadInfo;
 
 static void gt_diagbandseed_thread_info_set(GtDiagbandseedThreadInfo *ti,
                                      const GtDiagbandseedInfo *arg,
                                      const GtKmerPosList *alist,
-                                     FILE *stream,
+                                     GtOrderedOutput *ordered_output,
+                                     unsigned int worker,
                                      const GtEncseq *aencseq,
                                      const GtSequencePartsInfo *aseqranges,
                                      const GtEncseq *bencseq,
                                      const GtSequencePartsInfo *bseqranges,
                                      const GtKarlinAltschulStat
                                        *karlin_altschul_stat,
-                                     GtArray *combinations,
+                                     GtDiagbandseedState *dbs_state,
+                                     GtFtTrimstat *trimstat,
+                                     unsigned int numofthreads,
+                                     const GtArray *combinations,
                                      GtError *err)
 {
   gt_assert(ti != NULL);
   ti->arg = arg;
   ti->alist = alist;
-  ti->stream = stream;
+  ti->ordered_output = ordered_output;
+  ti->worker = worker;
   ti->aencseq = aencseq;
   ti->aseqranges = aseqranges;
   ti->bencseq = bencseq;
   ti->bseqranges = bseqranges;
   ti->karlin_altschul_stat = karlin_altschul_stat;
-  ti->combinations = gt_array_clone(combinations);
+  ti->dbs_state = dbs_state;
+  ti->trimstat = trimstat;
+  ti->numofthreads = numofthreads;
+  ti->combinations = combinations;
   ti->had_err = 0;
   ti->err = err;
 }
 
+/* process the combinations assigned by the ordered output one after the
+   other, until all combinations are assigned or an error occurs */
 static void *gt_diagbandseed_thread_algorithm(void *thread_info)
 {
   GtDiagbandseedThreadInfo *info = (GtDiagbandseedThreadInfo *)thread_info;
-  if (gt_array_size(info->combinations) > 0) {
-    const GtUwordPair *last = gt_array_get_last(info->combinations),
-                      *comb;
-
-    for (comb = gt_array_get_first(info->combinations); comb <= last; comb++) {
-      info->had_err = gt_diagbandseed_algorithm(
-                           info->arg,
-                           info->alist,
-                           info->stream,
-                           info->aencseq,
-                           info->aseqranges,
-                           comb->a,
-                           info->bencseq,
-                           info->bseqranges,
-                           comb->b,
-                           info->karlin_altschul_stat,
-                           NULL,
-                           NULL,
-                           info->err);
-      if (info->had_err) break;
-    }
+  FILE *stream;
+  GtUword unit;
+
+  while (!info->had_err &&
+         (stream = gt_ordered_output_next(info->ordered_output,info->worker,
+                                          &unit)) != NULL)
+  {
+    const GtUwordPair *comb = gt_array_get(info->combinations,unit);
+
+    info->had_err = gt_diagbandseed_algorithm(
+                         info->arg,
+                         info->alist,
+                         stream,
+                         info->aencseq,
+                         info->aseqranges,
+                         comb->a,
+                         info->bencseq,
+                         info->bseqranges,
+                         comb->b,
+                         info->karlin_altschul_stat,
+                         info->dbs_state,
+                         info->trimstat,
+                         info->numofthreads,
+                         info->err);
+    gt_ordered_output_done(info->ordered_output,info->worker);
   }
-  gt_array_delete(info->combinations);
   return NULL;
 }
+
+/* Run the algorithm for all combinations of sequence ranges in parallel,
+   using gt_jobs threads. The output is written to stdout in the order of
+   the combinations. The ANI and trimming statistics are collected for each
+   thread separately and added up at the end. */
+static int gt_diagbandseed_combinations_run(const GtDiagbandseedInfo *arg,
+                                     const GtKmerPosList *alist,
+                                     const GtSequencePartsInfo *aseqranges,
+                                     const GtSequencePartsInfo *bseqranges,
+                                     const GtArray *combinations,
+                                     const GtKarlinAltschulStat
+                                       *karlin_altschul_stat,
+                                     GtDiagbandseedState *dbs_state,
+                                     GtFtTrimstat *trimstat,
+                                     GtError *err)
+{
+  const GtUword numofcombinations = gt_array_size(combinations);
+  GtDiagbandseedThreadInfo *tinfo;
+  GtOrderedOutput *ordered_output;
+  unsigned int worker, numofworkers;
+  int had_err = 0;
+
+  if (numofcombinations == 0)
+  {
+    return 0;
+  }
+  numofworkers = numofcombinations < (GtUword) gt_jobs
+                   ? (unsigned int) numofcombinations
+                   : gt_jobs;
+  ordered_output = gt_ordered_output_new(stdout,numofcombinations,
+                                         numofworkers,
+                                         GT_DIAGBANDSEED_MAXBUFFERED);
+  tinfo = gt_malloc(sizeof *tinfo * numofworkers);
+  /* if there are less combinations than threads, the remaining threads
+     are used within the combinations; the state is only used for a single
+     combination */
+  for (worker = 0; worker < numofworkers; worker++)
+  {
+    gt_diagbandseed_thread_info_set(tinfo + worker,
+                                    worker == 0
+                                      ? arg
+                                      : gt_diagbandseed_local_info_set(
+                                                      &tinfo[worker].local,
+                                                      arg),
+                                    alist,
+                                    ordered_output,
+                                    worker,
+                                    arg->aencseq,
+                                    aseqranges,
+                                    arg->bencseq,
+                                    bseqranges,
+                                    karlin_altschul_stat,
+                                    numofcombinations == 1 ? dbs_state : NULL,
+                                    worker == 0 || trimstat == NULL
+                                      ? trimstat
+                                      : gt_ft_trimstat_new(),
+                                    gt_jobs / numofworkers,
+                                    combinations,
+                                    err);
+  }
+  gt_diagbandseed_parts_run(gt_diagbandseed_thread_algorithm,tinfo,
+                            sizeof *tinfo,numofworkers);
+  for (worker = 0; worker < numofworkers; worker++)
+  {
+    if (tinfo[worker].had_err)
+    {
+      had_err = -1;
+    }
+    if (worker > 0)
+    {
+      gt_diagbandseed_local_info_reduce(arg,&tinfo[worker].local);
+      if (trimstat != NULL)
+      {
+        gt_ft_trimstat_add_trimstat(trimstat,tinfo[worker].trimstat);
+        gt_ft_trimstat_delete(tinfo[worker].trimstat);
+      }
+    }
+  }
+  gt_free(tinfo);
+  gt_ordered_output_delete(ordered_output);
+  return had_err;
+}
 #endif
 
 static int gt_diagbandseed_write_kmers(const GtKmerPosList *kmerpos_list,
@@ -4679,6 +5501,15 @@ static void gt_diagbandseed_out_sequences_with_matches(
   gt_free(string_buffer);
 }
 
+static unsigned int gt_diagbandseed_numofthreads(void)
+{
+#ifdef GT_THREADS_ENABLED
+  return gt_jobs;
+#else
+  return 1U;
+#endif
+}
+
 /* Run the algorithm by iterating over all combinations of sequence ranges. */
 int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
                         const GtSequencePartsInfo *aseqranges,
@@ -4697,19 +5528,6 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
   GtFtTrimstat *trimstat = NULL;
   GtKarlinAltschulStat *karlin_altschul_stat = NULL;
   GtDiagbandseedState *dbs_state = NULL;
-#ifdef GT_THREADS_ENABLED
-  GtDiagbandseedThreadInfo *tinfo = gt_malloc(gt_jobs * sizeof *tinfo);
-  FILE **stream_tab;
-  unsigned int tidx;
-
-  /* create output streams */
-  stream_tab = gt_malloc(gt_jobs * sizeof *stream_tab);
-  stream_tab[0] = stdout;
-  for (tidx = 1; !had_err && tidx < gt_jobs; tidx++) {
-    stream_tab[tidx]
-      = gt_xtmpfp_generic(NULL, GT_TMPFP_OPENBINARY | GT_TMPFP_AUTOREMOVE);
-  }
-#endif
   if (arg->verbose || gt_querymatch_gfa2_display(arg->extp->out_display_flag))
   {
     GtUword a_num_sequences = 0, b_num_sequences = 0;
@@ -4775,6 +5593,7 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
                               arg->debug_kmer,
                               arg->verbose,
                               0,
+                              gt_diagbandseed_numofthreads(),
                               stdout);
           had_err = gt_diagbandseed_write_kmers(blist, path,
                                                 arg->spacedseedweight,
@@ -4854,6 +5673,7 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
                               arg->debug_kmer,
                               arg->verbose,
                               0,
+                              gt_diagbandseed_numofthreads(),
                               stdout);
       if (arg->use_kmerfile)
       {
@@ -4883,91 +5703,30 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
                            karlin_altschul_stat,
                            dbs_state,
                            trimstat,
+                           1U,
                            err);
         }
         bidx++;
       }
 #ifdef GT_THREADS_ENABLED
     } else if (!arg->use_kmerfile) {
-      const GtUword num_runs = bpick ? 1 : bnumseqranges - bidx;
-      const GtUword num_runs_per_thread = (num_runs - 1) / gt_jobs + 1;
-      const GtUword num_threads = (num_runs - 1) / num_runs_per_thread + 1;
       GtArray *combinations = gt_array_new(sizeof (GtUwordPair));
-      GtArray *threads = gt_array_new(sizeof (GtThread *));
-
-      gt_assert(bidx < bnumseqranges);
-      gt_assert(num_threads <= gt_jobs);
-      gt_assert(!bpick || num_threads == 1);
 
-      /* start additional threads */
-      for (tidx = 1; !had_err && tidx < num_threads; tidx++) {
-        GtThread *thread;
-        GtUword idx;
-        bidx += num_runs_per_thread;
-        const GtUword end = GT_MIN(bidx + num_runs_per_thread, bnumseqranges);
-
-        for (idx = bidx; idx < end; idx++) {
-          GtUwordPair comb = {aidx, idx};
+      for (/* Nothing */; bidx < bnumseqranges; bidx++) {
+        if (!bpick || pick->b == bidx) {
+          GtUwordPair comb = {aidx, bidx};
           gt_array_add(combinations, comb);
         }
-        gt_diagbandseed_thread_info_set(tinfo + tidx,
-                                        arg,
-                                        use_alist ? alist : NULL,
-                                        stream_tab[tidx],
-                                        arg->aencseq,
-                                        aseqranges,
-                                        arg->bencseq,
-                                        bseqranges,
-                                        karlin_altschul_stat,
-                                        combinations,
-                                        err);
-        gt_array_reset(combinations);
-        if ((thread = gt_thread_new(gt_diagbandseed_thread_algorithm,
-                                    tinfo + tidx, err)) != NULL) {
-          gt_array_add(threads, thread);
-        } else {
-          had_err = -1;
-        }
-      }
-
-      /* start main thread */
-      if (!had_err) {
-        GtUword idx;
-        bidx = self ? aidx : 0;
-        for (idx = bidx;
-             idx < GT_MIN(bidx + num_runs_per_thread, bnumseqranges);
-             ++idx) {
-          if (!bpick || pick->b == idx) {
-            GtUwordPair comb = {aidx, idx};
-            gt_array_add(combinations, comb);
-          }
-        }
-        gt_diagbandseed_thread_info_set(tinfo,
-                                        arg,
-                                        use_alist ? alist : NULL,
-                                        stream_tab[0],
-                                        arg->aencseq,
-                                        aseqranges,
-                                        arg->bencseq,
-                                        bseqranges,
-                                        karlin_altschul_stat,
-                                        combinations,
-                                        err);
-        gt_diagbandseed_thread_algorithm(tinfo);
-      }
-
-      /* clean up */
-      for (tidx = 0; tidx < gt_array_size(threads); tidx++) {
-        GtThread *thread = *(GtThread**) gt_array_get(threads, tidx);
-        if (!had_err) {
-          gt_thread_join(thread);
-        }
-        gt_thread_delete(thread);
-      }
-      gt_array_delete(threads);
-      for (tidx = 0; tidx < num_threads && !had_err; tidx++) {
-        had_err = tinfo[tidx].had_err;
       }
+      had_err = gt_diagbandseed_combinations_run(arg,
+                                                 use_alist ? alist : NULL,
+                                                 aseqranges,
+                                                 bseqranges,
+                                                 combinations,
+                                                 karlin_altschul_stat,
+                                                 dbs_state,
+                                                 trimstat,
+                                                 err);
       gt_array_delete(combinations);
     }
 #endif
@@ -4977,13 +5736,9 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
     gt_kmerpos_encode_info_delete(aencode_info);
   }
 #ifdef GT_THREADS_ENABLED
-  if (gt_jobs > 1 && arg->use_kmerfile) {
-    GtArray *combinations[gt_jobs];
-    GtArray *threads = gt_array_new(sizeof (GtThread *));
-    GtUword counter = 0;
-    for (tidx = 0; tidx < gt_jobs; tidx++) {
-      combinations[tidx] = gt_array_new(sizeof (GtUwordPair));
-    }
+  if (!had_err && gt_jobs > 1 && arg->use_kmerfile) {
+    GtArray *combinations = gt_array_new(sizeof (GtUwordPair));
+
     for (aidx = 0; aidx < anumseqranges; aidx++) {
       if (apick && pick->a != aidx)
       {
@@ -4992,76 +5747,21 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
       for (bidx = self ? aidx : 0; bidx < bnumseqranges; bidx++) {
         if (!bpick || pick->b == bidx) {
           GtUwordPair comb = {aidx, bidx};
-          gt_array_add(combinations[counter++ % gt_jobs], comb);
+          gt_array_add(combinations, comb);
         }
       }
     }
-
-    for (tidx = 1; !had_err && tidx < gt_jobs; tidx++) {
-      GtThread *thread;
-      gt_diagbandseed_thread_info_set(tinfo + tidx,
-                                      arg,
-                                      NULL,
-                                      stream_tab[tidx],
-                                      arg->aencseq,
-                                      aseqranges,
-                                      arg->bencseq,
-                                      bseqranges,
-                                      karlin_altschul_stat,
-                                      combinations[tidx],
-                                      err);
-      if ((thread = gt_thread_new(gt_diagbandseed_thread_algorithm,
-                                  tinfo + tidx, err)) != NULL) {
-        gt_array_add(threads, thread);
-      } else {
-        had_err = -1;
-      }
-    }
-    /* start main thread */
-    if (!had_err) {
-      gt_diagbandseed_thread_info_set(tinfo,
-                                      arg,
-                                      NULL,
-                                      stream_tab[0],
-                                      arg->aencseq,
-                                      aseqranges,
-                                      arg->bencseq,
-                                      bseqranges,
-                                      karlin_altschul_stat,
-                                      combinations[0],
-                                      err);
-      gt_diagbandseed_thread_algorithm(tinfo);
-    }
-
-    /* clean up */
-    for (tidx = 0; tidx < gt_array_size(threads); tidx++) {
-      GtThread *thread = *(GtThread**) gt_array_get(threads, tidx);
-      if (!had_err) {
-        gt_thread_join(thread);
-      }
-      gt_thread_delete(thread);
-    }
-    for (tidx = 0; tidx < gt_array_size(threads) && !had_err; tidx++) {
-      had_err = tinfo[tidx].had_err;
-    }
-    gt_array_delete(threads);
-    for (tidx = 0; tidx < gt_jobs; tidx++) {
-      gt_array_delete(combinations[tidx]);
-    }
+    had_err = gt_diagbandseed_combinations_run(arg,
+                                               NULL,
+                                               aseqranges,
+                                               bseqranges,
+                                               combinations,
+                                               karlin_altschul_stat,
+                                               dbs_state,
+                                               trimstat,
+                                               err);
+    gt_array_delete(combinations);
   }
-  gt_free(tinfo);
-
-  /* print the threads' output to stdout */
-  for (tidx = 1; tidx < gt_jobs; tidx++) {
-    int cc;
-    rewind(stream_tab[tidx]);
-    while ((cc = fgetc(stream_tab[tidx])) != EOF) {
-      putchar(cc);
-    }
-    gt_fa_xfclose(stream_tab[tidx]);
-  }
-  gt_free(stream_tab);
-
 #endif
   if (arg->verbose)
   {
@@ -5092,6 +5792,7 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
                   dbs_state->used_b_sequences);
     }
   }
+  gt_ft_trimstat_out(trimstat,arg->verbose);
   gt_diagbandseed_dbs_state_delete(dbs_state);
   gt_karlin_altschul_stat_delete(karlin_altschul_stat);
   gt_ft_trimstat_delete(trimstat);
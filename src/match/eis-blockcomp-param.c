@@ -31,4 +31,10 @@ gt_registerBlockEncOptions(GtOptionParser *op,
                                             "bucket",
                                   &paramOutput->bucketBlocks, 8U, 1U);
   gt_option_parser_add_option(op, option);
+  option = gt_option_new_bool("interleave", "store the sequence additionally "
+                               "in cache line sized blocks interleaved\n"
+                               "with the rank counts to speed up rank "
+                               "queries (DNA only)",
+                               &paramOutput->interleaveRankLines, false);
+  gt_option_parser_add_option(op, option);
 }
@@ -61,8 +61,33 @@ struct onDiskBlockCompIdx
                                 * portion */
   off_t cwDataPos,             /**< constant width data of the index */
     varDataPos,                /**< variable width part */
-    rangeEncPos;               /**< in-file position of special
+    rangeEncPos,               /**< in-file position of special
                                 *  symbol representation */
+    rankLinesPos;              /**< in-file position of the
+                                * interleaved rank lines, 0 if the
+                                * index has none */
+  char *rankLinesMMap;         /**< memory mapped rank lines or, if
+                                * mapping failed, a copy read into
+                                * memory */
+  bool rankLinesMapped;        /**< is rankLinesMMap a mapping? */
+};
+
+/**
+ * A rank line stores the ranks of the four symbols of a DNA block
+ * map alphabet before the first position covered by the line,
+ * followed by the RANK_LINE_SYMS symbols of the line, which are
+ * split into a plane of high bits and one of low bits. Thus every
+ * rank query for a block encoded symbol reads a single 64 byte
+ * line and counts matching symbols by popcount.
+ */
+struct rankLine
+{
+  uint64_t counts[4], hiBits[2], loBits[2];
+};
+
+enum {
+  RANK_LINE_SYMS = 128,
+  RANK_LINE_ALPHABET_SIZE = 4,
 };
 
 /**
@@ -96,6 +121,8 @@ struct blockCompositionSeq
   Symbol blockEncFallback, rangeEncFallback;
   int numModes;
   unsigned *partialSymSumBits, *partialSymSumBitsSums, symSumBits;
+  const struct rankLine *rankLines;
+  bool interleaveRankLines;
 };
 
 static inline size_t
@@ -125,6 +152,12 @@ writeIdxHeader(struct blockCompositionSeq *seqIdx,
 static inline int
 tryMMapOfIndex(struct onDiskBlockCompIdx *idxData);
 
+static int
+writeRankLines(struct blockCompositionSeq *seqIdx);
+
+static int
+mapRankLines(struct blockCompositionSeq *seqIdx);
+
 static const struct encIdxSeqClass blockCompositionSeqClass;
 
 static inline struct blockCompositionSeq *
@@ -377,6 +410,14 @@ gt_newGenBlockEncIdxSeq(GtUword totalLen, const char *projectName,
     gt_assert(gt_MRAEncGetSize(rangeMapAlphabet)
            == totalAlphabetSize - blockMapAlphabetSize);
   }
+  if ((newSeqIdx->interleaveRankLines
+       = params->encParams.blockEnc.interleaveRankLines)
+      && blockMapAlphabetSize != RANK_LINE_ALPHABET_SIZE)
+  {
+    gt_error_set(err, "interleaved rank lines are only available for DNA "
+                 "sequences");
+    newBlockEncIdxSeqErrRet();
+  }
   newSeqIdx->partialSymSumBits
     = gt_malloc(sizeof (newSeqIdx->partialSymSumBits[0])
                 * blockMapAlphabetSize * 2);
@@ -631,6 +672,15 @@ gt_newGenBlockEncIdxSeq(GtUword totalLen, const char *projectName,
               newBlockEncIdxSeqLoopErr();
             }
             tryMMapOfIndex(&newSeqIdx->externalData);
+            if (newSeqIdx->interleaveRankLines
+                && (!writeRankLines(newSeqIdx)
+                    || fflush(newSeqIdx->externalData.idxFP)
+                    || !mapRankLines(newSeqIdx)))
+            {
+              hadGtError = 1;
+              perror("error condition while writing interleaved rank lines");
+              newBlockEncIdxSeqLoopErr();
+            }
           }
           if (hadGtError)
           {
@@ -1159,6 +1209,96 @@ adjustPosRankForBlock(struct blockCompositionSeq *seqIdx,
   return rankCount;
 }
 
+static inline GtUword
+numRankLines(GtUword seqLen)
+{
+  /* one extra line holds the totals for queries at the sequence end */
+  return seqLen / RANK_LINE_SYMS + 1;
+}
+
+#ifdef __GNUC__
+static inline unsigned
+bitCountUInt64(uint64_t v)
+{
+  return __builtin_popcountll(v);
+}
+#else
+static inline unsigned
+bitCountUInt64(uint64_t v)
+{
+  return bitCountUInt32((uint32_t) (v & (uint64_t) UINT32_MAX)) +
+         bitCountUInt32((uint32_t) (v >> 32));
+}
+#endif
+
+static inline uint64_t
+rankLineSymMatches(const struct rankLine *line, Symbol bSym, unsigned word)
+{
+  return ((bSym & 2) ? line->hiBits[word] : ~line->hiBits[word])
+    & ((bSym & 1) ? line->loBits[word] : ~line->loBits[word]);
+}
+
+/* rank of bSym before pos, special symbols are not yet accounted for */
+static inline GtUword
+rankLineSymCount(const struct rankLine *line, Symbol bSym, unsigned linePos)
+{
+  GtUword rankCount = line->counts[bSym];
+  unsigned word = 0;
+  if (linePos >= 64)
+  {
+    rankCount += bitCountUInt64(rankLineSymMatches(line, bSym, 0));
+    linePos -= 64;
+    word = 1;
+  }
+  if (linePos)
+    rankCount += bitCountUInt64(rankLineSymMatches(line, bSym, word)
+                                & (((uint64_t)1 << linePos) - 1));
+  return rankCount;
+}
+
+static inline GtUword
+rankLinesRank(struct blockCompositionSeq *seqIdx, Symbol bSym, GtUword pos,
+              union EISHint *hint)
+{
+  unsigned linePos = pos % RANK_LINE_SYMS;
+  GtUword rankCount = rankLineSymCount(seqIdx->rankLines
+                                       + pos / RANK_LINE_SYMS, bSym, linePos);
+  if (bSym == seqIdx->blockEncFallback && linePos)
+    rankCount -= gt_SRLAllSymbolsCountInSeqRegion(
+      seqIdx->rangeEncs, pos - linePos, pos, &hint->bcHint.rangeHint);
+  return rankCount;
+}
+
+static inline void
+rankLinesRangeRank(struct blockCompositionSeq *seqIdx, GtUword pos,
+                   GtUword *rankCounts, union EISHint *hint)
+{
+  const struct rankLine *line = seqIdx->rankLines + pos / RANK_LINE_SYMS;
+  unsigned linePos = pos % RANK_LINE_SYMS;
+  Symbol bSym;
+  for (bSym = 0; bSym < RANK_LINE_ALPHABET_SIZE; ++bSym)
+    rankCounts[bSym] = rankLineSymCount(line, bSym, linePos);
+  if (linePos)
+    rankCounts[seqIdx->blockEncFallback]
+      -= gt_SRLAllSymbolsCountInSeqRegion(
+        seqIdx->rangeEncs, pos - linePos, pos, &hint->bcHint.rangeHint);
+}
+
+static inline Symbol
+rankLinesGet(struct blockCompositionSeq *seqIdx, GtUword pos,
+             union EISHint *hint)
+{
+  const struct rankLine *line = seqIdx->rankLines + pos / RANK_LINE_SYMS;
+  unsigned linePos = pos % RANK_LINE_SYMS, word = linePos / 64,
+    bit = linePos % 64;
+  Symbol sym = (Symbol) ((((line->hiBits[word] >> bit) & 1) << 1)
+                         | ((line->loBits[word] >> bit) & 1));
+  if (sym == seqIdx->blockEncFallback)
+    gt_SRLApplyRangesToSubString(seqIdx->rangeEncs, &sym, pos, 1, pos,
+                                 &hint->bcHint.rangeHint);
+  return sym;
+}
+
 /* Note: pos is meant exclusively, i.e. returns 0
    for any query where pos==0 because that corresponds to the empty prefix */
 static GtUword
@@ -1172,6 +1312,13 @@ blockCompSeqRank(struct encIdxSeq *eSeqIdx, Symbol eSym, GtUword pos,
   gt_assert(gt_MRAEncSymbolIsInSelectedRanges(seqIdx->baseClass.alphabet,
                                         eSym, BLOCK_COMPOSITION_INCLUDE,
                                         seqIdx->modes) >= 0);
+  if (seqIdx->rankLines != NULL
+      && gt_MRAEncSymbolIsInSelectedRanges(seqIdx->baseClass.alphabet, eSym,
+                                           BLOCK_COMPOSITION_INCLUDE,
+                                           seqIdx->modes))
+    return rankLinesRank(seqIdx,
+                         MRAEncMapSymbol(seqIdx->blockMapAlphabet, eSym), pos,
+                         hint);
   if (gt_MRAEncSymbolIsInSelectedRanges(seqIdx->baseClass.alphabet, eSym,
                                      BLOCK_COMPOSITION_INCLUDE, seqIdx->modes))
   {
@@ -1233,6 +1380,16 @@ blockCompSeqPosPairRank(struct encIdxSeq *eSeqIdx, Symbol eSym,
   gt_assert(gt_MRAEncSymbolIsInSelectedRanges(seqIdx->baseClass.alphabet,
                                         eSym, BLOCK_COMPOSITION_INCLUDE,
                                         seqIdx->modes) >= 0);
+  if (seqIdx->rankLines != NULL
+      && gt_MRAEncSymbolIsInSelectedRanges(seqIdx->baseClass.alphabet, eSym,
+                                           BLOCK_COMPOSITION_INCLUDE,
+                                           seqIdx->modes))
+  {
+    Symbol bSym = MRAEncMapSymbol(seqIdx->blockMapAlphabet, eSym);
+    rankCounts.a = rankLinesRank(seqIdx, bSym, posA, hint);
+    rankCounts.b = rankLinesRank(seqIdx, bSym, posB, hint);
+    return rankCounts;
+  }
   /* Only when both positions are in same bucket, special treatment
    * makes sense. */
   {
@@ -1412,6 +1569,11 @@ blockCompSeqRangeRank(struct encIdxSeq *eSeqIdx, AlphabetRangeID range,
   switch (seqIdx->modes[range])
   {
   case BLOCK_COMPOSITION_INCLUDE:
+    if (seqIdx->rankLines != NULL)
+    {
+      rankLinesRangeRank(seqIdx, pos, rankCounts, hint);
+      break;
+    }
     {
       BitOffset varDataMemOffset, cwIdxMemOffset;
       struct superBlock *sBlock;
@@ -1480,6 +1642,12 @@ blockCompSeqPosPairRangeRank(struct encIdxSeq *eSeqIdx, AlphabetRangeID range,
       /* Only when both positions are in same bucket, special treatment
        * makes sense. */
       GtUword bucketNum = bucketNumFromPos(seqIdx, posA);
+      if (seqIdx->rankLines != NULL)
+      {
+        rankLinesRangeRank(seqIdx, posA, rankCounts, hint);
+        rankLinesRangeRank(seqIdx, posB, rankCounts + rsize, hint);
+        return;
+      }
       if (bucketNum != bucketNumFromPos(seqIdx, posB))
       {
         blockCompSeqRangeRank(eSeqIdx, range, posA, rankCounts, hint);
@@ -1562,6 +1730,8 @@ blockCompSeqGet(struct encIdxSeq *seq, GtUword pos, union EISHint *hint)
   if (pos >= seq->seqLen)
     return ~(Symbol)0;
   seqIdx = encIdxSeq2blockCompositionSeq(seq);
+  if (seqIdx->rankLines != NULL)
+    return rankLinesGet(seqIdx, pos, hint);
   blockSize = seqIdx->blockSize;
   {
     Symbol block[blockSize];
@@ -1718,7 +1888,7 @@ initOnDiskBlockCompIdx(struct onDiskBlockCompIdx *idx,
 {
   idx->cwDataPos = roundUp(headerLen, HEADER_PAGESIZE_ROUNDUP);
   idx->varDataPos = cwLen + idx->cwDataPos;
-  idx->rangeEncPos = 0;
+  idx->rangeEncPos = idx->rankLinesPos = 0;
 }
 
 static void
@@ -1726,6 +1896,10 @@ destructOnDiskBlockCompIdx(struct onDiskBlockCompIdx *idx)
 {
   if (idx->idxMMap)
     gt_fa_xmunmap(idx->idxMMap);
+  if (idx->rankLinesMapped)
+    gt_fa_xmunmap(idx->rankLinesMMap);
+  else
+    gt_free(idx->rankLinesMMap);
   if (idx->idxFP)
     gt_fa_xfclose(idx->idxFP);
   if (idx->idxFN)
@@ -1902,6 +2076,7 @@ enum bdxHeader {
   REFB_HEADER_FIELD = 0x52454642, /* range encoding fallback symbol */
   VDOB_HEADER_FIELD = 0x56444f42, /* bitsPerVarDiskOffset */
   SELE_HEADER_FIELD = 0x53454c45, /* sequence length */
+  ILOF_HEADER_FIELD = 0x494c4f46, /* interleaved rank lines offset */
   EH_HEADER_PREFIX = 0x45480000,  /* extension headers */
 };
 
@@ -1940,6 +2115,8 @@ blockEncIdxSeqHeaderLength(const struct blockCompositionSeq *seqIdx,
     headerSize += 4 + 4         /* extra offset bits per constant block */
       + 4 + 8                   /* extension bits stored in constant block */
       + 4 + 8;                  /* variable area bits added per bucket max */
+  if (seqIdx->interleaveRankLines)
+    headerSize += 4 + 8;        /* offset of interleaved rank lines */
 
   headerSize += extHeadersSizeAggregate(numExtHeaders, extHeaderSizes);
   return headerSize;
@@ -2057,6 +2234,12 @@ writeIdxHeader(struct blockCompositionSeq *seqIdx,
     *(uint64_t *)(buf + offset + 4) = seqIdx->maxVarExtBitsPerBucket;
     offset += 12;
   }
+  if (seqIdx->interleaveRankLines)
+  {
+    *(uint32_t *)(buf + offset) = ILOF_HEADER_FIELD;
+    *(uint64_t *)(buf + offset + 4) = seqIdx->externalData.rankLinesPos;
+    offset += 12;
+  }
   gt_assert(offset == bufLen);
   if (fseeko(fp, 0, SEEK_SET))
     writeIdxHeaderErrRet(0);
@@ -2252,6 +2435,12 @@ gt_loadBlockEncIdxSeqGen(MRAEnc *alphabet,
         newSeqIdx->cwExtBitsPerBucket = *(uint64_t *)(buf + offset + 4);
         offset += 12;
         break;
+      case ILOF_HEADER_FIELD:
+        newSeqIdx->externalData.rankLinesPos
+          = *(uint64_t *)(buf + offset + 4);
+        newSeqIdx->interleaveRankLines = true;
+        offset += 12;
+        break;
       case 0:
         /* empty header skip to next portion */
         offset = headerLen;
@@ -2362,6 +2551,21 @@ gt_loadBlockEncIdxSeqGen(MRAEnc *alphabet,
     }
   }
   tryMMapOfIndex(&newSeqIdx->externalData);
+  if (newSeqIdx->interleaveRankLines)
+  {
+    if (blockMapAlphabetSize != RANK_LINE_ALPHABET_SIZE
+        || newSeqIdx->blockEncFallback >= RANK_LINE_ALPHABET_SIZE)
+    {
+      gt_error_set(err, "interleaved rank lines require an alphabet of "
+                   "size %d", RANK_LINE_ALPHABET_SIZE);
+      loadBlockEncIdxSeqErrRet();
+    }
+    if (!mapRankLines(newSeqIdx))
+    {
+      gt_error_set(err, "error reading interleaved rank lines");
+      loadBlockEncIdxSeqErrRet();
+    }
+  }
   gt_free(buf);
   return &newSeqIdx->baseClass;
 }
@@ -2467,6 +2671,15 @@ finalizeIdxOutput(struct blockCompositionSeq *seqIdx,
     return 0;
   if (!(gt_SRLSaveToStream(seqIdx->rangeEncs, seqIdx->externalData.idxFP)))
      return 0;
+  if (seqIdx->interleaveRankLines)
+  {
+    /* rank lines follow the range encodings, page aligned for mapping */
+    off_t rangeEncEnd = ftello(seqIdx->externalData.idxFP);
+    if (rangeEncEnd < 0)
+      return 0;
+    seqIdx->externalData.rankLinesPos
+      = roundUp(rangeEncEnd, HEADER_PAGESIZE_ROUNDUP);
+  }
   return 1;
 }
 
@@ -2511,6 +2724,96 @@ deleteBlockCompSeqHint(struct encIdxSeq *seq, union EISHint *hint)
   gt_free(hint);
 }
 
+/**
+ * @return 0 on error, 1 otherwise
+ */
+static int
+writeRankLines(struct blockCompositionSeq *seqIdx)
+{
+  GtUword seqLen = seqIdx->baseClass.seqLen, lineNum,
+    linesNum = numRankLines(seqLen), blockNum = ~(GtUword)0,
+    counts[RANK_LINE_ALPHABET_SIZE] = { 0 };
+  unsigned blockSize = seqIdx->blockSize;
+  FILE *fp = seqIdx->externalData.idxFP;
+  union EISHint *hint;
+  Symbol block[blockSize];
+  int retval = 1;
+  gt_assert(seqIdx->externalData.rankLinesPos > 0);
+  if (fseeko(fp, seqIdx->externalData.rankLinesPos, SEEK_SET))
+    return 0;
+  hint = newBlockCompSeqHint(&seqIdx->baseClass);
+  for (lineNum = 0; lineNum < linesNum; ++lineNum)
+  {
+    struct rankLine line;
+    GtUword pos, lineStart = lineNum * RANK_LINE_SYMS,
+      lineEnd = GT_MIN(lineStart + RANK_LINE_SYMS, seqLen);
+    unsigned sym;
+    memset(&line, 0, sizeof (line));
+    for (sym = 0; sym < RANK_LINE_ALPHABET_SIZE; ++sym)
+      line.counts[sym] = counts[sym];
+    for (pos = lineStart; pos < lineEnd; ++pos)
+    {
+      unsigned linePos = pos - lineStart;
+      uint64_t bit = (uint64_t)1 << (linePos % 64);
+      Symbol bSym;
+      if (pos / blockSize != blockNum)
+      {
+        blockNum = pos / blockSize;
+        blockCompSeqGetBlock(seqIdx, blockNum, &hint->bcHint, 0, NULL, block);
+      }
+      bSym = block[pos % blockSize];
+      gt_assert(bSym < RANK_LINE_ALPHABET_SIZE);
+      ++counts[bSym];
+      if (bSym & 2)
+        line.hiBits[linePos / 64] |= bit;
+      if (bSym & 1)
+        line.loBits[linePos / 64] |= bit;
+    }
+    /* the blocks store special symbols as fallback symbol */
+    if (lineEnd > lineStart)
+      counts[seqIdx->blockEncFallback] -= gt_SRLAllSymbolsCountInSeqRegion(
+        seqIdx->rangeEncs, lineStart, lineEnd, &hint->bcHint.rangeHint);
+    /* without mapping, reading blocks moves the file position */
+    if (!seqIdxUsesMMap(seqIdx)
+        && fseeko(fp, seqIdx->externalData.rankLinesPos
+                  + lineNum * sizeof (line), SEEK_SET))
+    {
+      retval = 0;
+      break;
+    }
+    gt_xfwrite(&line, sizeof (line), 1, fp);
+  }
+  deleteBlockCompSeqHint(&seqIdx->baseClass, hint);
+  return retval;
+}
+
+/**
+ * @return 0 on error, 1 otherwise
+ */
+static int
+mapRankLines(struct blockCompositionSeq *seqIdx)
+{
+  struct onDiskBlockCompIdx *idxData = &seqIdx->externalData;
+  size_t len = sizeof (struct rankLine)
+    * numRankLines(seqIdx->baseClass.seqLen);
+  gt_assert(idxData->rankLinesPos > 0 && idxData->rankLinesMMap == NULL);
+  idxData->rankLinesMMap = gt_fa_mmap_generic_fd(fileno(idxData->idxFP),
+                                                 gt_str_get(idxData->idxFN),
+                                                 len, idxData->rankLinesPos,
+                                                 false, false, NULL);
+  if (idxData->rankLinesMMap != NULL)
+    idxData->rankLinesMapped = true;
+  else
+  {
+    idxData->rankLinesMMap = gt_malloc(len);
+    if (fseeko(idxData->idxFP, idxData->rankLinesPos, SEEK_SET)
+        || fread(idxData->rankLinesMMap, len, 1, idxData->idxFP) != 1)
+      return 0;
+  }
+  seqIdx->rankLines = (const struct rankLine *)idxData->rankLinesMMap;
+  return 1;
+}
+
 static int
 printBlock(Symbol *block, unsigned blockSize, FILE *fp)
 {
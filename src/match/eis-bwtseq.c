@@ -145,6 +145,24 @@ gt_deleteBWTSeq(BWTSeq *bwtSeq)
   gt_free(bwtSeq);
 }
 
+BWTSeq *
+gt_newBWTSeqView(const BWTSeq *bwtSeq)
+{
+  BWTSeq *bwtSeqView;
+  gt_assert(bwtSeq);
+  bwtSeqView = gt_malloc(sizeof (*bwtSeqView));
+  *bwtSeqView = *bwtSeq;
+  bwtSeqView->hint = newEISHint(bwtSeq->seqIdx);
+  return bwtSeqView;
+}
+
+void
+gt_deleteBWTSeqView(BWTSeq *bwtSeqView)
+{
+  deleteEISHint(bwtSeqView->seqIdx, bwtSeqView->hint);
+  gt_free(bwtSeqView);
+}
+
 typedef struct
 {
   const Mbtab **mbtab;
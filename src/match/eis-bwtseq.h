@@ -106,6 +106,24 @@ gt_loadBWTSeq(const char *projectName, int BWTOptFlags, GtLogger *verbosity,
 void
 gt_deleteBWTSeq(BWTSeq *bwtseq);
 
+/**
+ * \brief Create a view of a BWT sequence object which shares all data
+ * with the object but uses its own hint, so that the object and its
+ * views can be queried concurrently by different threads.
+ * @param bwtSeq reference of object to create a view of
+ * @return reference to new view, must be deleted with gt_deleteBWTSeqView
+ * before bwtSeq is deleted
+ */
+BWTSeq *
+gt_newBWTSeqView(const BWTSeq *bwtSeq);
+
+/**
+ * \brief Deallocate a view created with gt_newBWTSeqView.
+ * @param bwtSeqView reference of view to delete
+ */
+void
+gt_deleteBWTSeqView(BWTSeq *bwtSeqView);
+
 /**
  * \brief Query BWT sequence object for availability of added
  * information to locate matches.
@@ -52,6 +52,12 @@ struct blockEncParams
                                * store partial symbol sums (lower
                                * values increase index size and
                                * decrease computations for lookup) */
+  bool interleaveRankLines;   /**< additionally store the sequence in
+                               * 64 byte lines, each holding the
+                               * symbol ranks at its start followed
+                               * by the symbols it covers, so that a
+                               * rank query touches a single cache
+                               * line (DNA alphabets only) */
 };
 
 /**
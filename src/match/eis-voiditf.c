@@ -401,6 +401,16 @@ void bwtrangewithspecial(GT_UNUSED GtArrayBoundswithchar *bwci,
 }
 */
 
+FMindex *gt_newvoidBWTSeqview(const FMindex *packedindex)
+{
+  return (FMindex *) gt_newBWTSeqView((const BWTSeq *) packedindex);
+}
+
+void gt_deletevoidBWTSeqview(FMindex *packedindexview)
+{
+  gt_deleteBWTSeqView((BWTSeq *) packedindexview);
+}
+
 void gt_deletevoidBWTSeq(FMindex *fmindex)
 {
   BWTSeq *bwtseq = (BWTSeq *) fmindex;
@@ -83,6 +83,12 @@ FMindex *gt_loadvoidBWTSeqForSA(const char *indexname,
 
 void gt_deletevoidBWTSeq(FMindex *packedindex);
 
+/* returns a view of <packedindex> with its own rank query cache, such that
+   it can be used by another thread than <packedindex>. */
+FMindex *gt_newvoidBWTSeqview(const FMindex *packedindex);
+
+void gt_deletevoidBWTSeqview(FMindex *packedindexview);
+
 /* the parameter is const void *, as this is required by the other
    indexed based methods */
 
@@ -272,6 +272,41 @@ int gt_esa_bottomup(Sequentialsuffixarrayreader *ssar,
   return haserr ? -1 : 0;
 }
 
+unsigned int gt_esa_bottomup_partition(GtUword *partstarts,
+                                       const Sequentialsuffixarrayreader *ssar,
+                                       unsigned int numofparts,
+                                       GtUword lcpthreshold)
+{
+  const Suffixarray *suffixarray = ssar->suffixarray;
+  GtUword nonspecials = gt_Sequentialsuffixarrayreader_nonspecials(ssar);
+  unsigned int part, numofsplits = 0;
+
+  gt_assert(!ssar->scanfile && numofparts > 0);
+  partstarts[numofsplits++] = 0;
+  for (part = 1U; part < numofparts; part++)
+  {
+    GtUword pos = (GtUword) part * nonspecials/numofparts;
+
+    if (pos <= partstarts[numofsplits-1])
+    {
+      pos = partstarts[numofsplits-1] + 1;
+    }
+    /* an lcp-interval with an lcp value larger than <lcpthreshold> cannot
+       contain a suffix whose lcp value is not larger than <lcpthreshold> */
+    while (pos < nonspecials && lcptable_get(suffixarray,pos) > lcpthreshold)
+    {
+      pos++;
+    }
+    if (pos >= nonspecials)
+    {
+      break;
+    }
+    partstarts[numofsplits++] = pos;
+  }
+  partstarts[numofsplits] = nonspecials;
+  return numofsplits;
+}
+
 int gt_esa_bottomup_RAM(const GtUword *suftab,
                         const uint16_t *lcptab_bucket,
                         GtUword nonspecials,
@@ -32,6 +32,19 @@ int gt_esa_bottomup(Sequentialsuffixarrayreader *ssar,
                     GtESAVisitor *ev,
                     GtError *err);
 
+/* Splits the nonspecial suffixes of <ssar>, which must have been mapped
+   into memory, into at most <numofparts> parts of similar size, such that
+   each part begins with a suffix whose lcp value with its predecessor is
+   not larger than <lcpthreshold>. Thus only lcp-intervals with an lcp value
+   not larger than <lcpthreshold> cross the border of a part. The first
+   suffix of the i-th part is stored in <partstarts[i]>, the entry following
+   the last part is the number of nonspecial suffixes, so <partstarts> must
+   have space for <numofparts>+1 values. Returns the number of parts. */
+unsigned int gt_esa_bottomup_partition(GtUword *partstarts,
+                                       const Sequentialsuffixarrayreader *ssar,
+                                       unsigned int numofparts,
+                                       GtUword lcpthreshold);
+
 GtArrayGtBUItvinfo *gt_GtArrayGtBUItvinfo_new(void);
 
 void gt_GtArrayGtBUItvinfo_delete(GtArrayGtBUItvinfo *stack,
@@ -213,6 +213,7 @@ static void initsuffixarray(Suffixarray *suffixarray)
 {
   suffixarray->encseq = NULL;
   suffixarray->suftab = NULL;
+  gt_suftabcompressed_init(&suffixarray->suftabcompressed);
   suffixarray->lcptab = NULL;
   suffixarray->llvtab = NULL;
   suffixarray->bwttab = NULL;
@@ -260,6 +261,7 @@ void gt_freesuffixarray(Suffixarray *suffixarray)
 {
   gt_fa_xmunmap((void *) suffixarray->suftab);
   suffixarray->suftab = NULL;
+  gt_suftabcompressed_unmap(&suffixarray->suftabcompressed);
   gt_fa_xmunmap((void *) suffixarray->lcptab);
   suffixarray->lcptab = NULL;
   gt_fa_xmunmap((void *) suffixarray->llvtab);
@@ -342,7 +344,21 @@ static int inputsuffixarray(bool map,
   }
   if (!haserr && (demand & SARR_SUFTAB))
   {
-    if (map)
+    if ((demand & SARR_SUFCOMPRESSED) &&
+        !gt_file_exists_with_suffix(indexname,GT_SUFTABSUFFIX) &&
+        gt_file_exists_with_suffix(indexname,GT_SUFTABSUFFIX_BYTECOMPRESSED))
+    {
+      /* the compressed suffix table is always mapped, as it is accessed
+         without decompressing it */
+      gt_logger_log(logger,"map compressed suftab");
+      if (gt_suftabcompressed_map(&suffixarray->suftabcompressed,
+                                  indexname,
+                                  suffixarray->numberofallsortedsuffixes,
+                                  err) != 0)
+      {
+        haserr = true;
+      }
+    } else if (map)
     {
       if (suffixarray->numberofallsortedsuffixes > 0)
       {
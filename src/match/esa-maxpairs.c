@@ -19,11 +19,18 @@
 #include "core/unused_api.h"
 #include "core/minmax_api.h"
 #include "core/arraydef_api.h"
+#include "core/thread_api.h"
+#include "esa-bottomup.h"
 #include "esa-seqread.h"
 #include "esa-lcpintervals.h"
 #include "esa-maxpairs.h"
+#include "ordered_output.h"
 #include "sfx-sain.h"
 
+/* the maximal number of bytes of output of completed parts kept in memory
+   when enumerating maximal pairs in parallel */
+#define GT_MAXPAIRS_MAXBUFFERED ((size_t) 1 << 26)
+
 #define ISLEFTDIVERSE   (GtUchar) (state->alphabetsize)
 #define INITIALCHAR     (GtUchar) (state->alphabetsize+1)
 
@@ -308,8 +315,14 @@ static bool linearfindlcpinterval(const Lcpinterval *itvtab,GtUword num,
 static bool binaryfindlcpinterval(const Lcpinterval *itvtab,GtUword num,
                                   GtUword lcp,GtUword lb)
 {
-  const Lcpinterval *left = itvtab, *right = itvtab + num - 1;
+  const Lcpinterval *left, *right;
 
+  if (num == 0)
+  {
+    return false;
+  }
+  left = itvtab;
+  right = itvtab + num - 1;
   while (left <= right)
   {
     const Lcpinterval *mid = left + (right - left + 1)/2;
@@ -451,6 +464,15 @@ static int processbranchingedge_maxpairs(bool firstsucc,
   return 0;
 }
 
+/* a son of an interval with depth smaller than the searchlength has been
+   moved to the merge of a partitioned traversal, which ignores it. As no
+   other interval is open in the part, the position lists can be reused. */
+static void processpartson_maxpairs(GT_UNUSED GtBUinfo_maxpairs *son,
+                                    GtBUstate_maxpairs *state)
+{
+  setpostabto0_maxpairs(state);
+}
+
 static GtUword gt_ssar_ssli_nonspecials(const Sequentialsuffixarrayreader *ssar,
                                         const GtSainSufLcpIterator *ssli)
 {
@@ -475,17 +497,16 @@ static GtUword gt_ssar_ssli_nonspecials(const Sequentialsuffixarrayreader *ssar,
 
 #include "esa-bottomup-maxpairs.inc"
 
-int gt_enumeratemaxpairs_generic(Sequentialsuffixarrayreader *ssar,
+static GtBUstate_maxpairs *gt_maxpairs_state_new(
+                                 const Sequentialsuffixarrayreader *ssar,
                                  GtSainSufLcpIterator *suflcpiterator,
                                  unsigned int searchlength,
                                  GtProcessmaxpairs processmaxpairs,
-                                 void *processmaxpairsinfo,
-                                 GtError *err)
+                                 void *processmaxpairsinfo)
 {
   unsigned int base;
   GtArrayGtUword *ptr;
   GtBUstate_maxpairs *state;
-  bool haserr = false;
 
   state = gt_malloc(sizeof (*state));
   state->searchlength = searchlength;
@@ -523,10 +544,14 @@ int gt_enumeratemaxpairs_generic(Sequentialsuffixarrayreader *ssar,
     ptr = &state->poslist[base];
     GT_INITARRAY(ptr,GtUword);
   }
-  if (gt_esa_bottomup_maxpairs(ssar, suflcpiterator,  state, err) != 0)
-  {
-    haserr = true;
-  }
+  return state;
+}
+
+static void gt_maxpairs_state_delete(GtBUstate_maxpairs *state)
+{
+  unsigned int base;
+  GtArrayGtUword *ptr;
+
   GT_FREEARRAY(&state->uniquechar,GtUword);
   for (base = 0; base < state->alphabetsize; base++)
   {
@@ -535,6 +560,192 @@ int gt_enumeratemaxpairs_generic(Sequentialsuffixarrayreader *ssar,
   }
   gt_free(state->poslist);
   gt_free(state);
+}
+
+int gt_enumeratemaxpairs_generic(Sequentialsuffixarrayreader *ssar,
+                                 GtSainSufLcpIterator *suflcpiterator,
+                                 unsigned int searchlength,
+                                 GtProcessmaxpairs processmaxpairs,
+                                 void *processmaxpairsinfo,
+                                 GtError *err)
+{
+  GtBUstate_maxpairs *state;
+  bool haserr = false;
+
+  state = gt_maxpairs_state_new(ssar,suflcpiterator,searchlength,
+                                processmaxpairs,processmaxpairsinfo);
+  if (gt_esa_bottomup_maxpairs(ssar, suflcpiterator,  state, err) != 0)
+  {
+    haserr = true;
+  }
+  gt_maxpairs_state_delete(state);
+  return haserr ? -1 : 0;
+}
+
+typedef struct
+{
+  const Suffixarray *suffixarray;
+  const GtUword *partstarts;
+  GtUword lcpthreshold;
+  GtArrayGtBUItvinfo_maxpairs **partitvs;
+  GtBUstate_maxpairs *state;
+  GtProcessmaxpairsoutput processmaxpairsoutput;
+  GtOrderedOutput *ordered_output;
+  unsigned int worker;
+  GtError *err;
+  bool haserr;
+} GtMaxpairsThreadinfo;
+
+static void *gt_enumeratemaxpairs_thread(void *data)
+{
+  GtMaxpairsThreadinfo *threadinfo = (GtMaxpairsThreadinfo *) data;
+  GtUword part;
+  FILE *stream;
+
+  while ((stream = gt_ordered_output_next(threadinfo->ordered_output,
+                                          threadinfo->worker,&part)) != NULL)
+  {
+    if (!threadinfo->haserr)
+    {
+      threadinfo->processmaxpairsoutput(threadinfo->state->processmaxpairsinfo,
+                                        stream);
+      if (gt_esa_bottomup_part_maxpairs(threadinfo->suffixarray,
+                                        threadinfo->partstarts[part],
+                                        threadinfo->partstarts[part+1],
+                                        threadinfo->lcpthreshold,
+                                        threadinfo->partitvs[part],
+                                        threadinfo->state,
+                                        threadinfo->err) != 0)
+      {
+        threadinfo->haserr = true;
+      }
+    }
+    gt_ordered_output_done(threadinfo->ordered_output,threadinfo->worker);
+  }
+  return NULL;
+}
+
+/* the parts are processed in parallel, writing the pairs of each part to a
+   stream of <ordered_output>. Since the suffix array is split at suffixes
+   with lcp value smaller than <searchlength>, the merge of the parts only
+   processes intervals of smaller depth and thus does not report pairs. */
+static int gt_enumeratemaxpairs_parallel(const Sequentialsuffixarrayreader
+                                           *ssar,
+                                         unsigned int searchlength,
+                                         GtProcessmaxpairs processmaxpairs,
+                                         GtProcessmaxpairsoutput
+                                           processmaxpairsoutput,
+                                         void **processmaxpairsinfo,
+                                         unsigned int numofthreads,
+                                         FILE *outfp,
+                                         GtLogger *logger,
+                                         GtError *err)
+{
+  const GtUword lcpthreshold = (GtUword) searchlength - 1;
+  GtArrayGtBUItvinfo_maxpairs **partitvs;
+  GtMaxpairsThreadinfo *threadinfo;
+  GtOrderedOutput *ordered_output;
+  GtBUstate_maxpairs *mergestate;
+  GtUword *partstarts;
+  unsigned int part, numofparts, thread;
+  bool haserr = false;
+
+  gt_assert(searchlength > 0 && numofthreads > 0);
+  /* more parts than threads balance the work of the threads */
+  partstarts = gt_malloc(sizeof *partstarts * (4 * numofthreads + 1));
+  numofparts = gt_esa_bottomup_partition(partstarts,ssar,4 * numofthreads,
+                                         lcpthreshold);
+  gt_logger_log(logger,"enumerate maximal pairs in %u parts",numofparts);
+  partitvs = gt_malloc(sizeof *partitvs * numofparts);
+  for (part = 0; part < numofparts; part++)
+  {
+    partitvs[part] = gt_GtArrayGtBUItvinfo_new_maxpairs();
+  }
+  ordered_output = gt_ordered_output_new(outfp,(GtUword) numofparts,
+                                         numofthreads,GT_MAXPAIRS_MAXBUFFERED);
+  threadinfo = gt_malloc(sizeof *threadinfo * numofthreads);
+  for (thread = 0; thread < numofthreads; thread++)
+  {
+    threadinfo[thread].suffixarray = ssar->suffixarray;
+    threadinfo[thread].partstarts = partstarts;
+    threadinfo[thread].lcpthreshold = lcpthreshold;
+    threadinfo[thread].partitvs = partitvs;
+    threadinfo[thread].state
+      = gt_maxpairs_state_new(ssar,NULL,searchlength,processmaxpairs,
+                              processmaxpairsinfo[thread]);
+    threadinfo[thread].processmaxpairsoutput = processmaxpairsoutput;
+    threadinfo[thread].ordered_output = ordered_output;
+    threadinfo[thread].worker = thread;
+    threadinfo[thread].err = gt_error_new();
+    threadinfo[thread].haserr = false;
+  }
+#ifdef GT_THREADS_ENABLED
+  {
+    GtThread **threads = gt_malloc(sizeof *threads * numofthreads);
+    unsigned int numofstarted;
+
+    for (thread = 0; thread < numofthreads; thread++)
+    {
+      threads[thread] = gt_thread_new(gt_enumeratemaxpairs_thread,
+                                      threadinfo + thread,err);
+      if (threads[thread] == NULL)
+      {
+        haserr = true;
+        break;
+      }
+    }
+    /* the threads started so far process all parts */
+    numofstarted = thread;
+    for (thread = 0; thread < numofstarted; thread++)
+    {
+      gt_thread_join(threads[thread]);
+      gt_thread_delete(threads[thread]);
+    }
+    gt_free(threads);
+  }
+#else
+  for (thread = 0; thread < numofthreads; thread++)
+  {
+    (void) gt_enumeratemaxpairs_thread(threadinfo + thread);
+  }
+#endif
+  gt_ordered_output_delete(ordered_output);
+  for (thread = 0; thread < numofthreads; thread++)
+  {
+    if (!haserr && threadinfo[thread].haserr)
+    {
+      gt_error_set(err,"%s",gt_error_get(threadinfo[thread].err));
+      haserr = true;
+    }
+  }
+  mergestate = threadinfo[0].state;
+  if (!haserr)
+  {
+    processmaxpairsoutput(processmaxpairsinfo[0],outfp);
+    if (gt_esa_bottomup_merge_maxpairs(ssar->suffixarray,
+                                      gt_Sequentialsuffixarrayreader_nonspecials(
+                                                                         ssar),
+                                      lcpthreshold,
+                                      partitvs,
+                                      numofparts,
+                                      mergestate,
+                                      err) != 0)
+    {
+      haserr = true;
+    }
+  }
+  for (part = 0; part < numofparts; part++)
+  {
+    gt_GtArrayGtBUItvinfo_delete_maxpairs(partitvs[part],mergestate);
+  }
+  for (thread = 0; thread < numofthreads; thread++)
+  {
+    gt_maxpairs_state_delete(threadinfo[thread].state);
+    gt_error_delete(threadinfo[thread].err);
+  }
+  gt_free(threadinfo);
+  gt_free(partitvs);
+  gt_free(partstarts);
   return haserr ? -1 : 0;
 }
 
@@ -629,14 +840,44 @@ void showcollectedintervals(const Lcpinterval *itvtab,GtUword num)
   }
 }
 
-int gt_callenummaxpairs(const char *indexname,
-                        unsigned int userdefinedleastlength,
-                        GtUword maxfreq,
-                        bool scanfile,
-                        GtProcessmaxpairs processmaxpairs,
-                        void *processmaxpairsinfo,
-                        GtLogger *logger,
-                        GtError *err)
+static int gt_maxfreqcollect_run(GtMaxfreqcollect *maxfreqcollect,
+                                 const char *indexname,
+                                 unsigned int userdefinedleastlength,
+                                 GtUword maxfreq,
+                                 GtLogger *logger,
+                                 GtError *err)
+{
+  bool haserr = false;
+
+  maxfreqcollect->userdefinedleastlength = userdefinedleastlength;
+  maxfreqcollect->maxfreq = maxfreq;
+  if (gt_runenumlcpvalues_process(indexname,
+                                  collectmaxfreqintervals,
+                                  maxfreqcollect,
+                                  logger,
+                                  err) != 0)
+  {
+    haserr = true;
+  }
+  sortLcpintervals(maxfreqcollect->arr.spaceLcpinterval,
+                   maxfreqcollect->arr.nextfreeLcpinterval);
+  /*showcollectedintervals(maxfreqcollect->arr.spaceLcpinterval,
+                         maxfreqcollect->arr.nextfreeLcpinterval);*/
+  return haserr ? -1 : 0;
+}
+
+static int gt_callenummaxpairs_generic(const char *indexname,
+                                       unsigned int userdefinedleastlength,
+                                       GtUword maxfreq,
+                                       bool scanfile,
+                                       GtProcessmaxpairs processmaxpairs,
+                                       GtProcessmaxpairsoutput
+                                         processmaxpairsoutput,
+                                       void **processmaxpairsinfo,
+                                       unsigned int numofthreads,
+                                       FILE *outfp,
+                                       GtLogger *logger,
+                                       GtError *err)
 {
   bool haserr = false;
   Sequentialsuffixarrayreader *ssar = NULL;
@@ -646,26 +887,19 @@ int gt_callenummaxpairs(const char *indexname,
   GT_INITARRAY(&maxfreqcollect.arr,Lcpinterval);
   if (maxfreq > 0)
   {
-    maxfreqcollect.userdefinedleastlength = userdefinedleastlength;
-    maxfreqcollect.maxfreq = maxfreq;
-    if (gt_runenumlcpvalues_process(indexname,
-                                    collectmaxfreqintervals,
-                                    &maxfreqcollect,
-                                    logger,
-                                    err) != 0)
+    if (gt_maxfreqcollect_run(&maxfreqcollect,indexname,
+                              userdefinedleastlength,maxfreq,logger,
+                              err) != 0)
     {
       haserr = true;
     }
-    sortLcpintervals(maxfreqcollect.arr.spaceLcpinterval,
-                     maxfreqcollect.arr.nextfreeLcpinterval);
-    /*showcollectedintervals(maxfreqcollect.arr.spaceLcpinterval,
-                           maxfreqcollect.arr.nextfreeLcpinterval);*/
   }
   if (!haserr)
   {
     ssar = gt_newSequentialsuffixarrayreaderfromfile(indexname,
                                                      SARR_LCPTAB |
                                                      SARR_SUFTAB |
+                                                     SARR_SUFCOMPRESSED |
                                                      SARR_ESQTAB |
                                                      SARR_SSPTAB,
                                                      scanfile,
@@ -683,13 +917,24 @@ int gt_callenummaxpairs(const char *indexname,
       gt_assert(ssar != NULL);
       ssar->extrainfo = &maxfreqcollect;
     }
-    if (gt_enumeratemaxpairs(ssar,
-                             userdefinedleastlength,
-                             processmaxpairs,
-                             processmaxpairsinfo,
-                             err) != 0)
+    if (processmaxpairsoutput == NULL)
     {
-      haserr = true;
+      haserr = gt_enumeratemaxpairs(ssar,
+                                    userdefinedleastlength,
+                                    processmaxpairs,
+                                    processmaxpairsinfo[0],
+                                    err) != 0 ? true : false;
+    } else
+    {
+      haserr = gt_enumeratemaxpairs_parallel(ssar,
+                                             userdefinedleastlength,
+                                             processmaxpairs,
+                                             processmaxpairsoutput,
+                                             processmaxpairsinfo,
+                                             numofthreads,
+                                             outfp,
+                                             logger,
+                                             err) != 0 ? true : false;
     }
   }
   GT_FREEARRAY(&maxfreqcollect.arr,Lcpinterval);
@@ -699,3 +944,50 @@ int gt_callenummaxpairs(const char *indexname,
   }
   return haserr ? -1 : 0;
 }
+
+int gt_callenummaxpairs(const char *indexname,
+                        unsigned int userdefinedleastlength,
+                        GtUword maxfreq,
+                        bool scanfile,
+                        GtProcessmaxpairs processmaxpairs,
+                        void *processmaxpairsinfo,
+                        GtLogger *logger,
+                        GtError *err)
+{
+  return gt_callenummaxpairs_generic(indexname,
+                                     userdefinedleastlength,
+                                     maxfreq,
+                                     scanfile,
+                                     processmaxpairs,
+                                     NULL,
+                                     &processmaxpairsinfo,
+                                     1U,
+                                     NULL,
+                                     logger,
+                                     err);
+}
+
+int gt_callenummaxpairs_parallel(const char *indexname,
+                                 unsigned int userdefinedleastlength,
+                                 GtUword maxfreq,
+                                 GtProcessmaxpairs processmaxpairs,
+                                 GtProcessmaxpairsoutput processmaxpairsoutput,
+                                 void **processmaxpairsinfo,
+                                 unsigned int numofthreads,
+                                 FILE *outfp,
+                                 GtLogger *logger,
+                                 GtError *err)
+{
+  gt_assert(processmaxpairsoutput != NULL && userdefinedleastlength > 0);
+  return gt_callenummaxpairs_generic(indexname,
+                                     userdefinedleastlength,
+                                     maxfreq,
+                                     false,
+                                     processmaxpairs,
+                                     processmaxpairsoutput,
+                                     processmaxpairsinfo,
+                                     numofthreads,
+                                     outfp,
+                                     logger,
+                                     err);
+}
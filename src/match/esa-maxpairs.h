@@ -42,6 +42,10 @@ typedef int (*GtProcessmaxpairs)(void *,
                                  GtUword,
                                  GtError *);
 
+/* directs the output of the function processing maximal pairs with the
+   given data to the given stream */
+typedef void (*GtProcessmaxpairsoutput)(void *,FILE *);
+
 int gt_enumeratemaxpairs(Sequentialsuffixarrayreader *ssar,
                          unsigned int searchlength,
                          GtProcessmaxpairs processmaxpairs,
@@ -63,4 +67,26 @@ int gt_callenummaxpairs(const char *indexname,
                         GtLogger *logger,
                         GtError *err);
 
+/* Enumerates the same maximal pairs of length at least
+   <userdefinedleastlength> > 0 as <gt_callenummaxpairs> with
+   <numofthreads> threads. The suffix array is mapped and split into parts
+   at suffixes whose lcp value with their predecessor is smaller than
+   <userdefinedleastlength>, so that each part is traversed independently.
+   The lcp-intervals crossing the borders of the parts are merged
+   afterwards. Thread <t> reports the pairs with <processmaxpairs> and
+   <processmaxpairsinfo[t]>, after <processmaxpairsoutput> has directed the
+   output for <processmaxpairsinfo[t]> to the stream of the current part.
+   The output of the parts is written to <outfp> in the order of the
+   sequential enumeration. */
+int gt_callenummaxpairs_parallel(const char *indexname,
+                                 unsigned int userdefinedleastlength,
+                                 GtUword maxfreq,
+                                 GtProcessmaxpairs processmaxpairs,
+                                 GtProcessmaxpairsoutput processmaxpairsoutput,
+                                 void **processmaxpairsinfo,
+                                 unsigned int numofthreads,
+                                 FILE *outfp,
+                                 GtLogger *logger,
+                                 GtError *err);
+
 #endif
@@ -130,6 +130,13 @@ int gt_nextSequentialsuftabvalue(GtUword *currentsuffix,
                                  Sequentialsuffixarrayreader *ssar)
 {
   gt_assert(ssar != NULL);
+  if (ssar->suffixarray->suftabcompressed.tab != NULL)
+  {
+    *currentsuffix
+      = gt_suftabcompressed_get(&ssar->suffixarray->suftabcompressed,
+                                ssar->nextsuftabindex++);
+    return 1;
+  }
   if (ssar->scanfile)
   {
 #if defined (_LP64) || defined (_WIN64)
@@ -95,13 +95,21 @@ int gt_nextSequentialsuftabvalue(GtUword *currentsuffix,
 #endif
 
 #define SSAR_NEXTSEQUENTIALSUFTABVALUE(SUFTABVALUE,SSAR)\
-        if ((SSAR)->scanfile)\
+        if ((SSAR)->suffixarray->suftabcompressed.tab != NULL)\
         {\
-          SSAR_NEXTSEQUENTIALSUFTABVALUE_SEQ_scan(SUFTABVALUE,SSAR);\
+          SUFTABVALUE = gt_suftabcompressed_get(\
+                                  &(SSAR)->suffixarray->suftabcompressed,\
+                                  (SSAR)->nextsuftabindex++);\
         } else\
         {\
-          SUFTABVALUE = ESASUFFIXPTRGET((SSAR)->suffixarray->suftab,\
-                                        (SSAR)->nextsuftabindex++);\
+          if ((SSAR)->scanfile)\
+          {\
+            SSAR_NEXTSEQUENTIALSUFTABVALUE_SEQ_scan(SUFTABVALUE,SSAR);\
+          } else\
+          {\
+            SUFTABVALUE = ESASUFFIXPTRGET((SSAR)->suffixarray->suftab,\
+                                          (SSAR)->nextsuftabindex++);\
+          }\
         }
 
 #define SSAR_NEXTSEQUENTIALLCPTABVALUE(LCPVALUE,SSAR)\
@@ -187,7 +195,7 @@ int gt_nextSequentialsuftabvalue(GtUword *currentsuffix,
               }\
             } else\
             {\
-              SSAR_NEXTSEQUENTIALSUFTABVALUE_SEQ_scan(LASTSUFTABVALUE,SSAR);\
+              SSAR_NEXTSEQUENTIALSUFTABVALUE(LASTSUFTABVALUE,SSAR);\
               break;\
             }\
           } else\
@@ -208,8 +216,7 @@ int gt_nextSequentialsuftabvalue(GtUword *currentsuffix,
               }\
             } else\
             {\
-              LASTSUFTABVALUE = ESASUFFIXPTRGET((SSAR)->suffixarray->suftab,\
-                                                (SSAR)->nextsuftabindex++);\
+              SSAR_NEXTSEQUENTIALSUFTABVALUE(LASTSUFTABVALUE,SSAR);\
               break;\
             }\
           }\
@@ -0,0 +1,210 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include "core/fa_api.h"
+#include "core/ma_api.h"
+#include "core/xansi_api.h"
+#include "esa-fileend.h"
+#include "esa-sufcompressed.h"
+
+#define GT_SUFTABCOMPRESSED_HEADERSIZE 2
+#define GT_SUFTABCOMPRESSED_BUFFERSIZE 1024
+
+struct GtSuftabcompressedWriter
+{
+  FILE *outfp;
+  GtUword buffer[GT_SUFTABCOMPRESSED_BUFFERSIZE],
+          currentunit,
+          numofentries;
+  unsigned int bitsperentry,
+               nextfreeinbuffer,
+               remainingbits;
+};
+
+void gt_suftabcompressed_init(GtSuftabcompressed *suftabcompressed)
+{
+  suftabcompressed->tab = NULL;
+  suftabcompressed->mappedptr = NULL;
+  suftabcompressed->numofentries = 0;
+  suftabcompressed->bitsperentry = 0;
+}
+
+static GtUword gt_suftabcompressed_numofunits(GtUword numofentries,
+                                              unsigned int bitsperentry)
+{
+  GtUword totalbits = numofentries * bitsperentry;
+
+  return GT_DIVWORDSIZE(totalbits) + (GT_MODWORDSIZE(totalbits) > 0 ? 1 : 0);
+}
+
+int gt_suftabcompressed_map(GtSuftabcompressed *suftabcompressed,
+                            const char *indexname,
+                            GtUword numofentries,
+                            GtError *err)
+{
+  size_t numofbytes = 0;
+  const GtUword *header;
+  bool haserr = false;
+
+  gt_error_check(err);
+  suftabcompressed->mappedptr
+    = gt_fa_mmap_read_with_suffix(indexname,GT_SUFTABSUFFIX_BYTECOMPRESSED,
+                                  &numofbytes,err);
+  if (suftabcompressed->mappedptr == NULL)
+  {
+    return -1;
+  }
+  header = (const GtUword *) suftabcompressed->mappedptr;
+  if (numofbytes < sizeof *header * GT_SUFTABCOMPRESSED_HEADERSIZE ||
+      header[0] != numofentries ||
+      header[1] == 0 || header[1] > (GtUword) GT_INTWORDSIZE ||
+      numofbytes != sizeof *header *
+                    (GT_SUFTABCOMPRESSED_HEADERSIZE +
+                     gt_suftabcompressed_numofunits(numofentries,
+                                                    (unsigned int) header[1])))
+  {
+    gt_error_set(err,"file %s%s is not a compressed suffix table with "
+                     GT_WU " entries",indexname,
+                     GT_SUFTABSUFFIX_BYTECOMPRESSED,numofentries);
+    haserr = true;
+  }
+  if (haserr)
+  {
+    gt_fa_xmunmap(suftabcompressed->mappedptr);
+    suftabcompressed->mappedptr = NULL;
+    return -1;
+  }
+  suftabcompressed->numofentries = numofentries;
+  suftabcompressed->bitsperentry = (unsigned int) header[1];
+  suftabcompressed->bitsleft = (unsigned int) GT_INTWORDSIZE -
+                               suftabcompressed->bitsperentry;
+  suftabcompressed->maskright = ~0UL >> suftabcompressed->bitsleft;
+  suftabcompressed->tab = header + GT_SUFTABCOMPRESSED_HEADERSIZE;
+  return 0;
+}
+
+void gt_suftabcompressed_unmap(GtSuftabcompressed *suftabcompressed)
+{
+  gt_fa_xmunmap(suftabcompressed->mappedptr);
+  gt_suftabcompressed_init(suftabcompressed);
+}
+
+GtSuftabcompressedWriter *gt_suftabcompressed_writer_new(FILE *outfp,
+                                                  unsigned int bitsperentry)
+{
+  GtSuftabcompressedWriter *writer = gt_malloc(sizeof *writer);
+  GtUword header[GT_SUFTABCOMPRESSED_HEADERSIZE] = {0};
+
+  gt_assert(outfp != NULL && bitsperentry > 0 &&
+            bitsperentry <= (unsigned int) GT_INTWORDSIZE);
+  writer->outfp = outfp;
+  writer->bitsperentry = bitsperentry;
+  writer->numofentries = 0;
+  writer->currentunit = 0;
+  writer->remainingbits = (unsigned int) GT_INTWORDSIZE;
+  writer->nextfreeinbuffer = 0;
+  /* the header is written when the number of entries is known */
+  gt_xfwrite(header,sizeof *header,(size_t) GT_SUFTABCOMPRESSED_HEADERSIZE,
+             outfp);
+  return writer;
+}
+
+static void gt_suftabcompressed_writer_nextunit(
+                                        GtSuftabcompressedWriter *writer)
+{
+  if (writer->nextfreeinbuffer == (unsigned int) GT_SUFTABCOMPRESSED_BUFFERSIZE)
+  {
+    gt_xfwrite(writer->buffer,sizeof *writer->buffer,
+               (size_t) writer->nextfreeinbuffer,writer->outfp);
+    writer->nextfreeinbuffer = 0;
+  }
+  writer->buffer[writer->nextfreeinbuffer++] = writer->currentunit;
+}
+
+static void gt_suftabcompressed_writer_addvalue(
+                                        GtSuftabcompressedWriter *writer,
+                                        GtUword value)
+{
+  gt_assert(writer->bitsperentry == (unsigned int) GT_INTWORDSIZE ||
+            value < (1UL << writer->bitsperentry));
+  if (writer->bitsperentry <= writer->remainingbits)
+  {
+    writer->remainingbits -= writer->bitsperentry;
+    writer->currentunit |= value << writer->remainingbits;
+    if (writer->remainingbits == 0)
+    {
+      gt_suftabcompressed_writer_nextunit(writer);
+      writer->currentunit = 0;
+      writer->remainingbits = (unsigned int) GT_INTWORDSIZE;
+    }
+  } else
+  {
+    unsigned int overflow = writer->bitsperentry - writer->remainingbits;
+
+    writer->currentunit |= value >> overflow;
+    gt_suftabcompressed_writer_nextunit(writer);
+    writer->remainingbits = (unsigned int) GT_INTWORDSIZE - overflow;
+    writer->currentunit = value << writer->remainingbits;
+  }
+  writer->numofentries++;
+}
+
+void gt_suftabcompressed_writer_add(GtSuftabcompressedWriter *writer,
+                                    const GtUword *ulongtab,
+                                    const uint32_t *uinttab,
+                                    GtUword numofentries)
+{
+  GtUword idx;
+
+  if (ulongtab != NULL)
+  {
+    for (idx = 0; idx < numofentries; idx++)
+    {
+      gt_suftabcompressed_writer_addvalue(writer,ulongtab[idx]);
+    }
+  } else
+  {
+    gt_assert(uinttab != NULL);
+    for (idx = 0; idx < numofentries; idx++)
+    {
+      gt_suftabcompressed_writer_addvalue(writer,(GtUword) uinttab[idx]);
+    }
+  }
+}
+
+void gt_suftabcompressed_writer_delete(GtSuftabcompressedWriter *writer)
+{
+  GtUword header[GT_SUFTABCOMPRESSED_HEADERSIZE];
+
+  if (writer == NULL)
+  {
+    return;
+  }
+  if (writer->remainingbits < (unsigned int) GT_INTWORDSIZE)
+  {
+    gt_suftabcompressed_writer_nextunit(writer);
+  }
+  gt_xfwrite(writer->buffer,sizeof *writer->buffer,
+             (size_t) writer->nextfreeinbuffer,writer->outfp);
+  header[0] = writer->numofentries;
+  header[1] = (GtUword) writer->bitsperentry;
+  gt_xfseek(writer->outfp,0,SEEK_SET);
+  gt_xfwrite(header,sizeof *header,(size_t) GT_SUFTABCOMPRESSED_HEADERSIZE,
+             writer->outfp);
+  gt_xfseek(writer->outfp,0,SEEK_END);
+  gt_free(writer);
+}
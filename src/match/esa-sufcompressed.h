@@ -0,0 +1,103 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef ESA_SUFCOMPRESSED_H
+#define ESA_SUFCOMPRESSED_H
+
+#include <stdio.h>
+#include "core/assert_api.h"
+#include "core/error_api.h"
+#include "core/intbits.h"
+#include "core/types_api.h"
+
+/* A suffix table stored with a fixed number of bits per entry, usually
+   ceil(log2(totallength+1)). The file with suffix
+   <GT_SUFTABSUFFIX_BYTECOMPRESSED> consists of the number of entries and
+   the number of bits per entry, both as <GtUword>-values, followed by the
+   entries packed into <GtUword>-values, most significant bits first (the
+   layout of <GtCompactUlongStore>). As all components are aligned, the file
+   is mapped into memory and accessed without decompressing it. */
+typedef struct
+{
+  const GtUword *tab;
+  GtUword numofentries,
+          maskright;
+  unsigned int bitsperentry,
+               bitsleft;
+  void *mappedptr;
+} GtSuftabcompressed;
+
+/* Initializes <suftabcompressed> as not mapped, i.e. <tab> is NULL. */
+void gt_suftabcompressed_init(GtSuftabcompressed *suftabcompressed);
+
+/* Maps the compressed suffix table of the index <indexname> into memory,
+   which must contain <numofentries> entries. Returns 0 on success and -1 if
+   an error occurred, which is stored in <err>. */
+int gt_suftabcompressed_map(GtSuftabcompressed *suftabcompressed,
+                            const char *indexname,
+                            GtUword numofentries,
+                            GtError *err);
+
+/* Unmaps <suftabcompressed> if it was mapped. */
+void gt_suftabcompressed_unmap(GtSuftabcompressed *suftabcompressed);
+
+/* Returns the entry with index <idx> of <suftabcompressed>. */
+static inline GtUword gt_suftabcompressed_get(
+                               const GtSuftabcompressed *suftabcompressed,
+                               GtUword idx)
+{
+  unsigned int unitoffset;
+  GtUword unitindex;
+
+  gt_assert(idx < suftabcompressed->numofentries);
+  idx *= suftabcompressed->bitsperentry;
+  unitoffset = (unsigned int) GT_MODWORDSIZE(idx);
+  unitindex = GT_DIVWORDSIZE(idx);
+  if (unitoffset <= suftabcompressed->bitsleft)
+  {
+    return (suftabcompressed->tab[unitindex] >>
+            (suftabcompressed->bitsleft - unitoffset)) &
+           suftabcompressed->maskright;
+  }
+  return ((suftabcompressed->tab[unitindex] <<
+           (unitoffset + suftabcompressed->bitsperentry - GT_INTWORDSIZE)) |
+          (suftabcompressed->tab[unitindex+1] >>
+           (GT_INTWORDSIZE + suftabcompressed->bitsleft - unitoffset))) &
+         suftabcompressed->maskright;
+}
+
+/* The <GtSuftabcompressedWriter> writes the entries of a suffix table in
+   the compressed format to a file, while they are computed. */
+typedef struct GtSuftabcompressedWriter GtSuftabcompressedWriter;
+
+/* Returns a new <GtSuftabcompressedWriter> writing to <outfp> with
+   <bitsperentry> bits per entry, which must be positive. */
+GtSuftabcompressedWriter *gt_suftabcompressed_writer_new(FILE *outfp,
+                                                  unsigned int bitsperentry);
+
+/* Appends the <numofentries> values in <ulongtab> or, if <ulongtab> is
+   NULL, in <uinttab> to the output of <writer>. */
+void gt_suftabcompressed_writer_add(GtSuftabcompressedWriter *writer,
+                                    const GtUword *ulongtab,
+                                    const uint32_t *uinttab,
+                                    GtUword numofentries);
+
+/* Writes the remaining entries and the header of <writer> and deletes it.
+   The output file is not closed. */
+void gt_suftabcompressed_writer_delete(GtSuftabcompressedWriter *writer);
+
+#endif
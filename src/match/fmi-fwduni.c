@@ -122,3 +122,35 @@ GtUword gt_skfmmstats (const void *genericindex,
   }
   return matchlength;
 }
+
+bool gt_skfmexactmatches(GtUwordBound *bwtbound,
+                         const Fmindex *fmindex,
+                         const GtUchar *qstart,
+                         const GtUchar *qend)
+{
+  GtUchar cc;
+  const GtUchar *qptr;
+
+  gt_assert(qstart < qend);
+  cc = *qstart;
+  if (GT_ISSPECIAL(cc))
+  {
+    return false;
+  }
+  bwtbound->lbound = fmindex->tfreq[cc];
+  bwtbound->ubound = fmindex->tfreq[cc+1];
+  for (qptr = qstart + 1;
+       qptr < qend && bwtbound->lbound < bwtbound->ubound; qptr++)
+  {
+    cc = *qptr;
+    if (GT_ISSPECIAL (cc))
+    {
+      return false;
+    }
+    bwtbound->lbound = fmindex->tfreq[cc] +
+                       fmoccurrence (fmindex, cc, bwtbound->lbound);
+    bwtbound->ubound = fmindex->tfreq[cc] +
+                       fmoccurrence (fmindex, cc, bwtbound->ubound);
+  }
+  return bwtbound->lbound < bwtbound->ubound ? true : false;
+}
@@ -18,6 +18,8 @@
 #define FMI_FWDUNI_H
 #include "core/types_api.h"
 #include "core/unused_api.h"
+#include "core/ulongbound.h"
+#include "fmindex.h"
 
 GtUword gt_skfmuniqueforward (const void *genericindex,
                               GT_UNUSED GtUword offset,
@@ -35,4 +37,12 @@ GtUword gt_skfmmstats (const void *genericindex,
                        const GtUchar *qstart,
                        const GtUchar *qend);
 
+/* computes the interval <bwtbound> of bwt positions of all matches of the
+   sequence from <qstart> to <qend>-1, which is read from left to right.
+   Returns false if there is no match. */
+bool gt_skfmexactmatches(GtUwordBound *bwtbound,
+                         const Fmindex *fmindex,
+                         const GtUchar *qstart,
+                         const GtUchar *qend);
+
 #endif
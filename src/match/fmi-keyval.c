@@ -55,6 +55,15 @@ static GtUword determinefmindexsize (const Fmindex *fm,
     sumsize += (uint64_t) sizeof (GtUword) *
                (uint64_t) MARKPOSTABLELENGTH(fm->bwtlength,fm->markdist);
   }
+  if (storeindexpos && fm->textmarkdist > 0)
+  {
+    sumsize += (uint64_t) sizeof (GtUword) *
+               (uint64_t) MARKPOSTABLELENGTH(fm->bwtlength,fm->textmarkdist);
+    sumsize += (uint64_t) sizeof (GtUword) *
+               (uint64_t) TEXTMARKRANKLENGTH(fm->bwtlength);
+    sumsize += (uint64_t) sizeof (GtBitsequence) *
+               (uint64_t) TEXTMARKBITSLENGTH(fm->bwtlength);
+  }
   if (suffixlength > 0)
   {
     sumsize += (uint64_t) sizeof (GtUwordBound) * (uint64_t) fm->numofcodes;
@@ -74,6 +83,7 @@ void gt_computefmkeyvalues (Fmindex *fm,
                             GtUword bwtlength,
                             unsigned int log2bsize,
                             unsigned int log2markdist,
+                            GtUword textmarkdist,
                             unsigned int numofchars,
                             unsigned int suffixlength,
                             bool storeindexpos)
@@ -90,6 +100,7 @@ void gt_computefmkeyvalues (Fmindex *fm,
   fm->nofsuperblocks = (GtUword) (fm->bwtlength / fm->superbsize) + 2;
   fm->markdist = (GtUword) GT_POW2 (fm->log2markdist);
   fm->markdistminus1 = (GtUword) (fm->markdist - 1);
+  fm->textmarkdist = storeindexpos ? textmarkdist : 0;
   fm->negatebsizeones = ~ (GtUword) (fm->bsize - 1);
   fm->negatesuperbsizeones = ~ (GtUword) (fm->superbsize - 1);
   fm->log2superbsizeminuslog2bsize = fm->log2superbsize - fm->log2bsize;
@@ -30,6 +30,7 @@ void gt_computefmkeyvalues (Fmindex *fm,
                             GtUword bwtlength,
                             unsigned int log2bsize,
                             unsigned int log2markdist,
+                            GtUword textmarkdist,
                             unsigned int numofchars,
                             unsigned int suffixlength,
                             bool storeindexpos);
@@ -15,7 +15,11 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <limits.h>
+#include "core/byte_popcount_api.h"
 #include "core/divmodmul_api.h"
+#include "core/intbits.h"
+#include "core/ma_api.h"
 
 #include "fmindex.h"
 #include "fmi-locate.h"
@@ -55,24 +59,266 @@ static GtUword searchsmallestgeq(const GtPairBwtidx *left,
   return found->suftabvalue;
 }
 
-GtUword gt_fmfindtextpos (const Fmindex *fm,GtUword idx)
+#ifdef __GNUC__
+#define FMPOPCOUNT(V) ((GtUword) __builtin_popcountll((unsigned long long) (V)))
+#else
+static GtUword fmpopcount(GtBitsequence v)
 {
-  GtUword offset = 0;
-  GtUchar cc;
+  GtUword count = 0;
 
-  while ((idx & fm->markdistminus1) != 0)
+  for (/* Nothing */; v != 0; v >>= CHAR_BIT)
   {
-    if (idx == fm->longestsuffixpos || GT_ISSPECIAL(cc = ACCESSBWTTEXT(idx)))
-    {
-      GtUword smallestgeq
-               = searchsmallestgeq(fm->specpos.spaceGtPairBwtidx,
+    count += (GtUword) gt_byte_popcount[v & UCHAR_MAX];
+  }
+  return count;
+}
+#define FMPOPCOUNT(V) fmpopcount(V)
+#endif
+
+/* returns true iff the text position of the suffix at bwt position <idx>
+   is sampled, and stores this text position in <textpos> */
+static bool fmtextmarked(const Fmindex *fm,GtUword idx,GtUword *textpos)
+{
+  GtUword rank, wordidx, lastwordidx;
+
+  if (fm->textmarkdist == 0 || !GT_ISIBITSET(fm->textmarkbits,idx))
+  {
+    return false;
+  }
+  rank = fm->textmarkrank[idx / FMTEXTMARKRANKBLOCK];
+  lastwordidx = GT_DIVWORDSIZE(idx);
+  for (wordidx = GT_DIVWORDSIZE((idx / FMTEXTMARKRANKBLOCK) *
+                                FMTEXTMARKRANKBLOCK);
+       wordidx < lastwordidx; wordidx++)
+  {
+    rank += FMPOPCOUNT(fm->textmarkbits[wordidx]);
+  }
+  if (GT_MODWORDSIZE(idx) > 0)
+  {
+    rank += FMPOPCOUNT(fm->textmarkbits[lastwordidx] >>
+                       (GT_INTWORDSIZE - GT_MODWORDSIZE(idx)));
+  }
+  *textpos = fm->textmarkpostable[rank];
+  return true;
+}
+
+/* returns true iff the text position of the suffix at bwt position <idx>
+   can be determined without further LF-steps. In this case the position
+   is stored in <textpos>, with the <offset> already applied. */
+static bool fmresolvetextpos(const Fmindex *fm,GtUword idx,GtUchar cc,
+                             GtUword offset,GtUword *textpos)
+{
+  GtUword sampledpos;
+
+  if ((idx & fm->markdistminus1) == 0)
+  {
+    *textpos = (fm->markpostable[idx >> fm->log2markdist] + offset)
+               % fm->bwtlength;
+    return true;
+  }
+  if (fmtextmarked(fm,idx,&sampledpos))
+  {
+    *textpos = (sampledpos + offset) % fm->bwtlength;
+    return true;
+  }
+  if (idx == fm->longestsuffixpos || GT_ISSPECIAL(cc))
+  {
+    sampledpos = searchsmallestgeq(fm->specpos.spaceGtPairBwtidx,
                                    fm->specpos.spaceGtPairBwtidx +
                                    fm->specpos.nextfreeGtPairBwtidx - 1,
                                    idx);
-      return (smallestgeq + offset) % fm->bwtlength;
+    *textpos = (sampledpos + offset) % fm->bwtlength;
+    return true;
+  }
+  return false;
+}
+
+static GtUword fmfindtextposwithoffset(const Fmindex *fm,GtUword idx,
+                                       GtUword offset)
+{
+  GtUword textpos;
+
+  while (true)
+  {
+    GtUchar cc = idx == fm->longestsuffixpos ? (GtUchar) GT_SEPARATOR
+                                             : ACCESSBWTTEXT(idx);
+
+    if (fmresolvetextpos(fm,idx,cc,offset,&textpos))
+    {
+      return textpos;
     }
     idx = fm->tfreq[cc] + fmoccurrence (fm, cc, idx);
     offset++;
   }
-  return (fm->markpostable[idx / fm->markdist] + offset) % fm->bwtlength;
+}
+
+GtUword gt_fmfindtextpos (const Fmindex *fm,GtUword idx)
+{
+  return fmfindtextposwithoffset(fm,idx,0);
+}
+
+#define FMUNDEFORIGIN (~(GtUword) 0)
+
+/* an interval of bwt positions reached after <offset> LF-steps from the
+   located interval. The entry <origin[i]> of the origin table tells which
+   located position the bwt position <lbound>+<i> belongs to, or is
+   FMUNDEFORIGIN if it does not belong to an unresolved position. */
+typedef struct
+{
+  GtUword lbound,
+          width,
+          offset,
+          origin;
+} Fmlocateinterval;
+
+void gt_fmfindtextpos_interval(const Fmindex *fm,GtUword lbound,
+                               GtUword ubound,GtUword *textpos)
+{
+  const GtUword numofhits = ubound - lbound;
+  const unsigned int numofchars = fm->mapsize - 1;
+  Fmlocateinterval *intervals, *nextintervals, *tmpintervals;
+  GtUword *origins, *nextorigins, *tmporigins, *entryrank, *charcount,
+          *firstrank, *lastrank, *childorigin,
+          idx, numofintervals = 1UL, numofnextintervals;
+  GtUchar *entrychar;
+  unsigned int cc;
+
+  gt_assert(lbound <= ubound && fm->markpostable != NULL);
+  if (numofhits <= 1UL)
+  {
+    if (numofhits == 1UL)
+    {
+      textpos[0] = gt_fmfindtextpos(fm,lbound);
+    }
+    return;
+  }
+  /* the children of an interval have at most its width in total, hence
+     for each round <numofhits> entries suffice */
+  intervals = gt_malloc(sizeof *intervals * 2 * numofhits);
+  nextintervals = intervals + numofhits;
+  origins = gt_malloc(sizeof *origins * 2 * numofhits);
+  nextorigins = origins + numofhits;
+  entryrank = gt_malloc(sizeof *entryrank * numofhits);
+  entrychar = gt_malloc(sizeof *entrychar * numofhits);
+  charcount = gt_malloc(sizeof *charcount * 4 * numofchars);
+  firstrank = charcount + numofchars;
+  lastrank = firstrank + numofchars;
+  childorigin = lastrank + numofchars;
+  for (idx = 0; idx < numofhits; idx++)
+  {
+    origins[idx] = idx;
+  }
+  intervals[0].lbound = lbound;
+  intervals[0].width = numofhits;
+  intervals[0].offset = 0;
+  intervals[0].origin = 0;
+  while (numofintervals > 0)
+  {
+    GtUword itvnum, nextfreeorigin = 0;
+
+    numofnextintervals = 0;
+    for (itvnum = 0; itvnum < numofintervals; itvnum++)
+    {
+      const Fmlocateinterval *itv = intervals + itvnum;
+      GtUword unresolved = 0, lastunresolved = 0;
+
+      for (cc = 0; cc < numofchars; cc++)
+      {
+        charcount[cc] = 0;
+        firstrank[cc] = FMUNDEFORIGIN;
+      }
+      /* one scan over the interval determines the positions resolved in
+         this round and the rank of the symbol preceding each of the
+         other positions */
+      for (idx = 0; idx < itv->width; idx++)
+      {
+        GtUword pos = itv->lbound + idx,
+                orig = origins[itv->origin + idx];
+        GtUchar bwtchar = pos == fm->longestsuffixpos
+                            ? (GtUchar) GT_SEPARATOR : ACCESSBWTTEXT(pos);
+
+        if (orig != FMUNDEFORIGIN &&
+            !fmresolvetextpos(fm,pos,bwtchar,itv->offset,textpos + orig))
+        {
+          entrychar[idx] = bwtchar;
+          entryrank[idx] = charcount[bwtchar];
+          if (firstrank[bwtchar] == FMUNDEFORIGIN)
+          {
+            firstrank[bwtchar] = charcount[bwtchar];
+          }
+          lastrank[bwtchar] = charcount[bwtchar];
+          lastunresolved = idx;
+          unresolved++;
+        } else
+        {
+          origins[itv->origin + idx] = FMUNDEFORIGIN;
+        }
+        if (!GT_ISSPECIAL(bwtchar))
+        {
+          charcount[bwtchar]++;
+        }
+      }
+      if (unresolved == 1UL)
+      {
+        /* a single position is cheaper to follow on its own */
+        GtUchar bwtchar = entrychar[lastunresolved];
+
+        textpos[origins[itv->origin + lastunresolved]]
+          = fmfindtextposwithoffset(fm,
+                                    fm->tfreq[bwtchar] +
+                                    fmoccurrence(fm,bwtchar,itv->lbound) +
+                                    entryrank[lastunresolved],
+                                    itv->offset + 1);
+        continue;
+      }
+      /* the positions preceded by the same symbol are mapped by the
+         LF-mapping to consecutive positions, so each symbol gives one
+         interval for the next round, requiring only one occurrence
+         count */
+      for (cc = 0; cc < numofchars; cc++)
+      {
+        if (firstrank[cc] != FMUNDEFORIGIN)
+        {
+          Fmlocateinterval *child = nextintervals + numofnextintervals++;
+
+          child->lbound = fm->tfreq[cc] +
+                          fmoccurrence(fm,(GtUchar) cc,itv->lbound) +
+                          firstrank[cc];
+          child->width = lastrank[cc] - firstrank[cc] + 1;
+          child->offset = itv->offset + 1;
+          child->origin = nextfreeorigin;
+          childorigin[cc] = nextfreeorigin;
+          for (idx = 0; idx < child->width; idx++)
+          {
+            nextorigins[nextfreeorigin++] = FMUNDEFORIGIN;
+          }
+        }
+      }
+      for (idx = 0; unresolved > 0 && idx < itv->width; idx++)
+      {
+        GtUword orig = origins[itv->origin + idx];
+
+        if (orig != FMUNDEFORIGIN)
+        {
+          cc = (unsigned int) entrychar[idx];
+          nextorigins[childorigin[cc] + entryrank[idx] - firstrank[cc]]
+            = orig;
+        }
+      }
+    }
+    gt_assert(nextfreeorigin <= numofhits &&
+              numofnextintervals <= numofhits);
+    tmpintervals = intervals;
+    intervals = nextintervals;
+    nextintervals = tmpintervals;
+    tmporigins = origins;
+    origins = nextorigins;
+    nextorigins = tmporigins;
+    numofintervals = numofnextintervals;
+  }
+  gt_free(intervals < nextintervals ? intervals : nextintervals);
+  gt_free(origins < nextorigins ? origins : nextorigins);
+  gt_free(entryrank);
+  gt_free(entrychar);
+  gt_free(charcount);
 }
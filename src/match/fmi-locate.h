@@ -21,6 +21,19 @@
 #include "core/types_api.h"
 #include "fmindex.h"
 
+/* returns the text position of the suffix at bwt position <idx> */
 GtUword gt_fmfindtextpos (const Fmindex *fm,GtUword idx);
 
+/* stores the text positions of the suffixes at the bwt positions
+   <lbound>..<ubound>-1 in <textpos>[0..<ubound>-<lbound>-1]. The positions
+   are located together: in each round the positions sharing the same
+   preceding symbol are advanced by one LF-step with a single occurrence
+   count, so that for large intervals much fewer occurrence counts are
+   needed than when locating each position by gt_fmfindtextpos.
+   So far only gt dev patternmatch -fmi locates whole intervals; the
+   matching statistics in fmi-fwduni.c need a single witness position
+   and still use gt_fmfindtextpos. */
+void gt_fmfindtextpos_interval(const Fmindex *fm,GtUword lbound,
+                               GtUword ubound,GtUword *textpos);
+
 #endif
@@ -55,6 +55,7 @@ static int scanfmafileviafileptr(Fmindex *fmindex,
   bool haserr = false;
   GtScannedprjkeytable *scannedprjkeytable;
   unsigned int intstoreindexpos;
+  bool textmarkdistdefined = false;
 
   gt_error_check(err);
   scannedprjkeytable = gt_scannedprjkeytable_new();
@@ -63,6 +64,9 @@ static int scanfmafileviafileptr(Fmindex *fmindex,
   GT_SCANNEDPRJKEY_ADD("storeindexpos",&intstoreindexpos,NULL);
   GT_SCANNEDPRJKEY_ADD("log2blocksize",&fmindex->log2bsize,NULL);
   GT_SCANNEDPRJKEY_ADD("log2markdist",&fmindex->log2markdist,NULL);
+  /* not available in indices without sampling of text positions */
+  GT_SCANNEDPRJKEY_ADD("textmarkdist",&fmindex->textmarkdist,
+                       &textmarkdistdefined);
   GT_SCANNEDPRJKEY_ADD("specialcharacters",
                        &specialcharinfo->specialcharacters,NULL);
   GT_SCANNEDPRJKEY_ADD("specialranges",&specialcharinfo->specialranges,NULL);
@@ -111,6 +115,10 @@ static int scanfmafileviafileptr(Fmindex *fmindex,
   {
     haserr = true;
   }
+  if (!haserr && !textmarkdistdefined)
+  {
+    fmindex->textmarkdist = 0;
+  }
   if (!haserr)
   {
     if (intstoreindexpos == 1U)
@@ -224,6 +232,7 @@ int gt_mapfmindex (Fmindex *fmindex,const char *indexname,
                            fmindex->bwtlength,
                            fmindex->log2bsize,
                            fmindex->log2markdist,
+                           fmindex->textmarkdist,
                            gt_alphabet_num_of_chars(fmindex->alphabet),
                            fmindex->suffixlength,
                            storeindexpos);
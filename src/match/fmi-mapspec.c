@@ -38,6 +38,19 @@ static void assignfmmapspecification(GtMapspec *mapspec,
                        ? (GtUword) MARKPOSTABLELENGTH(fmindex->bwtlength,
                                                             fmindex->markdist)
                        : 0);
+  gt_mapspec_add_ulong(mapspec, fmindex->textmarkpostable,
+                       fmindex->textmarkdist > 0
+                       ? (GtUword) MARKPOSTABLELENGTH(fmindex->bwtlength,
+                                                      fmindex->textmarkdist)
+                       : 0);
+  gt_mapspec_add_ulong(mapspec, fmindex->textmarkrank,
+                       fmindex->textmarkdist > 0
+                       ? (GtUword) TEXTMARKRANKLENGTH(fmindex->bwtlength)
+                       : 0);
+  gt_mapspec_add_bitsequence(mapspec, fmindex->textmarkbits,
+                             fmindex->textmarkdist > 0
+                             ? (GtUword) TEXTMARKBITSLENGTH(fmindex->bwtlength)
+                             : 0);
   gt_mapspec_add_ulongbound(mapspec, fmindex->boundarray,
                             (GtUword) fmindex->numofcodes);
   gt_mapspec_add_pairbwtindex(mapspec, fmindex->specpos.spaceGtPairBwtidx,
@@ -21,6 +21,7 @@
 #include "core/versionfunc_api.h"
 #include "core/logger.h"
 #include "core/ma_api.h"
+#include "core/mathsupport_api.h"
 #include "fmindex.h"
 #include "fmi-save.h"
 #include "fmi-keyval.h"
@@ -30,6 +31,8 @@
 typedef struct
 {
   bool noindexpos;
+  GtUword markdist,
+          textmarkdist;
   GtStrArray *indexnametab;
   GtStr *leveldesc,
       *outfmindex;
@@ -56,7 +59,8 @@ static GtOPrval parsemkfmindex(Mkfmcallinfo *mkfmcallinfo,
                                GtError *err)
 {
   GtOptionParser *op;
-  GtOption *option, *optionfmout;
+  GtOption *option, *optionfmout, *optionmarkdist, *optiontextmarkdist,
+           *optionnoindexpos;
   GtOPrval oprval;
   int parsed_args;
 
@@ -84,14 +88,39 @@ static GtOPrval parsemkfmindex(Mkfmcallinfo *mkfmcallinfo,
                              mkfmcallinfo->leveldesc, "medium");
   gt_option_parser_add_option(op, option);
 
-  option = gt_option_new_bool("noindexpos",
+  optionnoindexpos = gt_option_new_bool("noindexpos",
                            "store no index positions (hence the positions of\n"
                            "matches in the index cannot be retrieved)",
                            &mkfmcallinfo->noindexpos,false);
-  gt_option_parser_add_option(op, option);
+  gt_option_parser_add_option(op, optionnoindexpos);
+
+  optionmarkdist = gt_option_new_uword("markdist",
+                           "specify distance of sampled suffix array entries\n"
+                           "(must be a power of 2, overrides the value implied "
+                           "by option -size)",
+                           &mkfmcallinfo->markdist,0);
+  gt_option_parser_add_option(op, optionmarkdist);
+
+  optiontextmarkdist = gt_option_new_uword("textmarkdist",
+                           "additionally sample every k-th text position,\n"
+                           "which bounds the number of LF-steps to locate a\n"
+                           "match by k-1 (0 means no text sampling)",
+                           &mkfmcallinfo->textmarkdist,0);
+  gt_option_parser_add_option(op, optiontextmarkdist);
+  gt_option_exclude(optionnoindexpos, optionmarkdist);
+  gt_option_exclude(optionnoindexpos, optiontextmarkdist);
 
   oprval = gt_option_parser_parse(op, &parsed_args, argc, argv, gt_versionfunc,
                                   err);
+  if (oprval == GT_OPTION_PARSER_OK && gt_option_is_set(optionmarkdist))
+  {
+    if (mkfmcallinfo->markdist == 0 ||
+        (mkfmcallinfo->markdist & (mkfmcallinfo->markdist - 1)) != 0)
+    {
+      gt_error_set(err,"argument of option -markdist must be a power of 2");
+      oprval = GT_OPTION_PARSER_ERROR;
+    }
+  }
   if (oprval == GT_OPTION_PARSER_OK)
   {
     if (!gt_option_is_set(optionfmout))
@@ -154,6 +183,9 @@ static void freeconstructedfmindex(Fmindex *fm)
   gt_free (fm->superbfreq);
   gt_free (fm->tfreq);
   gt_free (fm->markpostable);
+  gt_free (fm->textmarkpostable);
+  gt_free (fm->textmarkrank);
+  gt_free (fm->textmarkbits);
   if (fm->suffixlength > 0)
   {
     gt_free(fm->boundarray);
@@ -196,6 +228,9 @@ static int runmkfmindex(Mkfmcallinfo *mkfmcallinfo,GtLogger *logger,
   fm.superbfreq = NULL;
   fm.tfreq = NULL;
   fm.markpostable = NULL;
+  fm.textmarkpostable = NULL;
+  fm.textmarkrank = NULL;
+  fm.textmarkbits = NULL;
   fm.boundarray = NULL;
   fm.suffixlength = 0;
 
@@ -207,10 +242,15 @@ static int runmkfmindex(Mkfmcallinfo *mkfmcallinfo,GtLogger *logger,
                       gt_str_get(mkfmcallinfo->leveldesc));
     haserr = true;
   }
+  if (!haserr && mkfmcallinfo->markdist > 0)
+  {
+    log2markdist = gt_determinebitspervalue(mkfmcallinfo->markdist) - 1;
+  }
   if (!haserr && gt_sufbwt2fmindex(&fm,
                                    &specialcharinfo,
                                    log2bsize,
                                    log2markdist,
+                                   mkfmcallinfo->textmarkdist,
                                    gt_str_get(mkfmcallinfo->outfmindex),
                                    mkfmcallinfo->indexnametab,
                                    mkfmcallinfo->noindexpos ? false : true,
@@ -43,6 +43,7 @@ static int writefmascii(const char *indexname,
   fprintf (fmafp, "storeindexpos=%d\n", storeindexpos ? 1 : 0);
   fprintf (fmafp, "log2blocksize=%u\n", fm->log2bsize);
   fprintf (fmafp, "log2markdist=%u\n", fm->log2markdist);
+  fprintf (fmafp, "textmarkdist=" GT_WU "\n", fm->textmarkdist);
   fprintf (fmafp, "specialcharacters=" GT_WU "\n",
            specialcharinfo->specialcharacters);
   fprintf (fmafp, "specialranges=" GT_WU "\n",specialcharinfo->specialranges);
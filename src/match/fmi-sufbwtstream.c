@@ -119,6 +119,20 @@ static void allocatefmtables(Fmindex *fm,
     GT_INITARRAY(&fm->specpos,GtPairBwtidx);
     fm->markpostable = NULL;
   }
+  if (fm->textmarkdist > 0)
+  {
+    fm->textmarkpostable = gt_malloc(sizeof *fm->textmarkpostable
+                                     * MARKPOSTABLELENGTH(fm->bwtlength,
+                                                          fm->textmarkdist));
+    fm->textmarkrank = gt_malloc(sizeof *fm->textmarkrank
+                                 * TEXTMARKRANKLENGTH(fm->bwtlength));
+    GT_INITBITTAB(fm->textmarkbits,fm->bwtlength);
+  } else
+  {
+    fm->textmarkpostable = NULL;
+    fm->textmarkrank = NULL;
+    fm->textmarkbits = NULL;
+  }
   fm->bfreq = gt_malloc(sizeof *fm->bfreq
                         * BFREQSIZE(fm->mapsize,fm->nofblocks));
 }
@@ -163,6 +177,28 @@ static void finalizefmfrequencies(Fmindex *fm)
   }
 }
 
+static void finalizetextmarkrank(Fmindex *fm)
+{
+  GtUword bwtpos, rank = 0;
+
+  for (bwtpos = 0; bwtpos < fm->bwtlength; bwtpos++)
+  {
+    if ((bwtpos & (FMTEXTMARKRANKBLOCK - 1)) == 0)
+    {
+      fm->textmarkrank[bwtpos / FMTEXTMARKRANKBLOCK] = rank;
+    }
+    if (GT_ISIBITSET(fm->textmarkbits,bwtpos))
+    {
+      rank++;
+    }
+  }
+  if ((fm->bwtlength & (FMTEXTMARKRANKBLOCK - 1)) == 0)
+  {
+    fm->textmarkrank[fm->bwtlength / FMTEXTMARKRANKBLOCK] = rank;
+  }
+  gt_assert(rank == MARKPOSTABLELENGTH(fm->bwtlength,fm->textmarkdist));
+}
+
 static void showconstructionmessage(const char *indexname,
                                     GtUword totallength,
                                     GtUword fmsize,
@@ -182,6 +218,39 @@ static void showconstructionmessage(const char *indexname,
           (double) fmsize/(double) (totallength+1));
 }
 
+static void showsamplingmessage(const Fmindex *fm)
+{
+  GtUword samples, samplespace;
+
+  if (fm->markpostable == NULL)
+  {
+    return;
+  }
+  samples = (GtUword) MARKPOSTABLELENGTH(fm->bwtlength,fm->markdist);
+  samplespace = (GtUword) sizeof (GtUword) * samples;
+  printf("# sampling of suffix array: markdist="GT_WU", "GT_WU" samples, "
+         GT_WU" bytes (%.2f bytes per symbol)\n",
+         fm->markdist,samples,samplespace,
+         (double) samplespace/fm->bwtlength);
+  if (fm->textmarkdist > 0)
+  {
+    samples = (GtUword) MARKPOSTABLELENGTH(fm->bwtlength,fm->textmarkdist);
+    samplespace = (GtUword) (sizeof (GtUword) *
+                             (samples + TEXTMARKRANKLENGTH(fm->bwtlength)) +
+                             sizeof (GtBitsequence) *
+                             TEXTMARKBITSLENGTH(fm->bwtlength));
+    printf("# sampling of text: textmarkdist="GT_WU", "GT_WU" samples, "
+           GT_WU" bytes (%.2f bytes per symbol), at most "GT_WU
+           " LF-steps per position\n",
+           fm->textmarkdist,samples,samplespace,
+           (double) samplespace/fm->bwtlength,fm->textmarkdist - 1);
+  } else
+  {
+    printf("# sampling of text: none, expected number of LF-steps per "
+           "position is "GT_WU"\n",fm->markdist - 1);
+  }
+}
+
 static int nextesamergedsufbwttabvalues(Definedunsignedlong *longest,
                                        GtUchar *bwtvalue,
                                        GtUword *suftabvalue,
@@ -245,6 +314,7 @@ int gt_sufbwt2fmindex(Fmindex *fmindex,
                    GtSpecialcharinfo *specialcharinfo,
                    unsigned int log2bsize,
                    unsigned int log2markdist,
+                   GtUword textmarkdist,
                    const char *outfmindex,
                    const GtStrArray *indexnametab,
                    bool storeindexpos,
@@ -261,6 +331,7 @@ int gt_sufbwt2fmindex(Fmindex *fmindex,
          firstignorespecial = 0,
          nextmark,
          *markptr,
+         *textmarkptr = NULL,
          nextprogress,
          tmpsuftabvalue,
          stepprogress;
@@ -384,6 +455,7 @@ int gt_sufbwt2fmindex(Fmindex *fmindex,
                         totallength+1,
                         log2bsize,
                         log2markdist,
+                        textmarkdist,
                         numofchars,
                         suffixlength,
                         storeindexpos);
@@ -394,7 +466,9 @@ int gt_sufbwt2fmindex(Fmindex *fmindex,
                             log2markdist,
                             numofchars);
     allocatefmtables(fmindex,specialcharinfo,storeindexpos);
+    showsamplingmessage(fmindex);
     set0frequencies(fmindex);
+    textmarkptr = fmindex->textmarkpostable;
     if (storeindexpos)
     {
       markptr = fmindex->markpostable;
@@ -457,6 +531,11 @@ int gt_sufbwt2fmindex(Fmindex *fmindex,
         *markptr++ = suftabvalue;
         nextmark += fmindex->markdist;
       }
+      if (textmarkptr != NULL && suftabvalue % fmindex->textmarkdist == 0)
+      {
+        GT_SETIBIT(fmindex->textmarkbits,bwtpos);
+        *textmarkptr++ = suftabvalue;
+      }
       if (GT_ISBWTSPECIAL(cc))
       {
         if (storeindexpos && bwtpos < firstignorespecial)
@@ -500,6 +579,10 @@ int gt_sufbwt2fmindex(Fmindex *fmindex,
   {
     (void) putchar('\n');
     finalizefmfrequencies(fmindex);
+    if (fmindex->textmarkdist > 0)
+    {
+      finalizetextmarkrank(fmindex);
+    }
     if (fmindex->suffixlength > 0)
     {
       fmindex->boundarray = gt_malloc(sizeof *fmindex->boundarray
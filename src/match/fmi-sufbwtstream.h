@@ -29,6 +29,7 @@ int gt_sufbwt2fmindex(Fmindex *fmindex,
                       GtSpecialcharinfo *specialcharinfo,
                       unsigned int log2bsize,
                       unsigned int log2markdist,
+                      GtUword textmarkdist,
                       const char *outfmindex,
                       const GtStrArray *indexnametab,
                       bool storeindexpos,
@@ -22,6 +22,7 @@
 #include "core/alphabet.h"
 #include "core/arraydef_api.h"
 #include "core/encseq.h"
+#include "core/intbits.h"
 #include "core/pairbwtidx.h"
 #include "core/ulongbound.h"
 
@@ -66,6 +67,16 @@
 #define MARKPOSTABLELENGTH(BWTLENGTH,MARKDIST)\
         (1 + ((BWTLENGTH) - 1) / (MARKDIST))
 
+/* number of bwt positions covered by one entry of the rank table of the
+   text sampling */
+#define FMTEXTMARKRANKBLOCK 512
+
+#define TEXTMARKBITSLENGTH(BWTLENGTH)\
+        GT_NUMOFINTSFORBITS(BWTLENGTH)
+
+#define TEXTMARKRANKLENGTH(BWTLENGTH)\
+        (1 + (BWTLENGTH) / FMTEXTMARKRANKBLOCK)
+
 #define TFREQSIZE(MAPSIZE)\
         ((MAPSIZE) + 1)
 
@@ -92,7 +103,12 @@ typedef struct
          longestsuffixpos,
          negatebsizeones,
          negatesuperbsizeones,
-         markdistminus1;   /* markdist - 1 */
+         markdistminus1,   /* markdist - 1 */
+         textmarkdist,     /* 0 or distance of sampled text positions */
+         *textmarkpostable,/* sampled text positions in order of bwt pos */
+         *textmarkrank;    /* textmarkrank[i] = #bits set in textmarkbits */
+                           /* before bwt pos i * FMTEXTMARKRANKBLOCK */
+  GtBitsequence *textmarkbits; /* bwt positions of sampled text positions */
   GtArrayGtPairBwtidx specpos; /* positions of special characters */
   const GtAlphabet *alphabet;
   void *mappedptr; /* NULL or pointer to the mapped space block */
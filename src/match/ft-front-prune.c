@@ -246,6 +246,215 @@ static GtUword ft_longest_common_all(GtFtSequenceObject *useq,
   return upos - ustart;
 }
 
+/* Returns the <len> symbols of <twobitencoding> beginning at position
+   <pos> (if <forward>) or ending at position <pos> and read from right to
+   left (if not <forward>), such that the first symbol read is in the most
+   significant bits. The remaining bits are undefined. Only the units
+   containing these symbols are accessed. */
+static inline GtTwobitencoding ft_twobitencoding_symbols(
+                                        const GtTwobitencoding *twobitencoding,
+                                        GtUword pos,
+                                        unsigned int len,
+                                        bool forward)
+{
+  GtTwobitencoding tbe;
+  GtUword unit;
+  unsigned int mod;
+
+  gt_assert(len > 0 && len <= (unsigned int) GT_UNITSIN2BITENC);
+  if (!forward)
+  {
+    gt_assert(pos + 1 >= (GtUword) len);
+    pos -= len - 1;
+  }
+  unit = GT_DIVBYUNITSIN2BITENC(pos);
+  mod = (unsigned int) GT_MODBYUNITSIN2BITENC(pos);
+  tbe = twobitencoding[unit] << GT_MULT2(mod);
+  if (mod > 0 && mod + len > (unsigned int) GT_UNITSIN2BITENC)
+  {
+    tbe |= twobitencoding[unit+1] >> GT_MULT2(GT_UNITSIN2BITENC - mod);
+  }
+  if (!forward)
+  {
+    /* reverse the order of the symbols */
+#if defined (_LP64) || defined (_WIN64)
+    tbe = ((tbe >> 2) & (GtTwobitencoding) 0x3333333333333333ULL) |
+          ((tbe & (GtTwobitencoding) 0x3333333333333333ULL) << 2);
+    tbe = ((tbe >> 4) & (GtTwobitencoding) 0x0F0F0F0F0F0F0F0FULL) |
+          ((tbe & (GtTwobitencoding) 0x0F0F0F0F0F0F0F0FULL) << 4);
+    tbe = ((tbe >> 8) & (GtTwobitencoding) 0x00FF00FF00FF00FFULL) |
+          ((tbe & (GtTwobitencoding) 0x00FF00FF00FF00FFULL) << 8);
+    tbe = ((tbe >> 16) & (GtTwobitencoding) 0x0000FFFF0000FFFFULL) |
+          ((tbe & (GtTwobitencoding) 0x0000FFFF0000FFFFULL) << 16);
+    tbe = (tbe >> 32) | (tbe << 32);
+#else
+    tbe = ((tbe >> 2) & (GtTwobitencoding) 0x33333333UL) |
+          ((tbe & (GtTwobitencoding) 0x33333333UL) << 2);
+    tbe = ((tbe >> 4) & (GtTwobitencoding) 0x0F0F0F0FUL) |
+          ((tbe & (GtTwobitencoding) 0x0F0F0F0FUL) << 4);
+    tbe = ((tbe >> 8) & (GtTwobitencoding) 0x00FF00FFUL) |
+          ((tbe & (GtTwobitencoding) 0x00FF00FFUL) << 8);
+    tbe = (tbe >> 16) | (tbe << 16);
+#endif
+    /* the first symbol read was in position len - 1 before the reversal */
+    if (len < (unsigned int) GT_UNITSIN2BITENC)
+    {
+      tbe <<= GT_MULT2(GT_UNITSIN2BITENC - len);
+    }
+  }
+  return tbe;
+}
+
+/* Compares up to GT_UNITSIN2BITENC symbols at once: the symbols of both
+   sequences are extracted into one unit each, in the order they are read,
+   and the length of the common prefix is derived from the leading zeros of
+   the XOR of both units. The complement of a symbol is obtained by
+   flipping both of its bits. */
+static GtUword ft_longest_common_twobit_twobit(GtFtSequenceObject *useq,
+                                               GtUword ustart,
+                                               GtFtSequenceObject *vseq,
+                                               const GtUword vstart)
+{
+  if (ustart < useq->substringlength && vstart < vseq->substringlength)
+  {
+    const GtTwobitencoding complement_mask
+      = vseq->dir_is_complement ? ~((GtTwobitencoding) 0) : 0;
+    GtUword uptr, vptr, matchlength = 0,
+            minsubstringlength = useq->substringlength - ustart;
+
+    if (vseq->substringlength - vstart < minsubstringlength)
+    {
+      minsubstringlength = vseq->substringlength - vstart;
+    }
+    uptr = useq->read_seq_left2right ? useq->offset + ustart
+                                     : useq->offset - ustart;
+    vptr = vseq->read_seq_left2right ? vseq->offset + vstart
+                                     : vseq->offset - vstart;
+    while (matchlength < minsubstringlength)
+    {
+      const unsigned int len
+        = (unsigned int) GT_MIN(minsubstringlength - matchlength,
+                                (GtUword) GT_UNITSIN2BITENC);
+      const GtTwobitencoding
+        utbe = ft_twobitencoding_symbols(useq->twobitencoding,uptr,len,
+                                         useq->read_seq_left2right),
+        vtbe = ft_twobitencoding_symbols(vseq->twobitencoding,vptr,len,
+                                         vseq->read_seq_left2right) ^
+               complement_mask;
+
+      if (utbe != vtbe)
+      {
+        const unsigned int common
+          = gt_encseq_lcpofdifferenttwobitencodings(utbe,vtbe);
+
+        if (common < len)
+        {
+          return matchlength + common;
+        }
+      }
+      matchlength += len;
+      if (useq->read_seq_left2right)
+      {
+        uptr += len;
+      } else
+      {
+        uptr -= len;
+      }
+      if (vseq->read_seq_left2right)
+      {
+        vptr += len;
+      } else
+      {
+        vptr -= len;
+      }
+    }
+    return matchlength;
+  }
+  return 0;
+}
+
+/* Compares blocks of sizeof (GtUword) symbols at once, if both sequences
+   are read in the same direction. Within the first block which differs, the
+   symbols are compared one by one. As the symbols are in the range 0..3
+   or are wildcards in only one of the sequences, the complement of a
+   symbol is obtained by flipping its two lower bits. */
+static GtUword ft_longest_common_bytes_bytes(GtFtSequenceObject *useq,
+                                             GtUword ustart,
+                                             GtFtSequenceObject *vseq,
+                                             const GtUword vstart)
+{
+  if (ustart < useq->substringlength && vstart < vseq->substringlength)
+  {
+    const GtUword blocksize = (GtUword) sizeof (GtUword),
+                  complement_mask = vseq->dir_is_complement
+                                      ? ~((GtUword) 0)/UCHAR_MAX * 3
+                                      : 0;
+    const GtUchar *uptr, *vptr;
+    int ustep, vstep;
+    GtUword minsubstringlength = useq->substringlength - ustart,
+            matchlength = 0;
+
+    if (vseq->substringlength - vstart < minsubstringlength)
+    {
+      minsubstringlength = vseq->substringlength - vstart;
+    }
+    if (useq->read_seq_left2right)
+    {
+      uptr = useq->bytesequenceptr + useq->offset + ustart; ustep = 1;
+    } else
+    {
+      uptr = useq->bytesequenceptr + useq->offset - ustart; ustep = -1;
+    }
+    if (vseq->read_seq_left2right)
+    {
+      vptr = vseq->bytesequenceptr + vseq->offset + vstart; vstep = 1;
+    } else
+    {
+      vptr = vseq->bytesequenceptr + vseq->offset - vstart; vstep = -1;
+    }
+    if (ustep == vstep)
+    {
+      while (matchlength + blocksize <= minsubstringlength)
+      {
+        GtUword ublock, vblock;
+
+        /* the block is stored at the lower address */
+        memcpy(&ublock,ustep == 1 ? uptr : uptr - (blocksize - 1),
+               sizeof ublock);
+        memcpy(&vblock,vstep == 1 ? vptr : vptr - (blocksize - 1),
+               sizeof vblock);
+        if (ublock != (vblock ^ complement_mask))
+        {
+          break;
+        }
+        uptr += ustep * (GtWord) blocksize;
+        vptr += vstep * (GtWord) blocksize;
+        matchlength += blocksize;
+      }
+    }
+    if (vseq->dir_is_complement)
+    {
+      while (matchlength < minsubstringlength &&
+             *uptr == GT_COMPLEMENTBASE(*vptr))
+      {
+        uptr += ustep;
+        vptr += vstep;
+        matchlength++;
+      }
+    } else
+    {
+      while (matchlength < minsubstringlength && *uptr == *vptr)
+      {
+        uptr += ustep;
+        vptr += vstep;
+        matchlength++;
+      }
+    }
+    return matchlength;
+  }
+  return 0;
+}
+
 #include "match/ft-longest-common.inc"
 
 static int ft_sequenceobject2mode(const GtFtSequenceObject *seq)
@@ -120,6 +120,46 @@ static int gt_ft_trimstat_compare_GtUword(const void *va, const void *vb)
   return 0;
 }
 
+void gt_ft_trimstat_add_trimstat(GtFtTrimstat *dest,const GtFtTrimstat *src)
+{
+  GtUword idx;
+
+  gt_assert(dest != NULL && src != NULL);
+  dest->diedout += src->diedout;
+  for (idx = 0; idx <= 100UL; idx++)
+  {
+    dest->trim_dist[idx] += src->trim_dist[idx];
+    dest->matchlength_dist[idx] += src->matchlength_dist[idx];
+  }
+  for (idx = 0; idx < src->distance_dist.nextfreeGtUword; idx++)
+  {
+    GT_STOREINARRAY(&dest->distance_dist,GtUword,32,
+                    src->distance_dist.spaceGtUword[idx]);
+  }
+  if (src->maxvalid_dist.allocatedGtUword >
+      dest->maxvalid_dist.allocatedGtUword)
+  {
+    const GtUword allocated = dest->maxvalid_dist.allocatedGtUword;
+
+    dest->maxvalid_dist.allocatedGtUword = src->maxvalid_dist.allocatedGtUword;
+    dest->maxvalid_dist.spaceGtUword
+      = gt_realloc(dest->maxvalid_dist.spaceGtUword,
+                   sizeof *dest->maxvalid_dist.spaceGtUword *
+                   dest->maxvalid_dist.allocatedGtUword);
+    for (idx = allocated; idx < dest->maxvalid_dist.allocatedGtUword; idx++)
+    {
+      dest->maxvalid_dist.spaceGtUword[idx] = 0;
+    }
+  }
+  for (idx = 0; idx < src->maxvalid_dist.allocatedGtUword; idx++)
+  {
+    dest->maxvalid_dist.spaceGtUword[idx]
+      += src->maxvalid_dist.spaceGtUword[idx];
+  }
+  dest->spaceforfront_total += src->spaceforfront_total;
+  dest->sum_meanvalid += src->sum_meanvalid;
+}
+
 #define MEGABYTES(X) ((double) (X)/(1UL << 20))
 
 void gt_ft_trimstat_delete(GtFtTrimstat *trimstat)
@@ -28,6 +28,10 @@ void gt_ft_trimstat_add_matchlength(GT_UNUSED GtFtTrimstat *trimstat,
                                     GT_UNUSED uint32_t matchlength);
 #endif
 
+/* adds the statistics of <src> to <dest>, e.g. to combine the statistics
+   collected by several threads */
+void gt_ft_trimstat_add_trimstat(GtFtTrimstat *dest,const GtFtTrimstat *src);
+
 void gt_ft_trimstat_delete(GtFtTrimstat *trimstat);
 
 void gt_ft_trimstat_out(const GtFtTrimstat *trimstat,bool verbose);
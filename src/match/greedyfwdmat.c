@@ -30,6 +30,7 @@
 #include "optionargmode.h"
 #include "greedyfwdmat.h"
 #include "initbasepower.h"
+#include "querybatch.h"
 
 typedef struct
 {
@@ -42,19 +43,22 @@ typedef struct
 
 typedef void (*Preprocessgmatchlength)(uint64_t,
                                        const char *,
-                                       void *);
+                                       void *,
+                                       GtStr *);
 typedef void (*Processgmatchlength)(const GtAlphabet *,
                                     const GtUchar *,
                                     GtUword,
                                     GtUword,
                                     GtUword,
-                                    void *);
+                                    void *,
+                                    GtStr *);
 typedef void (*Postprocessgmatchlength)(const GtAlphabet *,
                                         uint64_t,
                                         const char *,
                                         const GtUchar *,
                                         GtUword,
-                                        void *);
+                                        void *,
+                                        GtStr *);
 
 typedef struct
 {
@@ -99,12 +103,17 @@ static void checkifsequenceisthere(const GtEncseq *encseq,
 }
 #endif
 
-static void gmatchposinsinglesequence(Substringinfo *substringinfo,
-                                      uint64_t unitnum,
-                                      const GtUchar *query,
-                                      GtUword querylen,
-                                      const char *desc)
+/* the output for the query is appended to <outbuf>, as the queries are
+   processed in parallel by the threads of a <GtQuerybatch> */
+static int gmatchposinsinglesequence(void *info,
+                                     uint64_t unitnum,
+                                     const GtUchar *query,
+                                     GtUword querylen,
+                                     const char *desc,
+                                     GtStr *outbuf,
+                                     GT_UNUSED GtError *err)
 {
+  const Substringinfo *substringinfo = (const Substringinfo *) info;
   const GtUchar *qptr;
   GtUword gmatchlength, remaining;
   GtUword witnessposition, *wptr;
@@ -113,7 +122,8 @@ static void gmatchposinsinglesequence(Substringinfo *substringinfo,
   {
     substringinfo->preprocessgmatchlength(unitnum,
                                           desc,
-                                          substringinfo->processinfo);
+                                          substringinfo->processinfo,
+                                          outbuf);
   }
   if (((Rangespecinfo *) substringinfo->processinfo)->showsubjectpos ||
       substringinfo->encseq != NULL)
@@ -151,7 +161,8 @@ static void gmatchposinsinglesequence(Substringinfo *substringinfo,
                                          wptr == NULL
                                            ? (GtUword) 0
                                            : witnessposition,
-                                         substringinfo->processinfo);
+                                         substringinfo->processinfo,
+                                         outbuf);
     }
   }
   if (substringinfo->postprocessgmatchlength != NULL)
@@ -161,20 +172,29 @@ static void gmatchposinsinglesequence(Substringinfo *substringinfo,
                                            desc,
                                            query,
                                            querylen,
-                                           substringinfo->processinfo);
+                                           substringinfo->processinfo,
+                                           outbuf);
   }
+  return 0;
 }
 
 static void showunitnum(uint64_t unitnum,
                         const char *desc,
-                        GT_UNUSED void *info)
+                        GT_UNUSED void *info,
+                        GtStr *outbuf)
 {
-  printf("unit " Formatuint64_t, PRINTuint64_tcast(unitnum));
+  char buffer[32];
+
+  (void) snprintf(buffer,sizeof buffer,"unit " Formatuint64_t,
+                  PRINTuint64_tcast(unitnum));
+  gt_str_append_cstr(outbuf,buffer);
   if (desc != NULL && desc[0] != '\0')
   {
-    printf(" (%s)",desc);
+    gt_str_append_cstr(outbuf," (");
+    gt_str_append_cstr(outbuf,desc);
+    gt_str_append_char(outbuf,')');
   }
-  printf("\n");
+  gt_str_append_char(outbuf,'\n');
 }
 
 static void showifinlengthrange(const GtAlphabet *alphabet,
@@ -182,7 +202,8 @@ static void showifinlengthrange(const GtAlphabet *alphabet,
                                 GtUword gmatchlength,
                                 GtUword querystart,
                                 GtUword subjectpos,
-                                void *info)
+                                void *info,
+                                GtStr *outbuf)
 {
   Rangespecinfo *rangespecinfo = (Rangespecinfo *) info;
 
@@ -193,25 +214,34 @@ static void showifinlengthrange(const GtAlphabet *alphabet,
   {
     if (rangespecinfo->showquerypos)
     {
-      printf(""GT_WU" ",querystart);
+      gt_str_append_uword(outbuf,querystart);
+      gt_str_append_char(outbuf,' ');
     }
-    printf(""GT_WU"",gmatchlength);
+    gt_str_append_uword(outbuf,gmatchlength);
     if (rangespecinfo->showsubjectpos)
     {
-      printf(" "GT_WU"",subjectpos);
+      gt_str_append_char(outbuf,' ');
+      gt_str_append_uword(outbuf,subjectpos);
     }
     if (rangespecinfo->showsequence)
     {
-      (void) putchar(' ');
-      gt_alphabet_decode_seq_to_fp(alphabet,stdout,start + querystart,
-                                   gmatchlength);
+      const GtUchar *characters = gt_alphabet_characters(alphabet);
+      GtUword idx;
+
+      gt_str_append_char(outbuf,' ');
+      for (idx = 0; idx < gmatchlength; idx++)
+      {
+        gt_str_append_char(outbuf,(char) characters[start[querystart+idx]]);
+      }
     }
-    (void) putchar('\n');
+    gt_str_append_char(outbuf,'\n');
   }
 }
 
 int gt_findsubquerygmatchforward(const GtEncseq *encseq,
-                              const void *genericindex,
+                              const void **genericindextab,
+                              unsigned int numofthreads,
+                              GtUword batchsize,
                               GtUword totallength,
                               Greedygmatchforwardfunction gmatchforward,
                               const GtAlphabet *alphabet,
@@ -223,62 +253,46 @@ int gt_findsubquerygmatchforward(const GtEncseq *encseq,
                               bool showsubjectpos,
                               GtError *err)
 {
-  Substringinfo substringinfo;
+  Substringinfo *substringinfotab;
+  void **threadinfo;
   Rangespecinfo rangespecinfo;
-  bool haserr = false;
-  GtSeqIterator *seqit;
-  const GtUchar *query;
-  GtUword querylen;
-  char *desc = NULL;
+  unsigned int thread;
   int retval;
-  uint64_t unitnum;
 
   gt_error_check(err);
-  substringinfo.genericindex = genericindex;
-  substringinfo.totallength = totallength;
   rangespecinfo.minlength = minlength;
   rangespecinfo.maxlength = maxlength;
   rangespecinfo.showsequence = showsequence;
   rangespecinfo.showquerypos = showquerypos;
   rangespecinfo.showsubjectpos = showsubjectpos;
-  substringinfo.preprocessgmatchlength = showunitnum;
-  substringinfo.processgmatchlength = showifinlengthrange;
-  substringinfo.postprocessgmatchlength = NULL;
-  substringinfo.alphabet = alphabet;
-  substringinfo.processinfo = &rangespecinfo;
-  substringinfo.gmatchforward = gmatchforward;
-  substringinfo.encseq = encseq;
-  seqit = gt_seq_iterator_sequence_buffer_new(queryfilenames, err);
-  if (!seqit)
-    haserr = true;
-  if (!haserr)
+  substringinfotab = gt_malloc(sizeof *substringinfotab * numofthreads);
+  threadinfo = gt_malloc(sizeof *threadinfo * numofthreads);
+  for (thread = 0; thread < numofthreads; thread++)
   {
-    gt_seq_iterator_set_symbolmap(seqit, gt_alphabet_symbolmap(alphabet));
-    for (unitnum = 0; /* Nothing */; unitnum++)
-    {
-      retval = gt_seq_iterator_next(seqit,
-                                &query,
-                                &querylen,
-                                &desc,
-                                err);
-      if (retval < 0)
-      {
-        haserr = true;
-        break;
-      }
-      if (retval == 0)
-      {
-        break;
-      }
-      gmatchposinsinglesequence(&substringinfo,
-                                unitnum,
-                                query,
-                                querylen,
-                                desc);
-    }
-    gt_seq_iterator_delete(seqit);
+    Substringinfo *substringinfo = substringinfotab + thread;
+
+    substringinfo->genericindex = genericindextab[thread];
+    substringinfo->totallength = totallength;
+    substringinfo->preprocessgmatchlength = showunitnum;
+    substringinfo->processgmatchlength = showifinlengthrange;
+    substringinfo->postprocessgmatchlength = NULL;
+    substringinfo->alphabet = alphabet;
+    substringinfo->processinfo = &rangespecinfo;
+    substringinfo->gmatchforward = gmatchforward;
+    substringinfo->encseq = encseq;
+    threadinfo[thread] = substringinfo;
   }
-  return haserr ? -1 : 0;
+  retval = gt_querybatch_run(queryfilenames,
+                             gt_alphabet_symbolmap(alphabet),
+                             batchsize,
+                             numofthreads,
+                             threadinfo,
+                             gmatchposinsinglesequence,
+                             stdout,
+                             err);
+  gt_free(threadinfo);
+  gt_free(substringinfotab);
+  return retval;
 }
 
 #ifdef WITHrunsubstringiteration
@@ -35,8 +35,16 @@ typedef GtUword (*Greedygmatchforwardfunction) (const void *,
                                                       const GtUchar *,
                                                       const GtUchar *);
 
+/* Computes for each suffix of the query sequences in <queryfilenames> the
+   length of the greedy forward match against the index using <gmatchforward>
+   and shows those in the given length range. The queries are processed in
+   batches of <batchsize> sequences by <numofthreads> threads, where thread
+   <t> uses <genericindextab[t]> as the index. The output is in the order of
+   the queries. */
 int gt_findsubquerygmatchforward(const GtEncseq *encseq,
-                              const void *genericindex,
+                              const void **genericindextab,
+                              unsigned int numofthreads,
+                              GtUword batchsize,
                               GtUword totallength,
                               Greedygmatchforwardfunction gmatchforward,
                               const GtAlphabet *alphabet,
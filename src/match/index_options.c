@@ -508,8 +508,8 @@ static GtIndexOptions* gt_index_options_register_generic_create(
   gt_option_parser_add_option(op, idxo->option);
 
   idxo->option = gt_option_new_bool("compressedoutput",
-                                    "output suftab and lcptab in compressed "
-                                    "form",
+                                    "output suftab with a fixed number of "
+                                    "bits per entry",
                                     &idxo->sfxstrategy.compressedoutput,
                                     false);
   gt_option_is_development_option(idxo->option);
@@ -0,0 +1,498 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* for fopencookie */
+#endif
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include "core/assert_api.h"
+#include "core/ensure_api.h"
+#include "core/fa_api.h"
+#include "core/ma_api.h"
+#include "core/minmax_api.h"
+#include "core/str_api.h"
+#include "core/thread_api.h"
+#include "core/xansi_api.h"
+#include "match/ordered_output.h"
+
+/* Where the C library allows to define the functions behind a stream, the
+   output of a unit is kept in memory up to the limit and moved to a
+   temporary file beyond it. Otherwise, it always goes to a temporary file. */
+#if defined (__GLIBC__)
+#define GT_ORDERED_OUTPUT_FOPENCOOKIE
+#elif defined (__APPLE__) || defined (__FreeBSD__) || defined (__NetBSD__) \
+      || defined (__OpenBSD__)
+#define GT_ORDERED_OUTPUT_FUNOPEN
+#endif
+
+typedef struct
+{
+  struct GtOrderedOutput *ordered_output;
+  GtUword unit;
+  FILE *stream, /* the stream of a unit not being the first one */
+       *spillfp; /* the output not fitting into the buffer, or NULL */
+  char *buffer;
+  size_t size,
+         allocated;
+  bool direct, /* the unit became the first one, output goes to outfp */
+       done;
+} GtOrderedOutputUnit;
+
+typedef struct
+{
+  /* locked while the worker processes a unit, so that other workers can
+     wait for the completion of the unit */
+  GtMutex *busy;
+  GtUword unit;
+} GtOrderedOutputWorker;
+
+struct GtOrderedOutput
+{
+  FILE *outfp;
+  GtMutex *mutex;
+  GtOrderedOutputUnit *units;
+  GtOrderedOutputWorker *workers;
+  GtUword numofunits,
+          nextunit, /* the next unit to be assigned */
+          headunit; /* the first unit not written completely */
+  unsigned int numofworkers;
+  size_t buffered,
+         maxbuffered;
+};
+
+GtOrderedOutput *gt_ordered_output_new(FILE *outfp,
+                                       GtUword numofunits,
+                                       unsigned int numofworkers,
+                                       size_t maxbuffered)
+{
+  GtOrderedOutput *ordered_output = gt_malloc(sizeof *ordered_output);
+  unsigned int worker;
+
+  gt_assert(outfp != NULL && numofworkers > 0);
+  ordered_output->outfp = outfp;
+  ordered_output->mutex = gt_mutex_new();
+  ordered_output->units = gt_calloc((size_t) numofunits,
+                                    sizeof *ordered_output->units);
+  ordered_output->workers = gt_malloc(sizeof *ordered_output->workers *
+                                      numofworkers);
+  for (worker = 0; worker < numofworkers; worker++)
+  {
+    ordered_output->workers[worker].busy = gt_mutex_new();
+    ordered_output->workers[worker].unit = GT_UWORD_MAX;
+  }
+  ordered_output->numofunits = numofunits;
+  ordered_output->nextunit = ordered_output->headunit = 0;
+  ordered_output->numofworkers = numofworkers;
+  ordered_output->buffered = 0;
+  ordered_output->maxbuffered = maxbuffered;
+  return ordered_output;
+}
+
+static FILE *gt_ordered_output_tmpfp(void)
+{
+  return gt_xtmpfp_generic(NULL, GT_TMPFP_OPENBINARY | GT_TMPFP_AUTOREMOVE);
+}
+
+/* writes the output of <ounit> stored so far to <outfp> and releases its
+   buffer and temporary file. Must be called with the mutex locked, when all
+   previous units are written completely. */
+static void gt_ordered_output_buffer_write(FILE *outfp,
+                                           GtOrderedOutputUnit *ounit)
+{
+  if (ounit->spillfp != NULL)
+  {
+    char copybuffer[BUFSIZ];
+    size_t len;
+
+    rewind(ounit->spillfp);
+    while ((len = gt_xfread(copybuffer,sizeof (char),sizeof copybuffer,
+                            ounit->spillfp)) > 0)
+    {
+      gt_xfwrite(copybuffer,sizeof (char),len,outfp);
+    }
+    gt_fa_xfclose(ounit->spillfp);
+    ounit->spillfp = NULL;
+  }
+  if (ounit->size > 0)
+  {
+    gt_xfwrite(ounit->buffer,sizeof (char),ounit->size,outfp);
+  }
+  gt_free(ounit->buffer);
+  ounit->buffer = NULL;
+  ounit->size = ounit->allocated = 0;
+}
+
+#if defined (GT_ORDERED_OUTPUT_FOPENCOOKIE) || \
+    defined (GT_ORDERED_OUTPUT_FUNOPEN)
+/* called by the stream of a unit, whenever its (small) stdio buffer is
+   full. Once all previous units are written, the stored output is written
+   and the unit writes to the output stream directly. Otherwise the output
+   is appended to the buffer, which is moved to a temporary file when it
+   would exceed the limit. */
+static size_t gt_ordered_output_unit_write(GtOrderedOutputUnit *ounit,
+                                           const char *buf,
+                                           size_t size)
+{
+  GtOrderedOutput *ordered_output = ounit->ordered_output;
+
+  if (!ounit->direct)
+  {
+    gt_mutex_lock(ordered_output->mutex);
+    if (ounit->unit == ordered_output->headunit)
+    {
+      gt_ordered_output_buffer_write(ordered_output->outfp,ounit);
+      ounit->direct = true;
+    }
+    gt_mutex_unlock(ordered_output->mutex);
+  }
+  if (ounit->direct)
+  {
+    gt_xfwrite(buf,sizeof (char),size,ordered_output->outfp);
+    return size;
+  }
+  if (ounit->size + size > ordered_output->maxbuffered)
+  {
+    if (ounit->spillfp == NULL)
+    {
+      ounit->spillfp = gt_ordered_output_tmpfp();
+    }
+    if (ounit->size > 0)
+    {
+      gt_xfwrite(ounit->buffer,sizeof (char),ounit->size,ounit->spillfp);
+      ounit->size = 0;
+    }
+    if (size > ordered_output->maxbuffered)
+    {
+      gt_xfwrite(buf,sizeof (char),size,ounit->spillfp);
+      return size;
+    }
+  }
+  if (ounit->size + size > ounit->allocated)
+  {
+    ounit->allocated = GT_MIN(ordered_output->maxbuffered,
+                              ounit->size + size + ounit->allocated);
+    ounit->buffer = gt_realloc(ounit->buffer,ounit->allocated);
+  }
+  memcpy(ounit->buffer + ounit->size,buf,size);
+  ounit->size += size;
+  return size;
+}
+#endif
+
+#ifdef GT_ORDERED_OUTPUT_FOPENCOOKIE
+static ssize_t gt_ordered_output_cookie_write(void *cookie,const char *buf,
+                                              size_t size)
+{
+  return (ssize_t) gt_ordered_output_unit_write((GtOrderedOutputUnit *) cookie,
+                                                buf,size);
+}
+#endif
+
+#ifdef GT_ORDERED_OUTPUT_FUNOPEN
+static int gt_ordered_output_funopen_write(void *cookie,const char *buf,
+                                           int size)
+{
+  gt_assert(size >= 0);
+  return (int) gt_ordered_output_unit_write((GtOrderedOutputUnit *) cookie,
+                                            buf,(size_t) size);
+}
+#endif
+
+static void gt_ordered_output_buffer_open(GtOrderedOutputUnit *ounit)
+{
+#if defined (GT_ORDERED_OUTPUT_FOPENCOOKIE)
+  cookie_io_functions_t functions = {NULL,gt_ordered_output_cookie_write,
+                                     NULL,NULL};
+
+  ounit->stream = fopencookie(ounit,"w",functions);
+#elif defined (GT_ORDERED_OUTPUT_FUNOPEN)
+  ounit->stream = funopen(ounit,NULL,gt_ordered_output_funopen_write,NULL,
+                          NULL);
+#else
+  ounit->stream = gt_ordered_output_tmpfp();
+#endif
+  if (ounit->stream == NULL)
+  {
+    fprintf(stderr,"cannot open output stream: %s\n",strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+}
+
+/* closes the stream of the completed unit, so that all of its output is
+   in the buffer or the temporary file */
+static void gt_ordered_output_buffer_close(GtOrderedOutputUnit *ounit)
+{
+#if defined (GT_ORDERED_OUTPUT_FOPENCOOKIE) || \
+    defined (GT_ORDERED_OUTPUT_FUNOPEN)
+  gt_xfclose(ounit->stream);
+#else
+  gt_xfflush(ounit->stream);
+  ounit->spillfp = ounit->stream;
+#endif
+  ounit->stream = NULL;
+}
+
+FILE *gt_ordered_output_next(GtOrderedOutput *ordered_output,
+                             unsigned int worker,
+                             GtUword *unit)
+{
+  GtOrderedOutputUnit *ounit;
+  FILE *stream;
+
+  gt_assert(ordered_output != NULL && worker < ordered_output->numofworkers &&
+            unit != NULL);
+  gt_assert(ordered_output->workers[worker].unit == GT_UWORD_MAX);
+  gt_mutex_lock(ordered_output->mutex);
+#ifdef GT_THREADS_ENABLED
+  /* the first unit not written completely is processed by another worker,
+     wait until it is completed */
+  while (ordered_output->nextunit < ordered_output->numofunits &&
+         ordered_output->headunit < ordered_output->nextunit &&
+         ordered_output->buffered > ordered_output->maxbuffered)
+  {
+    GtMutex *headbusy = NULL;
+    unsigned int other;
+
+    for (other = 0; other < ordered_output->numofworkers; other++)
+    {
+      if (ordered_output->workers[other].unit == ordered_output->headunit)
+      {
+        headbusy = ordered_output->workers[other].busy;
+        break;
+      }
+    }
+    gt_assert(other < ordered_output->numofworkers);
+    gt_mutex_unlock(ordered_output->mutex);
+    gt_mutex_lock(headbusy);
+    gt_mutex_unlock(headbusy);
+    gt_mutex_lock(ordered_output->mutex);
+  }
+#endif
+  if (ordered_output->nextunit == ordered_output->numofunits)
+  {
+    gt_mutex_unlock(ordered_output->mutex);
+    return NULL;
+  }
+  *unit = ordered_output->nextunit++;
+  ounit = ordered_output->units + *unit;
+  ounit->ordered_output = ordered_output;
+  ounit->unit = *unit;
+  if (*unit == ordered_output->headunit)
+  {
+    ounit->stream = NULL;
+    ounit->direct = true;
+    stream = ordered_output->outfp;
+  } else
+  {
+    gt_ordered_output_buffer_open(ounit);
+    stream = ounit->stream;
+  }
+  ordered_output->workers[worker].unit = *unit;
+  gt_mutex_lock(ordered_output->workers[worker].busy);
+  gt_mutex_unlock(ordered_output->mutex);
+  return stream;
+}
+
+void gt_ordered_output_done(GtOrderedOutput *ordered_output,
+                            unsigned int worker)
+{
+  GtOrderedOutputUnit *ounit;
+  GtUword unit;
+
+  gt_assert(ordered_output != NULL && worker < ordered_output->numofworkers);
+  unit = ordered_output->workers[worker].unit;
+  gt_assert(unit < ordered_output->numofunits);
+  ounit = ordered_output->units + unit;
+  if (ounit->stream != NULL)
+  {
+    gt_ordered_output_buffer_close(ounit);
+  }
+  gt_mutex_lock(ordered_output->mutex);
+  ounit->done = true;
+  ordered_output->buffered += ounit->size;
+  /* write the buffered output of the completed units following the
+     completed units already written */
+  while (ordered_output->headunit < ordered_output->nextunit &&
+         ordered_output->units[ordered_output->headunit].done)
+  {
+    ounit = ordered_output->units + ordered_output->headunit;
+    ordered_output->buffered -= ounit->size;
+    gt_ordered_output_buffer_write(ordered_output->outfp,ounit);
+    ordered_output->headunit++;
+  }
+  ordered_output->workers[worker].unit = GT_UWORD_MAX;
+  gt_mutex_unlock(ordered_output->mutex);
+  gt_mutex_unlock(ordered_output->workers[worker].busy);
+}
+
+void gt_ordered_output_delete(GtOrderedOutput *ordered_output)
+{
+  unsigned int worker;
+
+  if (ordered_output == NULL)
+  {
+    return;
+  }
+  gt_assert(ordered_output->headunit == ordered_output->nextunit);
+  for (worker = 0; worker < ordered_output->numofworkers; worker++)
+  {
+    gt_mutex_delete(ordered_output->workers[worker].busy);
+  }
+  gt_mutex_delete(ordered_output->mutex);
+  gt_free(ordered_output->workers);
+  gt_free(ordered_output->units);
+  gt_free(ordered_output);
+}
+
+#define GT_ORDERED_OUTPUT_TEST_UNITS   20
+#define GT_ORDERED_OUTPUT_TEST_WORKERS 4
+
+typedef struct
+{
+  GtOrderedOutput *ordered_output;
+  unsigned int worker;
+} GtOrderedOutputTestThreadinfo;
+
+static void gt_ordered_output_test_unit(GtStr *str,GtUword unit)
+{
+  GtUword line;
+
+  for (line = 0; line < (unit % 7) * 50; line++)
+  {
+    gt_str_append_cstr(str,"unit ");
+    gt_str_append_uword(str,unit);
+    gt_str_append_cstr(str," line ");
+    gt_str_append_uword(str,line);
+    gt_str_append_char(str,'\n');
+  }
+}
+
+static void *gt_ordered_output_test_worker(void *data)
+{
+  GtOrderedOutputTestThreadinfo *threadinfo = data;
+  GtStr *str = gt_str_new();
+  GtUword unit;
+  FILE *stream;
+
+  while ((stream = gt_ordered_output_next(threadinfo->ordered_output,
+                                          threadinfo->worker,&unit)) != NULL)
+  {
+    gt_str_reset(str);
+    gt_ordered_output_test_unit(str,unit);
+    /* write line by line, so that the buffers fill up gradually */
+    if (gt_str_length(str) > 0)
+    {
+      char *line = gt_str_get(str), *end;
+
+      while ((end = strchr(line,'\n')) != NULL)
+      {
+        gt_xfwrite(line,sizeof (char),(size_t) (end - line + 1),stream);
+        line = end + 1;
+      }
+    }
+    gt_ordered_output_done(threadinfo->ordered_output,threadinfo->worker);
+  }
+  gt_str_delete(str);
+  return NULL;
+}
+
+int gt_ordered_output_unit_test(GtError *err)
+{
+  const size_t maxbuffered_values[] = {0,16,(size_t) 1 << 20};
+  size_t idx;
+  int had_err = 0;
+
+  gt_error_check(err);
+  for (idx = 0; !had_err &&
+                idx < sizeof maxbuffered_values/sizeof maxbuffered_values[0];
+       idx++)
+  {
+    GtOrderedOutputTestThreadinfo
+      threadinfo[GT_ORDERED_OUTPUT_TEST_WORKERS];
+    GtOrderedOutput *ordered_output;
+    GtStr *expected = gt_str_new();
+    char *output = NULL;
+    FILE *outfp;
+    GtUword unit;
+    unsigned int worker;
+    size_t outputlength = 0;
+
+    outfp = gt_ordered_output_tmpfp();
+    ordered_output = gt_ordered_output_new(outfp,
+                                           GT_ORDERED_OUTPUT_TEST_UNITS,
+                                           GT_ORDERED_OUTPUT_TEST_WORKERS,
+                                           maxbuffered_values[idx]);
+    for (worker = 0; worker < GT_ORDERED_OUTPUT_TEST_WORKERS; worker++)
+    {
+      threadinfo[worker].ordered_output = ordered_output;
+      threadinfo[worker].worker = worker;
+    }
+#ifdef GT_THREADS_ENABLED
+    {
+      GtThread *threads[GT_ORDERED_OUTPUT_TEST_WORKERS];
+
+      for (worker = 0; !had_err && worker < GT_ORDERED_OUTPUT_TEST_WORKERS;
+           worker++)
+      {
+        threads[worker] = gt_thread_new(gt_ordered_output_test_worker,
+                                        threadinfo + worker,err);
+        if (threads[worker] == NULL)
+        {
+          had_err = -1;
+        }
+      }
+      gt_ensure(!had_err);
+      if (!had_err)
+      {
+        for (worker = 0; worker < GT_ORDERED_OUTPUT_TEST_WORKERS; worker++)
+        {
+          gt_thread_join(threads[worker]);
+          gt_thread_delete(threads[worker]);
+        }
+      }
+    }
+#else
+    for (worker = 0; worker < GT_ORDERED_OUTPUT_TEST_WORKERS; worker++)
+    {
+      (void) gt_ordered_output_test_worker(threadinfo + worker);
+    }
+#endif
+    if (!had_err)
+    {
+      gt_ordered_output_delete(ordered_output);
+      for (unit = 0; unit < GT_ORDERED_OUTPUT_TEST_UNITS; unit++)
+      {
+        gt_ordered_output_test_unit(expected,unit);
+      }
+      rewind(outfp);
+      output = gt_malloc(gt_str_length(expected) + 1);
+      outputlength = gt_xfread(output,sizeof (char),
+                               gt_str_length(expected) + 1,outfp);
+      gt_ensure(outputlength == gt_str_length(expected));
+      gt_ensure(memcmp(output,gt_str_get(expected),
+                       gt_str_length(expected)) == 0);
+      gt_free(output);
+    }
+    gt_fa_xfclose(outfp);
+    gt_str_delete(expected);
+  }
+  return had_err;
+}
@@ -0,0 +1,63 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef ORDERED_OUTPUT_H
+#define ORDERED_OUTPUT_H
+
+#include <stdio.h>
+#include "core/error_api.h"
+#include "core/types_api.h"
+
+/* A <GtOrderedOutput> distributes the units <0>, <1>, ... of a computation
+   among a number of workers, usually threads, and writes the output of the
+   units in the order of the units, independent of the order in which the
+   units are completed. The output of the first unit not written completely
+   goes to the output stream directly, so that it appears as soon as it is
+   produced. The output of the other units is buffered, at most <maxbuffered>
+   bytes per unit in memory and the rest in a temporary file. It is written
+   as soon as all previous units are completed. A unit running when all
+   previous units are completed writes its buffered output and from then on
+   writes to the output stream directly. */
+typedef struct GtOrderedOutput GtOrderedOutput;
+
+/* Returns a new <GtOrderedOutput> object for <numofunits> units processed
+   by <numofworkers> workers, writing to <outfp>. A worker does not get a
+   new unit while more than <maxbuffered> bytes of output of completed units
+   wait for previous units to be completed. */
+GtOrderedOutput *gt_ordered_output_new(FILE *outfp,
+                                       GtUword numofunits,
+                                       unsigned int numofworkers,
+                                       size_t maxbuffered);
+
+/* Assigns the next unit to <worker>, stores its number in <unit> and returns
+   the stream the output of the unit must be written to. Returns NULL if all
+   units have been assigned. The units are assigned in increasing order. */
+FILE *gt_ordered_output_next(GtOrderedOutput *ordered_output,
+                             unsigned int worker,
+                             GtUword *unit);
+
+/* Marks the unit assigned to <worker> as completed. Its stream must not be
+   used any more. */
+void gt_ordered_output_done(GtOrderedOutput *ordered_output,
+                            unsigned int worker);
+
+/* Deletes <ordered_output>. All assigned units must be completed. */
+void gt_ordered_output_delete(GtOrderedOutput *ordered_output);
+
+int  gt_ordered_output_unit_test(GtError *err);
+
+#endif
@@ -0,0 +1,299 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/assert_api.h"
+#include "core/ma_api.h"
+#include "core/seq_iterator_sequence_buffer_api.h"
+#include "core/thread_api.h"
+#include "core/xansi_api.h"
+#include "match/querybatch.h"
+
+/* the query sequences and descriptions of one batch are stored
+   consecutively, the i-th query is
+   sequences[seqoffsets[i]..seqoffsets[i+1]-1] */
+typedef struct
+{
+  GtUchar *sequences;
+  char *descriptions;
+  GtUword *seqoffsets,
+          *descoffsets,
+          numofqueries,
+          maxnumofqueries,
+          seqspace,
+          descspace;
+  uint64_t firstquerynum;
+} GtQuerybatch;
+
+typedef struct
+{
+  const GtQuerybatch *batch;
+  GtUword firstquery,
+          nextquery;
+  void *threadinfo;
+  GtQuerybatchProcessfunc processquery;
+  GtStr *outbuf;
+  GtError *err;
+  bool haserr;
+  GtThread *thread;
+} GtQuerybatchpart;
+
+static void gt_querybatch_init(GtQuerybatch *batch,GtUword maxnumofqueries)
+{
+  batch->maxnumofqueries = maxnumofqueries;
+  batch->seqoffsets = gt_malloc(sizeof *batch->seqoffsets *
+                                (maxnumofqueries + 1));
+  batch->descoffsets = gt_malloc(sizeof *batch->descoffsets *
+                                 (maxnumofqueries + 1));
+  batch->seqoffsets[0] = batch->descoffsets[0] = 0;
+  batch->sequences = NULL;
+  batch->descriptions = NULL;
+  batch->seqspace = batch->descspace = 0;
+  batch->numofqueries = 0;
+  batch->firstquerynum = 0;
+}
+
+static void gt_querybatch_add(GtQuerybatch *batch,
+                              const GtUchar *query,
+                              GtUword querylen,
+                              const char *desc)
+{
+  GtUword seqnextfree = batch->seqoffsets[batch->numofqueries],
+          descnextfree = batch->descoffsets[batch->numofqueries],
+          desclen = desc == NULL ? 0 : (GtUword) strlen(desc);
+
+  gt_assert(batch->numofqueries < batch->maxnumofqueries);
+  if (seqnextfree + querylen > batch->seqspace)
+  {
+    batch->seqspace = (GtUword) ((seqnextfree + querylen) * 1.2) + 1024;
+    batch->sequences = gt_realloc(batch->sequences,
+                                  sizeof *batch->sequences * batch->seqspace);
+  }
+  if (descnextfree + desclen + 1 > batch->descspace)
+  {
+    batch->descspace = (GtUword) ((descnextfree + desclen + 1) * 1.2) + 1024;
+    batch->descriptions = gt_realloc(batch->descriptions,
+                                     sizeof *batch->descriptions *
+                                     batch->descspace);
+  }
+  memcpy(batch->sequences + seqnextfree,query,
+         sizeof *query * (size_t) querylen);
+  if (desclen > 0)
+  {
+    memcpy(batch->descriptions + descnextfree,desc,(size_t) desclen);
+  }
+  batch->descriptions[descnextfree + desclen] = '\0';
+  batch->numofqueries++;
+  batch->seqoffsets[batch->numofqueries] = seqnextfree + querylen;
+  batch->descoffsets[batch->numofqueries] = descnextfree + desclen + 1;
+}
+
+static void gt_querybatch_reset(GtQuerybatch *batch)
+{
+  batch->firstquerynum += (uint64_t) batch->numofqueries;
+  batch->numofqueries = 0;
+}
+
+static void gt_querybatch_delete(GtQuerybatch *batch)
+{
+  gt_free(batch->sequences);
+  gt_free(batch->descriptions);
+  gt_free(batch->seqoffsets);
+  gt_free(batch->descoffsets);
+}
+
+static void *gt_querybatch_thread(void *data)
+{
+  GtQuerybatchpart *part = (GtQuerybatchpart *) data;
+  const GtQuerybatch *batch = part->batch;
+  GtUword idx;
+
+  for (idx = part->firstquery; idx < part->nextquery; idx++)
+  {
+    if (part->processquery(part->threadinfo,
+                           batch->firstquerynum + (uint64_t) idx,
+                           batch->sequences + batch->seqoffsets[idx],
+                           batch->seqoffsets[idx+1] - batch->seqoffsets[idx],
+                           batch->descriptions + batch->descoffsets[idx],
+                           part->outbuf,
+                           part->err) != 0)
+    {
+      part->haserr = true;
+      break;
+    }
+  }
+  return NULL;
+}
+
+static void gt_querybatch_parts_run(GtQuerybatchpart *parts,
+                                    unsigned int numofparts)
+{
+#ifdef GT_THREADS_ENABLED
+  unsigned int part;
+  bool haserr = false;
+
+  if (numofparts == 1U)
+  {
+    (void) gt_querybatch_thread(parts);
+    return;
+  }
+  for (part = 0; part < numofparts; part++)
+  {
+    parts[part].thread = gt_thread_new(gt_querybatch_thread,parts + part,
+                                       NULL);
+    if (parts[part].thread == NULL)
+    {
+      haserr = true;
+      break;
+    }
+  }
+  for (part = 0; part < numofparts; part++)
+  {
+    if (parts[part].thread != NULL)
+    {
+      gt_thread_join(parts[part].thread);
+      gt_thread_delete(parts[part].thread);
+      parts[part].thread = NULL;
+    }
+  }
+  gt_assert(!haserr);
+#else
+  unsigned int part;
+
+  for (part = 0; part < numofparts; part++)
+  {
+    (void) gt_querybatch_thread(parts + part);
+  }
+#endif
+}
+
+/* processes the queries of <batch> and outputs the results in the order of
+   the queries */
+static int gt_querybatch_process(const GtQuerybatch *batch,
+                                 GtQuerybatchpart *parts,
+                                 unsigned int numofthreads,
+                                 FILE *outfp,
+                                 GtError *err)
+{
+  unsigned int part, numofparts;
+  bool haserr = false;
+
+  if (batch->numofqueries == 0)
+  {
+    return 0;
+  }
+  numofparts = batch->numofqueries < (GtUword) numofthreads
+                 ? (unsigned int) batch->numofqueries
+                 : numofthreads;
+  for (part = 0; part < numofparts; part++)
+  {
+    parts[part].batch = batch;
+    parts[part].firstquery = part * batch->numofqueries/numofparts;
+    parts[part].nextquery = (part + 1) * batch->numofqueries/numofparts;
+    parts[part].haserr = false;
+    parts[part].thread = NULL;
+  }
+  gt_querybatch_parts_run(parts,numofparts);
+  for (part = 0; part < numofparts; part++)
+  {
+    /* the output of the queries processed before the error is kept */
+    gt_xfwrite(gt_str_get(parts[part].outbuf),sizeof (char),
+               (size_t) gt_str_length(parts[part].outbuf),outfp);
+    gt_str_reset(parts[part].outbuf);
+    if (parts[part].haserr)
+    {
+      gt_error_set(err,"%s",gt_error_get(parts[part].err));
+      haserr = true;
+      break;
+    }
+  }
+  return haserr ? -1 : 0;
+}
+
+int gt_querybatch_run(const GtStrArray *queryfiles,
+                      const GtUchar *symbolmap,
+                      GtUword batchsize,
+                      unsigned int numofthreads,
+                      void **threadinfo,
+                      GtQuerybatchProcessfunc processquery,
+                      FILE *outfp,
+                      GtError *err)
+{
+  GtSeqIterator *seqit;
+  GtQuerybatch batch;
+  GtQuerybatchpart *parts;
+  unsigned int part;
+  bool haserr = false;
+
+  gt_error_check(err);
+  gt_assert(batchsize > 0 && numofthreads > 0);
+  seqit = gt_seq_iterator_sequence_buffer_new(queryfiles,err);
+  if (seqit == NULL)
+  {
+    return -1;
+  }
+  if (symbolmap != NULL)
+  {
+    gt_seq_iterator_set_symbolmap(seqit,symbolmap);
+  }
+  gt_querybatch_init(&batch,batchsize);
+  parts = gt_malloc(sizeof *parts * numofthreads);
+  for (part = 0; part < numofthreads; part++)
+  {
+    parts[part].threadinfo = threadinfo[part];
+    parts[part].processquery = processquery;
+    parts[part].outbuf = gt_str_new();
+    parts[part].err = gt_error_new();
+  }
+  while (!haserr)
+  {
+    const GtUchar *query;
+    GtUword querylen;
+    char *desc = NULL;
+    int retval = gt_seq_iterator_next(seqit,&query,&querylen,&desc,err);
+
+    if (retval < 0)
+    {
+      haserr = true;
+      break;
+    }
+    if (retval > 0)
+    {
+      gt_querybatch_add(&batch,query,querylen,desc);
+    }
+    if (retval == 0 || batch.numofqueries == batch.maxnumofqueries)
+    {
+      if (gt_querybatch_process(&batch,parts,numofthreads,outfp,err) != 0)
+      {
+        haserr = true;
+      }
+      gt_querybatch_reset(&batch);
+    }
+    if (retval == 0)
+    {
+      break;
+    }
+  }
+  for (part = 0; part < numofthreads; part++)
+  {
+    gt_str_delete(parts[part].outbuf);
+    gt_error_delete(parts[part].err);
+  }
+  gt_free(parts);
+  gt_querybatch_delete(&batch);
+  gt_seq_iterator_delete(seqit);
+  return haserr ? -1 : 0;
+}
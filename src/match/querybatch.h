@@ -0,0 +1,61 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef QUERYBATCH_H
+#define QUERYBATCH_H
+
+#include <inttypes.h>
+#include <stdio.h>
+#include "core/error_api.h"
+#include "core/str_api.h"
+#include "core/str_array_api.h"
+#include "core/types_api.h"
+
+/* The default number of query sequences read and processed in one batch. */
+#define GT_QUERYBATCH_DEFAULTSIZE 10000UL
+
+/* Processes the query sequence <query> of length <querylen> with description
+   <desc>, which is the <querynum>-th sequence of the input (counting from 0).
+   All output for the query is appended to <outbuf>. <threadinfo> is the
+   information given for the calling thread. Returns 0 on success, otherwise
+   -1 and <err> is set. */
+typedef int (*GtQuerybatchProcessfunc)(void *threadinfo,
+                                       uint64_t querynum,
+                                       const GtUchar *query,
+                                       GtUword querylen,
+                                       const char *desc,
+                                       GtStr *outbuf,
+                                       GtError *err);
+
+/* Reads the query sequences from the files in <queryfiles>, transformed by
+   <symbolmap> (if not NULL), in batches of <batchsize> sequences. Each batch
+   is split into <numofthreads> parts of consecutive sequences which are
+   processed in parallel by <processquery> (or one after the other, if
+   threads are not enabled). The <t>-th part is given <threadinfo[t]>, so
+   that <threadinfo> must have <numofthreads> entries. The functions called by
+   <processquery> must only read shared data. The output of all queries is
+   written to <outfp> in the order of the input. Returns 0 on success,
+   otherwise -1 and <err> is set. */
+int gt_querybatch_run(const GtStrArray *queryfiles,
+                      const GtUchar *symbolmap,
+                      GtUword batchsize,
+                      unsigned int numofthreads,
+                      void **threadinfo,
+                      GtQuerybatchProcessfunc processquery,
+                      FILE *outfp,
+                      GtError *err);
+
+#endif
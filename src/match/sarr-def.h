@@ -28,6 +28,7 @@
 
 #include "lcpoverflow.h"
 #include "bcktab.h"
+#include "esa-sufcompressed.h"
 
 #define SARR_ESQTAB 1U
 #define SARR_SUFTAB (1U << 1)
@@ -37,6 +38,10 @@
 #define SARR_SDSTAB (1U << 5)
 #define SARR_BCKTAB (1U << 6)
 #define SARR_SSPTAB (1U << 7)
+/* with SARR_SUFTAB: if the index has no suffix table, but a compressed
+   suffix table, map the latter. Then <suftab> is NULL and the suffixes
+   must be accessed by gt_suffixarray_suftab_get or the sequential reader */
+#define SARR_SUFCOMPRESSED (1U << 8)
 
 #define SARR_ALLTAB (SARR_ESQTAB |\
                      SARR_SUFTAB |\
@@ -72,6 +77,7 @@ typedef struct
   GtUword numberofallsortedsuffixes;
   /* either with mapped input */
   const ESASuffixptr *suftab;
+  GtSuftabcompressed suftabcompressed;
   const GtUchar *lcptab;
   const Largelcpvalue *llvtab;
   const GtUchar *bwttab;
@@ -139,4 +145,15 @@ typedef struct
   return largelcpvalue->value;
 }
 
+/*@unused@*/ static inline GtUword gt_suffixarray_suftab_get(
+                       const Suffixarray *suffixarray,
+                       GtUword idx)
+{
+  if (suffixarray->suftab != NULL)
+  {
+    return ESASUFFIXPTRGET(suffixarray->suftab,idx);
+  }
+  return gt_suftabcompressed_get(&suffixarray->suftabcompressed,idx);
+}
+
 #endif
@@ -0,0 +1,469 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdio.h>
+#include "core/alphabet.h"
+#include "core/encseq.h"
+#include "core/encseq_metadata.h"
+#include "core/fa_api.h"
+#include "core/fileutils_api.h"
+#include "core/ma_api.h"
+#include "core/seq_iterator_sequence_buffer_api.h"
+#include "core/str_array_api.h"
+#include "core/xansi_api.h"
+#include "core/xposix_api.h"
+#include "esa-fileend.h"
+#include "sfx-apfxlen.h"
+#include "sfx-extmerge.h"
+#include "sfx-outprj.h"
+#include "sfx-run.h"
+#include "test-mergeesa.h"
+
+#define GT_EXTMERGE_FASTASUFFIX ".fna"
+
+static const char *gt_extmerge_encseqsuffixes[] =
+{
+  GT_ENCSEQFILESUFFIX,
+  GT_SSPTABFILESUFFIX,
+  GT_DESTABFILESUFFIX,
+  GT_SDSTABFILESUFFIX,
+  GT_OISTABFILESUFFIX,
+  GT_MD5TABFILESUFFIX,
+  GT_ALPHABETFILESUFFIX,
+  NULL
+};
+
+static const char *gt_extmerge_esasuffixes[] =
+{
+  GT_SUFTABSUFFIX,
+  GT_LCPTABSUFFIX,
+  GT_LARGELCPTABSUFFIX,
+  GT_PROJECTFILESUFFIX,
+  NULL
+};
+
+typedef struct
+{
+  GtUint64 bytesread,
+           byteswritten;
+} GtExtmergeIOvolume;
+
+static GtUint64 gt_extmerge_filesizes(const char *indexname,
+                                      const char **suffixes)
+{
+  GtUint64 sum = 0;
+  const char **suffix;
+
+  for (suffix = suffixes; *suffix != NULL; suffix++)
+  {
+    if (gt_file_exists_with_suffix(indexname,*suffix))
+    {
+      sum += (GtUint64) gt_file_size_with_suffix(indexname,*suffix);
+    }
+  }
+  return sum;
+}
+
+static void gt_extmerge_removefiles(const char *indexname,
+                                    const char **suffixes)
+{
+  GtStr *filename = gt_str_new();
+  const char **suffix;
+
+  for (suffix = suffixes; *suffix != NULL; suffix++)
+  {
+    if (gt_file_exists_with_suffix(indexname,*suffix))
+    {
+      gt_str_set(filename,indexname);
+      gt_str_append_cstr(filename,*suffix);
+      gt_xunlink(gt_str_get(filename));
+    }
+  }
+  gt_str_delete(filename);
+}
+
+/* encodes the chunk stored in the fasta file for <chunkname> with the
+   <alphabet> of the complete index and constructs its suffix and lcp table */
+static int gt_extmerge_buildchunk(const Suffixeratoroptions *so,
+                                  const GtAlphabet *alphabet,
+                                  const char *chunkname,
+                                  GtExtmergeIOvolume *iovolume,
+                                  GtLogger *logger,
+                                  GtError *err)
+{
+  GtEncseqEncoder *ee;
+  GtStrArray *chunkfiles = gt_str_array_new();
+  GtStr *filename = gt_str_new_cstr(chunkname);
+  bool haserr = false;
+
+  gt_str_append_cstr(filename,GT_EXTMERGE_FASTASUFFIX);
+  gt_str_array_add(chunkfiles,filename);
+  iovolume->bytesread += (GtUint64) gt_file_size(gt_str_get(filename));
+  ee = gt_encseq_encoder_new();
+  gt_encseq_encoder_do_not_create_des_tab(ee);
+  gt_encseq_encoder_do_not_create_sds_tab(ee);
+  gt_encseq_encoder_do_not_create_ssp_tab(ee);
+  if (gt_alphabet_is_dna(alphabet))
+  {
+    gt_encseq_encoder_set_input_dna(ee);
+  } else
+  {
+    if (gt_alphabet_is_protein(alphabet))
+    {
+      gt_encseq_encoder_set_input_protein(ee);
+    } else
+    {
+      /* a custom alphabet is only stored in the .esq file of the complete
+         index, so a symbol map file is written for the chunk */
+      if (gt_alphabet_to_file(alphabet,chunkname,err) != 0)
+      {
+        haserr = true;
+      } else
+      {
+        GtStr *smapfile = gt_str_new_cstr(chunkname);
+
+        gt_str_append_cstr(smapfile,GT_ALPHABETFILESUFFIX);
+        haserr = gt_encseq_encoder_use_symbolmap_file(ee,gt_str_get(smapfile),
+                                                      err) != 0;
+        gt_str_delete(smapfile);
+      }
+    }
+  }
+  if (!haserr && gt_encseq_encoder_encode(ee,chunkfiles,chunkname,err) != 0)
+  {
+    haserr = true;
+  }
+  gt_encseq_encoder_delete(ee);
+  gt_xunlink(gt_str_get(filename));
+  gt_str_array_delete(chunkfiles);
+  if (!haserr)
+  {
+    Suffixeratoroptions chunkso = *so;
+
+    iovolume->byteswritten
+      += gt_extmerge_filesizes(chunkname,gt_extmerge_encseqsuffixes);
+    gt_str_set(filename,chunkname);
+    chunkso.indexname = filename;
+    chunkso.inputindex = filename;
+    chunkso.extmerge = false;
+    chunkso.showprogress = false;
+    if (gt_runsuffixerator(true,&chunkso,NULL,logger,err) != 0)
+    {
+      haserr = true;
+    } else
+    {
+      iovolume->bytesread
+        += gt_extmerge_filesizes(chunkname,gt_extmerge_encseqsuffixes);
+      iovolume->byteswritten
+        += gt_extmerge_filesizes(chunkname,gt_extmerge_esasuffixes);
+    }
+  }
+  gt_str_delete(filename);
+  return haserr ? -1 : 0;
+}
+
+/* splits the input sequences at sequence boundaries into chunks with at most
+   <maxchunklength> symbols, including the separators, and constructs the
+   index of each chunk. No sequence may be longer than <maxchunklength>. */
+static int gt_extmerge_buildchunks(const Suffixeratoroptions *so,
+                                   const GtAlphabet *alphabet,
+                                   GtStrArray *chunknames,
+                                   GtUword maxchunklength,
+                                   GtExtmergeIOvolume *iovolume,
+                                   GtLogger *logger,
+                                   GtError *err)
+{
+  GtSeqIterator *seqit;
+  GtStr *chunkname = gt_str_new(),
+        *fastafile = gt_str_new();
+  FILE *chunkfp = NULL;
+  GtUword chunklength = 0;
+  bool haserr = false;
+
+  seqit = gt_seq_iterator_sequence_buffer_new(so->db,err);
+  if (seqit == NULL)
+  {
+    haserr = true;
+  }
+  while (!haserr)
+  {
+    const GtUchar *sequence;
+    GtUword len;
+    char *desc;
+    int rval = gt_seq_iterator_next(seqit,&sequence,&len,&desc,err);
+
+    if (rval < 0)
+    {
+      haserr = true;
+      break;
+    }
+    if (chunkfp != NULL &&
+        (rval == 0 || chunklength + 1 + len > maxchunklength))
+    {
+      gt_fa_fclose(chunkfp);
+      chunkfp = NULL;
+      gt_logger_log(logger,"build index for chunk " GT_WU " of length " GT_WU,
+                    gt_str_array_size(chunknames),chunklength);
+      /* add the name first, so that the files are removed on failure */
+      gt_str_array_add(chunknames,chunkname);
+      if (gt_extmerge_buildchunk(so,alphabet,gt_str_get(chunkname),iovolume,
+                                 logger,err) != 0)
+      {
+        haserr = true;
+        break;
+      }
+    }
+    if (rval == 0)
+    {
+      break;
+    }
+    if (chunkfp == NULL)
+    {
+      gt_str_set(chunkname,gt_str_get(so->indexname));
+      gt_str_append_cstr(chunkname,"-chunk");
+      gt_str_append_uword(chunkname,gt_str_array_size(chunknames));
+      gt_str_set(fastafile,gt_str_get(chunkname));
+      gt_str_append_cstr(fastafile,GT_EXTMERGE_FASTASUFFIX);
+      chunkfp = gt_fa_fopen(gt_str_get(fastafile),"wb",err);
+      if (chunkfp == NULL)
+      {
+        haserr = true;
+        break;
+      }
+      chunklength = 0;
+    } else
+    {
+      chunklength++; /* separator */
+    }
+    gt_assert(chunklength + len <= maxchunklength);
+    gt_xfputs(">\n",chunkfp);
+    gt_xfwrite(sequence,sizeof *sequence,(size_t) len,chunkfp);
+    gt_xfputc('\n',chunkfp);
+    chunklength += len;
+  }
+  if (chunkfp != NULL)
+  {
+    gt_fa_fclose(chunkfp);
+    gt_xunlink(gt_str_get(fastafile));
+  }
+  gt_seq_iterator_delete(seqit);
+  gt_str_delete(chunkname);
+  gt_str_delete(fastafile);
+  return haserr ? -1 : 0;
+}
+
+static int gt_extmerge_outprjfile(const Suffixeratoroptions *so,
+                                  const GtMergeesaStats *mergestats,
+                                  GtLogger *logger,
+                                  GtError *err)
+{
+  GtEncseqLoader *el = gt_encseq_loader_new();
+  GtEncseq *encseq;
+  bool haserr = false;
+
+  gt_encseq_loader_disable_autosupport(el);
+  gt_encseq_loader_do_not_require_des_tab(el);
+  gt_encseq_loader_do_not_require_sds_tab(el);
+  gt_encseq_loader_do_not_require_ssp_tab(el);
+  encseq = gt_encseq_loader_load(el,gt_str_get(so->indexname),err);
+  gt_encseq_loader_delete(el);
+  if (encseq == NULL)
+  {
+    haserr = true;
+  } else
+  {
+    Definedunsignedlong longest;
+    unsigned int prefixlength
+      = gt_index_options_prefixlength_value(so->idxopts);
+
+    if (prefixlength == GT_PREFIXLENGTH_AUTOMATIC)
+    {
+      Sfxstrategy sfxstrategy
+        = gt_index_options_sfxstrategy_value(so->idxopts);
+
+      prefixlength
+        = gt_recommendedprefixlength(gt_alphabet_num_of_chars(
+                                               gt_encseq_alphabet(encseq)),
+                                     gt_encseq_total_length(encseq),
+                                     sfxstrategy.spmopt_minlength > 0
+                                       ? 0.15
+                                       : GT_RECOMMENDED_MULTIPLIER_DEFAULT,
+                                     sfxstrategy.spmopt_minlength == 0);
+    }
+    gt_assert(mergestats->numofsuffixes ==
+              gt_encseq_total_length(encseq) + 1);
+    longest.defined = true;
+    longest.valueunsignedlong = mergestats->longest;
+    if (gt_outprjfile(gt_str_get(so->indexname),
+                      GT_READMODE_FORWARD,
+                      encseq,
+                      mergestats->numofsuffixes,
+                      prefixlength,
+                      mergestats->numoflargelcpvalues,
+                      mergestats->lcptabsum/mergestats->numofsuffixes,
+                      mergestats->maxbranchdepth,
+                      &longest,
+                      err) != 0)
+    {
+      haserr = true;
+    }
+    gt_logger_log(logger,"numofsuffixes=" GT_WU ", maxbranchdepth=" GT_WU,
+                  mergestats->numofsuffixes,mergestats->maxbranchdepth);
+  }
+  gt_encseq_delete(encseq);
+  return haserr ? -1 : 0;
+}
+
+int gt_sfx_extmerge_run(Suffixeratoroptions *so,
+                        GtLogger *logger,
+                        GtError *err)
+{
+  GtEncseqEncoder *ee;
+  GtAlphabet *alphabet = NULL;
+  GtStrArray *chunknames = gt_str_array_new();
+  GtExtmergeIOvolume iovolume = {0,0};
+  GtMergeesaStats mergestats;
+  GtUword idx, maxchunklength;
+  bool haserr = false, direct = false;
+
+  gt_error_check(err);
+  gt_assert(so->extmerge && gt_str_length(so->inputindex) == 0);
+  if (gt_index_options_sfxstrategy_value(so->idxopts).compressedoutput)
+  {
+    gt_error_set(err,"option -extmerge cannot be combined with a compressed "
+                     "output of the suffix and lcp table");
+    return -1;
+  }
+  /* each suffix needs one word in the suffix table and at least one byte in
+     the lcp table and its buffer */
+  maxchunklength = gt_index_options_maximumspace_value(so->idxopts)/
+                   (sizeof (GtUword) + 2);
+  if (maxchunklength == 0)
+  {
+    maxchunklength = 1UL;
+  }
+  gt_logger_log(logger,"construct index in chunks of length at most " GT_WU,
+                maxchunklength);
+  ee = gt_encseq_encoder_new_from_options(so->encopts,err);
+  if (ee == NULL)
+  {
+    haserr = true;
+  } else
+  {
+    gt_encseq_encoder_set_logger(ee,logger);
+    if (gt_encseq_encoder_encode(ee,so->db,gt_str_get(so->indexname),
+                                 err) != 0)
+    {
+      haserr = true;
+    }
+    gt_encseq_encoder_delete(ee);
+  }
+  if (!haserr)
+  {
+    GtEncseqMetadata *emd = gt_encseq_metadata_new(gt_str_get(so->indexname),
+                                                   err);
+    if (emd == NULL)
+    {
+      haserr = true;
+    } else
+    {
+      /* if the input fits into a single chunk, there is nothing to merge */
+      direct = gt_encseq_metadata_total_length(emd) <= maxchunklength;
+      /* chunks are cut at sequence boundaries, so a longer sequence cannot
+         be indexed within the memory limit */
+      if (!direct && gt_encseq_metadata_max_seq_length(emd) > maxchunklength)
+      {
+        gt_error_set(err,"option -extmerge: sequence of length " GT_WU
+                         " does not fit into a chunk of length " GT_WU
+                         " as given by -memlimit; increase -memlimit to at "
+                         "least " GT_WU " bytes",
+                         gt_encseq_metadata_max_seq_length(emd),
+                         maxchunklength,
+                         gt_encseq_metadata_max_seq_length(emd) *
+                         (GtUword) (sizeof (GtUword) + 2));
+        haserr = true;
+      }
+      alphabet = gt_alphabet_ref(gt_encseq_metadata_alphabet(emd));
+      gt_encseq_metadata_delete(emd);
+    }
+  }
+  if (!haserr && direct)
+  {
+    Suffixeratoroptions directso = *so;
+
+    gt_logger_log(logger,"input fits into a single chunk");
+    directso.inputindex = so->indexname;
+    directso.extmerge = false;
+    if (gt_runsuffixerator(true,&directso,NULL,logger,err) != 0)
+    {
+      haserr = true;
+    }
+  }
+  if (!haserr && !direct)
+  {
+    for (idx = 0; idx < gt_str_array_size(so->db); idx++)
+    {
+      iovolume.bytesread
+        += (GtUint64) gt_file_size(gt_str_array_get(so->db,idx));
+    }
+    iovolume.byteswritten
+      += gt_extmerge_filesizes(gt_str_get(so->indexname),
+                               gt_extmerge_encseqsuffixes);
+    if (gt_extmerge_buildchunks(so,alphabet,chunknames,maxchunklength,
+                                &iovolume,logger,err) != 0)
+    {
+      haserr = true;
+    }
+  }
+  if (!haserr && !direct)
+  {
+    gt_logger_log(logger,"merge " GT_WU " chunk indexes",
+                  gt_str_array_size(chunknames));
+    for (idx = 0; idx < gt_str_array_size(chunknames); idx++)
+    {
+      const char *chunkname = gt_str_array_get(chunknames,idx);
+
+      iovolume.bytesread
+        += gt_extmerge_filesizes(chunkname,gt_extmerge_encseqsuffixes) +
+           gt_extmerge_filesizes(chunkname,gt_extmerge_esasuffixes);
+    }
+    gt_assert(gt_str_array_size(chunknames) > 1UL);
+    if (gt_performtheindexmerging_stats(so->indexname,chunknames,&mergestats,
+                                        logger,err) != 0
+        || gt_extmerge_outprjfile(so,&mergestats,logger,err) != 0)
+    {
+      haserr = true;
+    }
+  }
+  if (!haserr && !direct)
+  {
+    iovolume.byteswritten
+      += gt_extmerge_filesizes(gt_str_get(so->indexname),
+                               gt_extmerge_esasuffixes);
+    gt_logger_log(logger,"external merge: read " GT_LLU " bytes, wrote "
+                  GT_LLU " bytes",iovolume.bytesread,iovolume.byteswritten);
+  }
+  for (idx = 0; idx < gt_str_array_size(chunknames); idx++)
+  {
+    const char *chunkname = gt_str_array_get(chunknames,idx);
+
+    gt_extmerge_removefiles(chunkname,gt_extmerge_encseqsuffixes);
+    gt_extmerge_removefiles(chunkname,gt_extmerge_esasuffixes);
+  }
+  gt_str_array_delete(chunknames);
+  gt_alphabet_delete(alphabet);
+  return haserr ? -1 : 0;
+}
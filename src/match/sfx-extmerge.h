@@ -0,0 +1,37 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef SFX_EXTMERGE_H
+#define SFX_EXTMERGE_H
+
+#include "core/error_api.h"
+#include "core/logger.h"
+#include "match/sfx-opt.h"
+
+/* Constructs the encoded sequence, the suffix table and the lcp table for
+   the input sequences given in <so> without holding the suffix table of the
+   whole input in memory. The input is split at sequence boundaries into
+   chunks whose suffix and lcp tables fit into the space given by the
+   -memlimit option. The index of each chunk is constructed separately and
+   stored on disk, and all chunk indexes are finally merged into the index
+   <so->indexname>. The chunk files are removed afterwards. The amount of data
+   read from and written to disk is reported via <logger>. Returns 0 on
+   success, otherwise -1 and <err> is set. */
+int gt_sfx_extmerge_run(Suffixeratoroptions *so,
+                        GtLogger *logger,
+                        GtError *err);
+
+#endif
@@ -0,0 +1,427 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdio.h>
+#include "core/chardef_api.h"
+#include "core/fa_api.h"
+#include "core/ma_api.h"
+#include "core/minmax_api.h"
+#include "core/thread_api.h"
+#include "core/xansi_api.h"
+#include "esa-fileend.h"
+#include "esa-map.h"
+#include "lcpoverflow.h"
+#include "sfx-outprj.h"
+#include "sfx-lcpbuild.h"
+
+/* All steps work on contiguous parts of either the suffix array or the
+   sequence, one part per thread:
+   1. phitab[suftab[idx]] = suftab[idx-1], the written addresses differ.
+   2. The permuted lcp values of each part of the sequence are computed with
+      the phi-algorithm, overwriting phitab. Each part starts with an lcp
+      value of 0, so the parts are independent.
+   3. The lcp values are permuted into suffix array order and split into the
+      small values of the .lcp file and the large values of the .llv file.
+      In a first pass each part counts its large values, in a second pass
+      the large values are stored at the offset of the part, so the .llv file
+      is ordered by position as required. */
+
+typedef struct
+{
+  const GtEncseq *encseq;
+  GtReadmode readmode;
+  const ESASuffixptr *suftab;
+  GtUword *phitab,
+          partwidth,
+          totallength,
+          start,
+          end;
+  uint8_t *smalllcpvalues;
+  Largelcpvalue *largelcpvalues;
+  GtUword numoflargelcpvalues,
+          largelcpoffset,
+          maxbranchdepth;
+  double lcptabsum;
+  GtThread *thread;
+} GtLcpbuildpart;
+
+static GtLcpbuildpart *gt_lcpbuild_parts_new(unsigned int *numofparts,
+                                             const GtEncseq *encseq,
+                                             GtReadmode readmode,
+                                             const ESASuffixptr *suftab,
+                                             GtUword *phitab,
+                                             GtUword partwidth,
+                                             GtUword totallength)
+{
+  GtLcpbuildpart *parts;
+  unsigned int part;
+
+#ifdef GT_THREADS_ENABLED
+  *numofparts = gt_jobs;
+#else
+  *numofparts = 1U;
+#endif
+  if ((GtUword) *numofparts > totallength + 1)
+  {
+    *numofparts = (unsigned int) (totallength + 1);
+  }
+  parts = gt_malloc(sizeof *parts * (*numofparts));
+  for (part = 0; part < *numofparts; part++)
+  {
+    parts[part].encseq = encseq;
+    parts[part].readmode = readmode;
+    parts[part].suftab = suftab;
+    parts[part].phitab = phitab;
+    parts[part].partwidth = partwidth;
+    parts[part].totallength = totallength;
+    parts[part].start = parts[part].end = 0;
+    parts[part].smalllcpvalues = NULL;
+    parts[part].largelcpvalues = NULL;
+    parts[part].numoflargelcpvalues = 0;
+    parts[part].largelcpoffset = 0;
+    parts[part].maxbranchdepth = 0;
+    parts[part].lcptabsum = 0.0;
+    parts[part].thread = NULL;
+  }
+  return parts;
+}
+
+/* split the range from <start> to <end>-1 into <numofparts> parts */
+static void gt_lcpbuild_parts_split(GtLcpbuildpart *parts,
+                                    unsigned int numofparts,
+                                    GtUword start,
+                                    GtUword end)
+{
+  GtUword width = start < end ? (end - start + numofparts - 1)/numofparts : 0;
+  unsigned int part;
+
+  for (part = 0; part < numofparts; part++)
+  {
+    parts[part].start = GT_MIN(start + part * width,end);
+    parts[part].end = GT_MIN(parts[part].start + width,end);
+  }
+}
+
+static void gt_lcpbuild_parts_run(GtLcpbuildpart *parts,
+                                  unsigned int numofparts,
+                                  GtThreadFunc function)
+{
+#ifdef GT_THREADS_ENABLED
+  unsigned int part;
+  bool haserr = false;
+
+  if (numofparts == 1U)
+  {
+    (void) function(parts);
+    return;
+  }
+  for (part = 0; part < numofparts; part++)
+  {
+    parts[part].thread = gt_thread_new(function,parts + part,NULL);
+    if (parts[part].thread == NULL)
+    {
+      haserr = true;
+      break;
+    }
+  }
+  for (part = 0; part < numofparts; part++)
+  {
+    if (parts[part].thread != NULL)
+    {
+      gt_thread_join(parts[part].thread);
+      gt_thread_delete(parts[part].thread);
+      parts[part].thread = NULL;
+    }
+  }
+  gt_assert(!haserr);
+#else
+  gt_assert(numofparts == 1U);
+  (void) function(parts);
+#endif
+}
+
+static void *gt_lcpbuild_thread_phitab(void *data)
+{
+  GtLcpbuildpart *part = (GtLcpbuildpart *) data;
+  GtUword idx;
+
+  for (idx = part->start; idx < part->end; idx++)
+  {
+    part->phitab[ESASUFFIXPTRGET(part->suftab,idx)]
+      = ESASUFFIXPTRGET(part->suftab,idx-1);
+  }
+  return NULL;
+}
+
+static void *gt_lcpbuild_thread_plcptab(void *data)
+{
+  GtLcpbuildpart *part = (GtLcpbuildpart *) data;
+  GtUword pos, lcpvalue = 0,
+          suftab0 = ESASUFFIXPTRGET(part->suftab,0);
+  GtUword *plcptab = part->phitab; /* overlay both arrays */
+
+  for (pos = part->start; pos < part->end; pos++)
+  {
+    GtUchar cc = gt_encseq_get_encoded_char(part->encseq,pos,part->readmode);
+
+    if (pos == suftab0 || GT_ISSPECIAL(cc))
+    {
+      plcptab[pos] = 0;
+      lcpvalue = 0;
+    } else
+    {
+      const GtUword previousstart = part->phitab[pos],
+                    lastoffset = part->totallength
+                                 - GT_MAX(pos,previousstart);
+
+      while (lcpvalue < lastoffset)
+      {
+        GtUchar cc1, cc2;
+
+        cc1 = gt_encseq_get_encoded_char(part->encseq,pos+lcpvalue,
+                                         part->readmode);
+        cc2 = gt_encseq_get_encoded_char(part->encseq,previousstart+lcpvalue,
+                                         part->readmode);
+        if (cc1 == cc2 && GT_ISNOTSPECIAL(cc1))
+        {
+          lcpvalue++;
+        } else
+        {
+          break;
+        }
+      }
+      plcptab[pos] = lcpvalue;
+      if (lcpvalue > 0)
+      {
+        lcpvalue--;
+      }
+    }
+  }
+  return NULL;
+}
+
+GtUword *gt_ENCSEQ_plcp_phialgorithm(const GtEncseq *encseq,
+                                     GtReadmode readmode,
+                                     GtUword partwidth,
+                                     GtUword totallength,
+                                     const ESASuffixptr *suftab)
+{
+  GtUword *phitab;
+  GtLcpbuildpart *parts;
+  unsigned int numofparts;
+
+  gt_assert(partwidth <= totallength);
+  phitab = gt_malloc(sizeof (*phitab) * (totallength+1));
+  phitab[totallength] = 0;
+  parts = gt_lcpbuild_parts_new(&numofparts,encseq,readmode,suftab,phitab,
+                                partwidth,totallength);
+  if (partwidth > 1UL)
+  {
+    gt_lcpbuild_parts_split(parts,numofparts,1UL,partwidth);
+    gt_lcpbuild_parts_run(parts,numofparts,gt_lcpbuild_thread_phitab);
+  }
+  gt_lcpbuild_parts_split(parts,numofparts,0,totallength);
+  gt_lcpbuild_parts_run(parts,numofparts,gt_lcpbuild_thread_plcptab);
+  gt_free(parts);
+  return phitab;
+}
+
+static GtUword gt_lcpbuild_lcpvalue(const GtLcpbuildpart *part,GtUword idx)
+{
+  return idx > 0 && idx < part->partwidth
+           ? part->phitab[ESASUFFIXPTRGET(part->suftab,idx)]
+           : 0;
+}
+
+static void *gt_lcpbuild_thread_countlarge(void *data)
+{
+  GtLcpbuildpart *part = (GtLcpbuildpart *) data;
+  GtUword idx;
+
+  part->numoflargelcpvalues = 0;
+  part->maxbranchdepth = 0;
+  part->lcptabsum = 0.0;
+  for (idx = part->start; idx < part->end; idx++)
+  {
+    GtUword lcpvalue = gt_lcpbuild_lcpvalue(part,idx);
+
+    if (lcpvalue < (GtUword) LCPOVERFLOW)
+    {
+      part->smalllcpvalues[idx] = (uint8_t) lcpvalue;
+    } else
+    {
+      part->smalllcpvalues[idx] = LCPOVERFLOW;
+      part->numoflargelcpvalues++;
+    }
+    if (part->maxbranchdepth < lcpvalue)
+    {
+      part->maxbranchdepth = lcpvalue;
+    }
+    part->lcptabsum += (double) lcpvalue;
+  }
+  return NULL;
+}
+
+static void *gt_lcpbuild_thread_filllarge(void *data)
+{
+  GtLcpbuildpart *part = (GtLcpbuildpart *) data;
+  Largelcpvalue *largelcpvalueptr = part->largelcpvalues
+                                    + part->largelcpoffset;
+  GtUword idx;
+
+  for (idx = part->start; idx < part->end; idx++)
+  {
+    if (part->smalllcpvalues[idx] == LCPOVERFLOW)
+    {
+      largelcpvalueptr->position = idx;
+      largelcpvalueptr->value = gt_lcpbuild_lcpvalue(part,idx);
+      largelcpvalueptr++;
+    }
+  }
+  gt_assert(largelcpvalueptr == part->largelcpvalues + part->largelcpoffset
+                                + part->numoflargelcpvalues);
+  return NULL;
+}
+
+static int gt_lcpbuild_writetab(const char *esaindexname,
+                                const char *suffix,
+                                const void *tab,
+                                size_t sizeofunit,
+                                GtUword numofunits,
+                                GtError *err)
+{
+  FILE *fp = gt_fa_fopen_with_suffix(esaindexname,suffix,"wb",err);
+
+  if (fp == NULL)
+  {
+    return -1;
+  }
+  if (numofunits > 0)
+  {
+    gt_xfwrite(tab,sizeofunit,(size_t) numofunits,fp);
+  }
+  gt_fa_fclose(fp);
+  return 0;
+}
+
+int gt_lcptab_build_from_suftab(const char *esaindexname,
+                                GtLogger *logger,
+                                GtError *err)
+{
+  bool haserr = false;
+  Suffixarray suffixarray;
+  GtUword totallength = 0, partwidth = 0;
+
+  gt_error_check(err);
+  if (gt_mapsuffixarray(&suffixarray,SARR_ESQTAB | SARR_SUFTAB,esaindexname,
+                        logger,err) != 0)
+  {
+    /* the suffix array was already freed */
+    return -1;
+  }
+  if (!haserr)
+  {
+    totallength = gt_encseq_total_length(suffixarray.encseq);
+    if (suffixarray.numberofallsortedsuffixes != totallength + 1)
+    {
+      gt_error_set(err,"index %s does not contain all suffixes, cannot "
+                       "compute lcp table",esaindexname);
+      haserr = true;
+    } else
+    {
+      GtUword specials = gt_encseq_specialcharacters(suffixarray.encseq);
+
+      gt_assert(specials <= totallength);
+      partwidth = totallength - specials;
+    }
+  }
+  if (!haserr)
+  {
+    GtUword *plcptab, numoflargelcpvalues = 0, maxbranchdepth = 0;
+    double lcptabsum = 0.0;
+    GtLcpbuildpart *parts;
+    uint8_t *smalllcpvalues;
+    Largelcpvalue *largelcpvalues;
+    unsigned int numofparts, part;
+
+    plcptab = gt_ENCSEQ_plcp_phialgorithm(suffixarray.encseq,
+                                          suffixarray.readmode,
+                                          partwidth,
+                                          totallength,
+                                          suffixarray.suftab);
+    gt_logger_log(logger,"computed permuted lcp table");
+    smalllcpvalues = gt_malloc(sizeof (*smalllcpvalues) * (totallength+1));
+    parts = gt_lcpbuild_parts_new(&numofparts,suffixarray.encseq,
+                                  suffixarray.readmode,suffixarray.suftab,
+                                  plcptab,partwidth,totallength);
+    gt_lcpbuild_parts_split(parts,numofparts,0,totallength+1);
+    for (part = 0; part < numofparts; part++)
+    {
+      parts[part].smalllcpvalues = smalllcpvalues;
+    }
+    gt_lcpbuild_parts_run(parts,numofparts,gt_lcpbuild_thread_countlarge);
+    for (part = 0; part < numofparts; part++)
+    {
+      parts[part].largelcpoffset = numoflargelcpvalues;
+      numoflargelcpvalues += parts[part].numoflargelcpvalues;
+      if (maxbranchdepth < parts[part].maxbranchdepth)
+      {
+        maxbranchdepth = parts[part].maxbranchdepth;
+      }
+      lcptabsum += parts[part].lcptabsum;
+    }
+    largelcpvalues = gt_malloc(sizeof (*largelcpvalues) *
+                               GT_MAX(numoflargelcpvalues,1UL));
+    for (part = 0; part < numofparts; part++)
+    {
+      parts[part].largelcpvalues = largelcpvalues;
+    }
+    if (numoflargelcpvalues > 0)
+    {
+      gt_lcpbuild_parts_run(parts,numofparts,gt_lcpbuild_thread_filllarge);
+    }
+    gt_free(parts);
+    gt_free(plcptab);
+    gt_logger_log(logger,"numoflargelcpvalues="GT_WU,numoflargelcpvalues);
+    gt_logger_log(logger,"maxbranchdepth="GT_WU,maxbranchdepth);
+    if (gt_lcpbuild_writetab(esaindexname,GT_LCPTABSUFFIX,smalllcpvalues,
+                             sizeof (*smalllcpvalues),totallength+1,err) != 0
+        || gt_lcpbuild_writetab(esaindexname,GT_LARGELCPTABSUFFIX,
+                                largelcpvalues,sizeof (*largelcpvalues),
+                                numoflargelcpvalues,err) != 0)
+    {
+      haserr = true;
+    }
+    gt_free(smalllcpvalues);
+    gt_free(largelcpvalues);
+    if (!haserr && gt_outprjfile(esaindexname,
+                                 suffixarray.readmode,
+                                 suffixarray.encseq,
+                                 suffixarray.numberofallsortedsuffixes,
+                                 suffixarray.prefixlength,
+                                 numoflargelcpvalues,
+                                 lcptabsum/
+                                 suffixarray.numberofallsortedsuffixes,
+                                 maxbranchdepth,
+                                 &suffixarray.longest,
+                                 err) != 0)
+    {
+      haserr = true;
+    }
+  }
+  gt_freesuffixarray(&suffixarray);
+  return haserr ? -1 : 0;
+}
@@ -0,0 +1,45 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef SFX_LCPBUILD_H
+#define SFX_LCPBUILD_H
+
+#include "core/encseq.h"
+#include "core/error_api.h"
+#include "core/logger.h"
+#include "match/sarr-def.h"
+
+/* Computes the permuted lcp table of the suffixes of <encseq> in <readmode>
+   sorted in <suftab> using the phi-algorithm. The sequence is split into
+   <gt_jobs> many parts which are processed in parallel, if threads are
+   enabled. The result is indexed by sequence position, entries for the
+   position of <suftab[0]> and for special positions are 0. The caller is
+   responsible for freeing it. */
+GtUword *gt_ENCSEQ_plcp_phialgorithm(const GtEncseq *encseq,
+                                     GtReadmode readmode,
+                                     GtUword partwidth,
+                                     GtUword totallength,
+                                     const ESASuffixptr *suftab);
+
+/* Computes the lcp table for the suffix array with index name <esaindexname>,
+   which must have been built with a suffix table, and writes it to the
+   <.lcp> and <.llv> files. The lcp statistics in the <.prj> file are updated
+   accordingly. Returns 0 on success, otherwise -1 and <err> is set. */
+int gt_lcptab_build_from_suftab(const char *esaindexname,
+                                GtLogger *logger,
+                                GtError *err);
+
+#endif
@@ -41,6 +41,7 @@ static GtOPrval parse_options(int *parsed_args,
   GtOption *option,
            *optionshowprogress,
            *optiongenomediff,
+           *optionextmerge,
            *optionii;
   GtOPrval oprval;
   gt_error_check(err);
@@ -101,6 +102,35 @@ static GtOPrval parse_options(int *parsed_args,
   }
   gt_option_parser_add_option(op, optiongenomediff);
 
+  if (doesa) {
+    optionextmerge = gt_option_new_bool("extmerge",
+                                     "construct the suffix and lcp table of "
+                                     "chunks of the input sequences "
+                                     "separately and merge them on disk, such "
+                                     "that the construction fits into the "
+                                     "space given by option -memlimit",
+                                     &so->extmerge,
+                                     false);
+    gt_option_is_extended_option(optionextmerge);
+    gt_option_exclude(optionextmerge, optionii);
+    gt_option_exclude(optionextmerge, optiongenomediff);
+    gt_option_exclude(optionextmerge,
+                      gt_encseq_options_plain_option(so->encopts));
+    gt_option_exclude(optionextmerge,
+                      gt_encseq_options_mirrored_option(so->loadopts));
+    gt_option_imply(optionextmerge,
+                    gt_index_options_outsuftab_option(so->idxopts));
+    gt_option_imply(optionextmerge,
+                    gt_index_options_outlcptab_option(so->idxopts));
+    gt_option_exclude(optionextmerge,
+                      gt_index_options_outbwttab_option(so->idxopts));
+    gt_option_exclude(optionextmerge,
+                      gt_index_options_outbcktab_option(so->idxopts));
+    gt_option_parser_add_option(op, optionextmerge);
+  } else {
+    so->extmerge = false;
+  }
+
   /* suffixerator and friends do not take arguments */
   gt_option_parser_set_min_max_args(op, 0U, 0U);
 
@@ -117,6 +147,22 @@ static GtOPrval parse_options(int *parsed_args,
     gt_free(basenameptr);
   }
 
+  if (oprval == GT_OPTION_PARSER_OK && so->extmerge) {
+    if (gt_index_options_maximumspace_value(so->idxopts) == 0) {
+      gt_error_set(err, "option -extmerge requires option -memlimit");
+      oprval = GT_OPTION_PARSER_ERROR;
+    } else if (gt_index_options_readmode_value(so->idxopts)
+               != GT_READMODE_FORWARD) {
+      gt_error_set(err, "option -extmerge can only be used for the forward "
+                        "direction");
+      oprval = GT_OPTION_PARSER_ERROR;
+    } else if (gt_index_options_outkystab_value(so->idxopts)) {
+      gt_error_set(err, "option -extmerge cannot be combined with option "
+                        "-kys");
+      oprval = GT_OPTION_PARSER_ERROR;
+    }
+  }
+
   if (oprval == GT_OPTION_PARSER_OK &&
       gt_jobs > 1 && gt_index_options_outlcptab_value(so->idxopts)) {
     /* LCP table generation is not implemented in multithreaded
@@ -28,6 +28,7 @@ typedef struct
   bool beverbose,
        showprogress,
        genomediff,
+       extmerge,
        outlcptab;
   GtEncseqOptions *encopts,
                   *loadopts;
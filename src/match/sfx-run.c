@@ -38,6 +38,7 @@
 #include "giextract.h"
 #include "intcode-def.h"
 #include "sfx-apfxlen.h"
+#include "sfx-extmerge.h"
 #include "sfx-lcpvalues.h"
 #include "sfx-opt.h"
 #include "sfx-outprj.h"
@@ -243,16 +244,18 @@ static int suffixeratorwithoutput(Outfileinfo *outfileinfo,
   } else
   {
     const GtSuffixsortspace *suffixsortspace;
-    GtBitbuffer *bitbuffer = NULL;
+    GtSuftabcompressedWriter *suftabwriter = NULL;
     GtUword numberofsuffixes;
     bool specialsuffixes = false;
 
-    if (sfxstrategy->compressedoutput)
+    if (sfxstrategy->compressedoutput && outfileinfo->outfpsuftab != NULL)
     {
       GtUword totallength = gt_encseq_total_length(encseq);
       unsigned int bitsperentry = gt_determinebitspervalue(totallength);
 
-      bitbuffer = gt_bitbuffer_FILE_new(outfileinfo->outfpsuftab,bitsperentry);
+      suftabwriter
+        = gt_suftabcompressed_writer_new(outfileinfo->outfpsuftab,
+                                         bitsperentry > 0 ? bitsperentry : 1U);
     }
     while (true)
     {
@@ -265,10 +268,10 @@ static int suffixeratorwithoutput(Outfileinfo *outfileinfo,
       if (outfileinfo->outfpsuftab != NULL &&
           (!specialsuffixes || !swallow_tail))
       {
-        if (sfxstrategy->compressedoutput)
+        if (suftabwriter != NULL)
         {
           gt_suffixsortspace_compressed_to_file (suffixsortspace,
-                                                 bitbuffer,
+                                                 suftabwriter,
                                                  numberofsuffixes);
         } else
         {
@@ -285,9 +288,9 @@ static int suffixeratorwithoutput(Outfileinfo *outfileinfo,
       }
       outfileinfo->numberofallsortedsuffixes += numberofsuffixes;
     }
-    if (sfxstrategy->compressedoutput)
+    if (suftabwriter != NULL)
     {
-      gt_bitbuffer_delete(bitbuffer);
+      gt_suftabcompressed_writer_delete(suftabwriter);
     }
   }
   if (haserr)
@@ -386,6 +389,13 @@ static int run_packedindexconstruction(GtLogger *logger,
     = gt_alphabet_num_of_chars(gt_encseq_alphabet(encseq));
 
   finalcopy = bwtIdxParams.final;
+  if (finalcopy.seqParams.encParams.blockEnc.interleaveRankLines &&
+      numofchars != 4U)
+  {
+    gt_error_set(err,"interleaved rank lines are only available for DNA "
+                     "sequences");
+    return -1;
+  }
   if (numofchars > 10U && finalcopy.seqParams.encParams.blockEnc.blockSize > 3U)
   {
     finalcopy.seqParams.encParams.blockEnc.blockSize = 3U;
@@ -732,9 +742,18 @@ int gt_parseargsandcallsuffixerator(bool doesa,int argc,
 
     gt_logger_log(logger,"sizeof (GtUword)="GT_WU"",
                   (GtUword) (sizeof (GtUword) * CHAR_BIT));
-    if (gt_runsuffixerator(doesa,&so,NULL,logger,err) < 0)
+    if (so.extmerge)
     {
-      haserr = true;
+      if (gt_sfx_extmerge_run(&so,logger,err) < 0)
+      {
+        haserr = true;
+      }
+    } else
+    {
+      if (gt_runsuffixerator(doesa,&so,NULL,logger,err) < 0)
+      {
+        haserr = true;
+      }
     }
     gt_logger_delete(logger);
     logger = NULL;
@@ -20,6 +20,8 @@
 #include "core/unused_api.h"
 #include "core/timer_api.h"
 #include "core/mathsupport_api.h"
+#include "core/intbits.h"
+#include "core/thread_api.h"
 #include "sfx-lwcheck.h"
 #include "bare-encseq.h"
 #include "sfx-sain.h"
@@ -72,6 +74,144 @@ typedef struct
        roundtablepoints2suftab;
 } GtSainseq;
 
+#ifdef GT_THREADS_ENABLED
+
+/* The scans over the sequence counting the characters and inserting the
+   Sstar suffixes are split into gt_jobs many contiguous parts of the
+   sequence. Each part has its own count for every character, so a part
+   covers at least 16 positions per character. */
+
+#define GT_SAIN_MINPARTWIDTH ((GtUword) 1 << 14)
+
+typedef struct
+{
+  const GtSainseq *sainseq;
+  GtUsainindextype *suftab,
+                   *bucketcount;
+  GtUword startpos, endpos, nextcc, countSstartype;
+  bool nextisStype;
+  GtThread *thread;
+} GtSainSeqpart;
+
+static unsigned int gt_sain_numofseqparts(const GtSainseq *sainseq)
+{
+  GtUword maxparts
+    = sainseq->totallength/GT_MAX(GT_SAIN_MINPARTWIDTH,
+                                  GT_MULT2(GT_MULT8(sainseq->numofchars)));
+
+  return maxparts < (GtUword) gt_jobs ? (unsigned int) maxparts : gt_jobs;
+}
+
+static GtSainSeqpart *gt_sain_seqparts_new(unsigned int *numofparts,
+                                           const GtSainseq *sainseq)
+{
+  GtUword width, startpos = 0;
+  GtUsainindextype *bucketcount;
+  unsigned int part;
+  GtSainSeqpart *parts;
+
+  gt_assert(*numofparts > 1U);
+  width = (sainseq->totallength + *numofparts - 1)/(*numofparts);
+  parts = gt_malloc(sizeof *parts * (*numofparts));
+  bucketcount = gt_calloc((size_t) (*numofparts) * sainseq->numofchars,
+                          sizeof *bucketcount);
+  for (part = 0; part < *numofparts && startpos < sainseq->totallength;
+       part++)
+  {
+    parts[part].sainseq = sainseq;
+    parts[part].suftab = NULL;
+    parts[part].bucketcount = bucketcount + part * sainseq->numofchars;
+    parts[part].startpos = startpos;
+    parts[part].endpos = GT_MIN(startpos + width,sainseq->totallength);
+    parts[part].nextcc = GT_UNIQUEINT(sainseq->totallength);
+    parts[part].countSstartype = 0;
+    parts[part].nextisStype = true;
+    parts[part].thread = NULL;
+    startpos = parts[part].endpos;
+  }
+  *numofparts = part;
+  return parts;
+}
+
+static void gt_sain_seqparts_delete(GtSainSeqpart *parts)
+{
+  gt_free(parts[0].bucketcount);
+  gt_free(parts);
+}
+
+static void gt_sain_seqparts_run(GtSainSeqpart *parts,
+                                 unsigned int numofparts,
+                                 GtThreadFunc function)
+{
+  unsigned int part;
+  bool haserr = false;
+
+  for (part = 0; part < numofparts; part++)
+  {
+    parts[part].thread = gt_thread_new(function,parts + part,NULL);
+    if (parts[part].thread == NULL)
+    {
+      haserr = true;
+      break;
+    }
+  }
+  for (part = 0; part < numofparts; part++)
+  {
+    if (parts[part].thread != NULL)
+    {
+      gt_thread_join(parts[part].thread);
+      gt_thread_delete(parts[part].thread);
+      parts[part].thread = NULL;
+    }
+  }
+  gt_assert(!haserr);
+}
+
+static void *gt_sain_thread_countbuckets(void *data)
+{
+  GtSainSeqpart *part = (GtSainSeqpart *) data;
+  const GtSainseq *sainseq = part->sainseq;
+  GtUword position;
+
+  if (sainseq->seqtype == GT_SAIN_PLAINSEQ)
+  {
+    for (position = part->startpos; position < part->endpos; position++)
+    {
+      part->bucketcount[sainseq->seq.plainseq[position]]++;
+    }
+  } else
+  {
+    gt_assert(sainseq->seqtype == GT_SAIN_INTSEQ);
+    for (position = part->startpos; position < part->endpos; position++)
+    {
+      gt_assert((GtUword) sainseq->seq.array[position] < sainseq->numofchars);
+      part->bucketcount[sainseq->seq.array[position]]++;
+    }
+  }
+  return NULL;
+}
+
+/* the counts of the parts are added up in sainseq->bucketsize, which
+   must be initialized to zero */
+static void gt_sain_threaded_countbuckets(GtSainseq *sainseq,
+                                          unsigned int numofparts)
+{
+  GtSainSeqpart *parts = gt_sain_seqparts_new(&numofparts,sainseq);
+  GtUword charidx;
+  unsigned int part;
+
+  gt_sain_seqparts_run(parts,numofparts,gt_sain_thread_countbuckets);
+  for (part = 0; part < numofparts; part++)
+  {
+    for (charidx = 0; charidx < sainseq->numofchars; charidx++)
+    {
+      sainseq->bucketsize[charidx] += parts[part].bucketcount[charidx];
+    }
+  }
+  gt_sain_seqparts_delete(parts);
+}
+#endif
+
 static bool gt_sain_decideforfastmethod(GtUword maxvalue,
                                         GtUword len,
                                         GtUword numofchars)
@@ -145,6 +285,9 @@ static GtSainseq *gt_sainseq_new_from_plainseq(const GtUchar *plainseq,
 {
   const GtUchar *cptr;
   GtSainseq *sainseq = (GtSainseq *) gt_malloc(sizeof *sainseq);
+#ifdef GT_THREADS_ENABLED
+  unsigned int numofparts;
+#endif
 
   sainseq->seqtype = GT_SAIN_PLAINSEQ;
   sainseq->seq.plainseq = plainseq;
@@ -153,6 +296,14 @@ static GtSainseq *gt_sainseq_new_from_plainseq(const GtUchar *plainseq,
   sainseq->bare_encseq = NULL;
   sainseq->readmode = GT_READMODE_FORWARD;
   gt_sain_allocate_tmpspace(sainseq,len+1,len);
+#ifdef GT_THREADS_ENABLED
+  numofparts = gt_sain_numofseqparts(sainseq);
+  if (numofparts > 1U)
+  {
+    gt_sain_threaded_countbuckets(sainseq,numofparts);
+    return sainseq;
+  }
+#endif
   for (cptr = sainseq->seq.plainseq; cptr < sainseq->seq.plainseq + len; cptr++)
   {
     sainseq->bucketsize[*cptr]++;
@@ -202,6 +353,9 @@ static GtSainseq *gt_sainseq_new_from_array(GtUsainindextype *arr,
   GtUword charidx;
   GtUsainindextype *cptr;
   GtSainseq *sainseq = (GtSainseq *) gt_malloc(sizeof *sainseq);
+#ifdef GT_THREADS_ENABLED
+  unsigned int numofparts;
+#endif
 
   sainseq->seqtype = GT_SAIN_INTSEQ;
   sainseq->seq.array = arr;
@@ -268,6 +422,14 @@ static GtSainseq *gt_sainseq_new_from_array(GtUsainindextype *arr,
   {
     sainseq->bucketsize[charidx] = 0;
   }
+#ifdef GT_THREADS_ENABLED
+  numofparts = gt_sain_numofseqparts(sainseq);
+  if (numofparts > 1U)
+  {
+    gt_sain_threaded_countbuckets(sainseq,numofparts);
+    return sainseq;
+  }
+#endif
   for (cptr = arr; cptr < arr + sainseq->totallength; cptr++)
   {
     gt_assert((GtUword) *cptr < numofchars);
@@ -666,10 +828,113 @@ static void gt_sain_induceStypes2fromspecialranges(const GtSainseq *sainseq,
 
 #include "match/sfx-sain.inc"
 
+#ifdef GT_THREADS_ENABLED
+/* the type of <position> only depends on the first character to its right
+   which differs from the character at <position> */
+static bool gt_sain_isStype(const GtSainseq *sainseq,GtUword position,
+                            GtUword *cc)
+{
+  GtUword nextpos;
+
+  *cc = gt_sainseq_getchar(sainseq,position);
+  for (nextpos = position + 1; nextpos < sainseq->totallength; nextpos++)
+  {
+    GtUword nextcc = gt_sainseq_getchar(sainseq,nextpos);
+
+    if (nextcc != *cc)
+    {
+      return *cc < nextcc ? true : false;
+    }
+  }
+  return true;
+}
+
+static void *gt_sain_thread_partSstarsuffixes(void *data)
+{
+  GtSainSeqpart *part = (GtSainSeqpart *) data;
+  const GtSainseq *sainseq = part->sainseq;
+
+  switch (sainseq->seqtype)
+  {
+    case GT_SAIN_PLAINSEQ:
+      gt_sain_PLAINSEQ_partSstarsuffixes(sainseq->seq.plainseq,part);
+      break;
+    case GT_SAIN_ENCSEQ:
+      gt_sain_ENCSEQ_partSstarsuffixes(sainseq->seq.encseq,part);
+      break;
+    case GT_SAIN_INTSEQ:
+      gt_sain_INTSEQ_partSstarsuffixes(sainseq->seq.array,part);
+      break;
+    case GT_SAIN_BARE_ENCSEQ:
+      gt_sain_BARE_ENCSEQ_partSstarsuffixes(sainseq->seq.plainseq,part);
+      break;
+  }
+  return NULL;
+}
+
+/* In a first parallel pass each part counts its Sstar suffixes for each
+   bucket. The parts to the right fill the end of each bucket, so the second
+   parallel pass inserts the Sstar suffixes into the same entries of suftab
+   as the sequential right to left scan does. */
+static GtUword gt_sain_threaded_insertSstarsuffixes(GtSainseq *sainseq,
+                                                    GtUsainindextype *suftab,
+                                                    unsigned int numofparts)
+{
+  GtSainSeqpart *parts = gt_sain_seqparts_new(&numofparts,sainseq);
+  GtUword charidx, countSstartype = 0;
+  unsigned int part;
+
+  for (part = 0; part + 1 < numofparts; part++)
+  {
+    parts[part].nextisStype = gt_sain_isStype(sainseq,parts[part].endpos,
+                                              &parts[part].nextcc);
+  }
+  gt_sain_seqparts_run(parts,numofparts,gt_sain_thread_partSstarsuffixes);
+  gt_sain_endbuckets(sainseq);
+  for (charidx = 0; charidx < sainseq->numofchars; charidx++)
+  {
+    GtUsainindextype fillidx = sainseq->bucketfillptr[charidx];
+
+    for (part = numofparts; part > 0; part--)
+    {
+      GtUsainindextype count = parts[part-1].bucketcount[charidx];
+
+      parts[part-1].bucketcount[charidx] = fillidx;
+      fillidx -= count;
+    }
+    if (sainseq->seqtype != GT_SAIN_INTSEQ)
+    {
+      sainseq->sstarfirstcharcount[charidx]
+        += sainseq->bucketfillptr[charidx] - fillidx;
+    }
+    sainseq->bucketfillptr[charidx] = fillidx;
+  }
+  for (part = 0; part < numofparts; part++)
+  {
+    countSstartype += parts[part].countSstartype;
+    parts[part].suftab = suftab;
+  }
+  gt_sain_seqparts_run(parts,numofparts,gt_sain_thread_partSstarsuffixes);
+  gt_sain_seqparts_delete(parts);
+  gt_assert(GT_MULT2(countSstartype) <= sainseq->totallength);
+  return countSstartype;
+}
+#endif
+
 static GtUword gt_sain_insertSstarsuffixes(GtSainseq *sainseq,
                                            GtUsainindextype *suftab,
                                            GtLogger *logger)
 {
+#ifdef GT_THREADS_ENABLED
+  unsigned int numofparts = gt_sain_numofseqparts(sainseq);
+
+  /* the parallel insertion scans the sequence twice, so it only pays off
+     for more than two parts */
+  if (numofparts > 2U)
+  {
+    return gt_sain_threaded_insertSstarsuffixes(sainseq,suftab,numofparts);
+  }
+#endif
   switch (sainseq->seqtype)
   {
     case GT_SAIN_PLAINSEQ:
@@ -887,18 +1152,296 @@ static GtUword gt_sain_fast_moveSstar2front(
   return namecount;
 }
 
-static void gt_sain_fast_assignSstarnames(GtUword totallength,
+static int gt_sain_compare_Sstarstrings(const GtSainseq *sainseq,
+                                        GtUword start1,
+                                        GtUword start2,
+                                        GtUword len)
+{
+  switch (sainseq->seqtype)
+  {
+    case GT_SAIN_PLAINSEQ:
+      return gt_sain_PLAINSEQ_compare_Sstarstrings(sainseq,
+                                                   sainseq->seq.plainseq,
+                                                   start1,start2,len);
+    case GT_SAIN_ENCSEQ:
+      return gt_sain_ENCSEQ_compare_Sstarstrings(sainseq,
+                                                 sainseq->seq.encseq,
+                                                 start1,start2,len);
+    case GT_SAIN_INTSEQ:
+      return gt_sain_INTSEQ_compare_Sstarstrings(sainseq,
+                                                 sainseq->seq.array,
+                                                 start1,start2,len);
+    case GT_SAIN_BARE_ENCSEQ:
+      return gt_sain_BARE_ENCSEQ_compare_Sstarstrings(sainseq,
+                                                      sainseq->seq.plainseq,
+                                                      start1,start2,len);
+  }
+#ifndef S_SPLINT_S
+  return 0;
+#endif
+}
+
+#ifdef GT_THREADS_ENABLED
+
+/* Naming the sorted Sstar substrings is split into gt_jobs many parts of
+   the sorted Sstar suffixes. In a first parallel pass each part determines
+   which of its entries start a new name, the names of the part are then
+   offset by the number of names in all previous parts. As the positions of
+   the Sstar suffixes differ by at least 2, each thread writes to its own
+   addresses in the second half of suftab. */
+
+typedef struct
+{
+  const GtSainseq *sainseq;
+  const GtUsainindextype *suftab;
+  GtUsainindextype *secondhalf;
+  GtBitsequence *newnametab;
+  GtUword startidx, endidx, countnames, firstname, numberofnames;
+  GtThread *thread;
+} GtSainNamingpart;
+
+static unsigned int gt_sain_numofnamingparts(GtUword countSstartype)
+{
+  GtUword maxparts = countSstartype/GT_SAIN_MINPARTWIDTH;
+
+  return maxparts < (GtUword) gt_jobs ? (unsigned int) maxparts : gt_jobs;
+}
+
+static GtSainNamingpart *gt_sain_namingparts_new(unsigned int *numofparts,
+                                                 const GtSainseq *sainseq,
+                                                 GtUword countSstartype,
+                                                 GtUsainindextype *suftab)
+{
+  GtUword width, startidx = 0;
+  unsigned int part;
+  GtSainNamingpart *parts;
+
+  gt_assert(*numofparts > 1U);
+  /* the parts start at multiples of the word size, so that no two threads
+     update the same unit of the bit table */
+  width = (countSstartype + *numofparts - 1)/(*numofparts);
+  width = GT_DIVWORDSIZE(width + GT_INTWORDSIZE - 1) * GT_INTWORDSIZE;
+  parts = gt_malloc(sizeof *parts * (*numofparts));
+  for (part = 0; part < *numofparts && startidx < countSstartype; part++)
+  {
+    parts[part].sainseq = sainseq;
+    parts[part].suftab = suftab;
+    parts[part].secondhalf = suftab + countSstartype;
+    parts[part].newnametab = NULL;
+    parts[part].startidx = startidx;
+    parts[part].endidx = GT_MIN(startidx + width,countSstartype);
+    parts[part].countnames = parts[part].firstname = 0;
+    parts[part].numberofnames = 0;
+    parts[part].thread = NULL;
+    startidx = parts[part].endidx;
+  }
+  *numofparts = part;
+  return parts;
+}
+
+static void gt_sain_namingparts_run(GtSainNamingpart *parts,
+                                    unsigned int numofparts,
+                                    GtThreadFunc function)
+{
+  unsigned int part;
+  bool haserr = false;
+
+  for (part = 0; part < numofparts; part++)
+  {
+    parts[part].thread = gt_thread_new(function,parts + part,NULL);
+    if (parts[part].thread == NULL)
+    {
+      haserr = true;
+      break;
+    }
+  }
+  for (part = 0; part < numofparts; part++)
+  {
+    if (parts[part].thread != NULL)
+    {
+      gt_thread_join(parts[part].thread);
+      gt_thread_delete(parts[part].thread);
+      parts[part].thread = NULL;
+    }
+  }
+  gt_assert(!haserr);
+}
+
+static void *gt_sain_thread_markSstarnames(void *data)
+{
+  GtSainNamingpart *part = (GtSainNamingpart *) data;
+  GtUword idx;
+
+  part->countnames = 0;
+  for (idx = part->startidx; idx < part->endidx; idx++)
+  {
+    bool newname = true;
+
+    if (idx > 0)
+    {
+      GtUsainindextype previouspos = part->suftab[idx-1],
+                       position = part->suftab[idx];
+      GtUword previouslen = (GtUword) part->secondhalf[GT_DIV2(previouspos)],
+              currentlen = (GtUword) part->secondhalf[GT_DIV2(position)];
+
+      if (previouslen == currentlen)
+      {
+        int cmp = gt_sain_compare_Sstarstrings(part->sainseq,
+                                               (GtUword) previouspos,
+                                               (GtUword) position,
+                                               currentlen);
+        gt_assert(cmp != 1);
+        newname = cmp == -1 ? true : false;
+      }
+    }
+    if (newname)
+    {
+      GT_SETIBIT(part->newnametab,idx);
+      part->countnames++;
+    }
+  }
+  return NULL;
+}
+
+static void *gt_sain_thread_writeSstarnames(void *data)
+{
+  GtSainNamingpart *part = (GtSainNamingpart *) data;
+  GtUword idx, currentname = part->firstname;
+
+  for (idx = part->startidx; idx < part->endidx; idx++)
+  {
+    if (GT_ISIBITSET(part->newnametab,idx))
+    {
+      currentname++;
+    }
+    part->secondhalf[GT_DIV2(part->suftab[idx])]
+      = (GtUsainindextype) currentname;
+  }
+  return NULL;
+}
+
+static GtUword gt_sain_threaded_assignSstarnames(const GtSainseq *sainseq,
+                                                 GtUword countSstartype,
+                                                 GtUsainindextype *suftab,
+                                                 unsigned int numofparts)
+{
+  GtSainNamingpart *parts;
+  GtBitsequence *newnametab;
+  GtUword numberofnames = 0;
+  unsigned int part;
+
+  parts = gt_sain_namingparts_new(&numofparts,sainseq,countSstartype,suftab);
+  GT_INITBITTAB(newnametab,countSstartype);
+  for (part = 0; part < numofparts; part++)
+  {
+    parts[part].newnametab = newnametab;
+  }
+  /* all lengths must be read before the first name is written */
+  gt_sain_namingparts_run(parts,numofparts,gt_sain_thread_markSstarnames);
+  for (part = 0; part < numofparts; part++)
+  {
+    parts[part].firstname = numberofnames;
+    numberofnames += parts[part].countnames;
+  }
+  gt_sain_namingparts_run(parts,numofparts,gt_sain_thread_writeSstarnames);
+  gt_free(newnametab);
+  gt_free(parts);
+  return numberofnames;
+}
+
+static void *gt_sain_thread_countSstarnames(void *data)
+{
+  GtSainNamingpart *part = (GtSainNamingpart *) data;
+  GtUword idx, totallength = part->sainseq->totallength;
+
+  part->countnames = 0;
+  for (idx = part->startidx; idx < part->endidx; idx++)
+  {
+    if (part->suftab[idx] >= (GtUsainindextype) totallength)
+    {
+      part->countnames++;
+    }
+  }
+  return NULL;
+}
+
+static void *gt_sain_thread_fast_writeSstarnames(void *data)
+{
+  GtSainNamingpart *part = (GtSainNamingpart *) data;
+  GtUword idx, currentname = part->firstname,
+          totallength = part->sainseq->totallength;
+
+  for (idx = part->endidx; idx > part->startidx; idx--)
+  {
+    GtUsainindextype position = part->suftab[idx-1];
+
+    if (position >= (GtUsainindextype) totallength)
+    {
+      position -= totallength;
+      gt_assert(currentname > 0);
+      currentname--;
+    }
+    if (currentname <= part->numberofnames)
+    {
+      part->secondhalf[GT_DIV2(position)] = (GtUsainindextype) currentname;
+    }
+  }
+  return NULL;
+}
+
+/* In the fast method the first suffix of each name is marked by adding
+   totallength, so the names of a part only depend on the number of marked
+   suffixes in the parts to its right. */
+static void gt_sain_threaded_fast_assignSstarnames(const GtSainseq *sainseq,
+                                                   GtUword countSstartype,
+                                                   GtUsainindextype *suftab,
+                                                   GtUword numberofnames,
+                                                   unsigned int numofparts)
+{
+  GtSainNamingpart *parts;
+  GtUword currentname = numberofnames;
+  unsigned int part;
+
+  parts = gt_sain_namingparts_new(&numofparts,sainseq,countSstartype,suftab);
+  gt_sain_namingparts_run(parts,numofparts,gt_sain_thread_countSstarnames);
+  for (part = numofparts; part > 0; part--)
+  {
+    parts[part-1].firstname = currentname + 1;
+    parts[part-1].numberofnames = numberofnames;
+    gt_assert(currentname >= parts[part-1].countnames);
+    currentname -= parts[part-1].countnames;
+  }
+  gt_assert(currentname == 0);
+  gt_sain_namingparts_run(parts,numofparts,
+                          gt_sain_thread_fast_writeSstarnames);
+  gt_free(parts);
+}
+#endif
+
+static void gt_sain_fast_assignSstarnames(const GtSainseq *sainseq,
                                           GtUword countSstartype,
                                           GtUsainindextype *suftab,
                                           GtUword numberofnames,
                                           GtUword nonspecialentries)
 {
+  GtUword totallength = sainseq->totallength;
   GtUsainindextype *suftabptr, *secondhalf = suftab + countSstartype;
 
   if ((GtUword) numberofnames < countSstartype)
   {
     GtUword currentname = numberofnames + 1;
 
+#ifdef GT_THREADS_ENABLED
+    unsigned int numofparts = gt_sain_numofnamingparts(countSstartype);
+
+    if (numofparts > 1U)
+    {
+      gt_sain_threaded_fast_assignSstarnames(sainseq,countSstartype,suftab,
+                                             numberofnames,numofparts);
+      return;
+    }
+#endif
+
     for (suftabptr = suftab + nonspecialentries - 1; suftabptr >= suftab;
          suftabptr--)
     {
@@ -1129,6 +1672,15 @@ static GtUword gt_sain_assignSstarnames(const GtSainseq *sainseq,
                    previouspos;
   GtUword previouslen, currentname = 1UL;
 
+#ifdef GT_THREADS_ENABLED
+  unsigned int numofparts = gt_sain_numofnamingparts(countSstartype);
+
+  if (numofparts > 1U)
+  {
+    return gt_sain_threaded_assignSstarnames(sainseq,countSstartype,suftab,
+                                             numofparts);
+  }
+#endif
   previouspos = suftab[0];
   previouslen = (GtUword) secondhalf[GT_DIV2(previouspos)];
   secondhalf[GT_DIV2(previouspos)] = (GtUsainindextype) currentname;
@@ -1142,37 +1694,10 @@ static GtUword gt_sain_assignSstarnames(const GtSainseq *sainseq,
     currentlen = (GtUword) secondhalf[GT_DIV2(position)];
     if (previouslen == currentlen)
     {
-      switch (sainseq->seqtype)
-      {
-        case GT_SAIN_PLAINSEQ:
-          cmp = gt_sain_PLAINSEQ_compare_Sstarstrings(sainseq,
-                                                      sainseq->seq.plainseq,
-                                                      (GtUword) previouspos,
-                                                      (GtUword) position,
-                                                      currentlen);
-          break;
-        case GT_SAIN_ENCSEQ:
-          cmp = gt_sain_ENCSEQ_compare_Sstarstrings(sainseq,
-                                                    sainseq->seq.encseq,
-                                                    (GtUword) previouspos,
-                                                    (GtUword) position,
-                                                    currentlen);
-          break;
-        case GT_SAIN_INTSEQ:
-          cmp = gt_sain_INTSEQ_compare_Sstarstrings(sainseq,
-                                                    sainseq->seq.array,
-                                                    (GtUword) previouspos,
-                                                    (GtUword) position,
-                                                    currentlen);
-          break;
-        case GT_SAIN_BARE_ENCSEQ:
-          cmp = gt_sain_BARE_ENCSEQ_compare_Sstarstrings(sainseq,
-                                                         sainseq->seq.plainseq,
-                                                         (GtUword) previouspos,
-                                                         (GtUword) position,
-                                                         currentlen);
-          break;
-      }
+      cmp = gt_sain_compare_Sstarstrings(sainseq,
+                                         (GtUword) previouspos,
+                                         (GtUword) position,
+                                         currentlen);
       gt_assert(cmp != 1);
     } else
     {
@@ -1441,7 +1966,7 @@ static void gt_sain_rec_sortsuffixes(unsigned int level,
         sainseq->roundtable = NULL;
       }
       GT_SAIN_SHOWTIMER("fast assignSstarnames");
-      gt_sain_fast_assignSstarnames(sainseq->totallength,countSstartype,
+      gt_sain_fast_assignSstarnames(sainseq,countSstartype,
                                     suftab,numberofnames,nonspecialentries);
     }
     gt_assert(numberofnames <= countSstartype);
@@ -477,18 +477,12 @@ void gt_suffixsortspace_to_file (FILE *outfpsuftab,
 }
 
 void gt_suffixsortspace_compressed_to_file (const GtSuffixsortspace *sssp,
-                                            GtBitbuffer *bb,
-                                            GtUword numberofsuffixes)
+                                     GtSuftabcompressedWriter *writer,
+                                     GtUword numberofsuffixes)
 {
   gt_assert(sssp != NULL);
-  if (sssp->ulongtab != NULL)
-  {
-    gt_bitbuffer_write_ulongtab_FILE(bb,sssp->ulongtab,numberofsuffixes);
-  } else
-  {
-    gt_assert (sssp->uinttab != NULL);
-    gt_bitbuffer_write_uint32tab_FILE(bb,sssp->uinttab,numberofsuffixes);
-  }
+  gt_suftabcompressed_writer_add(writer,sssp->ulongtab,sssp->uinttab,
+                                 numberofsuffixes);
 }
 
 static GtUword gt_suffixsortspace_insertfullspecialrange(
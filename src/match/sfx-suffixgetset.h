@@ -24,7 +24,7 @@
 #include "core/error_api.h"
 #include "core/encseq_api.h"
 #include "core/encseq.h"
-#include "core/bitbuffer.h"
+#include "match/esa-sufcompressed.h"
 
 #define GT_SUFFIXSORTSPACE_EXPORT_SET(SSSP,EXPORTPTR,INDEX,POS)\
         if ((EXPORTPTR)->ulongtabsectionptr != NULL)\
@@ -151,8 +151,8 @@ void gt_suffixsortspace_to_file (FILE *outfpsuftab,
                                  GtUword numberofsuffixes);
 
 void gt_suffixsortspace_compressed_to_file (const GtSuffixsortspace *sssp,
-                                            GtBitbuffer *bb,
-                                            GtUword numberofsuffixes);
+                                     GtSuftabcompressedWriter *writer,
+                                     GtUword numberofsuffixes);
 
 typedef struct GtSSSPbuf GtSSSPbuf;
 
@@ -43,7 +43,12 @@ typedef struct
               outlcp,
               outllv;
   GtUword currentlcpindex,
+         numofsuffixes,
+         longest,
+         numoflargelcpvalues,
+         maxbranchdepth,
          absstartpostable[SIZEOFMERGERESULTBUFFER];
+  double lcptabsum;
 } Mergeoutinfo;
 
 static int initNameandFILE(NameandFILE *nf,
@@ -87,7 +92,12 @@ static int outputsuflcpllv(void *processinfo,
     mergeoutinfo->absstartpostable[i]
       = sequenceoffsettable[buf->suftabstore[i].idx] +
         buf->suftabstore[i].startpos;
+    if (mergeoutinfo->absstartpostable[i] == 0)
+    {
+      mergeoutinfo->longest = mergeoutinfo->numofsuffixes + i;
+    }
   }
+  mergeoutinfo->numofsuffixes += buf->nextstoreidx;
   gt_xfwrite(mergeoutinfo->absstartpostable, sizeof (GtUword),
             (size_t) buf->nextstoreidx, mergeoutinfo->outsuf.fp);
   if (!haserr)
@@ -112,7 +122,13 @@ static int outputsuflcpllv(void *processinfo,
         gt_xfwrite(&currentexception,sizeof (Largelcpvalue), (size_t) 1,
                    mergeoutinfo->outllv.fp);
         smallvalue = (GtUchar) LCPOVERFLOW;
+        mergeoutinfo->numoflargelcpvalues++;
       }
+      if (mergeoutinfo->maxbranchdepth < lcpvalue)
+      {
+        mergeoutinfo->maxbranchdepth = lcpvalue;
+      }
+      mergeoutinfo->lcptabsum += (double) lcpvalue;
       gt_xfwrite(&smallvalue,sizeof (GtUchar),(size_t) 1,
                  mergeoutinfo->outlcp.fp);
       mergeoutinfo->currentlcpindex++;
@@ -123,6 +139,7 @@ static int outputsuflcpllv(void *processinfo,
 
 static int mergeandstoreindex(const GtStr *storeindex,
                               Emissionmergedesa *emmesa,
+                              GtMergeesaStats *mergestats,
                               GtError *err)
 {
   Mergeoutinfo mergeoutinfo;
@@ -166,6 +183,11 @@ static int mergeandstoreindex(const GtStr *storeindex,
   if (!haserr)
   {
     mergeoutinfo.currentlcpindex = (GtUword) 1;
+    mergeoutinfo.numofsuffixes = 0;
+    mergeoutinfo.longest = 0;
+    mergeoutinfo.numoflargelcpvalues = 0;
+    mergeoutinfo.maxbranchdepth = 0;
+    mergeoutinfo.lcptabsum = 0.0;
     sequenceoffsettable = gt_encseqtable2sequenceoffsets(&totallength,
                                                       &specialcharinfo,
                                                       emmesa->suffixarraytable,
@@ -190,6 +212,14 @@ static int mergeandstoreindex(const GtStr *storeindex,
     }
     gt_free(sequenceoffsettable);
   }
+  if (!haserr && mergestats != NULL)
+  {
+    mergestats->numoflargelcpvalues = mergeoutinfo.numoflargelcpvalues;
+    mergestats->maxbranchdepth = mergeoutinfo.maxbranchdepth;
+    mergestats->lcptabsum = mergeoutinfo.lcptabsum;
+    mergestats->numofsuffixes = mergeoutinfo.numofsuffixes;
+    mergestats->longest = mergeoutinfo.longest;
+  }
   freeNameandFILE(&mergeoutinfo.outsuf);
   freeNameandFILE(&mergeoutinfo.outlcp);
   freeNameandFILE(&mergeoutinfo.outllv);
@@ -200,6 +230,16 @@ int gt_performtheindexmerging(const GtStr *storeindex,
                            const GtStrArray *indexnametab,
                            GtLogger *logger,
                            GtError *err)
+{
+  return gt_performtheindexmerging_stats(storeindex,indexnametab,NULL,
+                                         logger,err);
+}
+
+int gt_performtheindexmerging_stats(const GtStr *storeindex,
+                                    const GtStrArray *indexnametab,
+                                    GtMergeesaStats *mergestats,
+                                    GtLogger *logger,
+                                    GtError *err)
 {
   Emissionmergedesa emmesa;
   unsigned int demand = SARR_ESQTAB | SARR_SUFTAB | SARR_LCPTAB;
@@ -218,7 +258,7 @@ int gt_performtheindexmerging(const GtStr *storeindex,
   {
     if (gt_str_array_size(indexnametab) > 1UL)
     {
-      if (mergeandstoreindex(storeindex,&emmesa,err) != 0)
+      if (mergeandstoreindex(storeindex,&emmesa,mergestats,err) != 0)
       {
         haserr = true;
       }
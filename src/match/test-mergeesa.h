@@ -23,9 +23,28 @@
 #include "core/logger_api.h"
 #include "core/error_api.h"
 
+typedef struct
+{
+  GtUword numofsuffixes,
+          longest,
+          numoflargelcpvalues,
+          maxbranchdepth;
+  double lcptabsum;
+} GtMergeesaStats;
+
 int gt_performtheindexmerging(const GtStr *storeindex,
                               const GtStrArray *indexnametab,
                               GtLogger *logger,
                               GtError *err);
 
+/* Like <gt_performtheindexmerging>, but additionally stores the number of
+   merged suffixes, the position of the suffix starting at position 0 and the
+   statistics of the merged lcp table, which are required for the .prj file,
+   in <mergestats>, if it is not NULL. */
+int gt_performtheindexmerging_stats(const GtStr *storeindex,
+                                    const GtStrArray *indexnametab,
+                                    GtMergeesaStats *mergestats,
+                                    GtLogger *logger,
+                                    GtError *err);
+
 #endif
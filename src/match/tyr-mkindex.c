@@ -23,6 +23,7 @@
 #include "core/logger.h"
 #include "core/spacecalc.h"
 #include "core/str_api.h"
+#include "core/thread_api.h"
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
 #include "core/ma_api.h"
@@ -511,6 +512,300 @@ static void outputbytewiseUlongvalue(FILE *fpout,GtUword value)
   }
 }
 
+/* the suffixes <firstsuffix>..<nextsuffix>-1 of a mapped suffix array,
+   whose mers are counted independently of the other parts. <state> is a
+   copy of the global state with its own buffers and output files. */
+typedef struct
+{
+  TyrDfsstate state;
+  const Suffixarray *suffixarray;
+  GtUword firstsuffix,
+          nextsuffix;
+  GtError *err;
+  bool haserr;
+  GtThread *thread;
+} TyrCountpart;
+
+static bool tyr_lcpatleast(const Suffixarray *suffixarray,GtUword pos,
+                           GtUword mersize)
+{
+  GtUchar smalllcpvalue = suffixarray->lcptab[pos];
+
+  if (smalllcpvalue != (GtUchar) LCPOVERFLOW)
+  {
+    return (GtUword) smalllcpvalue >= mersize ? true : false;
+  }
+  return (mersize <= (GtUword) LCPOVERFLOW ||
+          lcptable_get(suffixarray,pos) >= mersize) ? true : false;
+}
+
+/* a part can only begin with a suffix which has no common prefix of length
+   mersize with its predecessor, so that each mer is counted in one part */
+static unsigned int tyr_countmers_partition(GtUword *partstarts,
+                                            const Suffixarray *suffixarray,
+                                            GtUword nonspecials,
+                                            GtUword mersize,
+                                            unsigned int numofparts)
+{
+  unsigned int part, numofsplits = 0;
+
+  partstarts[numofsplits++] = 0;
+  for (part = 1U; part < numofparts; part++)
+  {
+    GtUword pos = (GtUword) part * nonspecials/numofparts;
+
+    if (pos <= partstarts[numofsplits-1])
+    {
+      pos = partstarts[numofsplits-1] + 1;
+    }
+    while (pos < nonspecials && tyr_lcpatleast(suffixarray,pos,mersize))
+    {
+      pos++;
+    }
+    if (pos >= nonspecials)
+    {
+      break;
+    }
+    partstarts[numofsplits++] = pos;
+  }
+  partstarts[numofsplits] = nonspecials;
+  return numofsplits;
+}
+
+/* each maximal run of suffixes with pairwise lcp >= mersize corresponds to
+   an lcp-interval reported by tyr_processcompletenode and each remaining
+   suffix to a leaf reported by tyr_processleafedge. Runs are reported in
+   the order of the depth first traversal. */
+static void *tyr_countmers_part(void *data)
+{
+  TyrCountpart *part = (TyrCountpart *) data;
+  TyrDfsstate *state = &part->state;
+  GtUword idx = part->firstsuffix, right, position;
+
+  while (idx < part->nextsuffix)
+  {
+    right = idx;
+    while (right + 1 < part->nextsuffix &&
+           tyr_lcpatleast(part->suffixarray,right + 1,state->mersize))
+    {
+      right++;
+    }
+    position = gt_suffixarray_suftab_get(part->suffixarray,right);
+    if (right > idx ||
+        (position + state->mersize <= state->totallength &&
+         !gt_encseq_contains_special(state->encseq,
+                                     state->readmode,
+                                     state->esrspace,
+                                     position,
+                                     state->mersize)))
+    {
+      if (state->processoccurrencecount(right - idx + 1,position,state,
+                                        part->err) != 0)
+      {
+        part->haserr = true;
+        break;
+      }
+    }
+    idx = right + 1;
+  }
+  return NULL;
+}
+
+static void tyr_countpart_init(TyrCountpart *part,
+                               const TyrDfsstate *state,
+                               const Suffixarray *suffixarray,
+                               GtUword firstsuffix,
+                               GtUword nextsuffix)
+{
+  part->state = *state;
+  GT_INITARRAY(&part->state.occdistribution,Countwithpositions);
+  GT_INITARRAY(&part->state.largecounts,Largecount);
+  part->state.countoutputmers = 0;
+  part->state.esrspace
+    = gt_encseq_create_reader_with_readmode(state->encseq,state->readmode,0);
+  part->state.bytebuffer
+    = state->bytebuffer == NULL ? NULL
+                                : gt_malloc(sizeof *state->bytebuffer *
+                                            state->sizeofbuffer);
+  part->state.currentmer
+    = state->currentmer == NULL ? NULL
+                                : gt_malloc(sizeof *state->currentmer *
+                                            state->mersize);
+  part->state.merindexfpout
+    = state->merindexfpout == NULL
+        ? NULL
+        : gt_xtmpfp_generic(NULL,GT_TMPFP_OPENBINARY | GT_TMPFP_AUTOREMOVE);
+  part->state.countsfilefpout
+    = state->countsfilefpout == NULL
+        ? NULL
+        : gt_xtmpfp_generic(NULL,GT_TMPFP_OPENBINARY | GT_TMPFP_AUTOREMOVE);
+  part->suffixarray = suffixarray;
+  part->firstsuffix = firstsuffix;
+  part->nextsuffix = nextsuffix;
+  part->err = gt_error_new();
+  part->haserr = false;
+  part->thread = NULL;
+}
+
+static void tyr_copytmpfile(FILE *outfp,FILE *tmpfp)
+{
+  char buffer[BUFSIZ];
+  size_t len;
+
+  rewind(tmpfp);
+  while ((len = gt_xfread(buffer,sizeof (char),sizeof buffer,tmpfp)) > 0)
+  {
+    gt_xfwrite(buffer,sizeof (char),len,outfp);
+  }
+}
+
+/* appends the output of <part> to the output of <state>, which contains the
+   output of all previous parts */
+static void tyr_countpart_merge(TyrDfsstate *state,TyrDfsstate *partstate)
+{
+  GtUword idx;
+
+  if (state->merindexfpout != NULL)
+  {
+    tyr_copytmpfile(state->merindexfpout,partstate->merindexfpout);
+  }
+  if (state->countsfilefpout != NULL)
+  {
+    tyr_copytmpfile(state->countsfilefpout,partstate->countsfilefpout);
+  }
+  for (idx = 0; idx < partstate->largecounts.nextfreeLargecount; idx++)
+  {
+    Largecount *lc;
+
+    GT_GETNEXTFREEINARRAY(lc,&state->largecounts,Largecount,32);
+    lc->idx = state->countoutputmers +
+              partstate->largecounts.spaceLargecount[idx].idx;
+    lc->value = partstate->largecounts.spaceLargecount[idx].value;
+  }
+  state->countoutputmers += partstate->countoutputmers;
+  /* the positions are prepended to the lists, so the positions of a later
+     part precede those of the previous parts */
+  for (idx = 0; idx < partstate->occdistribution.nextfreeCountwithpositions;
+       idx++)
+  {
+    Countwithpositions *partcwp
+      = partstate->occdistribution.spaceCountwithpositions + idx;
+
+    if (partcwp->occcount > 0)
+    {
+      Countwithpositions *cwp;
+
+      incrementdistribcounts(&state->occdistribution,idx,partcwp->occcount);
+      cwp = state->occdistribution.spaceCountwithpositions + idx;
+      if (partcwp->positionlist != NULL)
+      {
+        ListUlong *tail = partcwp->positionlist;
+
+        while (tail->nextptr != NULL)
+        {
+          tail = tail->nextptr;
+        }
+        tail->nextptr = cwp->positionlist;
+        cwp->positionlist = partcwp->positionlist;
+        partcwp->positionlist = NULL;
+      }
+    }
+  }
+}
+
+static void tyr_countpart_delete(TyrCountpart *part)
+{
+  gt_fa_xfclose(part->state.merindexfpout);
+  gt_fa_xfclose(part->state.countsfilefpout);
+  GT_FREEARRAY(&part->state.occdistribution,Countwithpositions);
+  GT_FREEARRAY(&part->state.largecounts,Largecount);
+  gt_free(part->state.bytebuffer);
+  gt_free(part->state.currentmer);
+  gt_encseq_reader_delete(part->state.esrspace);
+  gt_error_delete(part->err);
+}
+
+/* counts the mers of the nonspecial suffixes in <numofthreads> parts of the
+   mapped suffix array in parallel, with the same result as the depth first
+   traversal */
+static int tyr_countmers_parallel(TyrDfsstate *state,
+                                  const Sequentialsuffixarrayreader *ssar,
+                                  unsigned int numofthreads,
+                                  GtLogger *logger,
+                                  GtError *err)
+{
+  const Suffixarray *suffixarray
+    = gt_suffixarraySequentialsuffixarrayreader(ssar);
+  TyrCountpart *parts;
+  GtUword *partstarts;
+  unsigned int part, numofparts;
+  bool haserr = false;
+
+  gt_assert(numofthreads > 1U);
+  partstarts = gt_malloc(sizeof *partstarts * (numofthreads + 1));
+  numofparts = tyr_countmers_partition(partstarts,
+                                       suffixarray,
+                                       gt_Sequentialsuffixarrayreader_nonspecials(
+                                                                        ssar),
+                                       state->mersize,
+                                       numofthreads);
+  gt_logger_log(logger,"count mers in %u parts",numofparts);
+  parts = gt_malloc(sizeof *parts * numofparts);
+  for (part = 0; part < numofparts; part++)
+  {
+    tyr_countpart_init(parts + part,state,suffixarray,partstarts[part],
+                       partstarts[part+1]);
+  }
+#ifdef GT_THREADS_ENABLED
+  if (numofparts == 1U)
+  {
+    (void) tyr_countmers_part(parts);
+  } else
+  {
+    for (part = 0; part < numofparts; part++)
+    {
+      parts[part].thread = gt_thread_new(tyr_countmers_part,parts + part,err);
+      if (parts[part].thread == NULL)
+      {
+        haserr = true;
+        break;
+      }
+    }
+    for (part = 0; part < numofparts; part++)
+    {
+      if (parts[part].thread != NULL)
+      {
+        gt_thread_join(parts[part].thread);
+        gt_thread_delete(parts[part].thread);
+      }
+    }
+  }
+#else
+  for (part = 0; part < numofparts; part++)
+  {
+    (void) tyr_countmers_part(parts + part);
+  }
+#endif
+  for (part = 0; part < numofparts; part++)
+  {
+    if (!haserr)
+    {
+      if (parts[part].haserr)
+      {
+        gt_error_set(err,"%s",gt_error_get(parts[part].err));
+        haserr = true;
+      } else
+      {
+        tyr_countpart_merge(state,&parts[part].state);
+      }
+    }
+    tyr_countpart_delete(parts + part);
+  }
+  gt_free(parts);
+  gt_free(partstarts);
+  return haserr ? -1 : 0;
+}
+
 static int enumeratelcpintervals(const char *inputindex,
                                  Sequentialsuffixarrayreader *ssar,
                                  const char *storeindex,
@@ -519,6 +814,7 @@ static int enumeratelcpintervals(const char *inputindex,
                                  GtUword minocc,
                                  GtUword maxocc,
                                  bool performtest,
+                                 unsigned int numofthreads,
                                  GtLogger *logger,
                                  GtError *err)
 {
@@ -600,17 +896,26 @@ static int enumeratelcpintervals(const char *inputindex,
     }
     if (!haserr)
     {
-      if (gt_depthfirstesa(ssar,
-                          tyr_allocateDfsinfo,
-                          tyr_freeDfsinfo,
-                          tyr_processleafedge,
-                          NULL,
-                          tyr_processcompletenode,
-                          tyr_assignleftmostleaf,
-                          tyr_assignrightmostleaf,
-                          (Dfsstate*) state,
-                          logger,
-                          err) != 0)
+      int retval;
+
+      if (numofthreads > 1U && !ssar->scanfile)
+      {
+        retval = tyr_countmers_parallel(state,ssar,numofthreads,logger,err);
+      } else
+      {
+        retval = gt_depthfirstesa(ssar,
+                                  tyr_allocateDfsinfo,
+                                  tyr_freeDfsinfo,
+                                  tyr_processleafedge,
+                                  NULL,
+                                  tyr_processcompletenode,
+                                  tyr_assignleftmostleaf,
+                                  tyr_assignrightmostleaf,
+                                  (Dfsstate*) state,
+                                  logger,
+                                  err);
+      }
+      if (retval != 0)
       {
         haserr = true;
       }
@@ -670,6 +975,7 @@ int gt_merstatistics(const char *inputindex,
                   bool storecounts,
                   bool scanfile,
                   bool performtest,
+                  unsigned int numofthreads,
                   GtLogger *logger,
                   GtError *err)
 {
@@ -680,7 +986,9 @@ int gt_merstatistics(const char *inputindex,
   ssar = gt_newSequentialsuffixarrayreaderfromfile(inputindex,
                                                 SARR_LCPTAB |
                                                 SARR_SUFTAB |
-                                                SARR_ESQTAB,
+                                                SARR_ESQTAB |
+                                                (performtest
+                                                  ? 0 : SARR_SUFCOMPRESSED),
                                                 (scanfile && !performtest)
                                                   ? true : false,
                                                 logger,
@@ -699,6 +1007,7 @@ int gt_merstatistics(const char *inputindex,
                               minocc,
                               maxocc,
                               performtest,
+                              numofthreads,
                               logger,
                               err) != 0)
     {
@@ -23,6 +23,9 @@
 #include "core/error_api.h"
 #include "core/logger.h"
 
+/* if <numofthreads> > 1 and the suffix array is mapped (i.e. <scanfile> is
+   false or <performtest> is true), the mers are counted in <numofthreads>
+   parts of the suffix array in parallel */
 int gt_merstatistics(const char *inputindex,
                      GtUword mersize,
                      GtUword minocc,
@@ -31,6 +34,7 @@ int gt_merstatistics(const char *inputindex,
                      bool storecounts,
                      bool scanfile,
                      bool performtest,
+                     unsigned int numofthreads,
                      GtLogger *logger,
                      GtError *err);
 
@@ -15,6 +15,7 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/alphabet.h"
 #include "core/fa_api.h"
 #include "core/unused_api.h"
@@ -23,6 +24,7 @@
 #include "core/format64.h"
 #include "core/encseq.h"
 #include "core/ma_api.h"
+#include "core/qsort_r_api.h"
 #include "revcompl.h"
 #include "tyr-map.h"
 #include "tyr-search.h"
@@ -212,10 +214,230 @@ static void singleseqtyrsearch(const Tyrindex *tyrindex,
   }
 }
 
+/* the mers of a query sequence in the order in which they are output by
+   singleseqtyrsearch; the i-th mer has the bytecode
+   bytecodes[i * merbytes..(i+1) * merbytes - 1] */
+typedef struct
+{
+  GtUword qpos;
+  bool forward;
+  const GtUchar *result;
+} Tyrbatchmer;
+
+typedef struct
+{
+  GtUchar *bytecodes;
+  Tyrbatchmer *mers;
+  GtUword *order,
+          merbytes,
+          nextfree,
+          allocated;
+} Tyrmerbatch;
+
+static void gt_tyrmerbatch_init(Tyrmerbatch *merbatch,GtUword merbytes)
+{
+  merbatch->bytecodes = NULL;
+  merbatch->mers = NULL;
+  merbatch->order = NULL;
+  merbatch->merbytes = merbytes;
+  merbatch->nextfree = merbatch->allocated = 0;
+}
+
+static void gt_tyrmerbatch_delete(Tyrmerbatch *merbatch)
+{
+  gt_free(merbatch->bytecodes);
+  gt_free(merbatch->mers);
+  gt_free(merbatch->order);
+}
+
+static void gt_tyrmerbatch_add(Tyrmerbatch *merbatch,
+                               const GtUchar *qptr,
+                               GtUword mersize,
+                               GtUword qpos,
+                               bool forward)
+{
+  if (merbatch->nextfree >= merbatch->allocated)
+  {
+    merbatch->allocated = (GtUword) (merbatch->allocated * 1.2) + 1024;
+    merbatch->bytecodes = gt_realloc(merbatch->bytecodes,
+                                     sizeof *merbatch->bytecodes *
+                                     merbatch->merbytes * merbatch->allocated);
+    merbatch->mers = gt_realloc(merbatch->mers,
+                                sizeof *merbatch->mers * merbatch->allocated);
+    merbatch->order = gt_realloc(merbatch->order,
+                                 sizeof *merbatch->order *
+                                 merbatch->allocated);
+  }
+  gt_encseq_plainseq2bytecode(merbatch->bytecodes +
+                              merbatch->nextfree * merbatch->merbytes,
+                              qptr,mersize);
+  merbatch->mers[merbatch->nextfree].qpos = qpos;
+  merbatch->mers[merbatch->nextfree].forward = forward;
+  merbatch->mers[merbatch->nextfree].result = NULL;
+  merbatch->order[merbatch->nextfree] = merbatch->nextfree;
+  merbatch->nextfree++;
+}
+
+static int gt_tyrmerbatch_cmp(const void *a,const void *b,void *data)
+{
+  const Tyrmerbatch *merbatch = (const Tyrmerbatch *) data;
+
+  return memcmp(merbatch->bytecodes +
+                  *(const GtUword *) a * merbatch->merbytes,
+                merbatch->bytecodes +
+                  *(const GtUword *) b * merbatch->merbytes,
+                (size_t) merbatch->merbytes);
+}
+
+#define TYRMER(IDX) (mertable + (IDX) * merbytes)
+
+/* returns the smallest index >= <left> of a mer in <mertable> which is not
+   smaller than <key>, or <numofmers> if there is no such mer. The search
+   doubles the distance from <left> before searching binary, so that the
+   cost is logarithmic in the distance to the result */
+static GtUword gt_tyrmerbatch_lowerbound(const GtUchar *mertable,
+                                         GtUword numofmers,
+                                         GtUword merbytes,
+                                         GtUword left,
+                                         const GtUchar *key)
+{
+  GtUword right, step = 1UL;
+
+  if (left >= numofmers ||
+      memcmp(TYRMER(left),key,(size_t) merbytes) >= 0)
+  {
+    return left;
+  }
+  right = left + 1;
+  while (right < numofmers &&
+         memcmp(TYRMER(right),key,(size_t) merbytes) < 0)
+  {
+    left = right;
+    step *= 2;
+    right = left + step;
+  }
+  if (right > numofmers)
+  {
+    right = numofmers;
+  }
+  /* TYRMER(left) < key <= TYRMER(right) */
+  while (left + 1 < right)
+  {
+    GtUword mid = left + (right - left)/2;
+
+    if (memcmp(TYRMER(mid),key,(size_t) merbytes) < 0)
+    {
+      left = mid;
+    } else
+    {
+      right = mid;
+    }
+  }
+  return right;
+}
+
+/* sorts the mers of <merbatch> and determines their position in the index
+   by a single merge-like pass over the sorted mer table */
+static void gt_tyrmerbatch_search(Tyrmerbatch *merbatch,
+                                  const Tyrindex *tyrindex)
+{
+  const GtUchar *mertable = gt_tyrindex_mertable(tyrindex);
+  const GtUword merbytes = merbatch->merbytes;
+  GtUword idx, left = 0, numofmers;
+
+  if (gt_tyrindex_isempty(tyrindex) || merbatch->nextfree == 0)
+  {
+    return;
+  }
+  numofmers = (GtUword) (gt_tyrindex_lastmer(tyrindex) - mertable)/merbytes
+              + 1;
+  gt_qsort_r(merbatch->order,(size_t) merbatch->nextfree,
+             sizeof *merbatch->order,merbatch,gt_tyrmerbatch_cmp);
+  for (idx = 0; idx < merbatch->nextfree && left < numofmers; idx++)
+  {
+    Tyrbatchmer *mer = merbatch->mers + merbatch->order[idx];
+    const GtUchar *key
+      = merbatch->bytecodes + merbatch->order[idx] * merbytes;
+
+    left = gt_tyrmerbatch_lowerbound(mertable,numofmers,merbytes,left,key);
+    if (left < numofmers &&
+        memcmp(TYRMER(left),key,(size_t) merbytes) == 0)
+    {
+      mer->result = TYRMER(left);
+    }
+  }
+}
+
+static void batchseqtyrsearch(const Tyrindex *tyrindex,
+                              const Tyrcountinfo *tyrcountinfo,
+                              const Tyrsearchinfo *tyrsearchinfo,
+                              Tyrmerbatch *merbatch,
+                              uint64_t unitnum,
+                              const GtUchar *query,
+                              GtUword querylen)
+{
+  const GtUchar *qptr;
+  GtUword idx, offset, skipvalue;
+
+  if (tyrsearchinfo->mersize > querylen)
+  {
+    return;
+  }
+  merbatch->nextfree = 0;
+  qptr = query;
+  offset = 0;
+  while (qptr <= query + querylen - tyrsearchinfo->mersize)
+  {
+    skipvalue = gt_containsspecialbytestring(qptr,offset,
+                                             tyrsearchinfo->mersize);
+    if (skipvalue == tyrsearchinfo->mersize)
+    {
+      offset = tyrsearchinfo->mersize-1;
+      if (tyrsearchinfo->searchstrand & STRAND_FORWARD)
+      {
+        gt_tyrmerbatch_add(merbatch,qptr,tyrsearchinfo->mersize,
+                           (GtUword) (qptr - query),true);
+      }
+      if (tyrsearchinfo->searchstrand & STRAND_REVERSE)
+      {
+        gt_assert(tyrsearchinfo->rcbuf != NULL);
+        gt_copy_reverse_complement(tyrsearchinfo->rcbuf,qptr,
+                                   tyrsearchinfo->mersize);
+        gt_tyrmerbatch_add(merbatch,tyrsearchinfo->rcbuf,
+                           tyrsearchinfo->mersize,
+                           (GtUword) (qptr - query),false);
+      }
+      qptr++;
+    } else
+    {
+      offset = 0;
+      qptr += (skipvalue+1);
+    }
+  }
+  gt_tyrmerbatch_search(merbatch,tyrindex);
+  for (idx = 0; idx < merbatch->nextfree; idx++)
+  {
+    const Tyrbatchmer *mer = merbatch->mers + idx;
+
+    if (mer->result != NULL)
+    {
+      mermatchoutput(tyrindex,
+                     tyrcountinfo,
+                     tyrsearchinfo,
+                     mer->result,
+                     query,
+                     query + mer->qpos,
+                     unitnum,
+                     mer->forward);
+    }
+  }
+}
+
 int gt_tyrsearch(const char *tyrindexname,
                  const GtStrArray *queryfilenames,
                  unsigned int showmode,
                  unsigned int searchstrand,
+                 bool batch,
                  bool verbose,
                  bool performtest,
                  GtError *err)
@@ -275,10 +497,12 @@ int gt_tyrsearch(const char *tyrindexname,
     uint64_t unitnum;
     int retval;
     Tyrsearchinfo tyrsearchinfo;
+    Tyrmerbatch merbatch;
     GtSeqIterator *seqit;
 
     gt_assert(tyrindex != NULL);
     gt_tyrsearchinfo_init(&tyrsearchinfo,tyrindex,showmode,searchstrand);
+    gt_tyrmerbatch_init(&merbatch,gt_tyrindex_merbytes(tyrindex));
     seqit = gt_seq_iterator_sequence_buffer_new(queryfilenames, err);
     if (!seqit)
       haserr = true;
@@ -302,17 +526,30 @@ int gt_tyrsearch(const char *tyrindexname,
         {
           break;
         }
-        singleseqtyrsearch(tyrindex,
-                           tyrcountinfo,
-                           &tyrsearchinfo,
-                           tyrbckinfo,
-                           unitnum,
-                           query,
-                           querylen,
-                           desc);
+        if (batch)
+        {
+          batchseqtyrsearch(tyrindex,
+                            tyrcountinfo,
+                            &tyrsearchinfo,
+                            &merbatch,
+                            unitnum,
+                            query,
+                            querylen);
+        } else
+        {
+          singleseqtyrsearch(tyrindex,
+                             tyrcountinfo,
+                             &tyrsearchinfo,
+                             tyrbckinfo,
+                             unitnum,
+                             query,
+                             querylen,
+                             desc);
+        }
       }
       gt_seq_iterator_delete(seqit);
     }
+    gt_tyrmerbatch_delete(&merbatch);
     gt_tyrsearchinfo_delete(&tyrsearchinfo);
   }
   if (tyrbckinfo != NULL)
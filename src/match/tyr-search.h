@@ -23,10 +23,13 @@
 #include "core/str_array_api.h"
 #include "core/error_api.h"
 
+/* if <batch> is true, all mers of a query sequence are sorted and merged
+   with the index instead of searching them one after the other */
 int gt_tyrsearch(const char *tyrindexname,
                  const GtStrArray *queryfilenames,
                  unsigned int showmode,
                  unsigned int searchstrand,
+                 bool batch,
                  bool verbose,
                  bool performtest,
                  GtError *err);
@@ -19,6 +19,7 @@
 #include "core/bioseq_api.h"
 #include "core/md5_tab_api.h"
 #include "core/option_api.h"
+#include "core/seqid_tab.h"
 #include "core/unused_api.h"
 #include "core/versionfunc_api.h"
 #include "core/xposix_api.h"
@@ -76,6 +77,7 @@ int gt_clean_runner(GT_UNUSED int argc, GT_UNUSED const char **argv,
   remove_pattern_in_current_dir(GT_SDSTABFILESUFFIX);
   remove_pattern_in_current_dir(GT_OISTABFILESUFFIX);
   remove_pattern_in_current_dir(GT_MD5TABFILESUFFIX);
+  remove_pattern_in_current_dir(GT_SIDTABFILESUFFIX);
 #else
   /* XXX */
   gt_error_set(err, "gt_clean_runner() not implemented");
@@ -31,7 +31,7 @@
 #include "core/fa_api.h"
 #include "core/fasta_api.h"
 #include "core/fasta_reader_api.h"
-#include "core/fasta_reader_rec.h"
+#include "core/fasta_reader_buf.h"
 #include "core/fileutils_api.h"
 #include "core/log_api.h"
 #include "core/logger.h"
@@ -81,7 +81,8 @@ typedef struct{
 typedef struct {
   GtUword avg,
           max,
-          count;
+          count,
+          current;
   double  raw_eval;
 } GtCondenseqBlastQInfo;
 
@@ -288,11 +289,25 @@ static inline int gt_condenseq_blast_create_blastdb(const char *dbfile,
 #define gt_condenseq_blast_create_blastdb_nucl(FILE) \
   gt_condenseq_blast_create_blastdb(FILE, "nucl", err)
 
-static inline int gt_condenseq_avg_helper(GtUword current_len,
+/* the sequence length reported by the fasta reader includes blanks and
+   carriage returns, so the length of a query is the sum of its parts */
+static inline int gt_condenseq_seqpart_helper(GT_UNUSED const char *seqpart,
+                                              GtUword length,
+                                              void *data,
+                                              GT_UNUSED GtError *err)
+{
+  GtCondenseqBlastQInfo *qinfo = (GtCondenseqBlastQInfo *) data;
+  qinfo->current += length;
+  return 0;
+}
+
+static inline int gt_condenseq_avg_helper(GT_UNUSED GtUword length,
                                           void *data,
                                           GT_UNUSED GtError *err)
 {
   GtCondenseqBlastQInfo *qinfo = (GtCondenseqBlastQInfo *) data;
+  GtUword current_len = qinfo->current;
+  qinfo->current = 0;
   qinfo->avg += current_len;
   qinfo->count++;
   gt_assert(qinfo->avg >= current_len);
@@ -369,6 +384,7 @@ gt_condenseq_blast_calc_query_stats(GtCesBlastInfo *info,
   qinfo->max = 0;
   qinfo->count = 0;
   qinfo->avg = 0;
+  qinfo->current = 0;
   qinfo->raw_eval = 0.0;
 
   /* from NCBI BLAST tutorial:
@@ -379,8 +395,9 @@ gt_condenseq_blast_calc_query_stats(GtCesBlastInfo *info,
      m being the subject (total) length, n the length of ONE query
      calculates E-value for bit-score S'
      */
-  reader = gt_fasta_reader_rec_new(info->args->querypath);
-  had_err = gt_fasta_reader_run(reader, NULL, NULL,
+  reader = gt_fasta_reader_buf_new(info->args->querypath);
+  had_err = gt_fasta_reader_run(reader, NULL,
+                                gt_condenseq_seqpart_helper,
                                 gt_condenseq_avg_helper,
                                 qinfo,
                                 info->err);
@@ -563,6 +580,7 @@ static int gt_condenseq_blast_runner(GT_UNUSED int argc,
   GtCondenseqBlastQInfo qinfo = {GT_UNDEF_UWORD,
                                  GT_UNDEF_UWORD,
                                  GT_UNDEF_UWORD,
+                                 0,
                                  GT_UNDEF_DOUBLE};
 
   GtFile          *gffout = NULL;
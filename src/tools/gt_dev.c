@@ -23,6 +23,7 @@
 #include "tools/gt_compressedbits.h"
 #include "tools/gt_consensus_sa.h"
 #include "tools/gt_extracttarget.h"
+#include "tools/gt_fastareader.h"
 #include "tools/gt_gdiffcalc.h"
 #include "tools/gt_guessprot.h"
 #include "tools/gt_idxlocali.h"
@@ -30,6 +31,7 @@
 #include "tools/gt_linspace_align.h"
 #include "tools/gt_magicmatch.h"
 #include "tools/gt_mergeesa.h"
+#include "tools/gt_mklcp.h"
 #include "tools/gt_paircmp.h"
 #include "tools/gt_parsexrf.h"
 #include "tools/gt_patternmatch.h"
@@ -39,6 +41,7 @@
 #include "tools/gt_sam_interface.h"
 #include "tools/gt_seqcorrect.h"
 #include "tools/gt_seqlensort.h"
+#include "tools/gt_sfxbench.h"
 #include "tools/gt_sfxmap.h"
 #include "tools/gt_show_seedext.h"
 #include "tools/gt_skproto.h"
@@ -61,17 +64,20 @@ static void* gt_dev_arguments_new(void)
   gt_toolbox_add_tool(dev_toolbox, "compbits", gt_compressedbits());
   gt_toolbox_add_tool(dev_toolbox, "consensus_sa", gt_consensus_sa_tool());
   gt_toolbox_add_tool(dev_toolbox, "extracttarget", gt_extracttarget());
+  gt_toolbox_add_tool(dev_toolbox, "fastareader", gt_fastareader());
   gt_toolbox_add_tool(dev_toolbox, "gdiffcalc", gt_gdiffcalc());
   gt_toolbox_add_tool(dev_toolbox, "idxlocali", gt_idxlocali());
   gt_toolbox_add_tool(dev_toolbox, "kmer_database", gt_kmer_database());
   gt_toolbox_add_tool(dev_toolbox, "linspace_align", gt_linspace_align());
   gt_toolbox_add_tool(dev_toolbox, "magicmatch", gt_magicmatch());
+  gt_toolbox_add_tool(dev_toolbox, "mklcp", gt_mklcp());
   gt_toolbox_add_tool(dev_toolbox, "parsexrf", gt_parsexrf());
   gt_toolbox_add_tool(dev_toolbox, "readreads", gt_readreads());
   gt_toolbox_add_tool(dev_toolbox, "sain", gt_sain());
   gt_toolbox_add_tool(dev_toolbox, "sambam", gt_sam_interface());
   gt_toolbox_add_tool(dev_toolbox, "seqcorrect", gt_seqcorrect());
   gt_toolbox_add_tool(dev_toolbox, "seqlensort", gt_seqlensort());
+  gt_toolbox_add_tool(dev_toolbox, "sfxbench", gt_sfxbench());
   gt_toolbox_add_tool(dev_toolbox, "sfxmap", gt_sfxmap());
   gt_toolbox_add_tool(dev_toolbox, "show_seedext", gt_show_seedext());
   gt_toolbox_add_tool(dev_toolbox, "skproto", gt_skproto());
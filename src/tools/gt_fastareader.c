@@ -0,0 +1,147 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <string.h>
+#include "core/fasta_reader_buf.h"
+#include "core/fasta_reader_fsm.h"
+#include "core/fasta_reader_rec.h"
+#include "core/ma_api.h"
+#include "core/str_api.h"
+#include "core/unused_api.h"
+#include "tools/gt_fastareader.h"
+
+typedef struct {
+  GtStr *reader;
+} GtFastareaderArguments;
+
+static void* gt_fastareader_arguments_new(void)
+{
+  GtFastareaderArguments *arguments = gt_malloc(sizeof (*arguments));
+  arguments->reader = gt_str_new();
+  return arguments;
+}
+
+static void gt_fastareader_arguments_delete(void *tool_arguments)
+{
+  GtFastareaderArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_str_delete(arguments->reader);
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_fastareader_option_parser_new(void *tool_arguments)
+{
+  GtFastareaderArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+  static const char *readers[] = {
+    "buf",
+    "fsm",
+    "rec",
+    NULL
+  };
+  gt_assert(arguments);
+
+  /* init */
+  op = gt_option_parser_new("[option ...] fasta_file [...]",
+                            "Read FASTA files with the given GtFastaReader "
+                            "implementation and show the results of its "
+                            "handler functions.");
+
+  option = gt_option_new_choice("reader", "fasta reader implementation\n"
+                                "choose from buf|fsm|rec",
+                                arguments->reader, readers[0], readers);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_min_args(op, 1U);
+  return op;
+}
+
+/* Each entry is shown as its description, its sequence parts concatenated on
+   a single line, and the sequence length reported by the reader, so that the
+   output does not depend on how a reader splits the sequence into parts. */
+static int gt_fastareader_show_description(const char *description,
+                                           GT_UNUSED GtUword length,
+                                           GT_UNUSED void *data,
+                                           GT_UNUSED GtError *err)
+{
+  gt_assert(strlen(description) == length);
+  printf(">%s\n", description);
+  return 0;
+}
+
+static int gt_fastareader_show_sequence_part(const char *seqpart,
+                                             GtUword length,
+                                             GT_UNUSED void *data,
+                                             GT_UNUSED GtError *err)
+{
+  gt_assert(length > 0);
+  fwrite(seqpart, sizeof (char), (size_t) length, stdout);
+  return 0;
+}
+
+static int gt_fastareader_show_sequence_length(GtUword length,
+                                               GT_UNUSED void *data,
+                                               GT_UNUSED GtError *err)
+{
+  printf("\nlength " GT_WU "\n", length);
+  return 0;
+}
+
+static int gt_fastareader_runner(int argc, const char **argv, int parsed_args,
+                                 void *tool_arguments, GtError *err)
+{
+  GtFastareaderArguments *arguments = tool_arguments;
+  GtStr *filename;
+  int i, had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  filename = gt_str_new();
+  for (i = parsed_args; !had_err && i < argc; i++) {
+    GtFastaReader *reader;
+    const char *readername = gt_str_get(arguments->reader);
+
+    gt_str_set(filename, argv[i]);
+    if (strcmp(readername, "rec") == 0)
+      reader = gt_fasta_reader_rec_new(filename);
+    else if (strcmp(readername, "fsm") == 0)
+      reader = gt_fasta_reader_fsm_new(filename);
+    else {
+      gt_assert(strcmp(readername, "buf") == 0);
+      reader = gt_fasta_reader_buf_new(filename);
+    }
+    had_err = gt_fasta_reader_run(reader,
+                                  gt_fastareader_show_description,
+                                  gt_fastareader_show_sequence_part,
+                                  gt_fastareader_show_sequence_length,
+                                  NULL, err);
+    gt_fasta_reader_delete(reader);
+  }
+  gt_str_delete(filename);
+  return had_err;
+}
+
+GtTool* gt_fastareader(void)
+{
+  return gt_tool_new(gt_fastareader_arguments_new,
+                     gt_fastareader_arguments_delete,
+                     gt_fastareader_option_parser_new,
+                     NULL,
+                     gt_fastareader_runner);
+}
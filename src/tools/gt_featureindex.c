@@ -24,6 +24,7 @@
 #include "extended/anno_db_gfflike_api.h"
 #include "extended/anno_db_schema_api.h"
 #include "extended/feature_index_api.h"
+#include "extended/feature_index_mapped_api.h"
 #include "extended/feature_node.h"
 #include "extended/feature_stream_api.h"
 #include "extended/gff3_visitor.h"
@@ -38,6 +39,7 @@
 
 #define GT_SQLITE_BACKEND_STRING "sqlite"
 #define GT_MYSQL_BACKEND_STRING  "mysql"
+#define GT_MAPPED_BACKEND_STRING "mapped"
 
 typedef struct {
   GtRange qry_rng;
@@ -95,6 +97,7 @@ static GtOptionParser* gt_featureindex_option_parser_new(void *tool_arguments)
 #ifdef HAVE_MYSQL
     GT_MYSQL_BACKEND_STRING,
 #endif
+    GT_MAPPED_BACKEND_STRING,
     NULL
   };
   gt_assert(arguments);
@@ -121,11 +124,12 @@ static GtOptionParser* gt_featureindex_option_parser_new(void *tool_arguments)
   backend_option = gt_option_new_choice("backend", "database backend to use\n"
                                         "choose from ["
 #ifdef HAVE_SQLITE
-                                         GT_SQLITE_BACKEND_STRING
+                                        GT_SQLITE_BACKEND_STRING "|"
 #endif
 #ifdef HAVE_MYSQL
-                                        "|" GT_MYSQL_BACKEND_STRING
+                                        GT_MYSQL_BACKEND_STRING "|"
 #endif
+                                        GT_MAPPED_BACKEND_STRING
                                         "]",
                                         arguments->backend, backends[0],
                                         backends);
@@ -134,7 +138,7 @@ static GtOptionParser* gt_featureindex_option_parser_new(void *tool_arguments)
   /* -filename */
   filenameoption = gt_option_new_string("filename",
                                         "filename for feature database "
-                                        "(sqlite backend only)",
+                                        "(sqlite and mapped backends only)",
                                         arguments->filename, NULL);
   gt_option_parser_add_option(op, filenameoption);
 
@@ -209,11 +213,22 @@ static int gt_featureindex_runner(GT_UNUSED int argc,
   GtNodeVisitor *gff3visitor = NULL;
   GtGenomeNode *regn = NULL;
   GtUword i = 0;
+  bool mapped;
   int had_err = 0;
 
   gt_error_check(err);
   gt_assert(arguments);
 
+  mapped = (strcmp(gt_str_get(arguments->backend),
+                   GT_MAPPED_BACKEND_STRING) == 0);
+  if (mapped) {
+    /* a mapped index is read directly from the file written by
+       mkfeatureindex, it does not need an annotation database */
+    fi = gt_feature_index_mapped_load(gt_str_get(arguments->filename), err);
+    if (!fi)
+      had_err = -1;
+  }
+
 #ifdef HAVE_SQLITE
   if (!had_err) {
     if (strcmp(gt_str_get(arguments->backend),
@@ -247,21 +262,24 @@ static int gt_featureindex_runner(GT_UNUSED int argc,
     }
   }
 #endif
-  if (!had_err)
+  if (!had_err && !mapped) {
     adbs = gt_anno_db_gfflike_new();
+    if (!adbs)
+      had_err = -1;
+  }
 
-  if (!had_err && !adbs)
-    had_err = -1;
-
-  if (!had_err) {
+  if (!had_err && !mapped) {
     fi = gt_anno_db_schema_get_feature_index(adbs, rdb, err);
     had_err = fi ? 0 : -1;
   }
 
   if (!had_err && gt_str_length(arguments->seqid) == 0) {
     char *firstseqid = gt_feature_index_get_first_seqid(fi, err);
-    if (firstseqid == NULL)
+    if (firstseqid == NULL) {
+      if (!gt_error_is_set(err))
+        gt_error_set(err, "no sequence regions in index");
       had_err = -1;
+    }
     else {
       gt_str_append_cstr(arguments->seqid, firstseqid);
       gt_free(firstseqid);
@@ -285,9 +303,12 @@ static int gt_featureindex_runner(GT_UNUSED int argc,
     if (arguments->retain)
       gt_gff3_visitor_retain_id_attributes((GtGFF3Visitor*) gff3visitor);
 
-    had_err = gt_feature_index_get_range_for_seqid(fi, &rng,
+    /* the sequence region as given in the annotation, the range of the
+       features may be smaller */
+    rng = arguments->qry_rng;
+    had_err = gt_feature_index_get_orig_range_for_seqid(fi, &rng,
                                                    gt_str_get(arguments->seqid),
-                                                   err);
+                                                        err);
   }
   if (!had_err) {
     regn = gt_region_node_new(arguments->seqid, rng.start, rng.end);
@@ -316,7 +337,9 @@ static int gt_featureindex_runner(GT_UNUSED int argc,
         }
       }
       gt_genome_node_accept(gn, gff3visitor, err);
-      gt_genome_node_delete(gn);
+      /* the trees returned by a mapped index are owned by the index */
+      if (!mapped)
+        gt_genome_node_delete(gn);
     }
   }
 
@@ -364,6 +364,7 @@ static int gt_genomediff_runner(int argc, const char **argv,
       sopts.db = NULL;
       sopts.encopts = NULL;
       sopts.genomediff = true;
+      sopts.extmerge = false;
       sopts.inputindex = arguments->indexname;
       sopts.loadopts = arguments->loadopts;
       sopts.showprogress = false;
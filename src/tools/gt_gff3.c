@@ -55,6 +55,7 @@ typedef struct {
        show,
        fixboundaries;
   GtWord offset;
+  GtUword sortmemory;
   GtStr *offsetfile, *newsource;
   GtUword width;
   GtTypecheckInfo *tci;
@@ -94,7 +95,7 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   GtOption *sort_option, *load_option, *strict_option, *tidy_option,
            *mergefeat_option, *addintrons_option, *offset_option,
            *offsetfile_option, *setsource_option, *sortlines_option,
-           *sortnum_option, *option;
+           *sortnum_option, *sortmemory_option, *option;
   gt_assert(arguments);
 
   /* init */
@@ -123,6 +124,18 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, sortnum_option);
   gt_option_exclude(sortlines_option, sortnum_option);
 
+  /* -sortmemory */
+  sortmemory_option = gt_option_new_uword("sortmemory", "limit the memory "
+                                          "used for sorting to the given "
+                                          "number of MB, sorted parts of the "
+                                          "input are written to temporary "
+                                          "files and merged afterwards\n"
+                                          "(0 means no limit)",
+                                          &arguments->sortmemory, 0);
+  gt_option_imply_either_3(sortmemory_option, sort_option, sortlines_option,
+                           sortnum_option);
+  gt_option_parser_add_option(op, sortmemory_option);
+
   /* -strict */
   strict_option = gt_option_new_bool("strict", "be very strict during GFF3 "
                                      "parsing (stricter than the specification "
@@ -322,6 +335,10 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
   if (!had_err && (arguments->sort || arguments->sortlines ||
                    arguments->sortnum)) {
     sort_stream = gt_sort_stream_new(last_stream);
+    if (arguments->sortmemory) {
+      gt_sort_stream_set_memory_limit((GtSortStream*) sort_stream,
+                                      arguments->sortmemory << 20);
+    }
     last_stream = sort_stream;
   }
 
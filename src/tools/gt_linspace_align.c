@@ -68,6 +68,7 @@ typedef struct{
              showscore,
              showsequences,
              scoreonly, /* dev option generate alignment, but do not show it*/
+             computeonlyscore, /* dev option compute score without alignment*/
              wildcardshow, /* show symbol wildcards in output*/
              spacetime; /* write space peak and time overall on stdout*/
   GtUword timesquarefactor; /*factor to specified termination of recursion
@@ -139,7 +140,7 @@ static GtOptionParser* gt_linspace_align_option_parser_new(void *tool_arguments)
            *optionaffinecosts, *optionoutputfile, *optionshowscore,
            *optionshowsequences, *optiondiagonal, *optiondiagonalbonds,
            *optionsimilarity, *optiontsfactor, *optionspacetime,
-           *optionscoreonly, *optionwildcardsymbol;
+           *optionscoreonly, *optioncomputeonlyscore, *optionwildcardsymbol;
 
   gt_assert(arguments);
 
@@ -202,6 +203,14 @@ static GtOptionParser* gt_linspace_align_option_parser_new(void *tool_arguments)
                                        &arguments->scoreonly, false);
   gt_option_parser_add_option(op, optionscoreonly);
 
+  optioncomputeonlyscore = gt_option_new_bool("computeonlyscore",
+                                              "compute only the score without "
+                                              "generating an alignment, output "
+                                              "as with -showonlyscore",
+                                              &arguments->computeonlyscore,
+                                              false);
+  gt_option_parser_add_option(op, optioncomputeonlyscore);
+
   optionspacetime = gt_option_new_bool("spacetime", "write space peak and time"
                                        " overall on stdout",
                                        &arguments->spacetime, false);
@@ -264,6 +273,10 @@ static GtOptionParser* gt_linspace_align_option_parser_new(void *tool_arguments)
   gt_option_exclude(optiondna, optionprotein);
   gt_option_exclude(optionshowsequences, optionscoreonly);
   gt_option_exclude(optionsimilarity, optiondiagonalbonds);
+  gt_option_exclude(optioncomputeonlyscore, optionscoreonly);
+  gt_option_exclude(optioncomputeonlyscore, optionshowsequences);
+  gt_option_exclude(optioncomputeonlyscore, optionshowscore);
+  gt_option_exclude(optioncomputeonlyscore, optiondiagonal);
   gt_option_imply_either_2(optionfiles, optionglobal, optionlocal);
   gt_option_imply_either_2(optiondna, optionstrings, optionfiles);
   gt_option_imply_either_2(optionstrings, optionglobal, optionlocal);
@@ -287,6 +300,7 @@ static GtOptionParser* gt_linspace_align_option_parser_new(void *tool_arguments)
   /* development option(s) */
   gt_option_is_development_option(optionspacetime);
   gt_option_is_development_option(optionscoreonly);/*only useful to test*/
+  gt_option_is_development_option(optioncomputeonlyscore);
 
   return op;
 }
@@ -493,6 +507,30 @@ static void get_onesequence(const GtSequenceTable *sequence_table,
   sequence_table->seqarray[0] = gt_str_new_cstr(gt_str_array_get(strings,idx));
 }
 
+/*show only the score, computed without an alignment*/
+static void gt_linspace_show_computed_score(bool affine,
+                                            bool global,
+                                            const GtScoreHandler *scorehandler,
+                                            const GtUchar *useq, GtUword ulen,
+                                            const GtUchar *vseq, GtUword vlen,
+                                            FILE *fp)
+{
+  GtWord score;
+
+  if (global)
+  {
+    score = (GtWord) (affine ? gt_linearalign_affinegapcost_global_distance_only
+                             : gt_linearalign_global_distance_only)
+                                 (scorehandler, useq, 0, ulen, vseq, 0, vlen);
+  } else
+  {
+    score = (affine ? gt_linearalign_affinegapcost_local_score_only
+                    : gt_linearalign_local_score_only)
+                        (scorehandler, useq, 0, ulen, vseq, 0, vlen);
+  }
+  fprintf(fp, "######\n%s: "GT_WD"\n", global ? "distance" : "score", score);
+}
+
 /*call function with linear gap costs for all given sequences */
 static int gt_all_against_all_alignment_check(bool affine,
                                         GtAlignment *align,
@@ -526,6 +564,30 @@ static int gt_all_against_all_alignment_check(bool affine,
       vlen = gt_str_length(sequence_table2->seqarray[j]);
       vseq = (const GtUchar*) gt_str_get(sequence_table2->seqarray[j]);
       gt_alignment_reset(align);
+      if (arguments->computeonlyscore)
+      {
+        if (!strcmp(gt_str_get(arguments->outputfile),"stdout"))
+        {
+          gt_linspace_show_computed_score(affine, arguments->global,
+                                          scorehandler, useq, ulen,
+                                          vseq, vlen, stdout);
+        } else
+        {
+          FILE *fp = gt_fa_fopen_func(gt_str_get(arguments->outputfile),
+                                                 "a", __FILE__,__LINE__,err);
+          if (fp == NULL)
+          {
+            had_err = -1;
+          } else
+          {
+            gt_linspace_show_computed_score(affine, arguments->global,
+                                            scorehandler, useq, ulen,
+                                            vseq, vlen, fp);
+            gt_fa_fclose(fp);
+          }
+        }
+        continue;
+      }
       if (arguments->global)
       {
         if (arguments->diagonal)
@@ -20,6 +20,7 @@
 #include "core/error_api.h"
 #include "core/ma_api.h"
 #include "core/option_api.h"
+#include "core/thread_api.h"
 #include "core/unused_api.h"
 #include "core/versionfunc_api.h"
 #include "match/eis-voiditf.h"
@@ -28,6 +29,7 @@
 #include "match/fmindex.h"
 #include "match/greedyfwdmat.h"
 #include "match/optionargmode.h"
+#include "match/querybatch.h"
 #include "match/sarr-def.h"
 #include "tools/gt_matstat.h"
 #include "tools/gt_uniquesub.h"
@@ -51,6 +53,7 @@ typedef struct
   Definedunsignedlong minlength,
                       maxlength;
   unsigned int showmode;
+  GtUword batchsize;
   bool verifywitnesspos;
   GtStr *indexname;
   GtStrArray *queryfilenames, *flagsoutputoption;
@@ -97,6 +100,7 @@ static GtOptionParser* gt_matstat_option_parser_new(void *tool_arguments)
 {
   Gfmsubcallinfo *arguments = tool_arguments;
   GtOptionParser *op;
+  GtOption *option;
   gt_assert(arguments);
 
   op = gt_option_parser_new("[options ...] -query queryfile [...]",
@@ -145,6 +149,15 @@ static GtOptionParser* gt_matstat_option_parser_new(void *tool_arguments)
                                    0,(GtUword) 1);
   gt_option_parser_add_option(op, arguments->optionmax);
 
+  option = gt_option_new_uword_min("batchsize",
+                                   "set the number of query sequences which "
+                                   "are read and distributed among the "
+                                   "threads at once",
+                                   &arguments->batchsize,
+                                   GT_QUERYBATCH_DEFAULTSIZE,(GtUword) 1);
+  gt_option_is_extended_option(option);
+  gt_option_parser_add_option(op, option);
+
   arguments->optionoutput = gt_option_new_string_array("output",
                    arguments->doms
                      ? "set output flags (sequence, querypos, subjectpos)"
@@ -415,6 +428,23 @@ static int gt_matstat_runner(GT_UNUSED int argc, GT_UNUSED const char **argv,
     }
     if (!haserr)
     {
+      const void **genericindextab;
+      unsigned int thread, numofthreads = gt_jobs;
+
+      /* the packed index caches the position of the last rank query, so
+         each thread needs its own view of the index */
+      genericindextab = gt_malloc(sizeof *genericindextab * numofthreads);
+      for (thread = 0; thread < numofthreads; thread++)
+      {
+        if (arguments->indextype == Packedindextype && thread > 0)
+        {
+          genericindextab[thread]
+            = gt_newvoidBWTSeqview((const FMindex *) theindex);
+        } else
+        {
+          genericindextab[thread] = theindex;
+        }
+      }
 #ifdef WITHBCKTAB
       if (prefixlength > 0 &&
           arguments->indextype == Esaindextype &&
@@ -436,7 +466,9 @@ static int gt_matstat_runner(GT_UNUSED int argc, GT_UNUSED const char **argv,
           gt_findsubquerygmatchforward(dotestsequence(arguments)
                                       ? suffixarray.encseq
                                       : NULL,
-                                      theindex,
+                                      genericindextab,
+                                      numofthreads,
+                                      arguments->batchsize,
                                       totallength,
                                       gmatchforwardfunction,
                                       alphabet,
@@ -453,6 +485,14 @@ static int gt_matstat_runner(GT_UNUSED int argc, GT_UNUSED const char **argv,
       {
         haserr = true;
       }
+      for (thread = 1U; thread < numofthreads; thread++)
+      {
+        if (arguments->indextype == Packedindextype)
+        {
+          gt_deletevoidBWTSeqview((FMindex *) genericindextab[thread]);
+        }
+      }
+      gt_free(genericindextab);
     }
   }
   if (arguments->indextype == Fmindextype)
@@ -24,6 +24,7 @@
 #include "extended/anno_db_gfflike_api.h"
 #include "extended/bed_in_stream.h"
 #include "extended/feature_index_api.h"
+#include "extended/feature_index_mapped_api.h"
 #include "extended/feature_stream_api.h"
 #include "extended/gff3_in_stream.h"
 #include "extended/gtf_in_stream.h"
@@ -37,6 +38,7 @@
 
 #define GT_SQLITE_BACKEND_STRING "sqlite"
 #define GT_MYSQL_BACKEND_STRING  "mysql"
+#define GT_MAPPED_BACKEND_STRING "mapped"
 
 typedef struct {
   GtStr *backend,
@@ -84,10 +86,13 @@ static GtOptionParser* gt_mkfeatureindex_option_parser_new(void *tool_arguments)
   GtOptionParser *op;
   GtOption *option, *backend_option, *filenameoption;
   static const char *backends[] = {
+#ifdef HAVE_SQLITE
     GT_SQLITE_BACKEND_STRING,
+#endif
 #ifdef HAVE_MYSQL
     GT_MYSQL_BACKEND_STRING,
 #endif
+    GT_MAPPED_BACKEND_STRING,
     NULL
   };
   static const char *inputs[] = {
@@ -111,11 +116,12 @@ static GtOptionParser* gt_mkfeatureindex_option_parser_new(void *tool_arguments)
   backend_option = gt_option_new_choice("backend", "database backend to use\n"
                                         "choose from ["
 #ifdef HAVE_SQLITE
-                                        GT_SQLITE_BACKEND_STRING
+                                        GT_SQLITE_BACKEND_STRING "|"
 #endif
 #ifdef HAVE_MYSQL
-                                        "|" GT_MYSQL_BACKEND_STRING
+                                        GT_MYSQL_BACKEND_STRING "|"
 #endif
+                                        GT_MAPPED_BACKEND_STRING
                                         "]",
                                         arguments->backend, backends[0],
                                         backends);
@@ -130,7 +136,7 @@ static GtOptionParser* gt_mkfeatureindex_option_parser_new(void *tool_arguments)
   /* -filename */
   filenameoption = gt_option_new_string("filename",
                                         "filename for feature database "
-                                        "(sqlite backend only)",
+                                        "(sqlite and mapped backends only)",
                                         arguments->filename, NULL);
   gt_option_parser_add_option(op, filenameoption);
 
@@ -190,14 +196,16 @@ static int gt_mkfeatureindex_runner(int argc,
   GtRDB *rdb = NULL;
   GtAnnoDBSchema *adb = NULL;
   GtFeatureIndex *fis = NULL;
+  bool mapped;
   int had_err = 0;
 
   gt_error_check(err);
   gt_assert(arguments);
 
-#ifdef HAVE_SQLITE
-  if (strcmp(gt_str_get(arguments->backend),
-             GT_SQLITE_BACKEND_STRING) == 0) {
+  mapped = (strcmp(gt_str_get(arguments->backend),
+                  GT_MAPPED_BACKEND_STRING) == 0);
+  if (mapped || strcmp(gt_str_get(arguments->backend),
+                       GT_SQLITE_BACKEND_STRING) == 0) {
     if (gt_file_exists(gt_str_get(arguments->filename))) {
       if (arguments->force) {
         gt_xunlink(gt_str_get(arguments->filename));
@@ -207,6 +215,10 @@ static int gt_mkfeatureindex_runner(int argc,
         had_err = -1;
       }
     }
+  }
+#ifdef HAVE_SQLITE
+  if (strcmp(gt_str_get(arguments->backend),
+             GT_SQLITE_BACKEND_STRING) == 0) {
     if (!had_err) {
       rdb = gt_rdb_sqlite_new(gt_str_get(arguments->filename), err);
       if (!rdb)
@@ -229,14 +241,22 @@ static int gt_mkfeatureindex_runner(int argc,
   }
 #endif
 
-  adb = gt_anno_db_gfflike_new();
-  if (!had_err && !adb)
-    had_err = -1;
-
-  if (!had_err) {
-    fis = gt_anno_db_schema_get_feature_index(adb, rdb, err);
-    if (!fis)
+  if (mapped) {
+    /* the mapped index is built in memory and written by
+       gt_feature_index_save() */
+    if (!had_err)
+      fis = gt_feature_index_mapped_new(gt_str_get(arguments->filename));
+  }
+  else {
+    adb = gt_anno_db_gfflike_new();
+    if (!had_err && !adb)
       had_err = -1;
+
+    if (!had_err) {
+      fis = gt_anno_db_schema_get_feature_index(adb, rdb, err);
+      if (!fis)
+        had_err = -1;
+    }
   }
 
   if (!had_err) {
@@ -244,6 +264,7 @@ static int gt_mkfeatureindex_runner(int argc,
     {
       in_stream = gt_gff3_in_stream_new_unsorted(argc - parsed_args,
                                                  argv + parsed_args);
+      gt_gff3_in_stream_enable_node_arena(in_stream);
       if (arguments->verbose)
         gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) in_stream);
     } else if (strcmp(gt_str_get(arguments->input), "bed") == 0)
@@ -258,12 +279,15 @@ static int gt_mkfeatureindex_runner(int argc,
         in_stream = gt_gtf_in_stream_new(NULL);
       else
         in_stream = gt_gtf_in_stream_new(argv[parsed_args]);
+      gt_gtf_in_stream_enable_node_arena(in_stream);
     }
     gt_assert(in_stream);
 
     feature_stream = gt_feature_stream_new(in_stream, fis);
     had_err = gt_node_stream_pull(feature_stream, err);
   }
+  if (!had_err && mapped)
+    had_err = gt_feature_index_save(fis, err);
   gt_node_stream_delete(feature_stream);
   gt_node_stream_delete(in_stream);
   gt_feature_index_delete(fis);
@@ -0,0 +1,123 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/logger.h"
+#include "core/ma_api.h"
+#include "core/str_api.h"
+#include "core/unused_api.h"
+#include "match/esa-map.h"
+#include "match/sfx-lcpbuild.h"
+#include "match/sfx-linlcp.h"
+#include "tools/gt_mklcp.h"
+
+typedef struct {
+  GtStr *indexname;
+  bool check,
+       verbose;
+} GtMklcpArguments;
+
+static void* gt_mklcp_arguments_new(void)
+{
+  GtMklcpArguments *arguments = gt_malloc(sizeof (*arguments));
+  arguments->indexname = gt_str_new();
+  return arguments;
+}
+
+static void gt_mklcp_arguments_delete(void *tool_arguments)
+{
+  GtMklcpArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_str_delete(arguments->indexname);
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_mklcp_option_parser_new(void *tool_arguments)
+{
+  GtMklcpArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+  gt_assert(arguments);
+
+  op = gt_option_parser_new("-ii indexname [option ...]",
+                            "Compute the lcp table of an existing suffix "
+                            "array and add it to the index.");
+
+  /* -ii */
+  option = gt_option_new_string("ii", "specify the index name of a suffix "
+                                "array with a suffix table",
+                                arguments->indexname, NULL);
+  gt_option_is_mandatory(option);
+  gt_option_parser_add_option(op, option);
+
+  /* -check */
+  option = gt_option_new_bool("check", "compare the lcp table against a "
+                              "reference computed with the sequential "
+                              "algorithm", &arguments->check, false);
+  gt_option_parser_add_option(op, option);
+
+  /* -v */
+  option = gt_option_new_verbose(&arguments->verbose);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_max_args(op, 0);
+  return op;
+}
+
+static int gt_mklcp_runner(GT_UNUSED int argc,
+                           GT_UNUSED const char **argv,
+                           GT_UNUSED int parsed_args,
+                           void *tool_arguments,
+                           GtError *err)
+{
+  GtMklcpArguments *arguments = tool_arguments;
+  GtLogger *logger;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  logger = gt_logger_new(arguments->verbose, GT_LOGGER_DEFLT_PREFIX, stdout);
+  had_err = gt_lcptab_build_from_suftab(gt_str_get(arguments->indexname),
+                                        logger, err);
+  if (!had_err && arguments->check)
+  {
+    Suffixarray suffixarray;
+
+    had_err = gt_mapsuffixarray(&suffixarray, SARR_ESQTAB | SARR_SUFTAB,
+                                gt_str_get(arguments->indexname), logger, err);
+    if (!had_err)
+    {
+      had_err = gt_lcptab_lightweightcheck(gt_str_get(arguments->indexname),
+                                           suffixarray.encseq,
+                                           suffixarray.readmode,
+                                           suffixarray.suftab,
+                                           logger,
+                                           err);
+      gt_freesuffixarray(&suffixarray);
+    }
+  }
+  gt_logger_delete(logger);
+  return had_err;
+}
+
+GtTool* gt_mklcp(void)
+{
+  return gt_tool_new(gt_mklcp_arguments_new,
+                     gt_mklcp_arguments_delete,
+                     gt_mklcp_option_parser_new,
+                     NULL,
+                     gt_mklcp_runner);
+}
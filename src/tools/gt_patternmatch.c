@@ -16,6 +16,8 @@
 */
 
 #include <inttypes.h>
+#include <stdlib.h>
+#include "core/arraydef_api.h"
 #include "core/encseq.h"
 #include "core/error_api.h"
 #include "core/option_api.h"
@@ -26,6 +28,10 @@
 #include "match/enum-patt.h"
 #include "match/esa-map.h"
 #include "match/esa-mmsearch.h"
+#include "match/fmi-fwduni.h"
+#include "match/fmi-locate.h"
+#include "match/fmi-map.h"
+#include "match/fmindex.h"
 #include "match/qgram2code.h"
 #include "match/sarr-def.h"
 #include "tools/gt_patternmatch.h"
@@ -33,8 +39,8 @@
 typedef struct
 {
   GtUword minpatternlen, maxpatternlen, numofsamples;
-  bool showpatt, usebcktab, immediate;
-  GtStr *indexname;
+  bool showpatt, usebcktab, immediate, fmisingle;
+  GtStr *indexname, *fmindexname;
 } Pmatchoptions;
 
 static void comparemmsis(const GtMMsearchiterator *mmsi1,
@@ -62,13 +68,96 @@ static void comparemmsis(const GtMMsearchiterator *mmsi1,
   }
 }
 
+static int compareGtUword(const void *a,const void *b)
+{
+  if (*(const GtUword *) a < *(const GtUword *) b)
+  {
+    return -1;
+  }
+  if (*(const GtUword *) a > *(const GtUword *) b)
+  {
+    return 1;
+  }
+  return 0;
+}
+
+/* the fmindex is built for the reversed sequence, so the pattern is
+   searched from left to right and the located positions are mapped back
+   to start positions in the forward sequence */
+static void fmilocatepattern(GtArrayGtUword *positions,
+                             const Fmindex *fmindex,
+                             bool fmisingle,
+                             const GtUchar *pattern,
+                             GtUword patternlen)
+{
+  GtUwordBound bwtbound;
+  GtUword lbound, ubound, idx;
+
+  positions->nextfreeGtUword = 0;
+  if (!gt_skfmexactmatches(&bwtbound,fmindex,pattern,pattern + patternlen))
+  {
+    return;
+  }
+  lbound = bwtbound.lbound;
+  ubound = bwtbound.ubound;
+  GT_CHECKARRAYSPACEMULTI(positions,GtUword,ubound - lbound);
+  if (fmisingle)
+  {
+    for (idx = lbound; idx < ubound; idx++)
+    {
+      positions->spaceGtUword[idx - lbound] = gt_fmfindtextpos(fmindex,idx);
+    }
+  } else
+  {
+    gt_fmfindtextpos_interval(fmindex,lbound,ubound,positions->spaceGtUword);
+  }
+  positions->nextfreeGtUword = ubound - lbound;
+  for (idx = 0; idx < positions->nextfreeGtUword; idx++)
+  {
+    gt_assert(fmindex->bwtlength - 1 >=
+              positions->spaceGtUword[idx] + patternlen);
+    positions->spaceGtUword[idx] = fmindex->bwtlength - 1 -
+                                   (positions->spaceGtUword[idx] + patternlen);
+  }
+  qsort(positions->spaceGtUword,(size_t) positions->nextfreeGtUword,
+        sizeof *positions->spaceGtUword,compareGtUword);
+}
+
+static void comparefmipositions(GtArrayGtUword *fmipositions,
+                                GtArrayGtUword *esapositions)
+{
+  GtUword idx;
+
+  qsort(esapositions->spaceGtUword,(size_t) esapositions->nextfreeGtUword,
+        sizeof *esapositions->spaceGtUword,compareGtUword);
+  if (fmipositions->nextfreeGtUword != esapositions->nextfreeGtUword)
+  {
+    fprintf(stderr,"fmindex reports "GT_WU" matches, but suffix array reports "
+                   GT_WU" matches\n",fmipositions->nextfreeGtUword,
+                   esapositions->nextfreeGtUword);
+    exit(GT_EXIT_PROGRAMMING_ERROR);
+  }
+  for (idx = 0; idx < fmipositions->nextfreeGtUword; idx++)
+  {
+    if (fmipositions->spaceGtUword[idx] != esapositions->spaceGtUword[idx])
+    {
+      fprintf(stderr,"fmindex reports match at "GT_WU", but suffix array "
+                     "reports match at "GT_WU"\n",
+                     fmipositions->spaceGtUword[idx],
+                     esapositions->spaceGtUword[idx]);
+      exit(GT_EXIT_PROGRAMMING_ERROR);
+    }
+  }
+}
+
 #define UNDEFREFSTART totallength
 
 static int callpatternmatcher(const Pmatchoptions *pmopt, GtError *err)
 {
   Suffixarray suffixarray;
+  Fmindex fmindex;
   GtUword totallength = 0;
-  bool haserr = false;
+  bool haserr = false, withfmindex = false;
   const GtUchar *pptr;
   GtUword patternlen;
   unsigned int demand = SARR_SUFTAB | SARR_ESQTAB;
@@ -88,8 +177,34 @@ static int callpatternmatcher(const Pmatchoptions *pmopt, GtError *err)
   {
     totallength = gt_encseq_total_length(suffixarray.encseq);
   }
+  if (!haserr && gt_str_length(pmopt->fmindexname) > 0)
+  {
+    if (gt_mapfmindex(&fmindex,gt_str_get(pmopt->fmindexname),NULL,err) != 0)
+    {
+      haserr = true;
+    } else
+    {
+      withfmindex = true;
+      if (fmindex.markpostable == NULL)
+      {
+        gt_error_set(err,"fmindex %s does not store index positions",
+                     gt_str_get(pmopt->fmindexname));
+        haserr = true;
+      } else
+      {
+        if (fmindex.bwtlength != totallength + 1)
+        {
+          gt_error_set(err,"fmindex %s and suffix array %s do not represent "
+                       "the same sequence",gt_str_get(pmopt->fmindexname),
+                       gt_str_get(pmopt->indexname));
+          haserr = true;
+        }
+      }
+    }
+  }
   if (!haserr)
   {
+    GtArrayGtUword fmipositions, esapositions;
     GtUword trial;
     GtUword dbstart;
     Enumpatterniterator *epi;
@@ -122,7 +237,9 @@ static int callpatternmatcher(const Pmatchoptions *pmopt, GtError *err)
     esr2 = gt_encseq_create_reader_with_readmode(suffixarray.encseq,
                                                  suffixarray.readmode, 0);
     alpha = gt_encseq_alphabet(suffixarray.encseq);
-    for (trial = 0; trial < pmopt->numofsamples; trial++)
+    GT_INITARRAY(&fmipositions,GtUword);
+    GT_INITARRAY(&esapositions,GtUword);
+    for (trial = 0; !haserr && trial < pmopt->numofsamples; trial++)
     {
       pptr = gt_nextEnumpatterniterator(&patternlen,epi);
       if (pmopt->showpatt)
@@ -229,7 +346,31 @@ static int callpatternmatcher(const Pmatchoptions *pmopt, GtError *err)
         gt_mmsearchiterator_delete(mmsiimm);
         mmsiimm = NULL;
       }
+      if (withfmindex)
+      {
+        fmilocatepattern(&fmipositions,&fmindex,pmopt->fmisingle,pptr,
+                         patternlen);
+        mmsiimm = gt_mmsearchiterator_new_complete_plain(
+                                            suffixarray.encseq,
+                                            suffixarray.suftab,
+                                            0,  /* leftbound */
+                                            totallength, /* rightbound */
+                                            0, /* offset */
+                                            suffixarray.readmode,
+                                            pptr,
+                                            patternlen);
+        esapositions.nextfreeGtUword = 0;
+        while (gt_mmsearchiterator_next(&dbstart,mmsiimm))
+        {
+          GT_STOREINARRAY(&esapositions,GtUword,128,dbstart);
+        }
+        gt_mmsearchiterator_delete(mmsiimm);
+        mmsiimm = NULL;
+        comparefmipositions(&fmipositions,&esapositions);
+      }
     }
+    GT_FREEARRAY(&fmipositions,GtUword);
+    GT_FREEARRAY(&esapositions,GtUword);
     gt_encseq_reader_delete(esr1);
     gt_encseq_reader_delete(esr2);
     if (pmopt->showpatt)
@@ -238,6 +379,10 @@ static int callpatternmatcher(const Pmatchoptions *pmopt, GtError *err)
     }
     gt_freeEnumpatterniterator(epi);
   }
+  if (withfmindex)
+  {
+    gt_freefmindex(&fmindex);
+  }
   gt_freesuffixarray(&suffixarray);
   return haserr ? -1 : 0;
 }
@@ -247,7 +392,7 @@ static GtOPrval parse_options(Pmatchoptions *pmopt,
                               int argc, const char **argv, GtError *err)
 {
   GtOptionParser *op;
-  GtOption *option, *optionimm, *optionbck;
+  GtOption *option, *optionimm, *optionbck, *optionfmi;
   GtOPrval oprval;
 
   gt_error_check(err);
@@ -290,6 +435,20 @@ static GtOPrval parse_options(Pmatchoptions *pmopt,
   gt_option_parser_add_option(op, option);
   gt_option_is_mandatory(option);
 
+  optionfmi = gt_option_new_string("fmi",
+                             "Specify fmindex of the reversed sequence and "
+                             "compare\nthe located matches with those in the "
+                             "input index",
+                             pmopt->fmindexname, NULL);
+  gt_option_parser_add_option(op, optionfmi);
+
+  option = gt_option_new_bool("fmisingle",
+                              "Locate the matches in the fmindex one by one",
+                              &pmopt->fmisingle,
+                              false);
+  gt_option_parser_add_option(op, option);
+  gt_option_imply(option, optionfmi);
+
   oprval = gt_option_parser_parse(op, parsed_args, argc, argv,
                                gt_versionfunc, err);
   gt_option_parser_delete(op);
@@ -307,6 +466,7 @@ int gt_patternmatch(int argc, const char **argv, GtError *err)
   gt_error_check(err);
 
   pmopt.indexname = gt_str_new();
+  pmopt.fmindexname = gt_str_new();
   oprval = parse_options(&pmopt,&parsed_args, argc, argv, err);
   if (oprval == GT_OPTION_PARSER_OK)
   {
@@ -317,6 +477,7 @@ int gt_patternmatch(int argc, const char **argv, GtError *err)
     }
   }
   gt_str_delete(pmopt.indexname);
+  gt_str_delete(pmopt.fmindexname);
   if (oprval == GT_OPTION_PARSER_REQUESTS_EXIT)
   {
     return 0;
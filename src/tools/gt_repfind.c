@@ -23,6 +23,7 @@
 #include "core/ma_api.h"
 #include "core/option_api.h"
 #include "core/str_api.h"
+#include "core/thread_api.h"
 #include "core/tool_api.h"
 #include "core/unused_api.h"
 #include "core/versionfunc_api.h"
@@ -138,6 +139,61 @@ static int gt_exact_selfmatch_with_output(void *info,
   return 0;
 }
 
+static void gt_exact_selfmatch_output_set(void *info,FILE *stream)
+{
+  GtProcessinfo_and_querymatchspaceptr *info_querymatch
+    = (GtProcessinfo_and_querymatchspaceptr *) info;
+
+  gt_querymatch_file_set(info_querymatch->querymatchspaceptr,stream);
+}
+
+/* enumerate the exact self matches with <numofthreads> threads, each
+   with a copy of <info_querymatch> and its own querymatch space */
+static int gt_exact_selfmatches_parallel(const GtMaxpairsoptions *arguments,
+                                         const
+                                         GtProcessinfo_and_querymatchspaceptr
+                                           *info_querymatch,
+                                         unsigned int numofthreads,
+                                         GtLogger *logger,
+                                         GtError *err)
+{
+  GtProcessinfo_and_querymatchspaceptr *threadinfo;
+  void **processmaxpairsinfo;
+  unsigned int thread;
+  int had_err;
+
+  threadinfo = gt_malloc(sizeof *threadinfo * numofthreads);
+  processmaxpairsinfo = gt_malloc(sizeof *processmaxpairsinfo * numofthreads);
+  for (thread = 0; thread < numofthreads; thread++)
+  {
+    threadinfo[thread] = *info_querymatch;
+    threadinfo[thread].querymatchspaceptr = gt_querymatch_new();
+    if (arguments->verify_alignment)
+    {
+      gt_querymatch_verify_alignment_set(threadinfo[thread].
+                                         querymatchspaceptr);
+    }
+    processmaxpairsinfo[thread] = (void *) (threadinfo + thread);
+  }
+  had_err = gt_callenummaxpairs_parallel(gt_str_get(arguments->indexname),
+                                         arguments->seedlength,
+                                         arguments->maxfreq,
+                                         gt_exact_selfmatch_with_output,
+                                         gt_exact_selfmatch_output_set,
+                                         processmaxpairsinfo,
+                                         numofthreads,
+                                         stdout,
+                                         logger,
+                                         err);
+  for (thread = 0; thread < numofthreads; thread++)
+  {
+    gt_querymatch_delete(threadinfo[thread].querymatchspaceptr);
+  }
+  gt_free(processmaxpairsinfo);
+  gt_free(threadinfo);
+  return had_err;
+}
+
 static int gt_suffix_prefix_match_with_output(GT_UNUSED void *info,
                                               const GtGenericEncseq
                                                 *genericencseq,
@@ -1033,16 +1089,31 @@ static int gt_repfind_runner(int argc,const char **argv, int parsed_args,
             }
             processmaxpairsdata = (void *) &info_querymatch;
           }
-          if (gt_callenummaxpairs(gt_str_get(arguments->indexname),
-                                  arguments->seedlength,
-                                  arguments->maxfreq,
-                                  arguments->scanfile,
-                                  processmaxpairs,
-                                  processmaxpairsdata,
-                                  logger,
-                                  err) != 0)
+          if (processmaxpairs == gt_exact_selfmatch_with_output &&
+              querymatchoutoptions == NULL && !arguments->scanfile &&
+              arguments->seedlength > 0 && gt_jobs > 1U)
           {
-            haserr = true;
+            if (gt_exact_selfmatches_parallel(arguments,
+                                              &info_querymatch,
+                                              gt_jobs,
+                                              logger,
+                                              err) != 0)
+            {
+              haserr = true;
+            }
+          } else
+          {
+            if (gt_callenummaxpairs(gt_str_get(arguments->indexname),
+                                    arguments->seedlength,
+                                    arguments->maxfreq,
+                                    arguments->scanfile,
+                                    processmaxpairs,
+                                    processmaxpairsdata,
+                                    logger,
+                                    err) != 0)
+            {
+              haserr = true;
+            }
           }
         }
         if (!haserr)
@@ -40,9 +40,6 @@
 #include "match/seed_extend_parts.h"
 #include "match/dbs_spaced_seeds.h"
 #include "tools/gt_seed_extend.h"
-#ifdef GT_THREADS_ENABLED
-#include "core/thread_api.h"
-#endif
 
 typedef struct {
   /* diagbandseed options */
@@ -698,13 +695,6 @@ static int gt_seed_extend_arguments_check(int rest_argc, void *tool_arguments,
       had_err = -1;
     }
   }
-#ifdef GT_THREADS_ENABLED
-  if (!had_err && arguments->compute_ani && gt_jobs > 1)
-  {
-    gt_error_set(err,"option -ani does not work with multiple threads");
-    had_err = -1;
-  }
-#endif
 
   /* minimum maxfreq value for 1 input file */
   if (!had_err && arguments->dbs_maxfreq == 1 &&
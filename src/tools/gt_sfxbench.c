@@ -0,0 +1,481 @@
+/*
+  Copyright (c) 2020 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <string.h>
+#include "core/encseq.h"
+#include "core/fa_api.h"
+#include "core/ma_api.h"
+#include "core/str_array_api.h"
+#include "core/timer_api.h"
+#include "core/unused_api.h"
+#include "core/xposix_api.h"
+#include "match/index_options.h"
+#include "match/sfx-apfxlen.h"
+#include "match/sfx-lwcheck.h"
+#include "match/sfx-sain.h"
+#include "match/sfx-strategy.h"
+#include "match/sfx-suffixer.h"
+#include "match/sfx-suffixgetset.h"
+#include "tools/gt_sfxbench.h"
+
+typedef enum
+{
+  GT_SFXBENCH_BUCKET,
+  GT_SFXBENCH_ALGBDS,
+  GT_SFXBENCH_DC,
+  GT_SFXBENCH_RADIX,
+  GT_SFXBENCH_SAIN,
+  GT_SFXBENCH_UNDEFINED
+} GtSfxbenchAlgorithm;
+
+static const char *gt_sfxbench_algorithm_names[] = {"bucket",
+                                                    "algbds",
+                                                    "dc",
+                                                    "radix",
+                                                    "sain"};
+
+typedef struct
+{
+  GtStrArray *algorithms,
+             *algbounds;
+  GtUword runs;
+  unsigned int differencecover,
+               numofparts;
+  bool check,
+       verbose;
+  /* the following are set by gt_sfxbench_arguments_check */
+  GtSfxbenchAlgorithm *algtab;
+  GtUword numofalgorithms;
+  Sfxstrategy algbdsstrategy;
+} GtSfxbenchArguments;
+
+static void *gt_sfxbench_arguments_new(void)
+{
+  GtSfxbenchArguments *arguments = gt_calloc((size_t) 1, sizeof *arguments);
+
+  arguments->algorithms = gt_str_array_new();
+  arguments->algbounds = gt_str_array_new();
+  return arguments;
+}
+
+static void gt_sfxbench_arguments_delete(void *tool_arguments)
+{
+  GtSfxbenchArguments *arguments = tool_arguments;
+
+  if (arguments != NULL)
+  {
+    gt_str_array_delete(arguments->algorithms);
+    gt_str_array_delete(arguments->algbounds);
+    gt_free(arguments->algtab);
+    gt_free(arguments);
+  }
+}
+
+static GtOptionParser *gt_sfxbench_option_parser_new(void *tool_arguments)
+{
+  GtSfxbenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+
+  gt_assert(arguments != NULL);
+  op = gt_option_parser_new("[option ...] indexname [indexname ...]",
+                            "Benchmark suffix array construction algorithms "
+                            "on encoded sequences.");
+  gt_option_parser_set_min_args(op, 1U);
+
+  option = gt_option_new_string_array("alg",
+                                      "algorithms to benchmark, choose from\n"
+                                      "bucket: bucket sorting as in "
+                                      "suffixerator\n"
+                                      "algbds: bucket sorting with the bounds "
+                                      "of option -algbds\n"
+                                      "dc: difference cover sampling with "
+                                      "modulus of option -dc\n"
+                                      "radix: bucket sorting with radixsort\n"
+                                      "sain: induced suffix sorting\n"
+                                      "default: all algorithms",
+                                      arguments->algorithms);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_string_array("algbds",
+                                      "length boundaries for insertion sort, "
+                                      "blindtrie sort and counting sort used "
+                                      "for algorithm algbds\n"
+                                      "default: 3 43 120",
+                                      arguments->algbounds);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uint_min("dc",
+                                  "difference cover modulus used for "
+                                  "algorithm dc",
+                                  &arguments->differencecover,
+                                  64U,
+                                  4U);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uint_min("parts",
+                                  "number of parts in which the suffix array "
+                                  "is computed by the bucket sorting "
+                                  "algorithms",
+                                  &arguments->numofparts,
+                                  1U,
+                                  1U);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("runs",
+                                   "number of runs of each algorithm for "
+                                   "each index",
+                                   &arguments->runs,
+                                   1UL,
+                                   1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_bool("check",
+                              "check the computed suffix arrays (not "
+                              "included in the measurements)",
+                              &arguments->check,
+                              false);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_verbose(&arguments->verbose);
+  gt_option_parser_add_option(op, option);
+  return op;
+}
+
+static int gt_sfxbench_arguments_check(GT_UNUSED int rest_argc,
+                                       void *tool_arguments,
+                                       GtError *err)
+{
+  GtSfxbenchArguments *arguments = tool_arguments;
+  const size_t numofnames = sizeof gt_sfxbench_algorithm_names/
+                            sizeof gt_sfxbench_algorithm_names[0];
+  GtUword idx;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments != NULL);
+  if (gt_str_array_size(arguments->algorithms) == 0)
+  {
+    for (idx = 0; idx < (GtUword) numofnames; idx++)
+    {
+      gt_str_array_add_cstr(arguments->algorithms,
+                            gt_sfxbench_algorithm_names[idx]);
+    }
+  }
+  arguments->numofalgorithms = gt_str_array_size(arguments->algorithms);
+  arguments->algtab = gt_malloc(sizeof *arguments->algtab *
+                                arguments->numofalgorithms);
+  for (idx = 0; !had_err && idx < arguments->numofalgorithms; idx++)
+  {
+    const char *name = gt_str_array_get(arguments->algorithms,idx);
+    size_t alg;
+
+    arguments->algtab[idx] = GT_SFXBENCH_UNDEFINED;
+    for (alg = 0; alg < numofnames; alg++)
+    {
+      if (strcmp(name,gt_sfxbench_algorithm_names[alg]) == 0)
+      {
+        arguments->algtab[idx] = (GtSfxbenchAlgorithm) alg;
+        break;
+      }
+    }
+    if (arguments->algtab[idx] == GT_SFXBENCH_UNDEFINED)
+    {
+      gt_error_set(err,"option -alg: illegal algorithm \"%s\"",name);
+      had_err = -1;
+    }
+  }
+  if (!had_err && gt_str_array_size(arguments->algbounds) == 0)
+  {
+    gt_str_array_add_cstr(arguments->algbounds,"3");
+    gt_str_array_add_cstr(arguments->algbounds,"43");
+    gt_str_array_add_cstr(arguments->algbounds,"120");
+  }
+  if (!had_err &&
+      gt_parse_algbounds(&arguments->algbdsstrategy,arguments->algbounds,
+                         err) != 0)
+  {
+    had_err = -1;
+  }
+  return had_err;
+}
+
+static GtUchar gt_sfxbench_accesschar(const void *encseq,GtUword position,
+                                      GtReadmode readmode)
+{
+  return gt_encseq_get_encoded_char((const GtEncseq *) encseq,
+                                    position,
+                                    readmode);
+}
+
+static GtUword gt_sfxbench_charcount(const void *encseq,GtUchar idx)
+{
+  return gt_encseq_charcount((const GtEncseq *) encseq, idx);
+}
+
+typedef struct
+{
+  GtUword wallusec,
+          cpuusec,
+          spacepeak,
+          mmappeak;
+} GtSfxbenchMeasurement;
+
+static GtUword gt_sfxbench_cpuusec(void)
+{
+  struct rusage ru;
+
+  gt_xgetrusage(RUSAGE_SELF, &ru);
+  return (GtUword) (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000UL +
+         (GtUword) (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec);
+}
+
+/* computes the suffix array of <encseq> with the bucket sorting algorithm of
+   the suffixerator. If <suftab> is not NULL, the suffixes are stored in it
+   for a later check. */
+static int gt_sfxbench_bucketsort(const GtEncseq *encseq,
+                                  const Sfxstrategy *sfxstrategy,
+                                  unsigned int numofparts,
+                                  GtUword *suftab,
+                                  GtLogger *logger,
+                                  GtError *err)
+{
+  Sfxiterator *sfi;
+  unsigned int prefixlength;
+  bool haserr = false;
+
+  prefixlength
+    = gt_recommendedprefixlength(gt_encseq_alphabetnumofchars(encseq),
+                                 gt_encseq_total_length(encseq),
+                                 GT_RECOMMENDED_MULTIPLIER_DEFAULT,
+                                 true);
+  sfi = gt_Sfxiterator_new(encseq,
+                           GT_READMODE_FORWARD,
+                           prefixlength,
+                           numofparts,
+                           0, /* maximumspace */
+                           sfxstrategy,
+                           NULL, /* sfxprogress */
+                           false, /* withprogressbar */
+                           logger,
+                           err);
+  if (sfi == NULL)
+  {
+    haserr = true;
+  } else
+  {
+    const GtSuffixsortspace *suffixsortspace;
+    GtUword numberofsuffixes, nextfree = 0;
+
+    while ((suffixsortspace = gt_Sfxiterator_next(&numberofsuffixes,NULL,sfi))
+           != NULL)
+    {
+      if (suftab != NULL)
+      {
+        GtUword idx;
+
+        for (idx = 0; idx < numberofsuffixes; idx++)
+        {
+          suftab[nextfree + idx]
+            = gt_suffixsortspace_getdirect(suffixsortspace,idx);
+        }
+      }
+      nextfree += numberofsuffixes;
+    }
+    gt_assert(nextfree == gt_encseq_total_length(encseq) + 1);
+    if (gt_Sfxiterator_delete(sfi,err) != 0)
+    {
+      haserr = true;
+    }
+  }
+  return haserr ? -1 : 0;
+}
+
+static int gt_sfxbench_run(GtSfxbenchMeasurement *measurement,
+                           const GtSfxbenchArguments *arguments,
+                           GtSfxbenchAlgorithm alg,
+                           const GtEncseq *encseq,
+                           GtLogger *logger,
+                           GtError *err)
+{
+  GtUword totallength = gt_encseq_total_length(encseq),
+          cpuusec,
+          spacebase,
+          mmapbase,
+          *suftab = NULL;
+  GtUsainindextype *sainsuftab = NULL;
+  GtTimer *timer;
+  bool haserr = false;
+
+  if (arguments->check && alg != GT_SFXBENCH_SAIN)
+  {
+    suftab = gt_malloc(sizeof *suftab * (totallength + 1));
+  }
+  gt_ma_reset_space_peak();
+  gt_fa_reset_space_peak();
+  spacebase = gt_ma_get_space_current();
+  mmapbase = gt_fa_get_space_current();
+  timer = gt_timer_new();
+  cpuusec = gt_sfxbench_cpuusec();
+  gt_timer_start(timer);
+  if (alg == GT_SFXBENCH_SAIN)
+  {
+    sainsuftab = gt_sain_encseq_sortsuffixes(encseq,
+                                             GT_READMODE_FORWARD,
+                                             false, /* intermediatecheck */
+                                             false, /* finalcheck */
+                                             logger,
+                                             NULL);
+  } else
+  {
+    Sfxstrategy sfxstrategy;
+
+    defaultsfxstrategy(&sfxstrategy,
+                       gt_encseq_bitwise_cmp_ok(encseq) ? false : true);
+    switch (alg)
+    {
+      case GT_SFXBENCH_ALGBDS:
+        sfxstrategy.maxinsertionsort
+          = arguments->algbdsstrategy.maxinsertionsort;
+        sfxstrategy.maxbltriesort = arguments->algbdsstrategy.maxbltriesort;
+        sfxstrategy.maxcountingsort
+          = arguments->algbdsstrategy.maxcountingsort;
+        break;
+      case GT_SFXBENCH_DC:
+        sfxstrategy.differencecover = arguments->differencecover;
+        break;
+      case GT_SFXBENCH_RADIX:
+        sfxstrategy.withradixsort = true;
+        break;
+      default:
+        break;
+    }
+    if (gt_sfxbench_bucketsort(encseq,&sfxstrategy,arguments->numofparts,
+                               suftab,logger,err) != 0)
+    {
+      haserr = true;
+    }
+  }
+  measurement->wallusec = (GtUword) gt_timer_elapsed_usec(timer);
+  measurement->cpuusec = gt_sfxbench_cpuusec() - cpuusec;
+  measurement->spacepeak = gt_ma_get_space_peak() - spacebase;
+  measurement->mmappeak = gt_fa_get_space_peak() - mmapbase;
+  gt_timer_delete(timer);
+  if (!haserr && arguments->check)
+  {
+    gt_suftab_lightweightcheck(gt_sfxbench_accesschar,
+                               gt_sfxbench_charcount,
+                               encseq,
+                               GT_READMODE_FORWARD,
+                               totallength,
+                               gt_encseq_alphabetnumofchars(encseq),
+                               sainsuftab != NULL ? (const void *) sainsuftab
+                                                  : (const void *) suftab,
+                               sainsuftab != NULL ? sizeof *sainsuftab
+                                                  : sizeof *suftab,
+                               logger);
+  }
+  gt_free(sainsuftab);
+  gt_free(suftab);
+  return haserr ? -1 : 0;
+}
+
+static int gt_sfxbench_runner(int argc, const char **argv, int parsed_args,
+                              void *tool_arguments, GtError *err)
+{
+  GtSfxbenchArguments *arguments = tool_arguments;
+  GtEncseqLoader *encseq_loader = gt_encseq_loader_new();
+  GtLogger *logger = gt_logger_new(arguments->verbose,
+                                   GT_LOGGER_DEFLT_PREFIX,stdout);
+  bool bookkeeping = gt_ma_bookkeeping_enabled();
+  int argnum, had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments != NULL);
+  if (!bookkeeping)
+  {
+    printf("# space peak requires GT_MEM_BOOKKEEPING=on\n");
+  }
+  printf("# index\talgorithm\trun\tlength\twall(s)\tcpu(s)\tspace(bytes)\t"
+         "mmap(bytes)\tbytes/s\n");
+  for (argnum = parsed_args; !had_err && argnum < argc; argnum++)
+  {
+    const char *indexname = argv[argnum];
+    GtEncseq *encseq = gt_encseq_loader_load(encseq_loader,indexname,err);
+    GtUword algnum, run;
+
+    if (encseq == NULL)
+    {
+      had_err = -1;
+      break;
+    }
+    for (algnum = 0; !had_err && algnum < arguments->numofalgorithms;
+         algnum++)
+    {
+      GtSfxbenchAlgorithm alg = arguments->algtab[algnum];
+
+      if (alg == GT_SFXBENCH_SAIN &&
+          gt_sain_checkmaxsequencelength(gt_encseq_total_length(encseq),true,
+                                         err) != 0)
+      {
+        printf("# %s: skip algorithm sain: %s\n",indexname,gt_error_get(err));
+        gt_error_unset(err);
+        continue;
+      }
+      for (run = 0; !had_err && run < arguments->runs; run++)
+      {
+        GtSfxbenchMeasurement measurement;
+        GtUword length = gt_encseq_total_length(encseq);
+
+        if (gt_sfxbench_run(&measurement,arguments,alg,encseq,logger,
+                            err) != 0)
+        {
+          had_err = -1;
+          break;
+        }
+        printf("%s\t%s\t" GT_WU "\t" GT_WU "\t%.3f\t%.3f\t",
+               indexname,gt_sfxbench_algorithm_names[alg],run,length,
+               (double) measurement.wallusec/1000000.0,
+               (double) measurement.cpuusec/1000000.0);
+        if (bookkeeping)
+        {
+          printf(GT_WU "\t",measurement.spacepeak);
+        } else
+        {
+          printf("NA\t");
+        }
+        printf(GT_WU "\t%.0f\n",measurement.mmappeak,
+               measurement.wallusec > 0
+                 ? (double) length * 1000000.0/measurement.wallusec
+                 : 0.0);
+      }
+    }
+    gt_encseq_delete(encseq);
+  }
+  gt_logger_delete(logger);
+  gt_encseq_loader_delete(encseq_loader);
+  return had_err;
+}
+
+GtTool *gt_sfxbench(void)
+{
+  return gt_tool_new(gt_sfxbench_arguments_new,
+                     gt_sfxbench_arguments_delete,
+                     gt_sfxbench_option_parser_new,
+                     gt_sfxbench_arguments_check,
+                     gt_sfxbench_runner);
+}
@@ -21,6 +21,7 @@
 #include "core/option_api.h"
 #include "core/str_array_api.h"
 #include "core/unused_api.h"
+#include "core/bitbuffer.h"
 #include "core/format64.h"
 #include "core/fa_api.h"
 #include "core/mathsupport_api.h"
@@ -30,6 +31,7 @@
 #include "match/esa-map.h"
 #include "match/esa-seqread.h"
 #include "match/esa-spmitvs.h"
+#include "match/esa-sufcompressed.h"
 #include "match/index_options.h"
 #include "match/optionargmode.h"
 #include "match/pckdfs.h"
@@ -864,95 +866,23 @@ static int gt_sfxmap_compressedesa(const char *indexname,GtError *err)
   }
   if (!haserr)
   {
-    uint64_t writtenbits;
-    uint8_t bitsperentry;
-    GtUword numberofentries = 0;
+    GtSuftabcompressed suftabcompressed;
     GtUword totallength = gt_encseq_total_length(encseq);
-    FILE *fp;
 
-    fp = gt_fa_fopen_with_suffix(indexname,GT_SUFTABSUFFIX_BYTECOMPRESSED,
-                                 "rb",err);
-    if (fp == NULL)
+    gt_suftabcompressed_init(&suftabcompressed);
+    if (gt_suftabcompressed_map(&suftabcompressed,indexname,totallength + 1,
+                                err) != 0)
     {
       haserr = true;
-    }
-    if (!haserr)
-    {
-      if (fread(&writtenbits,sizeof writtenbits,(size_t) 1,fp)
-          != (size_t) 1)
-      {
-        gt_error_set(err,"cannot read %d bytes from %s%s at offset 0",
-                        (int) sizeof writtenbits,
-                        indexname,GT_SUFTABSUFFIX_BYTECOMPRESSED);
-        haserr = true;
-      }
-    }
-    if (!haserr)
-    {
-      if (fread(&bitsperentry,sizeof bitsperentry,(size_t) 1,fp)
-          != (size_t) 1)
-      {
-        gt_error_set(err,"cannot read %d bytes from %s%s at offset %d",
-                        (int) sizeof bitsperentry,
-                        indexname,GT_SUFTABSUFFIX_BYTECOMPRESSED,
-                        (int) sizeof writtenbits);
-        haserr = true;
-      }
-      gt_assert(writtenbits % bitsperentry == 0);
-      numberofentries = (GtUword) (writtenbits/bitsperentry);
-      gt_assert(numberofentries == totallength + 1);
-    }
-    if (!haserr)
+    } else
     {
-      uint64_t readvalue = 0;
-      const unsigned int bitspervalue = 64U;
-      unsigned int bits2add = (unsigned int) bitsperentry,
-                   remainingbits = 0;
-      GtUword bitbuffer = 0,
-                    countentries = 0,
-                    *suftabptr,
-                    *suftab = gt_malloc(sizeof *suftab *
-                                        (size_t) numberofentries);
-
-      suftabptr = suftab;
-      while (true)
+      GtUword idx, *suftab = gt_malloc(sizeof *suftab *
+                                       (size_t) (totallength + 1));
+
+      for (idx = 0; idx <= totallength; idx++)
       {
-        if (remainingbits == 0)
-        {
-          if (fread(&readvalue,sizeof readvalue,(size_t) 1,fp) != (size_t) 1)
-          {
-            break;
-          }
-          remainingbits = bitspervalue;
-        } else
-        {
-          if (remainingbits >= (unsigned int) bits2add)
-          {
-            if (suftabptr >= suftab + numberofentries)
-            {
-              break;
-            }
-            bitbuffer |= ((GtUword) (readvalue) &
-                         ((1UL << bits2add) - 1)) << (bitsperentry-bits2add);
-            readvalue >>= bits2add;
-            remainingbits -= bits2add;
-            gt_assert(bitbuffer < (1UL << bitsperentry));
-            *suftabptr++ = bitbuffer;
-            bitbuffer = 0;
-            bits2add = (unsigned int) bitsperentry;
-            countentries++;
-          } else
-          {
-            gt_assert(remainingbits < 64U);
-            bitbuffer |= (readvalue & ((((uint64_t) 1) << remainingbits) - 1))
-                         << (bitsperentry-bits2add);
-            readvalue >>= remainingbits;
-            bits2add -= remainingbits;
-            remainingbits = 0;
-          }
-        }
+        suftab[idx] = gt_suftabcompressed_get(&suftabcompressed,idx);
       }
-      gt_assert(countentries == numberofentries);
       gt_suftab_lightweightcheck(sfx_accesschar_encseq,
                                  sfx_charcount_encseq,
                                  encseq,
@@ -964,7 +894,7 @@ static int gt_sfxmap_compressedesa(const char *indexname,GtError *err)
                                  NULL);
       gt_free(suftab);
     }
-    gt_fa_fclose(fp);
+    gt_suftabcompressed_unmap(&suftabcompressed);
   }
   gt_encseq_delete(encseq);
   return haserr ? -1 : 0;
@@ -24,6 +24,7 @@
 #include "core/ma_api.h"
 #include "core/option_api.h"
 #include "core/str_api.h"
+#include "core/thread_api.h"
 #include "core/tool.h"
 #include "core/toolbox.h"
 #include "core/unused_api.h"
@@ -266,6 +267,7 @@ static int gt_tyr_mkindex_runner(GT_UNUSED int argc,
                     arguments->storecounts,
                     arguments->scanfile,
                     arguments->performtest,
+                    gt_jobs,
                     logger,
                     err) != 0)
   {
@@ -796,7 +798,8 @@ typedef struct
   GtStrArray *showmodespec;
   unsigned int strand,
                showmode;
-  bool verbose,
+  bool batch,
+       verbose,
        performtest;
 } Tyr_search_options;
 
@@ -866,6 +869,14 @@ static GtOptionParser *gt_tyr_search_option_parser_new(void *tool_arguments)
                                       arguments->showmodespec);
   gt_option_parser_add_option(op, option);
 
+  option = gt_option_new_bool("batch",
+                              "sort the mers of each query sequence and "
+                              "merge them with the index instead of "
+                              "searching each mer separately",
+                              &arguments->batch,
+                              false);
+  gt_option_parser_add_option(op, option);
+
   option = gt_option_new_bool("test", "perform tests to verify program "
                                       "correctness", &arguments->performtest,
                                       false);
@@ -941,6 +952,7 @@ static int gt_tyr_search_runner(GT_UNUSED int argc,
                    arguments->queryfilenames,
                    arguments->showmode,
                    arguments->strand,
+                   arguments->batch,
                    arguments->verbose,
                    arguments->performtest,
                    err) != 0)
@@ -442,3 +442,48 @@ Test do
     end
   end
 end
+
+Name "gt encseq check extraction of ranges"
+Keywords "encseq gt_encseq extract"
+Test do
+  ["U89959_genomic.fas","at1MB","Atinsert.fna"].each do |file|
+    ["bit","uchar","ushort","uint32","direct"].each do |sat|
+      run_test "#{$bin}gt encseq encode -sat #{sat} -indexname foo " +
+               "#{$testdata}#{file}"
+      run_test "#{$bin}gt encseq check -scantrials 100 foo"
+    end
+  end
+end
+
+Name "gt encseq encode/suffixerator -j output equals -j 1 output"
+Keywords "encseq gt_encseq_encode gt_suffixerator threads"
+Test do
+  # the FASTQ file and the multi-file input span several read-ahead blocks
+  File.open("long.fastq", "w") do |file|
+    content = File.read("#{$testdata}fastq_long.fastq")
+    12.times { file.write(content) }
+  end
+  [["#{$testdata}at1MB"],
+   ["long.fastq"],
+   ["#{$testdata}at1MB", "#{$testdata}U89959_genomic.fas",
+    "#{$testdata}tRNA.dos.fas", "#{$testdata}fib25.fas.gz"],
+   ["#{$testdata}sw100K1.fsa", "#{$testdata}sw100K2.fsa"]].each do |files|
+    [1,2,3].each do |jobs|
+      run_test "#{$bin}gt -j #{jobs} encseq encode -des -ssp -sds -md5 " +
+               "-lossless -indexname enc#{jobs} #{files.join(" ")}",
+               :maxtime => 300
+      run_test "#{$bin}gt -j #{jobs} suffixerator -des -ssp -sds -md5 " +
+               "-lossless -tis -suf -indexname sfx#{jobs} " +
+               "-db #{files.join(" ")}", :maxtime => 300
+    end
+    [2,3].each do |jobs|
+      ["esq","des","ssp","sds","md5","ois"].each do |suffix|
+        run "cmp enc1.#{suffix} enc#{jobs}.#{suffix}"
+      end
+      ["esq","des","ssp","sds","md5","ois","suf","prj"].each do |suffix|
+        run "cmp sfx1.#{suffix} sfx#{jobs}.#{suffix}"
+      end
+    end
+    run "rm -f enc[123].* sfx[123].*"
+  end
+end
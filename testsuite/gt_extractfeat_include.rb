@@ -338,3 +338,55 @@ Test do
     :retval => 1
   grep(last_stderr, "could match more than one sequence")
 end
+
+Name "gt extractfeat -matchdescstart seqid table"
+Keywords "gt_extractfeat matchdescstart seqid_tab"
+Test do
+  FileUtils.copy "#{$testdata}gt_extractfeat_matchdescstart_1.fas", "."
+  run "#{$bin}gt encseq encode -lossless -indexname foo " \
+    "gt_extractfeat_matchdescstart_1.fas"
+  extractcall = "#{$bin}gt extractfeat -encseq foo -type gene -matchdescstart"
+  # the table is computed and stored with the index
+  run_test "#{extractcall} #{$testdata}gt_extractfeat_matchdescstart_1.gff3"
+  run "diff #{last_stdout} #{$testdata}gt_extractfeat_matchdescstart_1.out"
+  run "test -s foo.sid"
+  run "cp foo.sid foo.sid.orig"
+  # and mapped on later runs
+  run_test "#{extractcall} #{$testdata}gt_extractfeat_matchdescstart_1.gff3"
+  run "diff #{last_stdout} #{$testdata}gt_extractfeat_matchdescstart_1.out"
+  run "cmp foo.sid foo.sid.orig"
+  # sequence IDs not in the table
+  File.open("absent.gff3", "w") do |file|
+    file.puts "##gff-version 3"
+    file.puts "##sequence-region fo 1 100"
+    file.puts "fo\t.\tgene\t10\t20\t.\t+\t.\tID=fo"
+  end
+  run_test "#{extractcall} absent.gff3", :retval => 1
+  grep(last_stderr, "no description matched sequence ID 'fo'")
+  # corrupted tables, which are newer than the index, are recomputed
+  orig = File.binread("foo.sid.orig")
+  half = orig.size / 2
+  [orig[0, half - 1], "\xff" * orig.size,
+   orig[half, half] + orig[0, half]].each do |corrupted|
+    File.binwrite("foo.sid", corrupted)
+    run_test "#{extractcall} #{$testdata}gt_extractfeat_matchdescstart_1.gff3"
+    run "diff #{last_stdout} #{$testdata}gt_extractfeat_matchdescstart_1.out"
+    run "cmp foo.sid foo.sid.orig"
+  end
+  # a stale table of an index with the same sequences in another order is
+  # recomputed, even if it is not older than the index
+  File.open("reordered.fas", "w") do |file|
+    File.read("gt_extractfeat_matchdescstart_1.fas").split(/^(?=>)/).reverse.
+      each do |entry|
+      file.write(entry)
+    end
+  end
+  run "#{$bin}gt encseq encode -lossless -indexname foo reordered.fas"
+  run "cp foo.sid.orig foo.sid"
+  run_test "#{extractcall} #{$testdata}gt_extractfeat_matchdescstart_1.gff3"
+  run "diff #{last_stdout} #{$testdata}gt_extractfeat_matchdescstart_1.out"
+  run "cmp -s foo.sid foo.sid.orig", :retval => 1
+  # gt clean removes the table
+  run_test "#{$bin}gt clean"
+  run "test ! -e foo.sid"
+end
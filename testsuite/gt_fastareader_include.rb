@@ -0,0 +1,67 @@
+# files whose sequences contain no blanks or carriage returns, these are
+# reported with the same length by all readers
+fastareader_plainfiles = ["Atinsert.fna",
+                          "Duplicate.fna",
+                          "Random159.fna",
+                          "Random160.fna",
+                          "RandomN.fna",
+                          "U89959_genomic.fas",
+                          "at1MB",
+                          "nowildcardatend_rev.fna",
+                          "trna_glutamine.fna"]
+
+# the rec reader only counts sequence characters, while the fsm and the buf
+# reader also count blanks and carriage returns in the sequence lines
+fastareader_blankfiles = ["fasta_crlf_blanklines.fas",
+                          "marker.fas",
+                          "tRNA.dos.fas"]
+
+fastareader_errorfiles = ["corrupt.fas",
+                          "empty_seq.fas",
+                          "gt_bioseq_fail_1.fas",
+                          "gt_bioseq_fail_3.fas",
+                          "gt_bioseq_fail_5.fas",
+                          "gt_bioseq_fail_7.fas"]
+
+(fastareader_plainfiles + fastareader_blankfiles).each do |file|
+  Name "gt fastareader rec/fsm/buf #{file}"
+  Keywords "gt_fastareader fastareader"
+  Test do
+    ["rec","fsm","buf"].each do |reader|
+      run_test "#{$bin}gt dev fastareader -reader #{reader} " +
+               "#{$testdata}#{file}", :maxtime => 120
+      run "mv #{last_stdout} #{reader}.out"
+    end
+    run "cmp fsm.out buf.out"
+    if fastareader_plainfiles.member?(file)
+      run "cmp rec.out buf.out"
+    else
+      ["rec","buf"].each do |reader|
+        run "grep -v '^length' #{reader}.out"
+        run "mv #{last_stdout} #{reader}.seq"
+      end
+      run "cmp rec.seq buf.seq"
+    end
+  end
+end
+
+Name "gt fastareader CRLF and blank lines"
+Keywords "gt_fastareader fastareader"
+Test do
+  run_test "#{$bin}gt dev fastareader -reader buf " +
+           "#{$testdata}fasta_crlf_blanklines.fas"
+  run "diff #{last_stdout} #{$testdata}fasta_crlf_blanklines.out"
+end
+
+fastareader_errorfiles.each do |file|
+  Name "gt fastareader rec/fsm/buf #{file} (failure)"
+  Keywords "gt_fastareader fastareader"
+  Test do
+    ["rec","fsm","buf"].each do |reader|
+      run_test "#{$bin}gt dev fastareader -reader #{reader} " +
+               "#{$testdata}#{file}", :retval => 1
+      run "mv #{last_stderr} #{reader}.err"
+    end
+    run "cmp fsm.err buf.err"
+  end
+end
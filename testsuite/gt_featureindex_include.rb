@@ -65,4 +65,125 @@ if not $arguments["nordb"] then
     end
   end
 
+  FEATUREINDEX_TEST_FILES.each do |file|
+    Name "gt featureindex db vs. mapped (#{File.basename(file)})"
+    Keywords "gt_featureindex gt_featureindex_mapped"
+    Test do
+      run "#{$bin}gt seqids #{file}"
+      seqids = File.open(last_stdout).readlines
+      run "#{$bin}gt mkfeatureindex -filename tmp.db #{file}", :maxtime => 1200
+      run "#{$bin}gt mkfeatureindex -backend mapped -filename tmp.fim #{file}"
+      seqids.each do |seqid|
+        seqid.chomp!
+        run "#{$bin}gt featureindex -seqid #{seqid} -retain no -filename tmp.db > out.gff3"
+        run "#{$bin}gt featureindex -backend mapped -seqid #{seqid} -retain no " +
+            "-filename tmp.fim"
+        run "diff out.gff3 #{last_stdout}"
+      end
+    end
+  end
+
+end
+
+Name "gt featureindex mapped (empty file)"
+Keywords "gt_featureindex gt_featureindex_mapped"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend mapped -filename tmp.fim " +
+      "#{$testdata}/gt_view_prob_1.gff3"
+  run "#{$bin}gt featureindex -backend mapped -filename tmp.fim", :retval => 1
+  grep(last_stderr, /no sequence regions in index/)
+end
+
+Name "gt featureindex mapped (empty region)"
+Keywords "gt_featureindex gt_featureindex_mapped"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend mapped -filename tmp.fim " +
+      "#{$testdata}/gt_view_prob_2.gff3"
+  run "#{$bin}gt featureindex -backend mapped -filename tmp.fim"
+  run "diff #{last_stdout} #{$testdata}/gt_view_prob_2.gff3"
+end
+
+Name "gt featureindex mapped (existing file)"
+Keywords "gt_featureindex gt_featureindex_mapped"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend mapped -filename tmp.fim " +
+      "#{$testdata}/eden.gff3"
+  run "#{$bin}gt mkfeatureindex -backend mapped -filename tmp.fim " +
+      "#{$testdata}/eden.gff3", :retval => 1
+  grep(last_stderr, /exists already/)
+  run "#{$bin}gt mkfeatureindex -force -backend mapped -filename tmp.fim " +
+      "#{$testdata}/eden.gff3"
+end
+
+Name "gt featureindex mapped (invalid sequence ID)"
+Keywords "gt_featureindex gt_featureindex_mapped"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend mapped -filename tmp.fim " +
+      "#{$testdata}/standard_gene_simple.gff3"
+  run "#{$bin}gt featureindex -backend mapped -seqid foo -filename tmp.fim",
+      :retval => 1
+  grep(last_stderr, /does not contain the given sequence id/)
+end
+
+Name "gt featureindex mapped (corrupt file)"
+Keywords "gt_featureindex gt_featureindex_mapped"
+Test do
+  File.open("corrupt.fim", "w") do |file|
+    file.write("sdfnhsnl")
+  end
+  run "#{$bin}gt featureindex -backend mapped -filename corrupt.fim",
+      :retval => 1
+  grep(last_stderr, /is not a feature index file/)
+end
+
+Name "gt featureindex mapped (callbacks)"
+Keywords "gt_featureindex gt_featureindex_mapped"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend mapped -filename tmp.fim " +
+      "#{$testdata}/eden.gff3"
+  run "#{$bin}gt featureindex -backend mapped -child_check -attributes_check " +
+      "-filename tmp.fim"
+end
+
+FEATUREINDEX_MAPPED_TEST_FILES = \
+  ["#{$testdata}/eden.gff3",
+   "#{$testdata}/standard_gene_simple.gff3",
+   "#{$testdata}/standard_gene_as_tree.gff3",
+   "#{$testdata}/standard_gene_with_introns_as_tree.gff3",
+   "#{$testdata}/encode_known_genes_Mar07.gff3"]
+
+FEATUREINDEX_MAPPED_TEST_FILES.each do |file|
+  Name "gt featureindex mapped vs. parser (#{File.basename(file)})"
+  Keywords "gt_featureindex gt_featureindex_mapped"
+  Test do
+    run "#{$bin}gt seqids #{file}"
+    seqids = File.open(last_stdout).readlines
+    run "#{$bin}gt mkfeatureindex -backend mapped -filename tmp.fim #{file}"
+    seqids.each do |seqid|
+      seqid.chomp!
+      run "#{$bin}gt featureindex -backend mapped -seqid #{seqid} -retain no " +
+          "-filename tmp.fim > out.gff3"
+      run "#{$bin}gt gff3 -retainids no #{file} | " +
+          "#{$bin}gt select -seqid #{seqid}"
+      run "diff out.gff3 #{last_stdout}"
+    end
+  end
+end
+
+Name "gt featureindex mapped vs. parser (ranges)"
+Keywords "gt_featureindex gt_featureindex_mapped"
+Test do
+  file = "#{$testdata}/encode_known_genes_Mar07.gff3"
+  run "#{$bin}gt mkfeatureindex -backend mapped -filename tmp.fim #{file}"
+  [["chr2", 220204557, 220228999],
+   ["chr2", 220223110, 220223110],
+   ["chr7", 1, 100000000],
+   ["chr7", 26000000, 27000000],
+   ["chrX", 1, 5]].each do |seqid, startpos, endpos|
+    run "#{$bin}gt featureindex -backend mapped -seqid #{seqid} " +
+        "-range #{startpos} #{endpos} -retain no -filename tmp.fim > out.gff3"
+    run "#{$bin}gt gff3 -retainids no #{file} | " +
+        "#{$bin}gt select -seqid #{seqid} -overlap #{startpos} #{endpos}"
+    run "diff out.gff3 #{last_stdout}"
+  end
 end
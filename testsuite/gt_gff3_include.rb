@@ -1554,6 +1554,88 @@ Test do
   run "diff #{last_stdout} 1"
 end
 
+Name "gt gff3 -sortmemory"
+Keywords "gt_gff3 sortmemory"
+Test do
+  files = "#{$testdata}U89959_sas.gff3 " +
+          "#{$testdata}encode_known_genes_Mar07.gff3 " +
+          "#{$testdata}interfeat_pseudo.gff3 " +
+          "#{$testdata}unknown_meta_directive.gff3 #{$testdata}U89959_sas.gff3"
+  ["", "-retainids"].each do |opt|
+    run_test "#{$bin}gt gff3 -sort #{opt} #{files} > 1 2> 1.err"
+    run_test "#{$bin}gt gff3 -sort -sortmemory 1 #{opt} #{files} > 2 2> 2.err"
+    run "diff 1 2"
+    run "diff 1.err 2.err"
+  end
+end
+
+Name "gt gff3 -sortmemory (without sorting)"
+Keywords "gt_gff3 sortmemory"
+Test do
+  run_test "#{$bin}gt gff3 -sortmemory 1 #{$testdata}eden.gff3", :retval => 1
+  grep(last_stderr, "requires")
+end
+
+Name "gt -j 4 gff3"
+Keywords "gt_gff3 threads"
+Test do
+  files = "#{$testdata}encode_known_genes_Mar07.gff3 " +
+          "#{$testdata}U89959_sas.gff3 " +
+          "#{$testdata}unknown_meta_directive.gff3 " +
+          "#{$testdata}standard_fasta_example.gff3"
+  ["", "-tidy", "-retainids"].each do |opt|
+    run_test "#{$bin}gt gff3 #{opt} #{files} > 1 2> 1.err"
+    run_test "#{$bin}gt -j 4 gff3 #{opt} #{files} > 2 2> 2.err"
+    run "diff 1 2"
+    run "diff 1.err 2.err"
+  end
+end
+
+Name "gt -j 4 gff3 (without terminators)"
+Keywords "gt_gff3 threads"
+Test do
+  # chunks are cut at sequence id changes or after 1MB, lines referring to
+  # features of previous chunks join them
+  [[["chrA", 4000], ["chrB", 3000], ["chrA", 1], ["chrC", 3000]],
+   [["chrA", 8000]]].each_with_index do |parts, file_num|
+    File.open("noterm#{file_num}.gff3", "w") do |file|
+      file.puts "##gff-version 3"
+      parts.each_with_index do |(seqid, num), part|
+        num.times do |n|
+          id = "#{seqid}_#{part}_#{n}"
+          pos = 1 + n * 1000
+          file.puts "#{seqid}\t.\tgene\t#{pos}\t#{pos + 900}\t.\t+\t.\t" +
+                    "ID=#{id}"
+          file.puts "#{seqid}\t.\texon\t#{pos}\t#{pos + 200}\t.\t+\t.\t" +
+                    "Parent=#{id}"
+          file.puts "#{seqid}\t.\texon\t#{pos + 400}\t#{pos + 900}\t.\t+\t.\t" +
+                    "Parent=#{id}"
+        end
+        # a multi-feature spread over chunks
+        if part == 0 or part == 2
+          file.puts "chrA\t.\tmatch\t#{part * 100 + 1}\t#{part * 100 + 99}\t" +
+                    ".\t+\t.\tID=match"
+        end
+      end
+    end
+    ["", "-tidy -retainids"].each do |opt|
+      run_test "#{$bin}gt gff3 #{opt} noterm#{file_num}.gff3 > 1 2> 1.err"
+      run_test "#{$bin}gt -j 4 gff3 #{opt} noterm#{file_num}.gff3 > 2 2> 2.err"
+      run "diff 1 2"
+      run "diff 1.err 2.err"
+    end
+  end
+end
+
+Name "gt -j 4 gff3 (corrupt input)"
+Keywords "gt_gff3 threads"
+Test do
+  run "#{$bin}gt gff3 #{$testdata}corrupt_large.gff3", :retval => 1
+  run "mv #{last_stderr} 1.err"
+  run "#{$bin}gt -j 4 gff3 #{$testdata}corrupt_large.gff3", :retval => 1
+  run "diff 1.err #{last_stderr}"
+end
+
 Name "gt gff3 (double free regression)"
 Keywords "gt_gff3"
 Test do
@@ -100,6 +100,32 @@ Test do
   run_test "#{$bin}gt dev patternmatch -samples 10000 -ii sfx"
 end
 
+Name "gt patternmatch fmindex locate"
+Keywords "gt_patternmatch gt_mkfmindex"
+Test do
+  reffile = "#{$testdata}at1MB"
+  run_test "#{$bin}gt suffixerator -dna -tis -suf -db #{reffile} " +
+           "-indexname fwd"
+  run_test "#{$bin}gt suffixerator -dna -bwt -lcp -tis -suf -pl -dir rev " +
+           "-indexname at1MB.rev -db #{reffile}"
+  [["sa","-markdist 32"],
+   ["mixed","-markdist 32 -textmarkdist 8"],
+   ["big","-size big -textmarkdist 3"],
+   ["full","-markdist 1"],
+   ["text","-markdist 64 -textmarkdist 1"]].each do |name,opts|
+    run_test "#{$bin}gt mkfmindex #{opts} -fmout #{name} -ii at1MB.rev"
+    run_test "#{$bin}gt suffixerator -plain -des no -ssp no -sds no -tis " +
+             "-indexname #{name} -smap #{name}.al1 -db #{name}.bwt"
+    ["","-fmisingle"].each do |single|
+      run_test "#{$bin}gt dev patternmatch -ii fwd -fmi #{name} #{single} " +
+               "-minpl 5 -maxpl 8 -samples 500", :maxtime => 120
+    end
+  end
+  run_test "#{$bin}gt mkfmindex -markdist 24 -fmout odd -ii at1MB.rev",
+           :retval => 1
+  grep last_stderr, /power of 2/
+end
+
 allfiles.each do |reffile|
   allfiles.each do |queryfile|
     if queryfile != reffile
@@ -167,6 +193,34 @@ allfiles.each do |reffile|
   end
 end
 
+Name "gt matstat/uniquesub multithreaded batches"
+Keywords "gt_greedyfwdmat gt_matstat_threads"
+Test do
+  reffile = "#{$testdata}at1MB"
+  queryfile = "#{$testdata}U89959_ests.fas"
+  run "#{$scriptsdir}/runmkfm.sh #{$bin}gt 0 . fmi #{reffile}",
+      :maxtime => 100
+  run "#{$bin}gt suffixerator -indexname sfx -tis -suf -ssp -dna " +
+      "-db #{reffile}"
+  run "#{$bin}gt packedindex mkindex -tis -ssp -indexname pck -db " +
+      "#{reffile} -sprank -dna -pl -bsize 10 -locfreq 32 -dir rev",
+      :maxtime => 180
+  ["matstat -verify","uniquesub"].each do |prog|
+    ["fmi","esa","pck"].each do |indextype|
+      args = "-min 1 -max 20 -output querypos sequence -query #{queryfile} " +
+             "-#{indextype} #{indextype == "esa" ? "sfx" : indextype}"
+      run_test "#{$bin}gt #{prog} #{args}", :maxtime => 600
+      run "mv #{last_stdout} seq.out"
+      ["-batchsize 1","-batchsize 7",""].each do |batchopt|
+        run_test "#{$bin}gt -j 3 #{prog} #{batchopt} #{args}",
+                 :maxtime => 600
+        run "cmp seq.out #{last_stdout}"
+      end
+    end
+  end
+  run "rm -f sfx.* fmi.* pck.*"
+end
+
 Name "gt matstat/uniquesub at1MB U8"
 Keywords "gt_greedyfwdmat"
 Test do
@@ -159,6 +159,66 @@ Test do
   run "diff -i #{last_stdout} #{$testdata}gt_linspace_align_global_affine_special_cases.out"
 end
 
+# development option 'computeonlyscore' uses the striped SIMD kernels with
+# 8 or 16 bit values, the large score values enforce the fallback to 64 bit
+Name "gt linspace_align computeonlyscore dna"
+Keywords "gt_linspace_align computeonlyscore"
+Test do
+  filepairs = [["Ecoli-section1.fna", "Ecoli-section2.fna"],
+               ["gt_linspace_align_test_1.fas", "gt_linspace_align_test_2.fas"],
+               ["gt_linspace_align_test_3.fas", "gt_linspace_align_test_4.fas"],
+               ["gt_linspace_align_affine_test_1.fas",
+                "gt_linspace_align_affine_test_2.fas"],
+               ["gt_linspace_align_special_cases_test_1.fas",
+                "gt_linspace_align_special_cases_test_2.fas"]]
+  costs = ["-global -l 0 1 1",
+           "-global -l 0 3 2",
+           "-global -l 0 3000 2000",
+           "-local -l 2 \" -2\" \" -1\"",
+           "-local -l 1000 \" -1000\" \" -500\"",
+           "-global -a 0 2 3 1",
+           "-local -a 6 \" -2\" \" -5\" \" -1\"",
+           "-local -a 1000 \" -1000\" \" -500\" \" -100\""]
+  filepairs.each do |f1, f2|
+    costs.each do |cost|
+      run_test "#{$bin}gt dev linspace_align -ff #{$testdata}#{f1} "\
+               "#{$testdata}#{f2} -dna #{cost} -showonlyscore"
+      temp = last_stdout
+      run_test "#{$bin}gt dev linspace_align -ff #{$testdata}#{f1} "\
+               "#{$testdata}#{f2} -dna #{cost} -computeonlyscore"
+      run "diff #{last_stdout} #{temp}"
+    end
+  end
+end
+
+Name "gt linspace_align computeonlyscore protein"
+Keywords "gt_linspace_align computeonlyscore"
+Test do
+  filelist = ["protein_10.fas",
+              "protein_10th.fas",
+              "protein_short.fas"]
+  costs = ["-global -l #{$testdata}BLOSUM62 \" -1\"",
+           "-local -l #{$testdata}BLOSUM62 \" -4\"",
+           "-global -a #{$testdata}BLOSUM62 \" -11\" \" -1\"",
+           "-local -a #{$testdata}BLOSUM62 \" -11\" \" -1\""]
+  filelist.each do |f1|
+    filelist.each do |f2|
+      if f1 != f2
+        costs.each do |cost|
+          run_test "#{$bin}gt dev linspace_align -ff #{$testdata}nGASP/#{f1} "\
+                   "#{$testdata}nGASP/#{f2} -protein #{cost} -showonlyscore",
+                   :maxtime => 180
+          temp = last_stdout
+          run_test "#{$bin}gt dev linspace_align -ff #{$testdata}nGASP/#{f1} "\
+                   "#{$testdata}nGASP/#{f2} -protein #{cost} "\
+                   "-computeonlyscore", :maxtime => 180
+          run "diff #{last_stdout} #{temp}"
+        end
+      end
+    end
+  end
+end
+
 Name "gt linspace_align all checkfun with gt_paircmp (dna)"
 Keywords "gt_linspace_align"
 Test do
@@ -117,3 +117,13 @@ Test do
   run_test "#{$bin}gt matchtool -type BLASTOUT -matchfile #{$testdata}matchtool_blast.match.bz2"
   run "diff #{last_stdout} #{$testdata}matchtool_blast.out"
 end
+
+Name "gt matchtool test (Smith-Waterman)"
+Keywords "gt_matchtool"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname sw100K1 #{$testdata}sw100K1.fsa"
+  run_test "#{$bin}gt encseq encode -indexname sw100K2 #{$testdata}sw100K2.fsa"
+  run_test "#{$bin}gt matchtool -type SW -db sw100K1 -query sw100K2 " +
+           "-swminlen 5 -swmaxedist 1000"
+  run "diff #{last_stdout} #{$testdata}matchtool_sw.out"
+end
@@ -156,6 +156,41 @@ Test do
                          :chkintegrity => 800, :chksearch => 400 })
 end
 
+Name "gt packedindex check tools with interleaved rank lines"
+Keywords "gt_packedindex interleave"
+Test do
+  allfiles = prependTestdata(myfilelist)
+  runAndCheckPackedIndex('miniindex', allfiles,
+                         :bdx => { '-interleave' => nil })
+  runAndCheckPackedIndex('miniindex', allfiles,
+                         :bdx => { '-interleave' => nil, '-sprank' => nil },
+                         :chksearch => { '-full-lfmap' => nil },
+                         :timeOuts => { :chksearch => 800 })
+  prependTestdata(['Random160.fna', 'Random159.fna',
+                   'Random80.fna']).each do |file|
+    runAndCheckPackedIndex(nil, [file],
+                           :bdx => { '-interleave' => nil, '-bsize' => 10 })
+  end
+end
+
+Name "gt packedindex interleaved rank lines at1MB"
+Keywords "gt_packedindex interleave"
+Test do
+  runAndCheckPackedIndex('at1MB', ["#{$testdata}at1MB"],
+                         :bdx => { '-interleave' => nil },
+                         :timeOuts => { :bdxcreat => 400,
+                         :suffixerator => 400,
+                         :chkintegrity => 800, :chksearch => 400 })
+end
+
+Name "gt packedindex interleaved rank lines for protein"
+Keywords "gt_packedindex interleave"
+Test do
+  run_test("#{$bin}gt packedindex mkindex -tis -interleave -indexname pck " +
+           "-db #{$testdata}sw100K2.fsa", :retval => 1)
+  grep(last_stderr, /interleaved rank lines are only available for DNA/)
+end
+
 if $gttestdata then
   Name "gt packedindex check tools for chr01 yeast"
   Keywords "gt_packedindex"
@@ -255,6 +255,55 @@ Test do
   run "#{$bin}gt repfind -samples 1000 -l 6 -ii sfx",:maxtime => 600
 end
 
+Name "gt repfind compressed suftab"
+Keywords "gt_repfind compressedoutput"
+Test do
+  run_test "#{$bin}gt suffixerator -db #{$testdata}Atinsert.fna " +
+           "-indexname sfx -dna -tis -suf -lcp -ssp -compressedoutput"
+  run_test "#{$bin}gt dev sfxmap -esa sfx -compressedesa"
+  run_test "#{$bin}gt repfind -l 8 -ii sfx"
+  run "grep -v '^#' #{last_stdout}"
+  run "diff -w #{last_stdout} #{$testdata}repfind-result/Atinsert-8-8"
+  run_test "#{$bin}gt repfind -scan -l 8 -ii sfx"
+  run "grep -v '^#' #{last_stdout}"
+  run "diff -w #{last_stdout} #{$testdata}repfind-result/Atinsert-8-8"
+  run_test "#{$bin}gt tallymer mkindex -mersize 8 -minocc 2 -esa sfx " +
+           "-counts -pl -indexname tyr-compressed"
+  run_test "#{$bin}gt suffixerator -db #{$testdata}Atinsert.fna " +
+           "-indexname sfx -dna -tis -suf -lcp -ssp"
+  run_test "#{$bin}gt tallymer mkindex -mersize 8 -minocc 2 -esa sfx " +
+           "-counts -pl -indexname tyr-plain"
+  ["mer","mct","mbd"].each do |suffix|
+    run "cmp tyr-compressed.#{suffix} tyr-plain.#{suffix}"
+  end
+end
+
+Name "gt repfind multithreaded"
+Keywords "gt_repfind gt_repfind_threads"
+Test do
+  [["at1MB",""],["Duplicate.fna",""],
+   ["at1MB","-compressedoutput"]].each do |reffile,sfxopt|
+    run_test "#{$bin}gt suffixerator -db #{$testdata}#{reffile} " +
+             "-indexname sfx -dna -tis -suf -lcp -ssp #{sfxopt}",
+             :maxtime => 120
+    [8,14,32].each do |minlength|
+      ["","-maxfreq 3"].each do |maxfreqopt|
+        if sfxopt != "" and maxfreqopt != ""
+          next
+        end
+        args = "-l #{minlength} #{maxfreqopt} -ii sfx"
+        run_test "#{$bin}gt repfind #{args}", :maxtime => 300
+        run "mv #{last_stdout} seq.out"
+        [2,3,4].each do |threads|
+          run_test "#{$bin}gt -j #{threads} repfind #{args}", :maxtime => 300
+          run "cmp seq.out #{last_stdout}"
+        end
+      end
+    end
+    run "rm -f sfx.*"
+  end
+end
+
 if $gttestdata then
   extendexception = ["hs5hcmvcg.fna","Wildcards.fna","at1MB"]
   repfindtestfiles.each do |reffile|
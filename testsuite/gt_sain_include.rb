@@ -0,0 +1,24 @@
+["at1MB","U89959_genomic.fas","Atinsert.fna"].each do |filename|
+  Name "gt sain #{filename}"
+  Keywords "gt_sain"
+  Test do
+    ["fwd","rev","cpl","rcl"].each do |dir|
+      run "#{$bin}gt -j 4 dev sain -fcheck -icheck -suf -dir #{dir} " +
+          "-fasta #{$testdata}#{filename}"
+      run "mv #{filename}.suf #{filename}.j4.suf"
+      run "#{$bin}gt dev sain -fcheck -icheck -suf -dir #{dir} " +
+          "-fasta #{$testdata}#{filename}"
+      run "cmp -s #{filename}.suf #{filename}.j4.suf"
+    end
+    ["","-j 4"].each do |opt|
+      run "#{$bin}gt #{opt} dev sain -fcheck -icheck -file " +
+          "#{$testdata}#{filename}"
+    end
+    run "#{$bin}gt encseq encode -indexname esq #{$testdata}#{filename}"
+    ["fwd","rev","cpl","rcl"].each do |dir|
+      ["","-j 3","-j 4"].each do |opt|
+        run "#{$bin}gt #{opt} dev sain -fcheck -icheck -dir #{dir} -esq esq"
+      end
+    end
+  end
+end
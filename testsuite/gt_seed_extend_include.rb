@@ -40,6 +40,28 @@ Test do
   run_test build_encseq("U89959_genomic", "#{$testdata}U89959_genomic.fas")
   run_test "#{$bin}/gt seed_extend -ii at1MB -qii U89959_genomic -ani"
   run "diff -I '^#' #{last_stdout} #{$testdata}/see-ext-ani-at1MB-U8.txt"
+  for opts in ["", " -parts 3", " -parts 3 -kmerfile no"]
+    run_test "#{$bin}/gt -j 4 seed_extend -ii at1MB -qii U89959_genomic " +
+             "-ani#{opts}"
+    run "diff -I '^#' #{last_stdout} #{$testdata}/see-ext-ani-at1MB-U8.txt"
+  end
+end
+
+Name "gt seed_extend: threading, statistics"
+Keywords "gt_seed_extend thread gt_seed_extend_thread ANI"
+Test do
+  run_test build_encseq("at1MB", "#{$testdata}at1MB")
+  run_test build_encseq("fastq_long", "#{$testdata}fastq_long.fastq")
+  for dataset in ["at1MB", "fastq_long"] do
+    for opts in [" -ani", " -trimstat", " -outfmt evalue bitscore"]
+      for parts in ["", " -parts 3"]
+        run_test "#{$bin}gt seed_extend -ii #{dataset}#{opts}#{parts}"
+        run "mv #{last_stdout} single_thread.out"
+        run_test "#{$bin}gt -j 4 seed_extend -ii #{dataset}#{opts}#{parts}"
+        run "diff single_thread.out #{last_stdout}"
+      end
+    end
+  end
 end
 
 Name "gt seed_extend: blast like output"
@@ -374,6 +396,65 @@ Test do
   end
 end
 
+Name "gt seed_extend: threading within one pair of parts"
+Keywords "gt_seed_extend thread gt_seed_extend_thread"
+Test do
+  run_test build_encseq("at1MB", "#{$testdata}at1MB")
+  run_test build_encseq("fastq_long", "#{$testdata}fastq_long.fastq")
+  run_test build_encseq("U89959_genomic", "#{$testdata}U89959_genomic.fas")
+  for dataset in ["at1MB", "fastq_long"] do
+    for query in ["", " -qii U89959_genomic"]
+      for opts in ["", " -outfmt alignment", " -extendxdrop -kmerfile no"]
+        run_test "#{$bin}gt seed_extend -ii #{dataset}#{query}#{opts}"
+        run "mv #{last_stdout} single_thread.out"
+        # the output order does not depend on the number of threads
+        run_test "#{$bin}gt -j 4 seed_extend -ii #{dataset}#{query}#{opts}"
+        run "diff single_thread.out #{last_stdout}"
+      end
+    end
+  end
+end
+
+Name "gt seed_extend: threading, k-mers collected in parallel"
+Keywords "gt_seed_extend thread gt_seed_extend_thread"
+Test do
+  run_test build_encseq("at1MB", "#{$testdata}at1MB")
+  run_test build_encseq("Atinsert", "#{$testdata}Atinsert.fna")
+  run_test build_encseq("U89959_ests", "#{$testdata}U89959_ests.fas")
+  for dataset in ["at1MB", "Atinsert", "U89959_ests"] do
+    for seedlength in [10, 14, 30]
+      run_test "#{$bin}gt seed_extend -ii #{dataset} -debug-kmer " +
+               "-seedlength #{seedlength} -kmerfile no"
+      run "mv #{last_stdout} single_thread.out"
+      # the k-mers are the same and in the same order for all threads
+      run_test "#{$bin}gt -j 3 seed_extend -ii #{dataset} -debug-kmer " +
+               "-seedlength #{seedlength} -kmerfile no"
+      run "diff single_thread.out #{last_stdout}"
+    end
+  end
+end
+
+Name "gt seed_extend: threading, output in order of parts"
+Keywords "gt_seed_extend thread gt_seed_extend_thread"
+Test do
+  run_test build_encseq("at1MB", "#{$testdata}at1MB")
+  run_test build_encseq("fastq_long", "#{$testdata}fastq_long.fastq")
+  run_test build_encseq("U89959_genomic", "#{$testdata}U89959_genomic.fas")
+  for dataset in ["at1MB", "fastq_long"] do
+    for query in ["", " -qii U89959_genomic"]
+      for opts in [" -parts 3", " -parts 3 -kmerfile no", " -parts 2"]
+        run_test "#{$bin}gt seed_extend -ii #{dataset}#{query}#{opts}"
+        run "mv #{last_stdout} single_thread.out"
+        for jobs in [2, 4, 8]
+          run_test "#{$bin}gt -j #{jobs} seed_extend -ii #{dataset}#{query}" +
+                   "#{opts}"
+          run "diff single_thread.out #{last_stdout}"
+        end
+      end
+    end
+  end
+end
+
 # KmerPos and SeedPair verification
 Name "gt seed_extend: small_poly, no extension, verify lists"
 Keywords "gt_seed_extend only-seeds verify debug-kmer debug-seedpair small_poly"
@@ -0,0 +1,23 @@
+["Atinsert.fna","sw100K1.fsa","RandomN.fna"].each do |filename|
+  Name "gt sfxbench #{filename}"
+  Keywords "gt_sfxbench"
+  Test do
+    run_test "#{$bin}gt encseq encode -indexname sfxidx " +
+             "#{$testdata}#{filename}"
+    run_test "#{$bin}gt dev sfxbench -check -runs 2 sfxidx"
+    run "grep -v '^#' #{last_stdout}"
+    run "test `wc -l < #{last_stdout}` -eq 10"
+    run_test "#{$bin}gt dev sfxbench -check -alg algbds dc radix " +
+             "-algbds 5 20 100 -dc 16 -parts 3 sfxidx"
+    run_test "#{$bin}gt -j 4 dev sfxbench -alg sain bucket -check sfxidx"
+  end
+end
+
+Name "gt sfxbench illegal algorithm"
+Keywords "gt_sfxbench"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname sfxidx " +
+           "#{$testdata}Atinsert.fna"
+  run_test "#{$bin}gt dev sfxbench -alg quick -runs 1 sfxidx", :retval => 1
+  grep last_stderr, /illegal algorithm "quick"/
+end
@@ -608,4 +608,68 @@ Test do
   run "#{$bin}/gt -j 3 suffixerator -db #{$testdata}/at1MB -indexname foo " + \
       "-lcp -suf", :retval => 1
   grep(last_stderr, /cannot be used when/)
-end
\ No newline at end of file
+end
+["at1MB","Atinsert.fna","U89959_genomic.fas"].each do |filename|
+  ["fwd","rcl"].each do |dir|
+    Name "gt dev mklcp #{filename} #{dir}"
+    Keywords "gt_suffixerator mklcp"
+    Test do
+      run "#{$bin}/gt suffixerator -db #{$testdata}/#{filename} " + \
+          "-dir #{dir} -indexname ref -suf -lcp -tis"
+      ["","-j 3"].each do |opt|
+        run "#{$bin}/gt suffixerator -db #{$testdata}/#{filename} " + \
+            "-dir #{dir} -indexname sfx -suf -tis"
+        run "#{$bin}/gt #{opt} dev mklcp -check -ii sfx"
+        run "cmp -s ref.lcp sfx.lcp"
+        run "cmp -s ref.llv sfx.llv"
+        run "#{$bin}/gt dev sfxmap -lcp -suf -tis -esa sfx"
+      end
+    end
+  end
+end
+
+Name "gt dev mklcp without suftab"
+Keywords "gt_suffixerator mklcp"
+Test do
+  run "#{$bin}/gt suffixerator -db #{$testdata}/Atinsert.fna " + \
+      "-indexname sfx -tis"
+  run_test "#{$bin}/gt dev mklcp -ii sfx", :retval => 1
+end
+
+["at1MB","U89959_ests.fas",
+ "U89959_ests.fas Atinsert.fna at1MB"].each do |filenames|
+  Name "gt suffixerator -extmerge #{filenames}"
+  Keywords "gt_suffixerator extmerge"
+  Test do
+    db = filenames.split(" ").map {|f| "#{$testdata}/#{f}"}.join(" ")
+    run "#{$bin}/gt suffixerator -db #{db} -indexname ref -suf -lcp -tis " + \
+        "-des -sds -ssp"
+    run "#{$bin}/gt suffixerator -db #{db} -indexname ext -suf -lcp -tis " + \
+        "-des -sds -ssp -memlimit 1MB -extmerge"
+    ["esq","des","sds","ssp","suf","lcp","llv"].each do |suffix|
+      run "cmp -s ref.#{suffix} ext.#{suffix}"
+    end
+    run "#{$bin}/gt dev sfxmap -suf -lcp -des -sds -ssp -tis -esa ext"
+    run "ls ext-chunk*", :retval => 2
+  end
+end
+
+["U89959_genomic.fas","U89959_genomic.fas Atinsert.fna"].each do |filenames|
+  Name "gt suffixerator -extmerge sequence exceeds memlimit #{filenames}"
+  Keywords "gt_suffixerator extmerge"
+  Test do
+    db = filenames.split(" ").map {|f| "#{$testdata}/#{f}"}.join(" ")
+    run_test "#{$bin}/gt suffixerator -db #{db} -indexname ext -suf -lcp " + \
+             "-tis -memlimit 1MB -extmerge", :retval => 1
+    grep last_stderr, /sequence of length 106973 does not fit into a chunk/
+    run "ls ext.suf ext-chunk*", :retval => 2
+  end
+end
+
+Name "gt suffixerator -extmerge without -memlimit"
+Keywords "gt_suffixerator extmerge"
+Test do
+  run_test "#{$bin}/gt suffixerator -db #{$testdata}/at1MB -suf -lcp " + \
+           "-extmerge", :retval => 1
+  grep last_stderr, /option -extmerge requires option -memlimit/
+end
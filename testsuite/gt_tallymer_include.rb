@@ -58,3 +58,40 @@ if $gttestdata then
     end
   end
 end
+
+Name "gt tallymer mkindex multithreaded and search batch"
+Keywords "gt_tallymer gt_tallymer_threads"
+Test do
+  run_test "#{$bin}gt suffixerator -pl -dna -tis -suf -lcp " +
+           "-indexname sfxidx -db #{$testdata}at1MB", :maxtime => 360
+  [3,8,20].each do |mersize|
+    run_test "#{$bin}gt tallymer mkindex -test -mersize #{mersize} " +
+             "-esa sfxidx"
+    run "mv #{last_stdout} dist.seq"
+    run_test "#{$bin}gt -j 4 tallymer mkindex -test -mersize #{mersize} " +
+             "-esa sfxidx"
+    run "cmp #{last_stdout} dist.seq"
+    run_test "#{$bin}gt tallymer mkindex -mersize #{mersize} -minocc 2 " +
+             "-maxocc 5 -esa sfxidx"
+    run "mv #{last_stdout} list.seq"
+    run_test "#{$bin}gt -j 3 tallymer mkindex -mersize #{mersize} -minocc 2 " +
+             "-maxocc 5 -esa sfxidx"
+    run "cmp #{last_stdout} list.seq"
+    run_test "#{$bin}gt tallymer mkindex -counts -pl -mersize #{mersize} " +
+             "-minocc 1 -indexname tyr-seq -esa sfxidx"
+    run_test "#{$bin}gt -j 4 tallymer mkindex -counts -pl " +
+             "-mersize #{mersize} -minocc 1 -indexname tyr-par -esa sfxidx"
+    run "cmp tyr-seq.mer tyr-par.mer"
+    run "cmp tyr-seq.mct tyr-par.mct"
+    ["f","p","fp"].each do |strand|
+      run_test "#{$bin}gt tallymer search -strand #{strand} -output qseqnum " +
+               "qpos counts sequence -tyr tyr-seq " +
+               "-q #{$testdata}U89959_genomic.fas"
+      run "mv #{last_stdout} search.single"
+      run_test "#{$bin}gt tallymer search -batch -strand #{strand} " +
+               "-output qseqnum qpos counts sequence -tyr tyr-par " +
+               "-q #{$testdata}U89959_genomic.fas"
+      run "cmp #{last_stdout} search.single"
+    end
+  end
+end
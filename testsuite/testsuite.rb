@@ -239,10 +239,13 @@ require 'gt_chain2dim_include'
 require 'gt_cmpprjfiles_include'
 require 'gt_env_options_include'
 require 'gt_extractseq_include'
+require 'gt_fastareader_include'
 require 'gt_idxsearch_include'
 require 'gt_repfind_include'
 require 'gt_mergeesa_include'
 require 'gt_packedindex_include'
+require 'gt_sain_include'
+require 'gt_sfxbench_include'
 require 'gt_sortbench_include'
 require 'gt_suffixerator_include'
 require 'gt_encseq2spm_include'